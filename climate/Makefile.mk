@@ -21,5 +21,7 @@ climate_climate_la_SOURCES += climate/test.cpp
 climate_climate_la_SOURCES += climate/test.h
 climate_climate_la_SOURCES += climate/weather.cpp
 climate_climate_la_SOURCES += climate/weather.h
+climate_climate_la_SOURCES += climate/weather_cache.cpp
+climate_climate_la_SOURCES += climate/weather_cache.h
 climate_climate_la_SOURCES += climate/weather_reader.cpp
 climate_climate_la_SOURCES += climate/weather_reader.h
@@ -21,6 +21,7 @@
 
 #include "gridlabd.h"
 #include "climate.h"
+#include "weather_cache.h"
 #include "timestamp.h"
 EXPORT_CREATE(climate)
 EXPORT_INIT(climate)
@@ -89,13 +90,8 @@ EXPORT int64 calculate_solar_radiation_shading_radians(OBJECT *obj, double tilt,
 }
 
 EXPORT int64 calculate_solar_radiation_shading_position_radians(OBJECT *obj, double tilt, double orientation, double latitude, double longitude, double shading_value, double *value){
-	static SolarAngles sa; // just for the functions
 	double ghr, dhr, dnr = 0.0;
 	double cos_incident = 0.0;
-	double std_time = 0.0;
-	double solar_time = 0.0;
-	short int doy = 0;
-	DATETIME dt;
 
 	climate *cli;
 	if(obj == 0 || value == 0){
@@ -110,11 +106,7 @@ EXPORT int64 calculate_solar_radiation_shading_position_radians(OBJECT *obj, dou
 
 	cli->get_solar_for_location(latitude, longitude, &dnr, &ghr, &dhr);
 
-	gl_localtime(obj->clock, &dt);
-	std_time = (double)(dt.hour) + ((double)dt.minute)/60.0  + (dt.is_dst ? -1.0:0.0);
-	doy=sa.day_of_yr(dt.month,dt.day);
-	solar_time = sa.solar_time(std_time, doy, RAD(cli->get_tz_meridian()), RAD(longitude));
-	cos_incident = sa.cos_incident(RAD(latitude), tilt, orientation, solar_time, doy);
+	cos_incident = cli->get_incidence_liujordan(tilt, orientation, latitude, longitude);
 	*value = (shading_value*dnr*cos_incident) + dhr*(1+cos(tilt))/2. + ghr*(1-cos(tilt))*cli->get_ground_reflectivity()/2.;
 
 	return 1;
@@ -135,12 +127,9 @@ EXPORT int64 calc_solar_solpos_shading_rad(OBJECT *obj, double tilt, double orie
 //Solar radiation calcuation based on solpos and Perez tilt models
 EXPORT int64 calc_solar_solpos_shading_position_rad(OBJECT *obj, double tilt, double orientation, double latitude, double longitude, double shading_value, double *value)
 {
-	static SolarAngles sa; // just for the functions
 	double ghr, dhr, dnr;
 	double cos_incident;
-	double temp_value;
-	DATETIME dt;
-	TIMESTAMP offsetclock;
+	double perez_horz;
 
 	climate *cli;
 	if(obj == 0 || value == 0){
@@ -153,63 +142,10 @@ EXPORT int64 calc_solar_solpos_shading_position_rad(OBJECT *obj, double tilt, do
 
 	cli->get_solar_for_location(latitude, longitude, &dnr, &ghr, &dhr);
 
-	if (cli->reader_type==1)//check if reader_type is TMY2.
-	{
-		//Adjust time by half an hour - adjusts per TMY "reading" intervals - what they really represent
-		offsetclock = obj->clock + 1800;
-	}
-	else	//Just pass it in
-	{
-		offsetclock = obj->clock;
-	}
-
-	gl_localtime(offsetclock, &dt);
-
-	//Convert temperature back to centrigrade - since we seem to like imperial units
-	temp_value = ((cli->get_temperature() - 32.0)*5.0/9.0);
-
-	//Initialize solpos algorithm
-	sa.S_init(&sa.solpos_vals);
-
-	//Assign in values
-	sa.solpos_vals.longitude = longitude;
-	sa.solpos_vals.latitude = RAD(latitude);
-	if (dt.is_dst == 1)
-	{
-		sa.solpos_vals.timezone = cli->get_tz_offset_val()-1.0;
-	}
-	else
-	{
-		sa.solpos_vals.timezone = cli->get_tz_offset_val();
-	}
-	sa.solpos_vals.year = dt.year;
-	sa.solpos_vals.daynum = (dt.yearday+1);
-	sa.solpos_vals.hour = dt.hour+(dt.is_dst?-1:0);
-	sa.solpos_vals.minute = dt.minute;
-	sa.solpos_vals.second = dt.second;
-	sa.solpos_vals.temp = temp_value;
-	sa.solpos_vals.press = cli->get_pressure();
-
-	// Solar constant associated with extraterrestrial DNI, 1367 W/sq m - pull from TMY for now
-	//sa.solpos_vals.solcon = 126.998456;	//Use constant value for direct normal extraterrestrial irradiance - doesn't seem right to me
-	sa.solpos_vals.solcon = cli->get_direct_normal_extra();	//Use weather-read version (TMY)
-
-	sa.solpos_vals.aspect = orientation;
-	sa.solpos_vals.tilt = tilt;
-	sa.solpos_vals.diff_horz = dhr;
-	sa.solpos_vals.dir_norm = dnr;
-
-	//Calculate different solar position values
-	sa.S_solpos(&sa.solpos_vals);
-
-	//Pull off new cosine of incidence
-	if (sa.solpos_vals.cosinc >= 0.0)
-		cos_incident = sa.solpos_vals.cosinc;
-	else
-		cos_incident = 0.0;
+	cos_incident = cli->get_incidence_solpos(tilt, orientation, latitude, longitude, dnr, dhr, &perez_horz);
 
 	//Apply the adjustment
-	*value = (shading_value*dnr*cos_incident) + dhr*sa.solpos_vals.perez_horz + ghr*((1-cos(tilt))*cli->get_ground_reflectivity()/2.0);
+	*value = (shading_value*dnr*cos_incident) + dhr*perez_horz + ghr*((1-cos(tilt))*cli->get_ground_reflectivity()/2.0);
 
 	return 1;
 }
@@ -619,6 +555,8 @@ int climate::create(void)
 	cloud_speed_factor = 1;
 	//cloud_reflectivity = 1.0; // very reflective!
 	tmy = nullptr;
+	incidence = new INCIDENCECACHE;
+	incidence_lock = 0;
 	cloud_model = CM_NONE;
 	cloud_num_layers = 40;
 	cloud_alpha = 400;
@@ -787,12 +725,6 @@ int climate::init(OBJECT *parent)
 	
 	// begin parsing the TMY file
 	int line=0;
-	tmy = (TMYDATA*)malloc(sizeof(TMYDATA)*8760);
-	if (tmy==nullptr)
-	{
-		gl_error("TMY buffer allocation failed");
-		return 0;
-	}
 
 	int month, day, hour;//, year;
 	double dnr,dhr,ghr,wspeed,wdir,precip,snowdepth,pressure,extra_dni,extra_ghi,tot_sky_cov,opq_sky_cov;
@@ -853,7 +785,28 @@ int climate::init(OBJECT *parent)
 	file.elevation = (int)(file.elevation * meter_to_feet);
 	tz_meridian =  15 * file.tz_offset;//std_meridians[-file.tz_offset-5];
 	tz_offset_val = file.tz_offset;
-	while (line<8760 && file.next())
+
+	// use the pre-parsed table when another climate object or an earlier run already read this file
+	uint64 hash = weather_cache::hash(found_file,ground_reflectivity);
+	TMYCACHE *cache = weather_cache::find(hash);
+	if ( cache!=nullptr )
+	{
+		gl_verbose("climate:%s - using pre-parsed weather data for '%s'", obj->name, tmyfile.get_string());
+		file.close();
+		tmy = weather_cache::data(cache);
+		record = cache->record;
+		presync(gl_globalclock);
+		return 1;
+	}
+	cache = weather_cache::create(hash);
+	if (cache==nullptr)
+	{
+		gl_error("TMY buffer allocation failed");
+		return 0;
+	}
+	tmy = weather_cache::data(cache);
+
+	while (line<TMY_HOURS && file.next())
 	{
 		while (isdigit(file.buf[1]) == 0) {
 			file.next();
@@ -862,7 +815,7 @@ int climate::init(OBJECT *parent)
 
 		int doy = sa->day_of_yr(month,day);
 		int hoy = (doy - 1) * 24 + (hour-1);
-		if (hoy>=0 && hoy<8760){
+		if (hoy>=0 && hoy<TMY_HOURS){
 			// pre-conversion of solar data from W/m^2 to W/sf
 			if(0 == gl_convert("W/m^2", "W/sf", &(dnr))){
 				gl_error("climate::init unable to gl_convert() 'W/m^2' to 'W/sf'!");
@@ -948,6 +901,8 @@ int climate::init(OBJECT *parent)
 		line++;
 	}
 	file.close();
+	cache->record = record;
+	weather_cache::save(cache);
 
 	/* initialize climate to starttime */
 	presync(gl_globalclock);
@@ -971,6 +926,146 @@ int climate::init(OBJECT *parent)
 	return 1;
 }
 
+/**
+	@addtogroup incidence Solar incidence cache
+	@ingroup climate
+
+	Every consumer of a climate object (e.g., each solar panel) asks for the
+	irradiance on its own surface.  The geometric part of that calculation
+	only depends on the surface and the time, so the incidence factors are
+	kept per surface and recomputed only when the climate clock advances.
+	Consumers with identical tilt, orientation and position share one entry.
+ @{
+ **/
+
+incidence_key::incidence_key(double t, double o, double lat, double lon, INCIDENCEMODEL m)
+{
+	memcpy(&tilt,&t,sizeof(tilt));
+	memcpy(&orientation,&o,sizeof(orientation));
+	memcpy(&latitude,&lat,sizeof(latitude));
+	memcpy(&longitude,&lon,sizeof(longitude));
+	model = m;
+}
+
+bool incidence_key::operator==(const incidence_key &k) const
+{
+	return tilt==k.tilt && orientation==k.orientation && latitude==k.latitude && longitude==k.longitude && model==k.model;
+}
+
+size_t incidence_key_hash::operator()(const incidence_key &k) const
+{
+	uint64 h = k.tilt;
+	h = h*31 + k.orientation;
+	h = h*31 + k.latitude;
+	h = h*31 + k.longitude;
+	h = h*31 + k.model;
+	return std::hash<uint64>()(h);
+}
+
+/** Cosine of the incidence angle for the classic (Liu & Jordan) tilt model
+	@return cosine of the beam incidence angle, zero when the sun is behind the surface
+ **/
+double climate::get_incidence_liujordan(double tilt, double orientation, double latitude, double longitude)
+{
+	OBJECT *obj = OBJECTHDR(this);
+	double cos_incident;
+
+	WRITELOCK(&incidence_lock);
+	std::pair<INCIDENCECACHE::iterator,bool> item = incidence->emplace(incidence_key(tilt,orientation,latitude,longitude,IM_LIUJORDAN),INCIDENCE());
+	INCIDENCE &entry = item.first->second;
+	if ( item.second || entry.clock!=obj->clock )
+	{
+		DATETIME dt;
+		gl_localtime(obj->clock, &dt);
+		double std_time = (double)(dt.hour) + ((double)dt.minute)/60.0  + (dt.is_dst ? -1.0:0.0);
+		short int doy = sa->day_of_yr(dt.month,dt.day);
+		double solar_time = sa->solar_time(std_time, doy, RAD(tz_meridian), RAD(longitude));
+		entry.cos_incident = sa->cos_incident(RAD(latitude), tilt, orientation, solar_time, doy);
+		entry.clock = obj->clock;
+	}
+	cos_incident = entry.cos_incident;
+	WRITEUNLOCK(&incidence_lock);
+
+	return cos_incident;
+}
+
+/** Cosine of the incidence angle and Perez diffuse factor for the solpos tilt model
+	@return cosine of the beam incidence angle, zero when the sun is behind the surface
+ **/
+double climate::get_incidence_solpos(double tilt, double orientation, double latitude, double longitude, double dnr, double dhr, double *perez_horz)
+{
+	OBJECT *obj = OBJECTHDR(this);
+	double cos_incident;
+
+	WRITELOCK(&incidence_lock);
+	std::pair<INCIDENCECACHE::iterator,bool> item = incidence->emplace(incidence_key(tilt,orientation,latitude,longitude,IM_SOLPOS),INCIDENCE());
+	INCIDENCE &entry = item.first->second;
+	if ( item.second || entry.clock!=obj->clock || entry.dnr!=dnr || entry.dhr!=dhr )
+	{
+		SolarAngles::SOLPOS_POSDATA pos;
+		DATETIME dt;
+		TIMESTAMP offsetclock;
+
+		if (reader_type==1)//check if reader_type is TMY2.
+		{
+			//Adjust time by half an hour - adjusts per TMY "reading" intervals - what they really represent
+			offsetclock = obj->clock + 1800;
+		}
+		else	//Just pass it in
+		{
+			offsetclock = obj->clock;
+		}
+
+		gl_localtime(offsetclock, &dt);
+
+		//Initialize solpos algorithm
+		sa->S_init(&pos);
+
+		//Assign in values - temperature is converted back to centigrade
+		pos.longitude = longitude;
+		pos.latitude = RAD(latitude);
+		pos.timezone = dt.is_dst == 1 ? tz_offset_val-1.0 : tz_offset_val;
+		pos.year = dt.year;
+		pos.daynum = (dt.yearday+1);
+		pos.hour = dt.hour+(dt.is_dst?-1:0);
+		pos.minute = dt.minute;
+		pos.second = dt.second;
+		pos.temp = ((temperature - 32.0)*5.0/9.0);
+		pos.press = pressure;
+		pos.solcon = direct_normal_extra;	//Use weather-read version (TMY)
+		pos.aspect = orientation;
+		pos.tilt = tilt;
+		pos.diff_horz = dhr;
+		pos.dir_norm = dnr;
+
+		//Calculate different solar position values
+		sa->S_solpos(&pos);
+
+		entry.cos_incident = pos.cosinc >= 0.0 ? pos.cosinc : 0.0;
+		entry.perez_horz = pos.perez_horz;
+		entry.dnr = dnr;
+		entry.dhr = dhr;
+		entry.clock = obj->clock;
+	}
+	cos_incident = entry.cos_incident;
+	*perez_horz = entry.perez_horz;
+	WRITEUNLOCK(&incidence_lock);
+
+	return cos_incident;
+}
+
+/** Release the incidence factors at the end of the simulation
+ **/
+void climate::release_incidence(void)
+{
+	WRITELOCK(&incidence_lock);
+	delete incidence;
+	incidence = nullptr;
+	WRITEUNLOCK(&incidence_lock);
+}
+
+/**@}**/
+
 int climate::get_solar_for_location(double latitude, double longitude, double *direct, double *global, double *diffuse) {
 	int retval = 1;
 	//int cloud = 0; //binary cloud
@@ -2052,7 +2147,6 @@ TIMESTAMP climate::presync(TIMESTAMP t0) /* called in presync */
 		DATETIME ts;
 		int localres = gl_localtime(t0,&ts);
 		int hoy;
-		double now, hoy0, hoy1, hoy2;
 		if(localres == 0){
 			GL_THROW("climate::sync -- unable to resolve localtime!");
 		}
@@ -2070,160 +2164,31 @@ TIMESTAMP climate::presync(TIMESTAMP t0) /* called in presync */
 				hoy = hoy - 1;
 		}
 		if (hoy < 0){ //Taking care of the wrap-around at the year boundary.
-			hoy = hoy + 8760;
-		}
-		switch(interpolate){
-			case CI_NONE:
-				temperature = (tmy[hoy].temp);
-				humidity = (tmy[hoy].rh);
-				solar_direct = (tmy[hoy].dnr);
-				solar_diffuse = (tmy[hoy].dhr);
-				solar_global = (tmy[hoy].ghr);
-				wind_speed = (tmy[hoy].windspeed);
-				rainfall = (tmy[hoy].rainfall);
-				snowdepth = (tmy[hoy].snowdepth);
-				temperature_raw = (tmy[hoy].temp_raw);
-				solar_azimuth = (tmy[hoy].solar_azimuth);
-				solar_elevation = (tmy[hoy].solar_elevation);
-				solar_zenith = (tmy[hoy].solar_zenith);
-				solar_raw = (tmy[hoy].solar_raw);
-				pressure = tmy[hoy].pressure;
-				direct_normal_extra = tmy[hoy].direct_normal_extra;
-				global_horizontal_extra = tmy[hoy].global_horizontal_extra;
-				wind_dir = tmy[hoy].wind_dir;
-				tot_sky_cov = tmy[hoy].tot_sky_cov;
-				opq_sky_cov = tmy[hoy].opq_sky_cov;
-				if ( memcmp(solar_flux,tmy[hoy].solar,CP_LAST*sizeof(double))!=0 )
-					memcpy(solar_flux,tmy[hoy].solar,sizeof(solar_flux));
-				break;
-			case CI_LINEAR:
-				now = hoy+ts.minute/60.0;
-				hoy0 = hoy;
-				hoy1 = hoy+1.0;
-				temperature = (gl_lerp(now, hoy0, tmy[hoy].temp, hoy1, tmy[hoy+1%8760].temp));
-				humidity = (gl_lerp(now, hoy0, tmy[hoy].rh, hoy1, tmy[hoy+1%8760].rh));
-				solar_direct = (gl_lerp(now, hoy0, tmy[hoy].dnr, hoy1, tmy[hoy+1%8760].dnr));
-				solar_diffuse = (gl_lerp(now, hoy0, tmy[hoy].dhr, hoy1, tmy[hoy+1%8760].dhr));
-				solar_global = (gl_lerp(now, hoy0, tmy[hoy].ghr, hoy1, tmy[hoy+1%8760].ghr));
-				wind_speed = (gl_lerp(now, hoy0, tmy[hoy].windspeed, hoy1, tmy[hoy+1%8760].windspeed));
-				rainfall = (gl_lerp(now, hoy0, tmy[hoy].rainfall, hoy1, tmy[hoy+1%8760].rainfall));
-				snowdepth = (gl_lerp(now, hoy0, tmy[hoy].snowdepth, hoy1, tmy[hoy+1%8760].snowdepth));
-				solar_azimuth = (gl_lerp(now, hoy0, tmy[hoy].solar_azimuth, hoy1, tmy[hoy+1%8760].solar_azimuth));
-				solar_elevation = (gl_lerp(now, hoy0, tmy[hoy].solar_elevation, hoy1, tmy[hoy+1%8760].solar_elevation));
-				solar_zenith = (gl_lerp(now, hoy0, tmy[hoy].solar_zenith, hoy1, tmy[hoy+1%8760].solar_zenith));
-				temperature_raw = (gl_lerp(now, hoy0, tmy[hoy].temp_raw, hoy1, tmy[hoy+1%8760].temp_raw));
-				solar_raw = (gl_lerp(now, hoy0, tmy[hoy].solar_raw, hoy1, tmy[hoy+1%8760].solar_raw));
-				pressure = gl_lerp(now, hoy0, tmy[hoy].pressure, hoy1, tmy[hoy+1%8760].pressure);
-				direct_normal_extra = gl_lerp(now, hoy0, tmy[hoy].direct_normal_extra, hoy1, tmy[hoy+1%8760].direct_normal_extra);
-				global_horizontal_extra = gl_lerp(now, hoy0, tmy[hoy].global_horizontal_extra, hoy1, tmy[hoy+1%8760].global_horizontal_extra);
-				wind_dir = gl_lerp(now, hoy0, tmy[hoy].wind_dir, hoy1, tmy[hoy+1%8760].wind_dir);
-				tot_sky_cov = gl_lerp(now, hoy0, tmy[hoy].tot_sky_cov, hoy1, tmy[hoy+1%8760].tot_sky_cov);
-				opq_sky_cov = gl_lerp(now, hoy0, tmy[hoy].opq_sky_cov, hoy1, tmy[hoy+1%8760].opq_sky_cov);
-				for ( int pt = 0 ; pt < CP_LAST ; ++pt )
-				{
-					solar_flux[pt] = gl_lerp(now, hoy0, tmy[hoy].solar[pt], hoy1, tmy[hoy+1%8760].solar[pt]);
-				}
-				break;
-			case CI_QUADRATIC:
-				now = hoy+ts.minute/60.0;
-				hoy0 = hoy;
-				hoy1 = hoy+1.0;
-				hoy2 = hoy+2.0;
-				temperature = (gl_qerp(now, hoy0, tmy[hoy].temp, hoy1, tmy[hoy+1%8760].temp, hoy2, tmy[hoy+2%8760].temp));
-				humidity = (gl_qerp(now, hoy0, tmy[hoy].rh, hoy1, tmy[hoy+1%8760].rh, hoy2, tmy[hoy+2%8760].rh));
-				if(humidity < 0.0){
-					humidity = 0.0;
-					gl_verbose("Setting humidity to zero. Quadratic interpolation caused the humidity to drop below zero.");
-				}
-				solar_direct = (gl_qerp(now, hoy0, tmy[hoy].dnr, hoy1, tmy[hoy+1%8760].dnr, hoy2, tmy[hoy+2%8760].dnr));
-				if(solar_direct < 0.0){
-					solar_direct = 0.0;
-					gl_verbose("Setting solar_direct to zero. Quadratic interpolation caused the solar_direct to drop below zero.");
-				}
-				solar_diffuse = (gl_qerp(now, hoy0, tmy[hoy].dhr, hoy1, tmy[hoy+1%8760].dhr, hoy2, tmy[hoy+2%8760].dhr));
-				if(solar_diffuse < 0.0){
-					solar_diffuse = 0.0;
-					gl_verbose("Setting solar_diffuse to zero. Quadratic interpolation caused the solar_diffuse to drop below zero.");
-				}
-				solar_global = (gl_qerp(now, hoy0, tmy[hoy].ghr, hoy1, tmy[hoy+1%8760].ghr, hoy2, tmy[hoy+2%8760].ghr));
-				if(solar_global < 0.0){
-					solar_global = 0.0;
-					gl_verbose("Setting solar_global to zero. Quadratic interpolation caused the solar_global to drop below zero.");
-				}
-				wind_speed = (gl_qerp(now, hoy0, tmy[hoy].windspeed, hoy1, tmy[hoy+1%8760].windspeed, hoy2, tmy[hoy+2%8760].windspeed));
-				if(wind_speed < 0.0){
-					wind_speed = 0.0;
-					gl_verbose("Setting wind_speed to zero. Quadratic interpolation caused the wind_speed to drop below zero.");
-				}
-				rainfall = (gl_qerp(now, hoy0, tmy[hoy].rainfall, hoy1, tmy[hoy+1%8760].rainfall, hoy2, tmy[hoy+2%8760].rainfall));
-				if(rainfall < 0.0){
-					rainfall = 0.0;
-					gl_verbose("Setting rainfall to zero. Quadratic interpolation caused the rainfall to drop below zero.");
-				}
-				snowdepth = (gl_qerp(now, hoy0, tmy[hoy].snowdepth, hoy1, tmy[hoy+1%8760].snowdepth, hoy2, tmy[hoy+2%8760].snowdepth));
-				if(snowdepth < 0.0){
-					snowdepth = 0.0;
-					gl_verbose("Setting snowdepth to zero. Quadratic interpolation caused the snowdepth to drop below zero.");
-				}
-				solar_azimuth = (gl_qerp(now, hoy0, tmy[hoy].solar_azimuth, hoy1, tmy[hoy+1%8760].solar_azimuth, hoy2, tmy[hoy+2%8760].solar_azimuth));
-				solar_elevation = (gl_qerp(now, hoy0, tmy[hoy].solar_elevation, hoy1, tmy[hoy+1%8760].solar_elevation, hoy2, tmy[hoy+2%8760].solar_elevation));
-				solar_zenith = (gl_qerp(now, hoy0, tmy[hoy].solar_zenith, hoy1, tmy[hoy+1%8760].solar_zenith, hoy2, tmy[hoy+2%8760].solar_zenith));
-				temperature_raw = (gl_qerp(now, hoy0, tmy[hoy].temp_raw, hoy1, tmy[hoy+1%8760].temp_raw, hoy2, tmy[hoy+2%8760].temp_raw));
-				solar_raw = (gl_qerp(now, hoy0, tmy[hoy].solar_raw, hoy1, tmy[hoy+1%8760].solar_raw, hoy2, tmy[hoy+2%8760].solar_raw));
-				if(solar_raw < 0.0){
-					solar_raw = 0.0;
-					gl_verbose("Setting solar_raw to zero. Quadratic interpolation caused the solar_raw to drop below zero.");
-				}
-				pressure = gl_qerp(now, hoy0, tmy[hoy].pressure, hoy1, tmy[hoy+1%8760].pressure, hoy2, tmy[hoy+2%8760].pressure);
-				if(pressure < 0.0){
-					pressure = 0.0;
-					gl_verbose("Setting pressure to zero. Quadratic interpolation caused the pressure to drop below zero.");
-				}
-				direct_normal_extra = gl_qerp(now, hoy0, tmy[hoy].direct_normal_extra, hoy1, tmy[hoy+1%8760].direct_normal_extra, hoy2, tmy[hoy+2%8760].direct_normal_extra);
-				if(direct_normal_extra < 0.0){
-					direct_normal_extra = 0.0;
-					gl_verbose("Setting extraterrestrial_direct_normal to zero. Quadratic interpolation caused the extraterrestrial_direct_normal to drop below zero.");
-				}
-				global_horizontal_extra = gl_qerp(now, hoy0, tmy[hoy].global_horizontal_extra, hoy1, tmy[hoy+1%8760].global_horizontal_extra, hoy2, tmy[hoy+2%8760].global_horizontal_extra);
-				if(global_horizontal_extra < 0.0){
-					global_horizontal_extra = 0.0;
-					gl_verbose("Setting global_horizontal_extra to zero. Quadratic interpolation caused the global_horizontal_extra to drop below zero.");
-				}
-				wind_dir = gl_qerp(now, hoy0, tmy[hoy].wind_dir, hoy1, tmy[hoy+1%8760].wind_dir, hoy2, tmy[hoy+2%8760].wind_dir);
-				if(wind_dir < 0.0){
-					wind_dir = 360.0+wind_dir;
-					gl_verbose("Setting wind_dir to 360+wind_dir. Quadratic interpolation caused the wind_dir to drop below zero.");
-				}
-				if(wind_dir > 360.0){
-					wind_dir = wind_dir-360.0;
-					gl_verbose("Setting wind_dir to wind_dir-360. Quadratic interpolation caused the wind_dir to rise above 360.");
-				}
-				tot_sky_cov = gl_qerp(now, hoy0, tmy[hoy].tot_sky_cov, hoy1, tmy[hoy+1%8760].tot_sky_cov, hoy2, tmy[hoy+2%8760].tot_sky_cov);
-				if(tot_sky_cov < 0.0){
-					tot_sky_cov = 0.0;
-					gl_verbose("Setting tot_sky_cov to zero. Quadratic interpolation caused the tot_sky_cov to drop below zero.");
-				}
-				opq_sky_cov = gl_qerp(now, hoy0, tmy[hoy].opq_sky_cov, hoy1, tmy[hoy+1%8760].opq_sky_cov, hoy2, tmy[hoy+2%8760].opq_sky_cov);
-				if(opq_sky_cov < 0.0){
-					opq_sky_cov = 0.0;
-					gl_verbose("Setting opq_sky_cov to zero. Quadratic interpolation caused the opq_sky_cov to drop below zero.");
-				}
-
-				for ( int pt = 0; pt < CP_LAST; ++pt )
-				{
-					if ( tmy[hoy].solar[pt] == tmy[hoy+1].solar[pt])
-					{
-						solar_flux[pt] = tmy[hoy].solar[pt];
-					} else {
-						solar_flux[pt] = gl_qerp(now, hoy0, tmy[hoy].solar[pt], hoy1, tmy[hoy+1%8760].solar[pt], hoy2, tmy[hoy+2%8760].solar[pt]);
-						if(solar_flux[pt] < 0.0)
-							solar_flux[pt] = 0.0; /* quadratic isn't always cooperative... */
-					}
-				}
-				break;
-			default:
-				GL_THROW("climate::sync -- unrecognized interpolation mode!");
+			hoy = hoy + TMY_HOURS;
 		}
+		TMYDATA sample;
+		weather_cache::interpolate(interpolate, tmy, hoy, hoy+ts.minute/60.0, &sample);
+		temperature = sample.temp;
+		humidity = sample.rh;
+		solar_direct = sample.dnr;
+		solar_diffuse = sample.dhr;
+		solar_global = sample.ghr;
+		wind_speed = sample.windspeed;
+		rainfall = sample.rainfall;
+		snowdepth = sample.snowdepth;
+		temperature_raw = sample.temp_raw;
+		solar_azimuth = sample.solar_azimuth;
+		solar_elevation = sample.solar_elevation;
+		solar_zenith = sample.solar_zenith;
+		solar_raw = sample.solar_raw;
+		pressure = sample.pressure;
+		direct_normal_extra = sample.direct_normal_extra;
+		global_horizontal_extra = sample.global_horizontal_extra;
+		wind_dir = sample.wind_dir;
+		tot_sky_cov = sample.tot_sky_cov;
+		opq_sky_cov = sample.opq_sky_cov;
+		if ( memcmp(solar_flux,sample.solar,CP_LAST*sizeof(double))!=0 )
+			memcpy(solar_flux,sample.solar,sizeof(solar_flux));
 		update_forecasts(t0);
 		tmy_rv = -(t0+(3600*TS_SECOND-t0%(3600 *TS_SECOND))); /// negative means soft event
 	}
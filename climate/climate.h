@@ -11,6 +11,7 @@
 
 #include <stdarg.h>
 #include <vector>
+#include <unordered_map>
 
 #include "gridlabd.h"
 #include "solar_angles.h"
@@ -66,6 +67,40 @@ typedef struct s_tmy {
 	double opq_sky_cov;
 } TMYDATA;
 
+/** Incidence factors of one surface (tilt, orientation, location and tilt
+	model), shared by every consumer of a climate object that asks for the
+	same surface and recomputed at most once per timestep.
+ **/
+typedef struct s_incidence {
+	TIMESTAMP clock; ///< time at which the factors were computed
+	double dnr; ///< direct normal used by the Perez factor (solpos only)
+	double dhr; ///< diffuse horizontal used by the Perez factor (solpos only)
+	double cos_incident; ///< cosine of the beam incidence angle
+	double perez_horz; ///< Perez diffuse tilt factor (solpos only)
+} INCIDENCE;
+
+typedef enum {
+	IM_LIUJORDAN = 0, ///< classic Duffie & Beckman incidence
+	IM_SOLPOS = 1, ///< solpos position with Perez diffuse tilt
+} INCIDENCEMODEL;
+
+/** Surface key of the incidence cache; doubles are compared bitwise so
+	NaN (unspecified) positions are cached like any other value.
+ **/
+struct incidence_key {
+	uint64 tilt;
+	uint64 orientation;
+	uint64 latitude;
+	uint64 longitude;
+	INCIDENCEMODEL model;
+	incidence_key(double t, double o, double lat, double lon, INCIDENCEMODEL m);
+	bool operator==(const incidence_key &k) const;
+};
+struct incidence_key_hash {
+	size_t operator()(const incidence_key &k) const;
+};
+typedef std::unordered_map<incidence_key,INCIDENCE,incidence_key_hash> INCIDENCECACHE;
+
 /* published functions */
 EXPORT int64 calculate_solar_radiation_degrees(OBJECT *obj, double tilt, double orientation, double *value);
 EXPORT int64 calculate_solar_radiation_radians(OBJECT *obj, double tilt, double orientation, double *value);
@@ -230,6 +265,8 @@ private:
 	tmy2_reader file;
 	weather_reader *reader_hndl;
 	TMYDATA *tmy;
+	INCIDENCECACHE *incidence; ///< per-surface incidence factors for the current timestep
+	unsigned int incidence_lock;
 public:
 	enumeration reader_type;
 	static CLASS *oclass;
@@ -239,6 +276,9 @@ public:
 	void init_cloud_pattern(void);
 	void update_cloud_pattern(TIMESTAMP dt);
 	int get_solar_for_location(double latitude, double longitude, double *direct, double *global, double *diffuse);
+	double get_incidence_liujordan(double tilt, double orientation, double latitude, double longitude);
+	double get_incidence_solpos(double tilt, double orientation, double latitude, double longitude, double dnr, double dhr, double *perez_horz);
+	void release_incidence(void);
 private:
 	int calc_cloud_pattern_size(std::vector<std::vector<double> > &location_list);
 	void build_cloud_pattern(int col_min, int col_max, int row_min, int row_max);
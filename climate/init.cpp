@@ -12,6 +12,7 @@
 #include "climate.h"
 #include "weather.h"
 #include "csv_reader.h"
+#include "weather_cache.h"
 
 EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 {
@@ -21,6 +22,10 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 		return nullptr;
 	}
 
+	gl_global_create("climate::weather_cache",PT_char1024,&climate_weather_cache,
+		PT_DESCRIPTION, "directory used to keep pre-parsed binary copies of TMY weather files (empty to disable)",
+		nullptr);
+
 	new climate(module);
 	new weather(module);
 	new csv_reader(module);
@@ -29,6 +34,17 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	return climate::oclass;
 }
 
+EXPORT void term(void)
+{
+	/* release the solar incidence caches of the climate objects */
+	FINDLIST *climates = gl_find_objects(FL_NEW,FT_CLASS,SAME,"climate",FT_END);
+	OBJECT *obj = nullptr;
+	while ( (obj=gl_find_next(climates,obj)) != nullptr )
+	{
+		OBJECTDATA(obj,climate)->release_incidence();
+	}
+	gl_free(climates);
+}
 
 CDECL int do_kill()
 {
@@ -0,0 +1,256 @@
+/** $Id: weather_cache.cpp
+	Copyright (C) 2026 Battelle Memorial Institute
+	@file weather_cache.cpp
+	@addtogroup weather_cache
+	@ingroup climate
+
+	The binary cache file is the TMYCACHE header followed by the TMYDATA
+	table exactly as it is laid out in memory.  It is only meaningful to
+	the build that wrote it; the record size stored in the header is
+	checked so a file written by an incompatible build is simply rebuilt.
+ @{
+ **/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "weather_cache.h"
+
+#define TMYCACHE_MAGIC "GLDTMY1"
+
+char1024 climate_weather_cache; ///< directory of the binary weather cache (empty to disable)
+
+static std::map<uint64,TMYCACHE*> loaded; ///< tables already available in this process
+static unsigned int loaded_lock = 0;
+
+/** Compute the key of a weather file
+	@return FNV-1a hash of the file contents and the settings that affect parsing, 0 on failure
+ **/
+uint64 weather_cache::hash(const char *filename, double ground_reflectivity)
+{
+	uint64 h = 14695981039346656037ULL;
+	unsigned char buffer[65536];
+	size_t len;
+	FILE *fp = fopen(filename,"rb");
+	if ( fp==nullptr )
+		return 0;
+	while ( (len=fread(buffer,1,sizeof(buffer),fp))>0 )
+	{
+		for ( size_t n=0 ; n<len ; n++ )
+		{
+			h ^= buffer[n];
+			h *= 1099511628211ULL;
+		}
+	}
+	fclose(fp);
+
+	// compass point fluxes depend on the ground reflectivity
+	const unsigned char *p = (const unsigned char*)&ground_reflectivity;
+	for ( size_t n=0 ; n<sizeof(ground_reflectivity) ; n++ )
+	{
+		h ^= p[n];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+const char *weather_cache::filename(uint64 hash, char *buffer, size_t len)
+{
+	snprintf(buffer,len,"%s/%016llx.tmyc",climate_weather_cache.get_string(),(unsigned long long)hash);
+	return buffer;
+}
+
+/** Find a parsed table, first in this process then in the cache directory
+	@return the table, or nullptr if the file has to be parsed
+ **/
+TMYCACHE *weather_cache::find(uint64 hash)
+{
+	TMYCACHE *cache = nullptr;
+	WRITELOCK(&loaded_lock);
+	std::map<uint64,TMYCACHE*>::iterator item = loaded.find(hash);
+	if ( item!=loaded.end() )
+		cache = item->second;
+	else if ( (cache=load(hash))!=nullptr )
+		loaded[hash] = cache;
+	WRITEUNLOCK(&loaded_lock);
+	return cache;
+}
+
+TMYCACHE *weather_cache::load(uint64 hash)
+{
+	char path[2048];
+	if ( hash==0 || climate_weather_cache[0]=='\0' )
+		return nullptr;
+	filename(hash,path,sizeof(path));
+
+	size_t len = sizeof(TMYCACHE)+TMY_HOURS*sizeof(TMYDATA);
+	TMYCACHE *cache = nullptr;
+#ifdef _WIN32
+	FILE *fp = fopen(path,"rb");
+	if ( fp==nullptr )
+		return nullptr;
+	cache = (TMYCACHE*)malloc(len);
+	if ( cache!=nullptr && fread(cache,1,len,fp)!=len )
+	{
+		free(cache);
+		cache = nullptr;
+	}
+	fclose(fp);
+	if ( cache==nullptr )
+		return nullptr;
+#else
+	int fd = open(path,O_RDONLY);
+	struct stat info;
+	if ( fd<0 )
+		return nullptr;
+	if ( fstat(fd,&info)!=0 || (size_t)info.st_size!=len )
+	{
+		gl_warning("weather cache file '%s' has an unexpected size and is ignored", path);
+		close(fd);
+		return nullptr;
+	}
+	void *map = mmap(nullptr,len,PROT_READ,MAP_SHARED,fd,0);
+	close(fd);
+	if ( map==MAP_FAILED )
+	{
+		gl_warning("weather cache file '%s' could not be mapped (%s)", path, strerror(errno));
+		return nullptr;
+	}
+	cache = (TMYCACHE*)map;
+#endif
+	if ( strcmp(cache->magic,TMYCACHE_MAGIC)!=0 || cache->hash!=hash
+		|| cache->records!=TMY_HOURS || cache->size!=(int64)sizeof(TMYDATA) )
+	{
+		gl_warning("weather cache file '%s' is not compatible with this build and is ignored", path);
+#ifdef _WIN32
+		free(cache);
+#else
+		munmap(cache,len);
+#endif
+		return nullptr;
+	}
+	gl_verbose("weather cache file '%s' loaded", path);
+	return cache;
+}
+
+/** Allocate an empty table to be filled by the parser
+	@return the new table, which is available to other climate objects once saved
+ **/
+TMYCACHE *weather_cache::create(uint64 hash)
+{
+	TMYCACHE *cache = (TMYCACHE*)malloc(sizeof(TMYCACHE)+TMY_HOURS*sizeof(TMYDATA));
+	if ( cache==nullptr )
+		return nullptr;
+	memset(cache,0,sizeof(TMYCACHE)+TMY_HOURS*sizeof(TMYDATA));
+	strcpy(cache->magic,TMYCACHE_MAGIC);
+	cache->hash = hash;
+	cache->records = TMY_HOURS;
+	cache->size = sizeof(TMYDATA);
+	return cache;
+}
+
+/** Publish a parsed table to this process and, when enabled, to the cache directory
+	@return 1 on success, 0 if the cache file could not be written (the table is still usable)
+ **/
+int weather_cache::save(TMYCACHE *cache)
+{
+	if ( cache->hash==0 )
+		return 1;
+
+	WRITELOCK(&loaded_lock);
+	loaded[cache->hash] = cache;
+	WRITEUNLOCK(&loaded_lock);
+
+	if ( climate_weather_cache[0]=='\0' )
+		return 1;
+
+	// write under a private name and rename so concurrent runs never see a partial file
+	char path[2048], temp[2100];
+	filename(cache->hash,path,sizeof(path));
+	snprintf(temp,sizeof(temp),"%s.%d",path,(int)getpid());
+	FILE *fp = fopen(temp,"wb");
+	size_t len = sizeof(TMYCACHE)+TMY_HOURS*sizeof(TMYDATA);
+	if ( fp==nullptr || fwrite(cache,1,len,fp)!=len || fclose(fp)!=0 || rename(temp,path)!=0 )
+	{
+		gl_warning("unable to write weather cache file '%s' (%s)", path, strerror(errno));
+		/* TROUBLESHOOT
+			The climate::weather_cache directory does not exist or is not writable.  The
+			weather data is still used, but it will be parsed again on the next run.  Create
+			the directory or change climate::weather_cache to a writable location.
+		*/
+		remove(temp);
+		return 0;
+	}
+	gl_verbose("weather cache file '%s' saved", path);
+	return 1;
+}
+
+/** Interpolate all the fields of a TMY table in a single pass.
+
+	The table is treated as rows of plain doubles so every field gets the
+	same weights, which are computed only once per call.  Non-negative
+	fields are clamped after quadratic interpolation as before.
+ **/
+void weather_cache::interpolate(enumeration method, const TMYDATA *tmy, int hoy, double now, TMYDATA *out)
+{
+	static const size_t N = sizeof(TMYDATA)/sizeof(double);
+	const double *y0 = (const double*)&tmy[hoy];
+	const double *y1 = (const double*)&tmy[(hoy+1)%TMY_HOURS];
+	const double *y2 = (const double*)&tmy[(hoy+2)%TMY_HOURS];
+	double *y = (double*)out;
+	size_t n;
+	double d0 = now-hoy, d1 = now-(hoy+1);
+
+	switch ( method ) {
+	case CI_NONE:
+		*out = tmy[hoy];
+		break;
+	case CI_LINEAR:
+		for ( n=0 ; n<N ; n++ )
+			y[n] = y0[n] + d0*(y1[n]-y0[n]);
+		break;
+	case CI_QUADRATIC:
+		for ( n=0 ; n<N ; n++ )
+		{
+			double a = (y2[n] - 2*y1[n] + y0[n]) / 2;
+			y[n] = a*d0*d1 + (y1[n]-y0[n])*d0 + y0[n];
+		}
+
+		// quadratic isn't always cooperative...
+		if ( out->rh<0.0 ) out->rh = 0.0;
+		if ( out->dnr<0.0 ) out->dnr = 0.0;
+		if ( out->dhr<0.0 ) out->dhr = 0.0;
+		if ( out->ghr<0.0 ) out->ghr = 0.0;
+		if ( out->windspeed<0.0 ) out->windspeed = 0.0;
+		if ( out->rainfall<0.0 ) out->rainfall = 0.0;
+		if ( out->snowdepth<0.0 ) out->snowdepth = 0.0;
+		if ( out->solar_raw<0.0 ) out->solar_raw = 0.0;
+		if ( out->pressure<0.0 ) out->pressure = 0.0;
+		if ( out->direct_normal_extra<0.0 ) out->direct_normal_extra = 0.0;
+		if ( out->global_horizontal_extra<0.0 ) out->global_horizontal_extra = 0.0;
+		if ( out->tot_sky_cov<0.0 ) out->tot_sky_cov = 0.0;
+		if ( out->opq_sky_cov<0.0 ) out->opq_sky_cov = 0.0;
+		if ( out->wind_dir<0.0 ) out->wind_dir += 360.0;
+		if ( out->wind_dir>360.0 ) out->wind_dir -= 360.0;
+		for ( n=0 ; n<CP_LAST ; n++ )
+		{
+			if ( tmy[hoy].solar[n]==tmy[(hoy+1)%TMY_HOURS].solar[n] )
+				out->solar[n] = tmy[hoy].solar[n];
+			else if ( out->solar[n]<0.0 )
+				out->solar[n] = 0.0;
+		}
+		break;
+	default:
+		GL_THROW("climate::sync -- unrecognized interpolation mode!");
+	}
+}
+
+/**@}**/
@@ -0,0 +1,60 @@
+/** $Id: weather_cache.h
+	Copyright (C) 2026 Battelle Memorial Institute
+	@file weather_cache.h
+	@addtogroup climate
+	@ingroup modules
+ @{
+ **/
+
+#ifndef CLIMATE_WEATHER_CACHE_
+#define CLIMATE_WEATHER_CACHE_
+
+#include "climate.h"
+
+#define TMY_HOURS 8760 ///< number of hourly records in a TMY table
+
+extern char1024 climate_weather_cache;
+
+/** Header of a pre-parsed TMY table.  The table itself (TMY_HOURS TMYDATA
+	records) immediately follows the header, both in memory and in the
+	binary cache file, so a mapped cache file is used in place.
+ **/
+typedef struct s_tmycache {
+	char magic[8]; ///< file signature and format version
+	uint64 hash; ///< hash of the weather file contents and parse settings
+	int64 records; ///< number of TMYDATA records following the header
+	int64 size; ///< size of one TMYDATA record (guards against layout changes)
+	CLIMATERECORD record; ///< record values found while parsing the file
+} TMYCACHE;
+
+/**
+	@addtogroup weather_cache Pre-parsed weather data
+	@ingroup climate
+
+	Parsing a TMY file costs far more than the simulation needs it to.  The
+	parsed hourly table is kept once per process for every distinct file,
+	so several climate objects reading the same file share one copy.  When
+	\p climate::weather_cache names a directory, the table is also written
+	there as a binary file named after the content hash, and later runs
+	(including concurrent scenario runs) map that file instead of parsing.
+ **/
+class weather_cache {
+public:
+	static uint64 hash(const char *filename, double ground_reflectivity);
+	static TMYCACHE *find(uint64 hash);
+	static TMYCACHE *create(uint64 hash);
+	static int save(TMYCACHE *cache);
+	static inline TMYDATA *data(TMYCACHE *cache) { return (TMYDATA*)(cache+1); };
+
+	/** Interpolate every field of the hourly table at once
+		@return the interpolated sample in \p out
+	 **/
+	static void interpolate(enumeration method, const TMYDATA *tmy, int hoy, double now, TMYDATA *out);
+private:
+	static TMYCACHE *load(uint64 hash);
+	static const char *filename(uint64 hash, char *buffer, size_t len);
+};
+
+#endif
+
+/**@}*/
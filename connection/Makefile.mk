@@ -33,6 +33,8 @@ connection_connection_la_LIBADD += $(PTHREAD_CFLAGS)
 connection_connection_la_LIBADD += $(PTHREAD_LIBS)
 
 connection_connection_la_SOURCES =
+connection_connection_la_SOURCES += connection/binary.cpp
+connection_connection_la_SOURCES += connection/binary.h
 connection_connection_la_SOURCES += connection/connection.cpp
 connection_connection_la_SOURCES += connection/connection.h
 connection_connection_la_SOURCES += connection/socket.cpp
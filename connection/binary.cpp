@@ -0,0 +1,128 @@
+// $Id$
+//
+// Implements the fixed layout binary data frames
+//
+
+#include "connection.h"
+#include "binary.h"
+
+binary_frame::binary_frame(void)
+{
+	size = 0;
+	hash = 0;
+	buffer = nullptr;
+}
+
+binary_frame::~binary_frame(void)
+{
+	delete [] buffer;
+}
+
+size_t binary_frame::get_width(PROPERTY *prop)
+{
+	switch ( prop->ptype ) {
+	case PT_double:
+	case PT_complex:
+	case PT_float:
+	case PT_int16:
+	case PT_int32:
+	case PT_int64:
+	case PT_enumeration:
+	case PT_set:
+	case PT_bool:
+	case PT_timestamp:
+		return prop->width;
+	default:
+		return 0; // strings, arrays and objects have no fixed representation
+	}
+}
+
+// FNV-1a hash of a byte string (continues from the hash given)
+static uint64 hash_bytes(uint64 hash, const void *data, size_t len)
+{
+	const unsigned char *byte = (const unsigned char*)data;
+	for ( size_t n=0 ; n<len ; n++ )
+	{
+		hash ^= byte[n];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+int binary_frame::create(cache *list)
+{
+	field.clear();
+	field.reserve(list->get_count());
+	lookup.clear();
+	size = 0;
+	hash = 0xcbf29ce484222325ULL;
+	for ( size_t n=0 ; n<list->get_count() ; n++ )
+	{
+		VARMAP *var = list->get_item(n)->get_var();
+		BINARYFIELD item;
+		item.item = list->get_item(n);
+		item.obj = var->obj->get_object();
+		item.addr = var->obj->get_addr();
+		item.size = get_width(var->obj->get_property());
+		if ( item.size==0 )
+		{
+			gl_error("binary_frame::create(): property '%s' cannot be exchanged using binary encoding", var->local_name);
+			/* TROUBLESHOOT
+				Only numeric, complex, enumeration, set, bool and timestamp properties have a fixed size
+				and can be sent in binary frames.  Remove the link or use the default text encoding.
+			*/
+			return 0;
+		}
+		item.offset = size;
+		size += item.size;
+		lookup[item.item] = field.size();
+		field.push_back(item);
+
+		// the peer names the field by its remote name, so that is what must match
+		int64 type = var->obj->get_property()->ptype;
+		int64 offset = item.offset;
+		hash = hash_bytes(hash,var->remote_name,strlen(var->remote_name)+1);
+		hash = hash_bytes(hash,&type,sizeof(type));
+		hash = hash_bytes(hash,&offset,sizeof(offset));
+	}
+	delete [] buffer;
+	buffer = new char[size>0?size:1];
+	return 1;
+}
+
+void binary_frame::pack(void)
+{
+	for ( std::vector<BINARYFIELD>::iterator item=field.begin() ; item!=field.end() ; item++ )
+	{
+		if ( item->obj!=nullptr )
+		{
+			gld_rlock lock(item->obj);
+			memcpy(buffer+item->offset,item->addr,item->size);
+		}
+		else
+			memcpy(buffer+item->offset,item->addr,item->size);
+	}
+}
+
+int binary_frame::unpack(const char *data, varmap *list)
+{
+	int count = 0;
+	for ( VARMAP *var=list->getfirst() ; var!=nullptr ; var=list->getnext(var) )
+	{
+		if ( var->dir!=DXD_READ )
+			continue;
+		std::unordered_map<cacheitem*,size_t>::iterator n = lookup.find(var->item);
+		if ( n==lookup.end() )
+			continue;
+		BINARYFIELD *item = &field[n->second];
+		if ( item->obj!=nullptr )
+		{
+			gld_wlock lock(item->obj);
+			memcpy(item->addr,data+item->offset,item->size);
+		}
+		else
+			memcpy(item->addr,data+item->offset,item->size);
+		count++;
+	}
+	return count;
+}
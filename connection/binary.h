@@ -0,0 +1,67 @@
+/// $Id$
+/// @file binary.h
+/// @addtogroup connection
+///
+/// The binary encoding replaces the text data messages once the JSON handshake
+/// and schema exchange are complete.  Each frame is a BINARYHEADER followed by
+/// the values of the cache items in schema order, each at a fixed offset and in
+/// the native representation of its property type.  Both peers must therefore
+/// agree on the schema and on the byte order (which the frame magic detects).
+///
+/// There is one frame per direction and every event (e.g., "sync" or "commit")
+/// sends the whole frame, just as the text encoding sends the whole cache.  The
+/// receiver only copies the fields linked to the event into the properties, so
+/// the other values of the frame are ignored until their own event.
+/// @{
+
+#ifndef _BINARY_H
+#define _BINARY_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "gridlabd.h"
+
+#define BINARY_MAGIC 0x42444c47 ///< "GLDB" in native byte order
+#define BINARY_FORMAT "BIN" ///< transport message format used for binary frames
+
+typedef struct s_binaryheader {
+	unsigned int magic; ///< BINARY_MAGIC
+	unsigned int size; ///< payload size in bytes (excludes header)
+	int64 seqnum; ///< message sequence number
+	char method[16]; ///< event that sent the frame (e.g., "sync")
+} BINARYHEADER; ///< binary frame header
+
+typedef struct s_binaryfield {
+	class cacheitem *item; ///< cache item that the field exchanges
+	OBJECT *obj; ///< object to lock (NULL for globals)
+	void *addr; ///< resolved property address
+	size_t size; ///< value size in bytes
+	size_t offset; ///< value offset in frame payload
+} BINARYFIELD; ///< binary frame field
+
+class cache;
+class varmap;
+
+class binary_frame { ///< fixed layout of the data frames exchanged for a cache
+private:
+	std::vector<BINARYFIELD> field;
+	std::unordered_map<class cacheitem*,size_t> lookup; ///< position in field by cache item
+	size_t size;
+	uint64 hash;
+	char *buffer;
+public:
+	binary_frame(void);
+	~binary_frame(void);
+	int create(cache *list); ///< build the layout from the cache items (in schema order)
+	inline size_t get_size(void) { return size; }; ///< payload size
+	inline size_t get_count(void) { return field.size(); }; ///< number of fields
+	inline char *get_buffer(void) { return buffer; }; ///< payload buffer
+	inline uint64 get_hash(void) { return hash; }; ///< hash of the ordered (name,type,offset) field list
+	void pack(void); ///< copy the property values into the payload buffer
+	int unpack(const char *data, varmap *list); ///< copy the payload into the values of the properties in the list
+public:
+	static size_t get_width(PROPERTY *prop); ///< size of a property in a frame (0 if not supported)
+};
+
+#endif /// @} _BINARY_H
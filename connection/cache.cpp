@@ -8,7 +8,7 @@ cache::cache(void)
 {
 	size = 0x100;
 	tail = 0;
-	list = new CACHEID[size];
+	list = new cacheitem*[size];
 	memset(list,0,sizeof(list[0])*size);
 	cacheitem::init();
 }
@@ -39,12 +39,13 @@ void cache::set_size(size_t n)
 {
 	if ( n>size ) // only grow cache (shrinking it is too much trouble)
 	{
-		CACHEID *grown = new CACHEID[n];
+		cacheitem **grown = new cacheitem*[n];
 		memset(grown,0,sizeof(grown[0])*n);
 		if ( tail>0 ) memcpy(grown,list,tail*sizeof(list[0]));
 		delete [] list;
 		list = grown;
 		size = n;
+		lookup.reserve(n);
 	}
 	else
 		gl_error("cache::set_size(size_t n=%d): invalid size is ignored", n);
@@ -52,28 +53,21 @@ void cache::set_size(size_t n)
 
 bool cache::write(VARMAP *var, TRANSLATOR *xltr)
 {
-	OBJECT *obj = var->obj->get_object();
-	PROPERTY *prop = var->obj->get_property();
-	char *remote = var->remote_name;
-	CACHEID id = cacheitem::get_id(var);
-	cacheitem *item = cacheitem::get_item(id);
-	if ( item==nullptr ) item = new cacheitem(var);
-	char buffer[1025];
-	{	gld_rlock lock(var->obj->get_object());
-		var->obj->to_string(buffer,sizeof(buffer));
-	}
+	cacheitem *item = var->item;
+	if ( item==nullptr && (item=find_item(var))==nullptr && (item=add_item(var))==nullptr )
+		return false;
+	gld_rlock lock(var->obj->get_object());
+	if ( !item->copy_from_object() )
+		return false;
+	item->mark();
 	return true;
-	//return item->write(buffer);
 }
 
 bool cache::read(VARMAP *var, TRANSLATOR *xltr)
 {
-	OBJECT *obj = var->obj->get_object();
-	PROPERTY *prop = var->obj->get_property();
-	char *remote = var->remote_name;
-	CACHEID id = cacheitem::get_id(var);
-	cacheitem *item = cacheitem::get_item(id);
-	if ( item==nullptr ) item = new cacheitem(var);
+	cacheitem *item = var->item;
+	if ( item==nullptr && (item=find_item(var))==nullptr && (item=add_item(var))==nullptr )
+		return false;
 	char buffer[1025];
 	if ( item->read(buffer,sizeof(buffer)) )
 	{
@@ -91,27 +85,22 @@ bool cache::read(VARMAP *var, TRANSLATOR *xltr)
 
 cacheitem *cache::add_item(VARMAP *var)
 {
-	// create the cache item
-	CACHEID id = cacheitem::get_id(var);
-	cacheitem *item = cacheitem::get_item(id);
+	// create the cache item or reuse the one another cache already has
+	cacheitem *item = cacheitem::get_item(cacheitem::get_id(var));
 	if ( item==nullptr )
 		item = new cacheitem(var);
 
 	// assign it to the cache list
-	id = item->get_id();
-	if ( id > size )
+	std::string key = cacheitem::get_key(var);
+	if ( lookup.find(key)!=lookup.end() )
 	{
-		gl_error("cache id index overrun");
-		delete item;
+		gl_error("cache item '%s'/'%s' is already in this cache", var->local_name, var->remote_name);
 		return nullptr;
 	}
-	if ( list[id]!=0 )
-	{
-		gl_error("cache id index collision");
-		delete item;
-		return nullptr;
-	}
-	list[tail++] = id;
+	if ( tail==size )
+		set_size(size*2);
+	lookup[key] = tail;
+	list[tail++] = item;
 
 	// copy the initial value from the object
 	item->copy_from_object();
@@ -121,17 +110,8 @@ cacheitem *cache::add_item(VARMAP *var)
 
 cacheitem *cache::find_item(VARMAP *var)
 {
-	int n;
-	cacheitem *m;
-	cacheitem *item = nullptr;
-	for(n=0; n < tail; n++){
-		cacheitem *m = get_item(n);
-		if(strcmp((const char*)var->local_name, (const char*)m->get_var()->local_name) == 0 && strcmp((const char*)var->remote_name, (const char*)m->get_var()->remote_name) == 0){
-			item = m;
-			break;
-		}
-	}
-	return item;
+	std::unordered_map<std::string,size_t>::iterator n = lookup.find(cacheitem::get_key(var));
+	return n==lookup.end() ? nullptr : list[n->second];
 }
 
 void cache::dump(void)
@@ -151,88 +131,47 @@ void cache::dump(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // cacheitem implementation
 ////////////////////////////////////////////////////////////////////////////////////////
-size_t cacheitem::indexsize = 0x100;
-cacheitem **cacheitem::index = nullptr;
-cacheitem *cacheitem::first = nullptr;
+std::vector<cacheitem*> *cacheitem::index = nullptr;
+std::unordered_map<std::string,CACHEID> *cacheitem::lookup = nullptr;
 cacheitem::cacheitem(VARMAP *v)
 {
-	OBJECT *o = v->obj->get_object();
-	PROPERTY *p = v->obj->get_property();
-	char *r = v->remote_name;
-Retry:
-	id = get_id(v);
-
-	// id already in use
-	if ( index[id]!=nullptr )
-	{
-		// item is the same
-		cacheitem *item = get_item(id);
-		if ( item->get_object()==o && item->get_property()==p && strcmp(item->get_remote(),r)==0 )
-			throw "attempt to create a duplication cache item";
-		else // different item hash collision
-		{
-			gl_debug("cache collison, growing cache size");
-			grow();
-			goto Retry;
-		}
-	}
+	std::string key = get_key(v);
+	if ( lookup->find(key)!=lookup->end() )
+		throw "attempt to create a duplication cache item";
 
 	// setup new item
+	id = (CACHEID)index->size();
+	index->push_back(this);
+	(*lookup)[key] = id;
+	lock = 0;
 	marked = false;
-	index[id] = this;
 	var = v;
 	value = new char[1025]; // TODO look into using prop->width instead to save some memory
 	memset(value,0,1025);
 	xltr = nullptr;
-	next = nullptr;
-	if ( first!=nullptr )
-		first->next = this;
-	first = this;
 }
 
 void cacheitem::init(void)
 {
 	if ( index==nullptr )
 	{
-		gl_verbose("cacheitem::init(): initial cache index size is %d", indexsize);
-		index = new cacheitem*[indexsize];
-		memset(index,0,sizeof(index[0])*indexsize);
+		index = new std::vector<cacheitem*>;
+		lookup = new std::unordered_map<std::string,CACHEID>;
 	}
 }
 
-void cacheitem::grow(void)
+std::string cacheitem::get_key(VARMAP *v)
 {
-	size_t newsize = indexsize * 0x100; // 16 times bigger
-	gl_verbose("cacheitem::grow(): double cache index size to %d entries", newsize);
-	cacheitem **newindex = new cacheitem*[newsize];
-	memset(newindex,0,sizeof(newindex[0])*newsize);
-
-	// TODO this takes a while--put a mechanism in place to keep/use a list of non-null entries
-	// copy old ids to new ids
-	cacheitem *n;
-	for ( n=first ; n!=nullptr ; n=n->next )
-	{
-		CACHEID newid = get_id(n->get_var());
-		newindex[newid] = n;
-	}
-	delete index;
-	index = newindex;
+	std::string key(v->local_name);
+	key += '\0';
+	key += v->remote_name;
+	return key;
 }
 
-CACHEID cacheitem::get_id(VARMAP *v, size_t m)
+CACHEID cacheitem::get_id(VARMAP *v)
 {
-	OBJECT *o = v->obj->get_object();
-	PROPERTY *p = v->obj->get_property();
-	char *r = v->remote_name;
-	if ( m==0 ) m = indexsize;
-	// TODO check uniformity of this hash function
-	int64 a = o->id; // theoretically unlimited size
-	int64 b = (int64)(p->addr); 
-	int64 nb = (int64)(p->oclass->size);
-	int64 c = 0; 
-	int64 nc = strlen(r)*128;
-	while ( *r!='\0' ) c += *r++;
-	return (CACHEID)(((a*nb+b)*nc+c)%(int64)m);
+	std::unordered_map<std::string,CACHEID>::iterator item = lookup->find(get_key(v));
+	return item==lookup->end() ? BADCACHEID : item->second;
 }
 
 bool cacheitem::read(char *buffer, size_t len)
@@ -277,11 +216,9 @@ bool cacheitem::write(char *buffer)
 
 bool cacheitem::copy_from_object(void)
 {
-	gld_property prop(get_object(),get_property());
-	return prop.to_string(value,1024)<0 ? false : true;
+	return var->obj->to_string(value,1024)<0 ? false : true;
 }
 bool cacheitem::copy_to_object(void)
 {
-	gld_property prop(get_object(),get_property());
-	return prop.from_string(value)<0 ? false : true;
+	return var->obj->from_string(value)<0 ? false : true;
 }
@@ -6,6 +6,10 @@
 #ifndef _CACHE_H
 #define _CACHE_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "connection.h"
 #include "message.h"
 #include "varmap.h"
@@ -23,28 +27,25 @@ typedef unsigned int CACHEID; ///< cache item id number
 #define BADCACHEID (CACHEID)(-1) ///< indicates that the cache id is not valid
 class cacheitem { ///< cacheitem class
 private:
-	static size_t indexsize; 
-	static cacheitem **index;
-	static cacheitem *first;
+	static std::vector<cacheitem*> *index; ///< all cache items by id
+	static std::unordered_map<std::string,CACHEID> *lookup; ///< cache item ids by (local,remote) name
 	CACHEID id;
 	unsigned int lock;
 	VARMAP *var;
 	char *value;
 	TRANSLATOR *xltr;
-	cacheitem *next;
 	bool marked; // true indicate value needs to be sync'd
 public:
-	cacheitem(VARMAP *var); ///< creates a new cache entry (invalidates pre-existing CACHEIDs)
+	cacheitem(VARMAP *var); ///< creates a new cache entry
 	static void init();
-private:
-	static void grow();
+	static std::string get_key(VARMAP *var); ///< get the (local,remote) name key of a cache tuple
 public:
 	inline void mark(void) { marked=true; };
 	inline void unmark(void) { marked=false; };
 	inline bool is_marked(void) { return marked; };
-	static CACHEID get_id(VARMAP *var, size_t modulo=0); ///< get the CACHEID for a cache tuple
+	static CACHEID get_id(VARMAP *var); ///< get the CACHEID for a cache tuple
 	static inline cacheitem *get_item(CACHEID id) ///< get the cache item from the id
-		{ return index[id];};
+		{ return id<index->size() ? (*index)[id] : NULL;};
 	inline CACHEID get_id(void) { return id; };
 	inline VARMAP *get_var() ///< get the variable map for this item
 		{ return var; };
@@ -70,7 +71,8 @@ class cache { ///< cache class
 private:
 	size_t size;
 	size_t tail;
-	CACHEID *list;
+	cacheitem **list; ///< dense list of the items exchanged by this cache
+	std::unordered_map<std::string,size_t> lookup; ///< position in list by (local,remote) name
 public:
 	cache(void); // constructs a cache
 	~cache(void);
@@ -79,8 +81,8 @@ public:
 	void set_size(size_t); ///< sets the size of a connection cache
 	inline size_t get_count(void) ///< gets the size of the connection cache
 		{ return tail; }; 
-	CACHEID get_id(size_t n) { return list[n];};
-	cacheitem *get_item(size_t n) { return cacheitem::get_item(list[n]); };
+	CACHEID get_id(size_t n) { return list[n]->get_id();};
+	cacheitem *get_item(size_t n) { return list[n]; };
 	cacheitem *add_item(VARMAP *var);
 	bool write(VARMAP *var, TRANSLATOR *xltr=NULL); ///< write to a cache item
 	bool read(VARMAP *var, TRANSLATOR *xltr=NULL); ///< read from a cache item
@@ -10,6 +10,7 @@ connection_mode::connection_mode(void)
 	seqnum = 0;
 	transport = nullptr;
 	ignore_error = 1;
+	encoding = CE_TEXT;
 }
 
 CONNECTIONMODE connection_mode::get_mode(const char *s)
@@ -87,13 +88,25 @@ connection_mode* connection_mode::new_instance(const char *options)
 						return nullptr;
 					}
 				}
+				else if ( strcmp(cmd,"encoding")==0 )
+				{
+					if ( strcmp(arg,"text")==0 )
+						connection->encoding = CE_TEXT;
+					else if ( strcmp(arg,"binary")==0 )
+						connection->encoding = CE_BINARY;
+					else
+					{
+						gl_error("connection_mode::new_instance(char *options='%s'): unrecognized %s value '%s'", options, cmd, arg);
+						return nullptr;
+					}
+				}
 				// TODO add multi-argument options here
 				else
 				{
 					gl_error("connection_mode::new_instance(char *options='%s'): unrecognized tag '%s'", options, tag);
 					return nullptr;
 				}
-				goto OK;
+				continue;
 			}
 			// hand off to client/server subclass
 			if ( !connection->option(tag)  )
@@ -103,7 +116,6 @@ connection_mode* connection_mode::new_instance(const char *options)
 			}
 		}
 	}
-OK:
 	if ( connection==nullptr )
 	{
 		gl_warning("connection_mode::new_instance(char *options='%s'): connection mode not specified", options);
@@ -252,6 +264,8 @@ int connection_mode::update(VARMAP *var, DATAEXCHANGEDIRECTION dir, TRANSLATOR *
 
 int connection_mode::update(varmap *varlist, const char *tag, TRANSLATOR *xlate)
 {
+	if ( encoding==CE_BINARY )
+		return update_binary(varlist,tag);
 	int count=0;
 	VARMAP *v;
 	//update outgoing cache variables with the local values
@@ -298,23 +312,156 @@ int connection_mode::update(varmap *varlist, const char *tag, TRANSLATOR *xlate)
 	return count;
 }
 
-cacheitem *connection_mode::create_cache(VARMAP *map)
+/// negotiate the binary frame layout
+/// @return 1 on success, 0 on failure
+int connection_mode::init_binary(void)
+{
+	if ( !read_frame.create(&read_cache) || !write_frame.create(&write_cache) )
+		return 0;
+
+	// the client sends its frame sizes and layouts so the server can check them against its own schema
+	int64 input = read_frame.get_size();
+	int64 output = write_frame.get_size();
+	int64 input_hash = (int64)read_frame.get_hash();
+	int64 output_hash = (int64)write_frame.get_hash();
+	int64 id;
+	if ( client_initiated(
+			MSG_CRITICAL,
+			MSG_INITIATE,
+				MSG_TAG,"method","binary",
+				MSG_OPEN,"frame",
+					MSG_INTEGER,"input",&input,
+					MSG_INTEGER,"output",&output,
+					MSG_INTEGER,"input_hash",&input_hash,
+					MSG_INTEGER,"output_hash",&output_hash,
+				MSG_CLOSE,
+			MSG_COMPLETE, &id,
+			nullptr)<0 )
+	{
+		error("binary frame negotiation failed");
+		return 0;
+	}
+	if ( get_mode()==CM_SERVER && ( input!=(int64)write_frame.get_size() || output!=(int64)read_frame.get_size() ) )
+	{
+		error("binary frame sizes do not match (remote input=%lld, output=%lld; local input=%lld, output=%lld)",
+			input, output, (int64)read_frame.get_size(), (int64)write_frame.get_size());
+		/* TROUBLESHOOT
+			The client and the server do not exchange the same properties, or the properties do not
+			have the same types on both sides.  Check that the links on each side match.
+		 */
+		return 0;
+	}
+	if ( get_mode()==CM_SERVER && ( (uint64)input_hash!=write_frame.get_hash() || (uint64)output_hash!=read_frame.get_hash() ) )
+	{
+		error("binary frame layouts do not match (remote input=%016llx, output=%016llx; local input=%016llx, output=%016llx)",
+			(uint64)input_hash, (uint64)output_hash, read_frame.get_hash(), write_frame.get_hash());
+		/* TROUBLESHOOT
+			The client and the server exchange frames of the same size, but the properties are not
+			in the same order, do not have the same remote names, or do not have the same types.
+			Check that the links on each side are listed in the same order with the same names.
+		 */
+		return 0;
+	}
+	if ( server_response(
+			MSG_CRITICAL,
+			MSG_INITIATE,
+				MSG_TAG,"result","binary",
+			MSG_COMPLETE, &id,
+			nullptr)<0 )
+	{
+		error("binary frame negotiation response failed");
+		return 0;
+	}
+
+	// all data messages from now on are binary frames
+	transport->set_message_format(BINARY_FORMAT);
+	transport->set_translator(nullptr);
+	debug(0,"binary frames negotiated (input=%d bytes, output=%d bytes)", read_frame.get_size(), write_frame.get_size());
+	return 1;
+}
+
+/// exchange data using binary frames
+/// Every event sends the whole write frame (like the text encoding sends the whole
+/// cache) but only the properties of the event's variable list are updated from
+/// the frame received.
+/// @return number of variables updated, or -1 on failure
+int connection_mode::update_binary(varmap *varlist, const char *tag)
 {
-	if ( map->dir==DXD_READ ){
-		cacheitem * item = read_cache.find_item(map);
-		if(item != nullptr){
-			return item;
-		} else{
-			return read_cache.add_item(map);
+	if ( varlist->getfirst()==nullptr )
+		return 0;
+	if ( read_frame.get_buffer()==nullptr || write_frame.get_buffer()==nullptr )
+	{
+		error("binary frame layout has not been negotiated");
+		return -1;
+	}
+	int count = 0;
+	for ( VARMAP *v = varlist->getfirst() ; v!=nullptr ; v = v->next )
+		count++;
+
+	// the client sends first and the server replies
+	BINARYHEADER header;
+	int order[2] = {DXD_WRITE,DXD_READ};
+	if ( get_mode()==CM_SERVER )
+	{
+		order[0] = DXD_READ;
+		order[1] = DXD_WRITE;
+	}
+	for ( int n=0 ; n<2 ; n++ )
+	{
+		if ( order[n]==DXD_WRITE )
+		{
+			memset(&header,0,sizeof(header));
+			header.magic = BINARY_MAGIC;
+			header.size = (unsigned int)write_frame.get_size();
+			header.seqnum = get_mode()==CM_SERVER ? seqnum : ++seqnum; // server echoes the request
+			strncpy(header.method,tag,sizeof(header.method)-1);
+			write_frame.pack();
+			MSGPART part[2] = {
+				{&header,sizeof(header)},
+				{write_frame.get_buffer(),write_frame.get_size()},
+			};
+			if ( transport->send(part,2)<=0 )
+			{
+				error("binary frame send failed");
+				return -1;
+			}
 		}
-	} else if ( map->dir==DXD_WRITE ){
-		cacheitem * item = write_cache.find_item(map);
-		if(item != nullptr){
-			return item;
-		} else{
-			return write_cache.add_item(map);
+		else
+		{
+			int len = recv();
+			if ( len<=0 )
+				return ignore_error>0 ? 0 : -1;
+			const char *data = transport->get_input();
+			memcpy(&header,data,sizeof(header));
+			if ( (size_t)len!=sizeof(header)+read_frame.get_size() || header.magic!=BINARY_MAGIC || header.size!=read_frame.get_size() )
+			{
+				error("binary frame received for '%s' has an invalid header or size (%d bytes)", tag, len);
+				return -1;
+			}
+			if ( strncmp(header.method,tag,sizeof(header.method)-1)!=0 )
+				warning("binary frame received for '%.15s' while expecting '%s'", header.method, tag);
+			if ( get_mode()==CM_SERVER )
+				seqnum = header.seqnum;
+			read_frame.unpack(data+sizeof(header),varlist);
 		}
-	} else return nullptr;
+	}
+	return count;
+}
+
+cacheitem *connection_mode::create_cache(VARMAP *map)
+{
+	cache *list;
+	if ( map->dir==DXD_READ )
+		list = &read_cache;
+	else if ( map->dir==DXD_WRITE )
+		list = &write_cache;
+	else
+		return nullptr;
+	cacheitem *item = list->find_item(map);
+	if ( item==nullptr )
+		item = list->add_item(map);
+	map->item = item; // resolved once so exchanges never look it up again
+	return item;
 }
 
 int connection_mode::exchange(EXCHANGETRANSLATOR *xlate, bool critical)
@@ -16,6 +16,7 @@
 #include "cache.h"
 #include "transport.h"
 #include "varmap.h"
+#include "binary.h"
 
 #ifdef _WIN32
 #define snprintf _snprintf
@@ -64,6 +65,12 @@ typedef enum {
 	CM_SERVER, ///< client connecdtion (initiates requests)
 } CONNECTIONMODE; ///< type of connection (e.g., client, server)
 
+///< Connection data encodings
+typedef enum {
+	CE_TEXT, ///< data messages use the text translators (e.g., JSON)
+	CE_BINARY, ///< data messages use fixed layout binary frames after the handshake
+} CONNECTIONENCODING; ///< encoding of data messages
+
 
 //GLOBAL bool enable_subsecond_models INIT(false);
 /// The connection_mode class provides control over connection-specific things
@@ -96,6 +103,9 @@ protected:
 	cache write_cache;
 	long long seqnum;
 	int ignore_error;
+	CONNECTIONENCODING encoding;
+	binary_frame read_frame;
+	binary_frame write_frame;
 
 public:
 	connection_mode(void);
@@ -109,6 +119,9 @@ public:
 	void set_transport(const char *s); ///< change transport
 	int update(VARMAP *var, DATAEXCHANGEDIRECTION dir, TRANSLATOR *xltr=NULL);
 	int update(varmap *var, const char *tag, TRANSLATOR *xltr=NULL);
+	inline CONNECTIONENCODING get_encoding(void) { return encoding; };
+	int init_binary(void); ///< negotiate the binary frame layout (after the schema exchange)
+	int update_binary(varmap *var, const char *tag); ///< exchange binary data frames
 	int option(char *target, char *command);
 
 	void set_translators(EXCHANGETRANSLATOR *out, EXCHANGETRANSLATOR *in, TRANSLATOR *data);
@@ -322,6 +322,19 @@ int json::init(OBJECT *parent)
 		return 0;
 	}
 
+	// binary data frames replace the text data messages once the schema is known
+	if ( get_connection()->get_encoding()==CE_BINARY )
+	{
+		if ( !get_connection()->init_binary() )
+		{
+			error("binary encoding negotiation failed");
+			return 0;
+		}
+		connection_transport *transport = get_connection()->get_transport();
+		json::destroy((JSONLIST*)transport->get_translation());
+		transport->set_translation(nullptr);
+	}
+
 	// first update
 	return get_connection()->update(get_initmap(),"start",&json_translate)>=0;
 }
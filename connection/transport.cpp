@@ -106,6 +106,24 @@ void connection_transport::exception(const char *fmt, ...)
 	throw msg;
 }
 
+/// default gathered send copies the parts into the output buffer
+size_t connection_transport::send(const MSGPART *part, size_t count)
+{
+	size_t len = 0;
+	for ( size_t n=0 ; n<count ; n++ )
+	{
+		if ( len+part[n].len>sizeof(output) )
+		{
+			error("message exceeds output buffer size");
+			return 0;
+		}
+		memcpy(output+len,part[n].data,part[n].len);
+		len += part[n].len;
+	}
+	position = (int)len;
+	return send(output,len);
+}
+
 bool connection_transport::message_open()
 {
 	//if ( position>0 )
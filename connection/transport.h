@@ -14,6 +14,11 @@ typedef enum {
 	CT_TCP=2, ///< TCP transport
 } CONNECTIONTRANSPORT;
 
+typedef struct s_msgpart {
+	const void *data; ///< start of the part
+	size_t len; ///< length of the part
+} MSGPART; ///< part of a message gathered from several buffers
+
 class connection_transport {
 protected:
 	int maxmsg;
@@ -41,6 +46,7 @@ public:
 	virtual int option(char *command)=0; ///< set a transport option
 	virtual size_t send(const char *msg, const size_t len)=0; // send message
 	virtual size_t recv(char *buffer, const size_t maxlen)=0; // recv message
+	virtual size_t send(const MSGPART *part, size_t count); // send message gathered from parts
 	virtual void set_message_format(const char *s)=0;
 	virtual void set_message_version(double x)=0;
 
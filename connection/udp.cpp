@@ -181,6 +181,15 @@ Retry:
 	return 1;
 }
 
+/// format outbound message header for a payload of \p len bytes
+int udp::format_header(char *header, size_t len)
+{
+	int tlim = (int)ceil((double)timeout.tv_usec/1000.0) + (int)timeout.tv_sec;
+	if ( tlim>0 ) tlim=9; else if ( tlim<1 ) tlim=1;
+	return sprintf(header,"%-1d %-3d %-7lu %-5.5s %-3.1f %-1d %-3d   ",
+		header_version, header_size, len, message_format, message_version, tlim, 0);
+}
+
 size_t udp::send(const char *msg, size_t len)
 {
 	if ( msg==nullptr )
@@ -190,17 +199,17 @@ size_t udp::send(const char *msg, size_t len)
 	}
 	// format outbound message header
 	char temp[256];
-	int tlim = (int)ceil((double)timeout.tv_usec/1000.0) + (int)timeout.tv_sec;
-	if ( tlim>0 ) tlim=9; else if ( tlim<1 ) tlim=1;
-	sprintf(temp,"%-1d %-3d %-7lu %-5.5s %-3.1f %-1d %-3d   ",
-		header_version, header_size, len, message_format, message_version, tlim, 0);
-	if ( len>1500-strlen(temp) )
+	int hlen = format_header(temp,len);
+	if ( len>1500-hlen )
 	{
 		error("udp::send(const char *msg='%-10.10s', size_t len=%d): message is too long for UDP", msg, len);
 		return 0;
 	}
 	char sendbuf[2048];
-	int totlen = sprintf(sendbuf,"%s%s",temp,msg);
+	memcpy(sendbuf,temp,hlen);
+	memcpy(sendbuf+hlen,msg,len); // payload need not be a string
+	int totlen = hlen+(int)len;
+	sendbuf[totlen] = '\0';
 	struct sockaddr_in &serv_addr = *(struct sockaddr_in *)sockdata;
 	size_t sndlen = sendto(sd,sendbuf,totlen,0,(struct sockaddr*)&serv_addr,sizeof(serv_addr));
 	debug(9,"%d <= sendto(addr='%s',port=%d,msg='%s')", sndlen, inet_ntoa(serv_addr.sin_addr), ntohs(serv_addr.sin_port), sendbuf);
@@ -208,6 +217,45 @@ size_t udp::send(const char *msg, size_t len)
 		exception("UDP sendto failed: %s", Socket::strerror());
 	return sndlen;
 }
+size_t udp::send(const MSGPART *part, size_t count)
+{
+#ifdef _WIN32
+	return connection_transport::send(part,count);
+#else
+	// gather the header and the parts straight from their buffers
+	struct iovec iov[16];
+	size_t len = 0;
+	if ( count+1>sizeof(iov)/sizeof(iov[0]) )
+		return connection_transport::send(part,count);
+	for ( size_t n=0 ; n<count ; n++ )
+	{
+		iov[n+1].iov_base = const_cast<void*>(part[n].data);
+		iov[n+1].iov_len = part[n].len;
+		len += part[n].len;
+	}
+	char temp[256];
+	int hlen = format_header(temp,len);
+	if ( len>1500-hlen )
+	{
+		error("udp::send(const MSGPART *part, size_t count=%d): message is too long for UDP", count);
+		return 0;
+	}
+	iov[0].iov_base = temp;
+	iov[0].iov_len = hlen;
+	struct sockaddr_in &serv_addr = *(struct sockaddr_in *)sockdata;
+	struct msghdr msg;
+	memset(&msg,0,sizeof(msg));
+	msg.msg_name = &serv_addr;
+	msg.msg_namelen = sizeof(serv_addr);
+	msg.msg_iov = iov;
+	msg.msg_iovlen = count+1;
+	size_t sndlen = sendmsg(sd,&msg,0);
+	debug(9,"%d <= sendmsg(addr='%s',port=%d,parts=%d)", sndlen, inet_ntoa(serv_addr.sin_addr), ntohs(serv_addr.sin_port), count);
+	if ( sndlen==SOCKET_ERROR )
+		exception("UDP sendmsg failed: %s", Socket::strerror());
+	return sndlen;
+#endif
+}
 size_t udp::recv(char *buf, size_t len)
 {
 	if ( buf==nullptr )
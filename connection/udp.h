@@ -27,6 +27,7 @@
 	#include <unistd.h>
 	#include <sys/errno.h>
 	#include <netdb.h>
+	#include <sys/uio.h>
 
 	#ifdef INVALID_SOCKET
 	#undef INVALID_SOCKET
@@ -89,6 +90,7 @@ private:
 	unsigned int debug_level;
 	timeval timeout;
 	SOCKET sd;
+	int format_header(char *header, size_t len);
 
 public:
 	// construction
@@ -99,6 +101,7 @@ public:
 
 	// event handlers 
 	size_t send(const char *msg, const size_t len);
+	size_t send(const MSGPART *part, size_t count);
 	size_t recv(char *buffer, const size_t maxlen);
 	int call_setsockopt(SOCKET s, int level, int optname, timeval *optval, int optlen);
 	void flush(void);
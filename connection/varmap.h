@@ -114,6 +114,7 @@ typedef struct s_varmap {
 	COMMUNICATIONTYPE ctype; ///< The actual communication type. Used only for communication with FNCS.
 	char threshold[1024]; ///< The threshold to exceed to actually trigger sending a message. Used only for communication with FNCS.
 	std::unique_ptr<last_value_buffer> last_value { nullptr };
+	class cacheitem *item { nullptr }; ///< cache item linked to this variable (set by linkcache)
 
 
 } VARMAP; ///< variable map structure
@@ -286,6 +286,10 @@ inverter_dyn::inverter_dyn(MODULE *module)
 		// 	GL_THROW("Unable to publish inverter_dyn deltamode function");
 		if (gl_publish_function(oclass, "current_injection_update", (FUNCTIONADDR)inverter_dyn_NR_current_injection_update) == nullptr)
 			GL_THROW("Unable to publish inverter_dyn current injection update function");
+		if (gl_publish_function(oclass, "current_injection_update_batch", (FUNCTIONADDR)inverter_dyn_NR_current_injection_update_batch) == nullptr)
+			GL_THROW("Unable to publish inverter_dyn current injection update function");
+		if (gl_publish_function(oclass, "current_injection_push", (FUNCTIONADDR)inverter_dyn_NR_current_injection_push) == nullptr)
+			GL_THROW("Unable to publish inverter_dyn current injection update function");
 		if (gl_publish_function(oclass, "register_gen_DC_object", (FUNCTIONADDR)inverter_dyn_DC_object_register) == nullptr)
 			GL_THROW("Unable to publish inverter_dyn DC registration function");
 	}
@@ -318,6 +322,8 @@ int inverter_dyn::create(void)
 	parent_is_triplex = false;		//By default, not a triplex
 	attached_bus_type = 0;			//By default, we're basically a PQ bus
 	swing_test_fxn = nullptr;			//By default, no mapping
+	voltage_is_bus_voltage = false;	//By default, pull the voltages from the parent
+	push_voltage_pending = false;	//Nothing computed yet
 
 	pCircuit_V[0] = pCircuit_V[1] = pCircuit_V[2] = nullptr;
 	pLine_I[0] = pLine_I[1] = pLine_I[2] = nullptr;
@@ -1157,6 +1163,27 @@ int inverter_dyn::init(OBJECT *parent)
 				*/
 			}
 
+			//Bundle the powerflow values, so each pull or push is one pass over their addresses
+			powerflow_values.add(pMeterStatus, &value_MeterStatus);
+			powerflow_values.add(pFrequency, &value_Frequency);
+			for (temp_idx_x = 0; temp_idx_x < (parent_is_single_phase ? 1 : 3); temp_idx_x++)
+			{
+				powerflow_voltage.add(pCircuit_V[temp_idx_x], &value_Circuit_V[temp_idx_x]);
+				powerflow_values.add(pIGenerated[temp_idx_x], &value_IGenerated[temp_idx_x]);
+
+				//Accumulators
+				powerflow_values.add(pLine_I[temp_idx_x], &value_Line_I[temp_idx_x], PBO_ADD);
+				powerflow_values.add(pPower[temp_idx_x], &value_Power[temp_idx_x], PBO_ADD);
+				powerflow_values.add(pLine_unrotI[temp_idx_x], &value_Line_unrotI[temp_idx_x], PBO_ADD);
+
+				//Direct writes
+				powerflow_values.add(pIGenerated[temp_idx_x], &value_IGenerated[temp_idx_x], PBO_SET);
+				powerflow_voltage.add(pCircuit_V[temp_idx_x], &value_Circuit_V[temp_idx_x], PBO_SET);
+			}
+
+			//Three-phase voltages of a node that is not a child are the solver's bus voltages - the class-level update can take them from its packed gather
+			voltage_is_bus_voltage = !parent_is_single_phase && ((tmp_obj->parent == nullptr) || !gl_object_isa(tmp_obj->parent, "node", "powerflow"));
+
 			//Pull initial voltages, but see which ones we should grab
 			if (parent_is_single_phase)
 			{
@@ -6049,34 +6076,11 @@ gld_property *inverter_dyn::map_double_value(OBJECT *obj, const char *name)
 //Function to pull all the complex properties from powerflow into local variables
 void inverter_dyn::pull_complex_powerflow_values(void)
 {
-	//Pull in the various values from powerflow - straight reads
-	//Pull status
-	value_MeterStatus = pMeterStatus->get_enumeration();
-
-	//Pull frequency
-	value_Frequency = pFrequency->get_double();
-
+	//Pull in the status, frequency, voltages and IGenerated (in case the powerflow is overriding it) - straight reads
+	//Unlocked - the parent calls us while it is locked
 	//********** TODO - Portions of this may need to be a "deltamode only" pull	 **********//
-	//Update IGenerated, in case the powerflow is overriding it
-	if (parent_is_single_phase)
-	{
-		//Just pull "zero" values
-		value_Circuit_V[0] = pCircuit_V[0]->get_complex();
-
-		value_IGenerated[0] = pIGenerated[0]->get_complex();
-	}
-	else
-	{
-		//Pull all voltages
-		value_Circuit_V[0] = pCircuit_V[0]->get_complex();
-		value_Circuit_V[1] = pCircuit_V[1]->get_complex();
-		value_Circuit_V[2] = pCircuit_V[2]->get_complex();
-
-		//Pull currents
-		value_IGenerated[0] = pIGenerated[0]->get_complex();
-		value_IGenerated[1] = pIGenerated[1]->get_complex();
-		value_IGenerated[2] = pIGenerated[2]->get_complex();
-	}
+	powerflow_values.pull_unlocked();
+	powerflow_voltage.pull_unlocked();
 }
 
 //Function to reset the various accumulators, so they don't double-accumulate if they weren't used
@@ -6118,120 +6122,34 @@ void inverter_dyn::reset_complex_powerflow_accumulators(void)
 //Function to push up all changes of complex properties to powerflow from local variables
 void inverter_dyn::push_complex_powerflow_values(bool update_voltage)
 {
-	gld::complex temp_complex_val;
-	gld_wlock *test_rlock = nullptr;
-	int indexval;
-
-	//See which one we are, since that will impact things
-	if (!parent_is_single_phase) //Three-phase
+	//See if we were a voltage push or not
+	if (update_voltage)
 	{
-		//See if we were a voltage push or not
-		if (update_voltage)
-		{
-			//Loop through the three-phases/accumulators
-			for (indexval=0; indexval<3; indexval++)
-			{
-				//**** push voltage value -- not an accumulator, just force ****/
-				pCircuit_V[indexval]->setp<gld::complex>(value_Circuit_V[indexval],*test_rlock);
-			}
-		}
-		else
-		{
-			//Loop through the three-phases/accumulators
-			for (indexval = 0; indexval < 3; indexval++)
-			{
-				//**** Current value ***/
-				//Pull current value again, just in case
-				temp_complex_val = pLine_I[indexval]->get_complex();
-
-				//Add the difference
-				temp_complex_val += value_Line_I[indexval];
-
-				//Push it back up
-				pLine_I[indexval]->setp<gld::complex>(temp_complex_val, *test_rlock);
-
-				//**** Power value ***/
-				//Pull current value again, just in case
-				temp_complex_val = pPower[indexval]->get_complex();
-
-				//Add the difference
-				temp_complex_val += value_Power[indexval];
-
-				//Push it back up
-				pPower[indexval]->setp<gld::complex>(temp_complex_val, *test_rlock);
-
-				//**** pre-rotated Current value ***/
-				//Pull current value again, just in case
-				temp_complex_val = pLine_unrotI[indexval]->get_complex();
-
-				//Add the difference
-				temp_complex_val += value_Line_unrotI[indexval];
-
-				//Push it back up
-				pLine_unrotI[indexval]->setp<gld::complex>(temp_complex_val, *test_rlock);
-
-				/* If was VSI, adjust Norton injection */
-				{
-					//**** IGenerated Current value ***/
-					//Direct write, not an accumulator
-					pIGenerated[indexval]->setp<gld::complex>(value_IGenerated[indexval], *test_rlock);
-				}
-			}//End phase loop
-		}//End not voltage push
-	}//End three-phase
-	else //Assumes must be single-phased - else how did it get here?
+		//**** push voltage value -- not an accumulator, just force ****/
+		powerflow_voltage.push_unlocked();
+	}
+	else
 	{
-		//Check for voltage push - in case that's ever needed here
-		if (update_voltage)
-		{
-			//Should just be zero
-			//**** push voltage value -- not an accumulator, just force ****/
-			pCircuit_V[0]->setp<gld::complex>(value_Circuit_V[0],*test_rlock);
-		}
-		else
-		{
-			//Pull the relevant values -- all single pulls
-
-			//**** Current value ***/
-			//Pull current value again, just in case
-			temp_complex_val = pLine_I[0]->get_complex();
-
-			//Add the difference
-			temp_complex_val += value_Line_I[0];
-
-			//Push it back up
-			pLine_I[0]->setp<gld::complex>(temp_complex_val, *test_rlock);
-
-			//**** power value ***/
-			//Pull current value again, just in case
-			temp_complex_val = pPower[0]->get_complex();
-
-			//Add the difference
-			temp_complex_val += value_Power[0];
-
-			//Push it back up
-			pPower[0]->setp<gld::complex>(temp_complex_val, *test_rlock);
-
-			//**** prerotated value ***/
-			//Pull current value again, just in case
-			temp_complex_val = pLine_unrotI[0]->get_complex();
+		//Add the current, power and pre-rotated current accumulators, and write IGenerated directly - unlocked, like the pull
+		powerflow_values.push_unlocked();
+	}
+}
 
-			//Add the difference
-			temp_complex_val += value_Line_unrotI[0];
+// Function to update current injection IGenerated for VSI
+STATUS inverter_dyn::updateCurrInjection(int64 iteration_count,bool *converged_failure)
+{
+	STATUS temp_status;
 
-			//Push it back up
-			pLine_unrotI[0]->setp<gld::complex>(temp_complex_val, *test_rlock);
+	//Compute the injection, then hand it to powerflow
+	temp_status = computeCurrInjection(iteration_count,converged_failure,nullptr);
+	pushCurrInjection();
 
-			//**** IGenerated ****/
-			//********* TODO - Does this need to be deltamode-flagged? *************//
-			//Direct write, not an accumulator
-			pIGenerated[0]->setp<gld::complex>(value_IGenerated[0], *test_rlock);
-		}//End not voltage update
-	}//End single-phase
+	return temp_status;
 }
 
-// Function to update current injection IGenerated for VSI
-STATUS inverter_dyn::updateCurrInjection(int64 iteration_count,bool *converged_failure)
+// Function to compute the current injection IGenerated for VSI - nothing is written to powerflow until pushCurrInjection
+// bus_voltage is the solver's packed gather of the bus voltages (three values), nullptr to pull them from the parent
+STATUS inverter_dyn::computeCurrInjection(int64 iteration_count,bool *converged_failure,gld::complex *bus_voltage)
 {
 	double temp_time;
 	OBJECT *obj = OBJECTHDR(this);
@@ -6270,10 +6188,24 @@ STATUS inverter_dyn::updateCurrInjection(int64 iteration_count,bool *converged_f
 		//Reset the accumulators, just in case
 		reset_complex_powerflow_accumulators();
 
-		//Pull status and voltage (mostly status)
-		pull_complex_powerflow_values();
+		//Pull status and voltage (mostly status) - the voltage comes from the solver's gather if it is our bus voltage
+		if ((bus_voltage != nullptr) && voltage_is_bus_voltage)
+		{
+			powerflow_values.pull_unlocked();
+
+			value_Circuit_V[0] = bus_voltage[0];
+			value_Circuit_V[1] = bus_voltage[1];
+			value_Circuit_V[2] = bus_voltage[2];
+		}
+		else
+		{
+			pull_complex_powerflow_values();
+		}
 	}
 
+	//Assume no voltage gets forced on the parent
+	push_voltage_pending = false;
+
 	//See if we're in QSTS and a grid-forming inverter - update if we are
 	if (!running_in_delta && (control_mode == GRID_FORMING))
 	{
@@ -6295,10 +6227,10 @@ STATUS inverter_dyn::updateCurrInjection(int64 iteration_count,bool *converged_f
 		value_IGenerated[1] *= rotate_value;
 		value_IGenerated[2] *= rotate_value;
 
-		//Push the voltage - standard meter check (bit redundant)
+		//Push the voltage with the injection - standard meter check (bit redundant)
 		if (parent_is_a_meter)
 		{
-			push_complex_powerflow_values(true);
+			push_voltage_pending = true;
 		}
 
 		//Update trackers
@@ -6709,14 +6641,25 @@ STATUS inverter_dyn::updateCurrInjection(int64 iteration_count,bool *converged_f
 		}
 	}//End connected/working
 
+	//Always a success, but power flow solver may not like it if VA_OUT exceeded the rating and thus changed
+	return SUCCESS;
+}
+
+// Function to push the last computed current injection (and a grid-forming QSTS voltage) to powerflow
+void inverter_dyn::pushCurrInjection(void)
+{
 	//Push the changes up
 	if (parent_is_a_meter)
 	{
+		//Rotated voltage first, like the parent would see it before the injection
+		if (push_voltage_pending)
+		{
+			push_complex_powerflow_values(true);
+			push_voltage_pending = false;
+		}
+
 		push_complex_powerflow_values(false);
 	}
-
-	//Always a success, but power flow solver may not like it if VA_OUT exceeded the rating and thus changed
-	return SUCCESS;
 }
 
 //Internal function to the mapping of the DC object update function
@@ -7528,6 +7471,43 @@ EXPORT STATUS inverter_dyn_NR_current_injection_update(OBJECT *obj, int64 iterat
 	return temp_status;
 }
 
+//// Class-level version of the above - powerflow calls this once per pass for all the inverters of an island, before its current injection loop
+//// Only computes - the solver calls inverter_dyn_NR_current_injection_push at the position of each inverter's bus
+//// bus_voltages holds the three bus voltages of each inverter, packed in the order of obj_list
+EXPORT STATUS inverter_dyn_NR_current_injection_update_batch(OBJECT **obj_list, gld::complex *bus_voltages, unsigned int count, int64 iteration_count, bool *converged_failure)
+{
+	STATUS temp_status;
+	unsigned int index;
+
+	for (index=0; index<count; index++)
+	{
+		//Map the node
+		inverter_dyn *my = OBJECTDATA(obj_list[index], inverter_dyn);
+
+		//Call the function, where we can compute the IGenerated injection
+		temp_status = my->computeCurrInjection(iteration_count,&converged_failure[index],&bus_voltages[3*index]);
+
+		//Stop at the first failure
+		if (temp_status != SUCCESS)
+		{
+			return temp_status;
+		}
+	}
+
+	return SUCCESS;
+}
+
+//// Pushes the injection computed by the class-level update
+EXPORT STATUS inverter_dyn_NR_current_injection_push(OBJECT *obj)
+{
+	//Map the node
+	inverter_dyn *my = OBJECTDATA(obj, inverter_dyn);
+
+	my->pushCurrInjection();
+
+	return SUCCESS;
+}
+
 // Export function for registering a DC interaction object
 EXPORT STATUS inverter_dyn_DC_object_register(OBJECT *this_obj, OBJECT *DC_obj)
 {
@@ -10,6 +10,8 @@ EXPORT STATUS preupdate_inverter_dyn(OBJECT *obj, TIMESTAMP t0, unsigned int64 d
 EXPORT SIMULATIONMODE interupdate_inverter_dyn(OBJECT *obj, unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val);
 EXPORT STATUS postupdate_inverter_dyn(OBJECT *obj, gld::complex *useful_value, unsigned int mode_pass);
 EXPORT STATUS inverter_dyn_NR_current_injection_update(OBJECT *obj, int64 iteration_count, bool *converged_failure);
+EXPORT STATUS inverter_dyn_NR_current_injection_update_batch(OBJECT **obj_list, gld::complex *bus_voltages, unsigned int count, int64 iteration_count, bool *converged_failure);
+EXPORT STATUS inverter_dyn_NR_current_injection_push(OBJECT *obj);
 EXPORT STATUS inverter_dyn_DC_object_register(OBJECT *this_obj, OBJECT *DC_obj);
 
 //Alias the currents
@@ -130,6 +132,8 @@ private:
 	enumeration attached_bus_type;	//Determines attached bus type - mostly for VSI and grid-forming functionality
 
 	FUNCTIONADDR swing_test_fxn;	//Function to map to swing testing function, if needed
+	bool voltage_is_bus_voltage;	//Boolean to indicate if the voltages are the solver's bus voltages (three-phase node that is not a child)
+	bool push_voltage_pending;		//Boolean to indicate if the last computed injection also forces the voltage (grid-forming in QSTS)
 
 	gld_property *pCircuit_V[3];   ///< pointer to the three L-N voltage fields
 	gld_property *pLine_I[3];	   ///< pointer to the three current fields
@@ -137,6 +141,8 @@ private:
 	gld_property *pPower[3];	   ///< pointer to power value on meter parent
 	gld_property *pMeterStatus;	   ///< Pointer to service_status variable on meter parent
 	gld_property *pSOC;            ///< Pointer to battery SOC
+	gld_bundle powerflow_values;   ///< Bundle of the powerflow values pulled and pushed each pass
+	gld_bundle powerflow_voltage;  ///< Bundle of the voltages pulled each pass and forced on a grid-forming SWING parent
 
 
 	//Default or "connecting point" values for powerflow interactions
@@ -446,6 +452,8 @@ public:
 	SIMULATIONMODE inter_deltaupdate(unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val);
 	STATUS post_deltaupdate(gld::complex *useful_value, unsigned int mode_pass);
 	STATUS updateCurrInjection(int64 iteration_count,bool *converged_failure);
+	STATUS computeCurrInjection(int64 iteration_count,bool *converged_failure,gld::complex *bus_voltage);
+	void pushCurrInjection(void);
 	STATUS init_dynamics(INV_DYN_STATE *curr_time);
 	STATUS DC_object_register(OBJECT *DC_object);
 
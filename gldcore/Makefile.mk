@@ -85,6 +85,8 @@ GLD_SOURCES_PLACE_HOLDER += gldcore/object.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/output.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/output.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/platform.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/profiler.cpp
+GLD_SOURCES_PLACE_HOLDER += gldcore/profiler.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/property.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/property.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/random.c
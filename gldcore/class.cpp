@@ -17,6 +17,7 @@
 #include "enduse.h"
 #include "stream.h"
 #include "gldrandom.h"
+#include "profiler.h"
 
 #if defined(_WIN32) && !defined(__MINGW32__)
 #define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
@@ -1180,6 +1181,7 @@ void class_profiles(void)
 	int64 total=0;
 	int count=0, i=0, hits;
 	CLASS **index;
+	profile_merge();
 	output_profile("Model profiler results");
 	output_profile("======================\n");
 	output_profile("Class            Time (s) Time (%%) msec/obj");
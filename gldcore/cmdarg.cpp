@@ -976,6 +976,24 @@ static int threadcount(int argc, char *argv[])
 	}
 	return 1;
 }
+static int batch(int argc, char *argv[])
+{
+	if (argc>1)
+	{
+		strncpy(global_batch_file,(argc--,*++argv),sizeof(global_batch_file)-1);
+		return 1;
+	}
+	else
+	{
+		output_fatal("missing batch sweep file");
+		/*	TROUBLESHOOT
+			The <b>--batch</b> command line directive
+			was not followed by the name of a sweep file.  The correct syntax is
+			<b>--batch <i>sweepfile</i></b>.
+		 */
+		return CMDERR;
+	}
+}
 static int output(int argc, char *argv[])
 {
 	if (argc>1)
@@ -1430,6 +1448,7 @@ static CMDARG main_cmd[] = {
 	{"pidfile",		nullptr,	pidfile,		"[=<filename>]", "Set the process ID file (default is gridlabd.pid)" },
 	{"threadcount", "T",	threadcount,	"<n>", "Set the maximum number of threads allowed" },
 	{"job",			nullptr,	job,			"...", "Start a job"},
+	{"batch",		nullptr,	batch,			"<sweepfile>", "Run the scenarios of a sweep file in workers forked from the initialized model"},
 
 	{nullptr,nullptr,nullptr,nullptr, "System options"},
 	{"avlbalance",	nullptr,	avlbalance,		nullptr, "Toggles automatic balancing of object index" },
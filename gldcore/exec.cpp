@@ -136,6 +136,8 @@
 #include "test.h"
 #include "link.h"
 #include "save.h"
+#include "profiler.h"
+#include "job.h"
 
 #include "cpp_threadpool.h"
 
@@ -1890,7 +1892,7 @@ void exec_clock_update_modules()
  **/
 STATUS exec_start()
 {
-	cpp_threadpool* threadpool = new cpp_threadpool(global_threadcount);
+	cpp_threadpool* threadpool = nullptr;
 	int64 passes = 0, tsteps = 0;
 	int ptc_rv = 0; // unused
 	int ptj_rv = 0; // unused
@@ -1952,6 +1954,15 @@ STATUS exec_start()
 	if (global_compileonly)
 		return SUCCESS;
 
+	/* batch scenarios are run by workers forked from the initialized model (before any helper thread is started) */
+	if (global_batch_file[0]!='\0')
+	{
+		int code = job_batch();
+		if (code>=0)
+			exit(code);
+	}
+	threadpool = new cpp_threadpool(global_threadcount);
+
 	/* enable non-determinism check, if any */
 	if (global_randomseed!=0 && global_threadcount>1)
 		global_nondeterminism_warning = 1;
@@ -2680,6 +2691,7 @@ STATUS exec_start()
 	/* report performance */
 	if (global_profiler && !exec_sync_isinvalid(nullptr) )
 	{
+		profile_merge();
 		double elapsed_sim = timestamp_to_hours(global_clock)-timestamp_to_hours(global_starttime);
 		double elapsed_wall = (double)(realtime_now()-started_at+1);
 		double sync_time = 0;
@@ -2730,6 +2742,7 @@ STATUS exec_start()
 		output_profile("Time steps completed    %8d timesteps", tsteps);
 		output_profile("Convergence efficiency  %8.02lf passes/timestep", (double)passes/tsteps);
 #ifndef NOLOCKS
+		lock_merge();
 		output_profile("Read lock contention    %7.01lf%%", (rlock_spin>0 ? (1-(double)rlock_count/(double)rlock_spin)*100 : 0));
 		output_profile("Write lock contention   %7.01lf%%", (wlock_spin>0 ? (1-(double)wlock_count/(double)wlock_spin)*100 : 0));
 #endif
@@ -26,6 +26,13 @@
 #include "aggregate.h"
 #include "module.h"
 #include "timestamp.h"
+#include "lock.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 static FINDTYPE invar_types[] = {FT_ID, FT_SIZE, FT_CLASS, FT_PARENT, FT_RANK, FT_NAME, FT_LAT, FT_LONG, FT_INSVC, FT_OUTSVC, FT_MODULE, FT_ISA, static_cast<FINDTYPE>(0)};
 
@@ -301,7 +308,7 @@ FINDLIST *new_list(unsigned int n)
 #define ADDOBJ(L,N) (!FOUND((L),(N))?((L).result[(N)>>3]|=(1<<((N)&0x7)),++((L).hit_count)):(L).hit_count)
 #define DELOBJ(L,N) (FOUND((L),(N))?((L).result[(N)>>3]&=~(1<<((N)&0x7)),--((L).hit_count)):(L).hit_count)
 #define ADDALL(L) ((L).hit_count=object_get_count(),memset((L).result,0xff,(L).result_size))
-#define DELALL(L) ((L).hit_count=object_get_count(),memset((L).result,0x00,(L).result_size))
+#define DELALL(L) ((L).hit_count=0,memset((L).result,0x00,(L).result_size))
 
 FINDLIST *find_runpgm(FINDLIST *list, FINDPGM *pgm);
 FINDPGM *find_mkpgm(char *expression);
@@ -370,11 +377,6 @@ FINDLIST *find_objects(FINDLIST * volatile start, ...)
 	double rval;
 	OBJECT *obj;
 	FINDLIST *result = start;
-	if (start==FL_NEW || start==FL_GROUP)
-	{
-		result=new_list(object_get_count());
-		ADDALL(*result);
-	}
 	/* FL_GROUP is something of an interrupt option that constructs a program by parsing string input. */
 	if (start==FL_GROUP)
 	{
@@ -382,14 +384,18 @@ FINDLIST *find_objects(FINDLIST * volatile start, ...)
 		va_list(ptr);
 		va_start(ptr,start);
 		pgm = find_mkpgm(va_arg(ptr,char*));
+		va_end(ptr);
 		if (pgm!=nullptr){
-			return find_runpgm(result,pgm);
+			return find_runpgm(nullptr,pgm); /* a new search may use the find indexes and cache */
 		} else {
-			va_end(ptr);
-			DELALL(*result); /* pgm == nullptr */
-			return result;
+			return new_list(object_get_count()); /* pgm == nullptr */
 		}
 	}
+	if (start==FL_NEW)
+	{
+		result=new_list(object_get_count());
+		ADDALL(*result);
+	}
 	/* if we're not using FL_GROUP, we break apart the va_arg list, taking data inputs in the "correct" type. */
 	for (obj=object_get_first(); obj!=nullptr; obj=obj->next)
 	{
@@ -608,6 +614,11 @@ int compare_string_gt(void *a, FINDVALUE b) { return *(char **)a != nullptr && s
 int compare_string_le(void *a, FINDVALUE b) { return *(char **)a != nullptr && strcmp(*(char**)a,b.string)<=0;}
 int compare_string_ge(void *a, FINDVALUE b) { return *(char **)a != nullptr && strcmp(*(char**)a,b.string)>=0;}
 
+/* object names are pointers into the name tree */
+int compare_name_eq(void *a, FINDVALUE b) { return *(char **)a != nullptr && strcmp(*(char**)a,b.string)==0;}
+int compare_name_li(void *a, FINDVALUE b) { return *(char **)a != nullptr && match(b.string,*(char**)a);}
+int compare_name_nl(void *a, FINDVALUE b) { return *(char **)a == nullptr || !match(b.string,*(char**)a);}
+
 int compare_pointer_li(void *a, FINDVALUE b) {return 0;}
 
 int compare_integer_li(void *a, FINDVALUE b) {
@@ -697,7 +708,7 @@ int compare_integer64_nl(void *a, FINDVALUE b) {
  **/
 FINDLIST *findlist_copy(FINDLIST * volatile list)
 {
-	unsigned int size = sizeof(FINDLIST)+(list->result_size>>3);
+	unsigned int size = sizeof(FINDLIST)+list->result_size-1;
 	FINDLIST *new_list = static_cast<FINDLIST*>(module_malloc(size));
 	memcpy(new_list,list,size);
 	return new_list;
@@ -731,7 +742,7 @@ PGMCONSTFLAGS find_pgmconstants(FINDPGM *pgm)
 
 }
 
-static FINDPGM *add_pgm(FINDPGM **pgm, COMPAREFUNC op, unsigned short target, FINDVALUE value, FOUNDACTION pos, FOUNDACTION neg)
+static FINDPGM *add_pgm(FINDPGM **pgm, COMPAREFUNC op, unsigned short target, FINDVALUE value, FOUNDACTION pos, FOUNDACTION neg, FINDTYPE ftype)
 {
 	/* create program entry */
 	FINDPGM *item = (FINDPGM*)malloc(sizeof(FINDPGM));
@@ -743,6 +754,7 @@ static FINDPGM *add_pgm(FINDPGM **pgm, COMPAREFUNC op, unsigned short target, FI
 		item->value = value;
 		item->pos = pos;
 		item->neg = neg;
+		item->ftype = ftype;
 		item->next = nullptr;
 
 		/* attach to existing program */
@@ -765,15 +777,198 @@ static FINDPGM *add_pgm(FINDPGM **pgm, COMPAREFUNC op, unsigned short target, FI
 	return item;
 }
 
-/** Runs a search engine built by find_mkpgm **/
-FINDLIST *find_runpgm(FINDLIST *list, FINDPGM *pgm)
+/**************************************************************
+ * FIND INDEXES
+ **************************************************************/
+
+/* The indexes cover the header fields that only change through object
+   creation and removal, object_set_name(), object_set_parent(), and the
+   loader's parent and groupid assignments.  Each of these calls
+   find_index_invalidate(), and the indexes are rebuilt the next time they
+   are used.  Programs that only test these fields give the same result
+   until then, so their results are cached. */
+typedef struct s_findindex {
+	unsigned int generation; /* generation of the objects when the index was built */
+	std::vector<OBJECT*> id; /* objects by id */
+	std::unordered_map<void*,std::vector<OBJECT*> > oclass; /* objects by class */
+	std::unordered_map<void*,std::vector<OBJECT*> > parent; /* objects by parent (nullptr for root objects) */
+	std::unordered_map<std::string,std::vector<OBJECT*> > groupid; /* objects by groupid */
+	std::vector<std::pair<std::string,OBJECT*> > name; /* named objects sorted by name */
+} FINDINDEX;
+static FINDINDEX find_index = {0};
+static std::map<std::string,FINDLIST*> find_cache; /* results of invariant programs */
+static unsigned int find_cache_generation = 0;
+static unsigned int find_generation = 1;
+static unsigned int find_lock = 0;
+
+/** Invalidate the find indexes and the cached results.  This must be called
+	whenever an object is created or removed, or its name, parent or groupid
+	is changed.
+ **/
+void find_index_invalidate(void)
 {
-	if (list==nullptr)
+	find_generation++;
+}
+
+static void find_index_update(void)
+{
+	OBJECT *obj;
+	if ( find_index.generation==find_generation )
+		return;
+	find_index.id.clear();
+	find_index.oclass.clear();
+	find_index.parent.clear();
+	find_index.groupid.clear();
+	find_index.name.clear();
+	for ( obj=object_get_first() ; obj!=nullptr ; obj=obj->next )
 	{
-		list=new_list(object_get_count());
-		ADDALL(*list);
+		if ( obj->id>=find_index.id.size() )
+			find_index.id.resize(obj->id+1,nullptr);
+		find_index.id[obj->id] = obj;
+		find_index.oclass[obj->oclass].push_back(obj);
+		find_index.parent[obj->parent].push_back(obj);
+		if ( obj->groupid[0]!='\0' )
+			find_index.groupid[std::string(obj->groupid)].push_back(obj);
+		if ( obj->name!=nullptr )
+			find_index.name.push_back(std::make_pair(std::string(obj->name),obj));
+	}
+	std::sort(find_index.name.begin(),find_index.name.end());
+	find_index.generation = find_generation;
+	output_debug("find_index_update(): %d objects indexed", (int)find_index.id.size());
+}
+
+/* get the literal prefix of a name pattern anchored with '^' (see match()) */
+static std::string find_name_prefix(const char *pattern)
+{
+	std::string prefix;
+	if ( pattern[0]!='^' )
+		return prefix;
+	for ( pattern++ ; *pattern!='\0' && strchr(".*\\$",*pattern)==nullptr && pattern[1]!='*' ; pattern++ )
+		prefix += *pattern;
+	return prefix;
+}
+
+/* get the objects that may satisfy a program step using the indexes
+   @return the number of candidates; -1 if no index applies to the step */
+static int64 find_index_lookup(FINDPGM *step, std::vector<OBJECT*> *result)
+{
+	std::vector<OBJECT*> *items = nullptr;
+	switch ( step->ftype ) {
+	case FT_CLASS:
+	case FT_MODULE: /* matches an object's class against a module, so the index is simply empty */
+		if ( step->op==compare_pointer_eq )
+		{
+			auto item = find_index.oclass.find(step->value.pointer);
+			items = ( item==find_index.oclass.end() ? nullptr : &(item->second) );
+			break;
+		}
+		return -1;
+	case FT_PARENT:
+		if ( step->op==compare_pointer_eq )
+		{
+			auto item = find_index.parent.find(step->value.pointer);
+			items = ( item==find_index.parent.end() ? nullptr : &(item->second) );
+			break;
+		}
+		return -1;
+	case FT_GROUPID:
+		if ( step->op==compare_string_eq )
+		{
+			auto item = find_index.groupid.find(std::string(step->value.string));
+			items = ( item==find_index.groupid.end() ? nullptr : &(item->second) );
+			break;
+		}
+		return -1;
+	case FT_ID:
+	{
+		int64 first = 0, last = (int64)find_index.id.size()-1, id = (int32)step->value.integer;
+		if ( step->op==compare_integer_eq ) first = last = id;
+		else if ( step->op==compare_integer_lt ) last = id-1;
+		else if ( step->op==compare_integer_le ) last = id;
+		else if ( step->op==compare_integer_gt ) first = id+1;
+		else if ( step->op==compare_integer_ge ) first = id;
+		else return -1;
+		if ( first<0 ) first = 0;
+		if ( last>=(int64)find_index.id.size() ) last = (int64)find_index.id.size()-1;
+		if ( result!=nullptr )
+		{
+			for ( int64 n=first ; n<=last ; n++ )
+				if ( find_index.id[n]!=nullptr ) result->push_back(find_index.id[n]);
+		}
+		return last>=first ? last-first+1 : 0;
+	}
+	case FT_NAME:
+	{
+		std::string prefix;
+		if ( step->op==compare_name_eq )
+			prefix = step->value.string;
+		else if ( step->op==compare_name_li )
+			prefix = find_name_prefix(step->value.string);
+		if ( prefix.empty() )
+			return -1;
+		auto first = std::lower_bound(find_index.name.begin(),find_index.name.end(),std::make_pair(prefix,(OBJECT*)nullptr));
+		auto last = first;
+		while ( last!=find_index.name.end() && last->first.compare(0,prefix.size(),prefix)==0 )
+		{
+			if ( result!=nullptr ) result->push_back(last->second);
+			last++;
+		}
+		return last-first;
+	}
+	default:
+		return -1;
+	}
+	if ( items==nullptr )
+		return 0;
+	if ( result!=nullptr )
+		result->insert(result->end(),items->begin(),items->end());
+	return items->size();
+}
+
+/* get the cache key of a program whose result only depends on indexed fields
+   @return false if the program's result cannot be cached */
+static bool find_cache_key(FINDPGM *pgm, std::string &key)
+{
+	char buffer[64];
+	for ( ; pgm!=nullptr ; pgm=pgm->next )
+	{
+		switch ( pgm->ftype ) {
+		case FT_CLASS:
+		case FT_MODULE:
+		case FT_PARENT:
+		case FT_ID:
+			snprintf(buffer,sizeof(buffer),"%p:%d:%llx;",(void*)pgm->op,pgm->ftype,(unsigned long long)pgm->value.integer);
+			key += buffer;
+			break;
+		case FT_GROUPID:
+		case FT_NAME:
+			snprintf(buffer,sizeof(buffer),"%p:%d:",(void*)pgm->op,pgm->ftype);
+			key += buffer;
+			key += pgm->value.string;
+			key += ";";
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+/* test whether an object satisfies all the steps of a program */
+static bool find_match(OBJECT *obj, FINDPGM *pgm)
+{
+	for ( ; pgm!=nullptr ; pgm=pgm->next )
+	{
+		if ( !(*pgm->op)((void*)(((char*)obj)+pgm->target),pgm->value) )
+			return false;
 	}
-	if (pgm!=nullptr)
+	return true;
+}
+
+/* run each step of a program over the whole list */
+static void find_runsteps(FINDLIST *list, FINDPGM *pgm)
+{
+	for ( ; pgm!=nullptr ; pgm=pgm->next )
 	{
 		OBJECT *obj;
 		for (obj=find_first(list); obj!=nullptr; obj=find_next(list,obj))
@@ -783,7 +978,111 @@ FINDLIST *find_runpgm(FINDLIST *list, FINDPGM *pgm)
 			else
 			{	if (pgm->neg) (*pgm->neg)(list,obj); }
 		}
-		find_runpgm(list,pgm->next);
+	}
+}
+
+/** Runs a search engine built by find_mkpgm
+
+	When \p find_index is enabled, the steps of the program are combined into a
+	single pass over the objects.  If a step can be answered by an index (class, 
+	parent, groupid, id or name), only the objects found by the most selective 
+	such step are tested.  When \p list is \p nullptr and the program only tests 
+	indexed fields, the result is cached for later searches using the same criteria.
+ **/
+FINDLIST *find_runpgm(FINDLIST *list, FINDPGM *pgm)
+{
+	FINDPGM *step, *best = nullptr;
+	int64 best_size = -1;
+	std::vector<OBJECT*> candidates;
+	std::string key;
+	bool combined = false, cache = false;
+	if ( pgm!=nullptr && global_find_index )
+	{
+		/* the combined pass only works when each step deletes the objects that fail it */
+		for ( step=pgm ; step!=nullptr ; step=step->next )
+		{
+			if ( step->pos!=nullptr || step->neg!=findlist_del )
+				break;
+		}
+		combined = ( step==nullptr );
+		if ( combined )
+		{
+			wlock(&find_lock);
+			find_index_update();
+			if ( list==nullptr && find_cache_key(pgm,key) )
+			{
+				if ( find_cache_generation!=find_generation )
+				{
+					for ( auto item=find_cache.begin() ; item!=find_cache.end() ; item++ )
+						module_free(item->second);
+					find_cache.clear();
+					find_cache_generation = find_generation;
+				}
+				auto item = find_cache.find(key);
+				if ( item!=find_cache.end() )
+				{
+					FINDLIST *result = findlist_copy(item->second);
+					wunlock(&find_lock);
+					return result;
+				}
+				cache = true;
+			}
+			for ( step=pgm ; step!=nullptr ; step=step->next )
+			{
+				int64 size = find_index_lookup(step,nullptr);
+				if ( size>=0 && ( best==nullptr || size<best_size ) )
+				{
+					best = step;
+					best_size = size;
+				}
+			}
+			if ( best!=nullptr )
+				find_index_lookup(best,&candidates);
+			wunlock(&find_lock);
+		}
+	}
+	if (list==nullptr)
+	{
+		list=new_list(object_get_count());
+		if ( list==nullptr )
+			return nullptr;
+		ADDALL(*list);
+	}
+	if ( pgm==nullptr )
+		return list;
+	if ( !combined )
+	{
+		find_runsteps(list,pgm);
+		return list;
+	}
+	if ( best!=nullptr )
+	{
+		/* test only the candidates found in the index */
+		std::vector<OBJECT*> found;
+		for ( auto obj=candidates.begin() ; obj!=candidates.end() ; obj++ )
+		{
+			if ( (*obj)->id < SIZE(*list)*8 && FOUND(*list,(*obj)->id) && find_match(*obj,pgm) )
+				found.push_back(*obj);
+		}
+		DELALL(*list);
+		for ( auto obj=found.begin() ; obj!=found.end() ; obj++ )
+			ADDOBJ(*list,(*obj)->id);
+	}
+	else
+	{
+		OBJECT *obj;
+		for ( obj=find_first(list) ; obj!=nullptr ; obj=find_next(list,obj) )
+		{
+			if ( !find_match(obj,pgm) )
+				DELOBJ(*list,obj->id);
+		}
+	}
+	if ( cache )
+	{
+		wlock(&find_lock);
+		if ( find_cache_generation==find_generation && find_cache.find(key)==find_cache.end() )
+			find_cache[key] = findlist_copy(list);
+		wunlock(&find_lock);
 	}
 	return list;
 }
@@ -1048,7 +1347,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			else
 			{
 				v.pointer=(void*)oclass;
-				add_pgm(pgm,comparemap[op].pointer,OFFSET(oclass),v,nullptr,findlist_del);
+				add_pgm(pgm,comparemap[op].pointer,OFFSET(oclass),v,nullptr,findlist_del,FT_CLASS);
 				(*pgm)->constflags |= CF_CLASS; /* this will always reduce in a set class of fixed class, leaving it invariant if already so */
 				ACCEPT;	DONE;
 			}
@@ -1066,7 +1365,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			else
 			{
 				v.pointer=(void*)oclass;
-				add_pgm(pgm,compare_isa,OFFSET(oclass),v,nullptr,findlist_del);
+				add_pgm(pgm,compare_isa,OFFSET(oclass),v,nullptr,findlist_del,FT_ISA);
 				(*pgm)->constflags |= CF_CLASS; /* this will always reduce in a set class of fixed class, leaving it invariant if already so */
 				ACCEPT;	DONE;
 			}
@@ -1076,7 +1375,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			FINDVALUE v;
 			strcpy(v.string, pvalue);
 			//printf("find(): v.string=\"%s\", pvalue=\"%s\"\n", v.string, pvalue);
-			add_pgm(pgm, comparemap[op%7].string, OFFSET(groupid), v, nullptr, findlist_del);
+			add_pgm(pgm, comparemap[op%7].string, OFFSET(groupid), v, nullptr, findlist_del, FT_GROUPID);
 			(*pgm)->constflags |= CF_NAME;
 			ACCEPT;
 			DONE;
@@ -1094,7 +1393,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			else
 			{
 				v.pointer=(void*)mod;
-				add_pgm(pgm,comparemap[op].pointer,OFFSET(oclass),v,nullptr,findlist_del);
+				add_pgm(pgm,comparemap[op].pointer,OFFSET(oclass),v,nullptr,findlist_del,FT_MODULE);
 				(*pgm)->constflags |= CF_MODULE; 
 				ACCEPT;	DONE;
 			}
@@ -1111,7 +1410,7 @@ static int expression(PARSER, FINDPGM **pgm)
 				 */
 			} else {
 				v.integer = idnum;
-				add_pgm(pgm,comparemap[op].integer,OFFSET(id),v,nullptr,findlist_del);
+				add_pgm(pgm,comparemap[op].integer,OFFSET(id),v,nullptr,findlist_del,FT_ID);
 				(*pgm)->constflags |= CF_ID;
 				ACCEPT;
 				DONE;
@@ -1121,11 +1420,29 @@ static int expression(PARSER, FINDPGM **pgm)
 		{
 			/* Accept implicitly.  If it's bad, it's bad. -MH */
 			FINDVALUE v;
+			COMPAREFUNC compare = nullptr;
 			strcpy(v.string, pvalue);
-			add_pgm(pgm, comparemap[op].string, OFFSET(name), v, nullptr, findlist_del);
-			(*pgm)->constflags |= CF_NAME;
-			ACCEPT;
-			DONE;
+			if (op==EQ)
+				compare = compare_name_eq;
+			else if (op==LIKE)
+				compare = compare_name_li;
+			else if (op==UNLIKE)
+				compare = compare_name_nl;
+			else if (op<=GE)
+				compare = comparemap[op].string;
+			if (compare==nullptr)
+				output_error("find expression on name does not support this comparison");
+				/* TROUBLESHOOT
+					A search rule compared object names using an operation that is not supported.
+					Use =, !=, <, >, <=, >=, ~ or !~ and try again.
+				 */
+			else
+			{
+				add_pgm(pgm, compare, OFFSET(name), v, nullptr, findlist_del, FT_NAME);
+				(*pgm)->constflags |= CF_NAME;
+				ACCEPT;
+				DONE;
+			}
 		}
 		else if (strcmp(pname,"parent")==0)
 		{
@@ -1140,7 +1457,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			else
 			{
 				v.pointer = (void*)parent;
-				add_pgm(pgm,comparemap[op].pointer,OFFSET(parent),v,nullptr,findlist_del);
+				add_pgm(pgm,comparemap[op].pointer,OFFSET(parent),v,nullptr,findlist_del,FT_PARENT);
 				(*pgm)->constflags |= CF_PARENT;
 				ACCEPT; DONE;
 			}
@@ -1158,7 +1475,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			else
 			{
 				v.integer = rank;
-				add_pgm(pgm,comparemap[op].integer,OFFSET(rank),v,nullptr,findlist_del);
+				add_pgm(pgm,comparemap[op].integer,OFFSET(rank),v,nullptr,findlist_del,FT_RANK);
 				(*pgm)->constflags |= CF_RANK;
 				ACCEPT; DONE;
 			}
@@ -1185,7 +1502,7 @@ static int expression(PARSER, FINDPGM **pgm)
 					REJECT;
 				}
 				v.real = val;
-				add_pgm(pgm, comparemap[op].real, OFFSET(latitude), v, nullptr, findlist_del);
+				add_pgm(pgm, comparemap[op].real, OFFSET(latitude), v, nullptr, findlist_del, FT_LAT);
 				(*pgm)->constflags |= CF_LAT;
 				ACCEPT; DONE;
 			}
@@ -1212,7 +1529,7 @@ static int expression(PARSER, FINDPGM **pgm)
 					REJECT;
 				}
 				v.real = val;
-				add_pgm(pgm, comparemap[op].real, OFFSET(longitude), v, nullptr, findlist_del);
+				add_pgm(pgm, comparemap[op].real, OFFSET(longitude), v, nullptr, findlist_del, FT_LONG);
 				(*pgm)->constflags |= CF_LONG;
 				ACCEPT; DONE;
 			}
@@ -1223,7 +1540,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			v.integer = convert_to_timestamp(pvalue);
 			if(v.integer == TS_NEVER)
 				REJECT;
-			add_pgm(pgm, comparemap[op].integer, OFFSET(clock), v, nullptr, findlist_del);
+			add_pgm(pgm, comparemap[op].integer, OFFSET(clock), v, nullptr, findlist_del, FT_CLOCK);
 			(*pgm)->constflags |= CF_CLOCK;
 			ACCEPT; DONE;
 		}
@@ -1234,7 +1551,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			printf("find insvc=%lld\n", v.integer);
 			if(v.integer == TS_NEVER)
 				REJECT;
-			add_pgm(pgm, comparemap[op].integer, OFFSET(in_svc), v, nullptr, findlist_del);
+			add_pgm(pgm, comparemap[op].integer, OFFSET(in_svc), v, nullptr, findlist_del, FT_INSVC);
 			(*pgm)->constflags |= CF_INSVC;
 			ACCEPT; DONE;
 		}
@@ -1244,7 +1561,7 @@ static int expression(PARSER, FINDPGM **pgm)
 			v.integer = convert_to_timestamp(pvalue);
 			if(v.integer == TS_NEVER)
 				REJECT;
-			add_pgm(pgm, comparemap[op].integer, OFFSET(out_svc), v, nullptr, findlist_del);
+			add_pgm(pgm, comparemap[op].integer, OFFSET(out_svc), v, nullptr, findlist_del, FT_OUTSVC);
 			(*pgm)->constflags |= CF_OUTSVC;
 			ACCEPT; DONE;
 		}
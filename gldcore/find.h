@@ -61,6 +61,7 @@ typedef struct s_findpgm {
 	unsigned short target; /* offset from start of object header */
 	FINDVALUE value;
 	FOUNDACTION pos, neg;
+	FINDTYPE ftype; /* header field tested (used to select a find index) */
 	struct s_findpgm *next;
 } FINDPGM;
 
@@ -82,6 +83,7 @@ FINDPGM *find_mkpgm(char *search);
 PGMCONSTFLAGS find_pgmconstants(FINDPGM *pgm);
 char *find_file(const char *name, const char *path, int mode, char *buffer, int len);
 FINDPGM *find_make_invariant(FINDPGM *pgm, int mode);
+void find_index_invalidate(void);
 
 #ifdef __cplusplus
 }
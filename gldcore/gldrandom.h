@@ -34,6 +34,15 @@ extern "C" {
 		RT_BETA,		/**< Beta distribution; double alpha, double beta */
 		RT_TRIANGLE,	/**< Triangle distribution; double a, double b */
 	} RANDOMTYPE;
+	typedef enum {
+		RS_GLOBAL=0,	/**< stream of the global generator */
+		RS_OBJECT,		/**< stream of an object (id is the object id) */
+		RS_LOADSHAPE,	/**< stream of a loadshape */
+		RS_RANDOMVAR,	/**< stream of a randomvar */
+		RS_STATE,		/**< stream of a state that was not created by random_newstate() */
+		RS_NUMDOMAINS,
+	} RANDOMSTREAM; /**< owners of counter-based generator streams */
+#define RS_NEXTID 0xffffffff /**< use the next id of the stream domain */
 	int random_init(void);
 	int random_test(void);
 	int randwarn(unsigned int *state);
@@ -58,6 +67,8 @@ extern "C" {
 	int random_nargs(char *name);
 	double random_value(RANDOMTYPE type, ...);
 	double pseudorandom_value(RANDOMTYPE, unsigned int *state, ...);
+	int random_values(RANDOMTYPE type, unsigned int *state, double *value, unsigned int count, double a, double b);
+	unsigned int random_newstate(RANDOMSTREAM domain, unsigned int id);
 #ifdef __cplusplus
 }
 #endif
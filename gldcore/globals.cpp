@@ -53,7 +53,8 @@ static KEYWORD cpt_keys[] = {
 
 static KEYWORD rng_keys[] = {
 	{"RNG2", RNG2, rng_keys+1},		/**< version 2 random number generator (stateless) */
-	{"RNG3", RNG3, nullptr,},			/**< version 3 random number generator (statefull) */
+	{"RNG3", RNG3, rng_keys+2,},		/**< version 3 random number generator (statefull) */
+	{"RNG4", RNG4, nullptr,},			/**< version 4 random number generator (counter-based) */
 };
 
 static KEYWORD mls_keys[] = {
@@ -143,12 +144,18 @@ static struct s_varmap {
 	{"federation_reiteration", PT_bool, &global_federation_reiteration, PA_REFERENCE, "global boolean to enforce a reiteration for all modules due to an external federation reiteration"},
 	{"workdir", PT_char1024, &global_workdir, PA_REFERENCE, "working directory"},
 	{"lock", PT_bool, &global_lock_enabled, PA_PUBLIC, "lock enabled flag"},
+	{"lock_stats", PT_bool, &global_lock_stats, PA_PUBLIC, "lock statistics enable flag"},
+	{"lock_stats_top", PT_int32, &global_lock_stats_top, PA_PUBLIC, "number of most contended locks reported"},
+	{"lock_spin_limit", PT_int32, &global_lock_spin_limit, PA_PUBLIC, "number of lock attempts before a waiting thread yields"},
 	{"dumpfile", PT_char1024, &global_dumpfile, PA_PUBLIC, "dump filename"},
 	{"savefile", PT_char1024, &global_savefile, PA_PUBLIC, "save filename"},
 	{"dumpall", PT_bool, &global_dumpall, PA_PUBLIC, "dumpall enable flag"},
 	{"runchecks", PT_bool, &global_runchecks, PA_PUBLIC, "runchecks enable flag"},
 	{"threadcount", PT_int32, &global_threadcount, PA_PUBLIC, "number of threads to use while using multicore"},
 	{"profiler", PT_bool, &global_profiler, PA_PUBLIC, "profiler enable flag"},
+	{"profile_trace", PT_char1024, &global_profile_trace, PA_PUBLIC, "Chrome trace event file written by the profiler"},
+	{"profile_folded", PT_char1024, &global_profile_folded, PA_PUBLIC, "folded stack (flamegraph) file written by the profiler"},
+	{"profile_trace_limit", PT_int32, &global_profile_trace_limit, PA_PUBLIC, "maximum number of trace events recorded per thread"},
 	{"pauseatexit", PT_bool, &global_pauseatexit, PA_PUBLIC, "pause at exit flag"},
 	{"testoutputfile", PT_char1024, &global_testoutputfile, PA_PUBLIC, "filename for test output"},
 	{"xml_encoding", PT_int32, &global_xml_encoding, PA_PUBLIC, "XML data encoding"},
@@ -180,6 +187,9 @@ static struct s_varmap {
 	{"minimum_timestep", PT_int32, &global_minimum_timestep, PA_PUBLIC, "minimum timestep"},
 	{"platform",PT_char8, global_platform, PA_REFERENCE, "operating platform"},
 	{"suppress_repeat_messages",PT_bool, &global_suppress_repeat_messages, PA_PUBLIC, "suppress repeated messages enable flag"},
+	{"output_async",PT_bool, &global_output_async, PA_PUBLIC, "write messages from a separate thread"},
+	{"output_json",PT_bool, &global_output_json, PA_PUBLIC, "write messages as JSON lines"},
+	{"output_repeat_limit",PT_int32, &global_output_repeat_limit, PA_PUBLIC, "maximum number of messages of each type using the same format (0 for no limit)"},
 	{"maximum_synctime",PT_int32, &global_maximum_synctime, PA_PUBLIC, "maximum sync time for deltamode"},
 	{"run_realtime",PT_bool, &global_run_realtime, PA_PUBLIC, "realtime enable flag"},
 	{"enter_realtime",PT_timestamp, &global_enter_realtime, PA_PUBLIC, "timestamp to transition to realtime mode"},
@@ -205,6 +215,10 @@ static struct s_varmap {
 	{"checkpoint_keepall", PT_bool, &global_checkpoint_keepall, PA_PUBLIC, "checkpoint file keep enable flag"},
 	{"check_version", PT_bool, &global_check_version, PA_PUBLIC, "check version enable flag"},
 	{"random_number_generator", PT_enumeration, &global_randomnumbergenerator, PA_PUBLIC, "random number generator version control flag", rng_keys},
+	{"transform_events", PT_bool, &global_transform_events, PA_PUBLIC, "update schedule transforms only when the schedule value changes"},
+	{"find_index", PT_bool, &global_find_index, PA_PUBLIC, "use indexes and cached results to run find programs"},
+	{"batch_file", PT_char1024, &global_batch_file, PA_PUBLIC, "sweep file of the scenarios to run in forked workers after the model is initialized"},
+	{"batch_workers", PT_int32, &global_batch_workers, PA_PUBLIC, "maximum number of batch workers running at once (0 for processor count)"},
 	{"mainloop_state", PT_enumeration, &global_mainloopstate, PA_PUBLIC, "main sync loop state flag", mls_keys},
 	{"pauseat", PT_timestamp, &global_mainlooppauseat, PA_PUBLIC, "pause at time"},
 	{"infourl", PT_char1024, &global_infourl, PA_PUBLIC, "URL to use for obtaining online help"},
@@ -98,11 +98,17 @@ GLOBAL char global_workdir[1024] INIT("."); /**< The current working directory *
 GLOBAL char global_dumpfile[1024] INIT("gridlabd.xml"); /**< The dump file name */
 GLOBAL char global_savefile[1024] INIT(""); /**< The save file name */
 GLOBAL int global_lock_enabled INIT(true); /**Disable locks*/
+GLOBAL bool global_lock_stats INIT(false); /**< Flags the collection of per-lock contention statistics */
+GLOBAL int32 global_lock_stats_top INIT(10); /**< number of most contended locks reported */
+GLOBAL int32 global_lock_spin_limit INIT(100); /**< number of lock attempts before a waiting thread yields */
 GLOBAL int global_dumpall INIT(false);	/**< Flags all modules to dump data after run complete */
 GLOBAL int global_runchecks INIT(false); /**< Flags module check code to be called after initialization */
 /** @todo Set the threadcount to zero to automatically use the maximum system resources (tickets 180) */
 GLOBAL int global_threadcount INIT(1); /**< the maximum thread limit, zero means automagically determine best thread count */
 GLOBAL int global_profiler INIT(0); /**< Flags the profiler to process class performance data */
+GLOBAL char1024 global_profile_trace INIT(""); /**< Chrome trace event file written by the profiler (none if empty) */
+GLOBAL char1024 global_profile_folded INIT(""); /**< folded stack (flamegraph) file written by the profiler (none if empty) */
+GLOBAL int32 global_profile_trace_limit INIT(1000000); /**< maximum number of trace events recorded per thread */
 GLOBAL int global_pauseatexit INIT(0); /**< Enable a pause for user input after exit */
 GLOBAL char global_testoutputfile[1024] INIT("test.txt"); /**< Specifies the test output file */
 GLOBAL int global_xml_encoding INIT(8);  /**< Specifies XML encoding (default is 8) */
@@ -182,6 +188,9 @@ GLOBAL char global_platform[8] /**< the host operating platform */
 #endif
 
 GLOBAL int global_suppress_repeat_messages INIT(1); /**< flag that allows repeated messages to be suppressed */
+GLOBAL bool global_output_async INIT(false); /**< write messages from a separate thread */
+GLOBAL bool global_output_json INIT(false); /**< write messages as JSON lines */
+GLOBAL int32 global_output_repeat_limit INIT(0); /**< maximum number of messages of each type using the same format (0 for no limit) */
 GLOBAL int global_suppress_deprecated_messages INIT(0); /**< flag to suppress output notice of deprecated properties usage */
 
 GLOBAL int global_run_realtime INIT(0); /**< flag to force simulator into realtime mode */
@@ -234,9 +243,15 @@ GLOBAL int global_check_version INIT(0); /**< check version flag */
 typedef enum {
 	RNG2=2, /**< random numbers generated using pre-V3 method */
 	RNG3=3, /**< random numbers generated using post-V2 method */
+	RNG4=4, /**< random numbers generated using counter-based streams */
 } RANDOMNUMBERGENERATOR; /**< identifies the type of random number generator used */
 GLOBAL int global_randomnumbergenerator INIT(RNG3); /**< select which random number generator to use */
 
+GLOBAL bool global_transform_events INIT(true); /**< update schedule transforms only when the schedule value changes */
+GLOBAL bool global_find_index INIT(true); /**< use indexes and cached results to run find programs */
+GLOBAL char1024 global_batch_file INIT(""); /**< sweep file of the scenarios to run in forked workers after the model is initialized */
+GLOBAL int32 global_batch_workers INIT(0); /**< maximum number of batch workers running at once (0 for processor count) */
+
 typedef enum {
 	MLS_INIT, /**< main loop initializing */
 	MLS_RUNNING, /**< main loop is running */
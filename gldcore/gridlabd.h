@@ -773,6 +773,10 @@ inline bool *gl_get_bool(OBJECT *obj, /**< object to set dependency */
 #define gl_findlist_add (*callback->find.add)
 #define gl_findlist_del (*callback->find.del)
 #define gl_findlist_clear (*callback->find.clear)
+/** Invalidate the find indexes after writing an object's name, parent or groupid directly
+	@see find_index_invalidate()
+ **/
+#define gl_find_invalidate (*callback->find.invalidate)
 /** Release memory used by a find list
 	@see free()
  **/
@@ -856,6 +860,10 @@ inline bool *gl_get_bool(OBJECT *obj, /**< object to set dependency */
 #define gl_random_beta (*callback->random.beta)
 #define gl_random_weibull (*callback->random.weibull)
 #define gl_random_rayleigh (*callback->random.rayleigh)
+/** Generate a batch of random numbers of a distribution
+	@see random_values()
+ **/
+#define gl_random_values (*callback->random.values)
 /** @} **/
 
 /******************************************************************************
@@ -1333,6 +1341,7 @@ static unsigned long _nan[] = { 0xffffffff, 0x7fffffff, };
  **************************************************************************************/
 #include <ctype.h>
 #include <stdio.h>
+#include <vector>
 
 #include "module.h"
 #include "class.h"
@@ -2242,6 +2251,143 @@ private: // exceptions
 	};
 };
 
+/// Property bundle operations
+typedef enum {
+	PBO_GET=0, ///< copy the property into the local variable (pull)
+	PBO_SET=1, ///< copy the local variable into the property (push)
+	PBO_ADD=2, ///< add the local variable to the property (push, double and complex only)
+} PROPERTYBUNDLEOP;
+
+/// Property bundle container
+/** A bundle binds properties of other objects to local variables.  The
+	bindings are resolved to raw addresses when they are added (usually at
+	init), and pull() or push() then copy the whole bundle in or out taking
+	each target object's lock only once, instead of once per value as
+	gld_property::getp/setp do.  pull_unlocked() and push_unlocked() leave the
+	locking to the caller, e.g., for children that are called by their parent
+	while the parent is locked (PC_AUTOLOCK).
+ **/
+class gld_bundle {
+
+private: // data
+	typedef struct s_binding {
+		void *addr; ///< address of the property
+		void *local; ///< address of the local variable
+		PROPERTYTYPE type; ///< property type
+		size_t size; ///< property size
+		PROPERTYBUNDLEOP op; ///< operation
+	} BINDING;
+	typedef struct s_target {
+		OBJECT *obj; ///< object locked
+		std::vector<BINDING> bindings; ///< bindings to the object's properties
+		unsigned int pulls, pushes; ///< number of bindings of each direction
+	} TARGET;
+	std::vector<TARGET> targets;
+
+public: // constructors
+	inline gld_bundle(void) {};
+
+public: // bindings
+	/// Bind a property to a local variable of the same type
+	inline void add(gld_property *prop, void *local, PROPERTYBUNDLEOP op=PBO_GET)
+	{
+		if ( prop==NULL || !prop->is_valid() || prop->get_object()==NULL || prop->has_part() )
+			throw "gld_bundle::add(): property is not a valid object property";
+		if ( op==PBO_ADD && !prop->is_complex() && !prop->is_double() )
+			exception(prop,"only double and complex properties can be accumulated");
+		OBJECT *obj = prop->get_object();
+		std::vector<TARGET>::iterator target;
+		for ( target=targets.begin() ; target!=targets.end() && target->obj!=obj ; target++ ) {}
+		if ( target==targets.end() )
+		{
+			TARGET item;
+			item.obj = obj;
+			item.pulls = item.pushes = 0;
+			target = targets.insert(targets.end(),item);
+		}
+		BINDING binding = {prop->get_addr(), local, prop->get_property()->ptype, prop->get_size(), op};
+		target->bindings.push_back(binding);
+		if ( op==PBO_GET ) target->pulls++; else target->pushes++;
+	};
+	/// Remove all the bindings
+	inline void clear(void) { targets.clear(); };
+	inline bool is_empty(void) { return targets.empty(); };
+
+public: // transfers
+	/// Copy all the PBO_GET bindings into their local variables, read locking each object once
+	inline void pull(void)
+	{
+		for ( std::vector<TARGET>::iterator target=targets.begin() ; target!=targets.end() ; target++ )
+		{
+			if ( target->pulls==0 ) continue;
+			gld_core::rlock(&target->obj->lock);
+			pull(*target);
+			gld_core::runlock(&target->obj->lock);
+		}
+	};
+	/// Copy all the PBO_GET bindings into their local variables, the caller handles the locks
+	inline void pull_unlocked(void)
+	{
+		for ( std::vector<TARGET>::iterator target=targets.begin() ; target!=targets.end() ; target++ )
+			pull(*target);
+	};
+	/// Copy or add all the PBO_SET and PBO_ADD bindings into their properties, write locking each object once
+	inline void push(void)
+	{
+		for ( std::vector<TARGET>::iterator target=targets.begin() ; target!=targets.end() ; target++ )
+		{
+			if ( target->pushes==0 ) continue;
+			gld_core::wlock(&target->obj->lock);
+			push(*target);
+			gld_core::wunlock(&target->obj->lock);
+		}
+	};
+	/// Copy or add all the PBO_SET and PBO_ADD bindings into their properties, the caller handles the locks
+	inline void push_unlocked(void)
+	{
+		for ( std::vector<TARGET>::iterator target=targets.begin() ; target!=targets.end() ; target++ )
+			push(*target);
+	};
+
+private: // helpers
+	inline static void pull(TARGET &target)
+	{
+		for ( std::vector<BINDING>::iterator binding=target.bindings.begin() ; binding!=target.bindings.end() ; binding++ )
+		{
+			if ( binding->op==PBO_GET ) copy(binding->local,binding->addr,binding->type,binding->size);
+		}
+	};
+	inline static void push(TARGET &target)
+	{
+		for ( std::vector<BINDING>::iterator binding=target.bindings.begin() ; binding!=target.bindings.end() ; binding++ )
+		{
+			switch ( binding->op ) {
+			case PBO_SET: copy(binding->addr,binding->local,binding->type,binding->size); break;
+			case PBO_ADD:
+				if ( binding->type==PT_complex ) *(gld::complex*)binding->addr += *(gld::complex*)binding->local;
+				else *(double*)binding->addr += *(double*)binding->local;
+				break;
+			default: break;
+			}
+		}
+	};
+	inline static void copy(void *to, void *from, PROPERTYTYPE type, size_t size)
+	{
+		switch ( type ) {
+		case PT_complex: *(gld::complex*)to = *(gld::complex*)from; break;
+		case PT_double: *(double*)to = *(double*)from; break;
+		case PT_enumeration: *(enumeration*)to = *(enumeration*)from; break;
+		default: memcpy(to,from,size); break;
+		}
+	};
+	inline static void exception(gld_property *prop, const char *msg)
+	{
+		static char buf[1024];
+		snprintf(buf,sizeof(buf),"gld_bundle::add(%s.%s): %s",OBJECTDATA(prop->get_object(),gld_object)->get_name(),prop->get_name(),msg);
+		throw (const char*)buf;
+	};
+};
+
 /// Global variable container
 class gld_global {
 
@@ -8,6 +8,8 @@
 #else
 #include <unistd.h>
 #include <dirent.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
 #endif
 
 #include <cerrno>
@@ -15,6 +17,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 #include <sys/stat.h>
 
 #include "globals.h"
@@ -23,6 +27,8 @@
 #include "exec.h"
 #include "lock.h"
 #include "threadpool.h"
+#include "object.h"
+#include "job.h"
 
 
 static bool clean = false; // set to true to force purge of test directories
@@ -391,3 +397,279 @@ extern "C" int job(int argc, char *argv[])
 
 	exit(final_result==0 ? XC_SUCCESS : XC_TSTERR);
 }
+
+/* scenario of a batch sweep file */
+typedef struct s_batchscenario {
+	std::string name; ///< scenario name (also the name of its output directory)
+	std::vector< std::pair<std::string,std::string> > assignments; ///< globals or object properties set by the scenario
+#ifndef _WIN32
+	pid_t pid; ///< worker process
+#endif
+	int64 started; ///< exec clock when the worker started
+	double elapsed; ///< wall time of the worker (s)
+	double peak_rss; ///< peak resident set size of the worker (MB)
+	int code; ///< exit code of the worker
+} BATCHSCENARIO;
+
+static void batch_trim(std::string &text)
+{
+	size_t start = text.find_first_not_of(" \t\r\n");
+	size_t end = text.find_last_not_of(" \t\r\n");
+	text = ( start==std::string::npos ) ? "" : text.substr(start,end-start+1);
+	if ( text.size()>=2 && (text[0]=='"' || text[0]=='\'') && text[text.size()-1]==text[0] )
+		text = text.substr(1,text.size()-2);
+}
+
+/** load the scenarios of a sweep file
+
+	A sweep file lists the scenarios in blocks that start with the scenario
+	name in brackets, followed by the assignments the scenario makes, e.g.,
+	\verbatim
+	# comment
+	[hot]
+	stoptime='2001-01-08 00:00:00'
+	house_1.cooling_setpoint=72
+	\endverbatim
+	Names that are not global variables are taken to be \p object.property.
+
+	The assignments are made in the workers, after the model is initialized.
+	Values that are only used while objects are initialized (e.g., values
+	used to size equipment or to build the powerflow solver) keep the value
+	of the loaded model, so scenarios that change them must be run
+	separately rather than as a batch.
+ **/
+static bool batch_load(const char *filename, std::vector<BATCHSCENARIO> &list)
+{
+	FILE *fp = fopen(filename,"r");
+	if ( fp==nullptr )
+	{
+		output_error("batch_load(filename='%s'): %s", filename, strerror(errno));
+		/* TROUBLESHOOT
+			The batch sweep file could not be opened.  Check the name of the file and its permissions and try again.
+		 */
+		return false;
+	}
+	char line[1024];
+	int linenum = 0;
+	while ( fgets(line,sizeof(line),fp)!=nullptr )
+	{
+		std::string text = line;
+		linenum++;
+		batch_trim(text);
+		if ( text.empty() || text[0]=='#' )
+			continue;
+		if ( text[0]=='[' && text[text.size()-1]==']' )
+		{
+			BATCHSCENARIO scenario;
+			scenario.name = text.substr(1,text.size()-2);
+			batch_trim(scenario.name);
+			if ( scenario.name.empty() || scenario.name.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_-.")!=std::string::npos || scenario.name[0]=='.' )
+			{
+				output_error("%s(%d): scenario name '%s' is not valid", filename, linenum, scenario.name.c_str());
+				/* TROUBLESHOOT
+					The scenario name is used to name the output directory of the scenario, so it can only use letters, digits, and
+					the characters '_', '-' and '.' (but not at the start).  Change the scenario name and try again.
+				 */
+				fclose(fp);
+				return false;
+			}
+			scenario.started = 0;
+			scenario.elapsed = 0;
+			scenario.peak_rss = 0;
+			scenario.code = XC_EXFAILED;
+			list.push_back(scenario);
+			continue;
+		}
+		size_t eq = text.find('=');
+		if ( eq==std::string::npos || list.empty() )
+		{
+			output_error("%s(%d): '%s' is not a valid %s", filename, linenum, text.c_str(), list.empty() ? "scenario name" : "assignment");
+			/* TROUBLESHOOT
+				Each scenario of a sweep file starts with its name in brackets, and is followed by assignments of the form
+				<i>name</i>=<i>value</i>.  Correct the sweep file and try again.
+			 */
+			fclose(fp);
+			return false;
+		}
+		std::string name = text.substr(0,eq), value = text.substr(eq+1);
+		batch_trim(name);
+		batch_trim(value);
+		list.back().assignments.push_back(std::make_pair(name,value));
+	}
+	fclose(fp);
+	if ( list.empty() )
+	{
+		output_error("batch_load(filename='%s'): no scenarios found", filename);
+		/* TROUBLESHOOT
+			The batch sweep file does not define any scenario.  Add at least one scenario name in brackets and try again.
+		 */
+		return false;
+	}
+	return true;
+}
+
+#ifndef _WIN32
+/* prepare a worker to run its scenario */
+static bool batch_worker(BATCHSCENARIO &scenario)
+{
+	char cwd[1024];
+	if ( getcwd(cwd,sizeof(cwd))==nullptr || chdir(scenario.name.c_str())!=0 )
+	{
+		output_error("batch scenario '%s': unable to enter output directory (%s)", scenario.name.c_str(), strerror(errno));
+		return false;
+	}
+
+	/* files named relative to the model are still found through the GLPATH */
+	global_gl_path = std::string(cwd) + env_delim + global_gl_path;
+	if ( getcwd(global_workdir,sizeof(global_workdir))==nullptr )
+		strcpy(global_workdir,".");
+	if ( freopen("gridlabd.out","w",stdout)==nullptr || freopen("gridlabd.err","w",stderr)==nullptr )
+		return false;
+
+	for ( size_t n=0 ; n<scenario.assignments.size() ; n++ )
+	{
+		const char *name = scenario.assignments[n].first.c_str();
+		char value[1024];
+		strncpy(value,scenario.assignments[n].second.c_str(),sizeof(value)-1);
+		value[sizeof(value)-1] = '\0';
+		if ( global_find(name)!=nullptr )
+		{
+			if ( global_setvar(name,value)!=SUCCESS )
+			{
+				output_error("batch scenario '%s': unable to set global '%s' to '%s'", scenario.name.c_str(), name, value);
+				return false;
+			}
+			continue;
+		}
+		std::string objname = scenario.assignments[n].first;
+		size_t dot = objname.find('.');
+		OBJECT *obj = ( dot==std::string::npos ) ? nullptr : object_find_name(objname.substr(0,dot).c_str());
+		if ( obj==nullptr || object_set_value_by_name(obj,(char*)objname.substr(dot+1).c_str(),value)<=0 )
+		{
+			output_error("batch scenario '%s': unable to set '%s' to '%s'", scenario.name.c_str(), name, value);
+			/* TROUBLESHOOT
+				A scenario assignment must name a global variable or an object property using <i>object</i>.<i>property</i>.
+				Check that the global, object or property exists and that the value is valid for it.
+			 */
+			return false;
+		}
+	}
+	output_verbose("batch scenario '%s' running in '%s'", scenario.name.c_str(), global_workdir);
+	return true;
+}
+#endif
+
+/** Run the scenarios of the batch sweep file in forked workers
+
+	The model is loaded and initialized once, then each scenario runs in a
+	worker forked from the initialized model, so the workers share the pages
+	of the model they do not change.  Each worker runs in its own output
+	directory, named after the scenario, where its console output is also
+	written.  No more than \p batch_workers workers run at once.  A summary
+	of the wall time and peak memory use of each worker is output when all
+	the scenarios are done.
+
+	@return -1 in the workers (which go on to run their scenario), otherwise the exit code of the batch
+ **/
+extern "C" int job_batch(void)
+{
+#ifdef _WIN32
+	output_error("batch runs are not supported on this platform");
+	return XC_ENVERR;
+#else
+	std::vector<BATCHSCENARIO> list;
+	if ( !batch_load(global_batch_file,list) )
+		return XC_ARGERR;
+	for ( size_t n=0 ; n<list.size() ; n++ )
+	{
+		if ( mkdir(list[n].name.c_str(),0755)!=0 && errno!=EEXIST )
+		{
+			output_error("batch scenario '%s': unable to create output directory (%s)", list[n].name.c_str(), strerror(errno));
+			return XC_IOERR;
+		}
+	}
+	unsigned int workers = global_batch_workers>0 ? (unsigned int)global_batch_workers : (unsigned int)processor_count();
+	output_message("running %d scenario(s) of '%s' using up to %d worker(s)", (int)list.size(), global_batch_file.get_string(), workers);
+
+	/* workers must not inherit pending output or the output thread */
+	output_flush();
+	output_stop();
+	fflush(nullptr);
+
+	size_t next = 0;
+	unsigned int running = 0;
+	while ( next<list.size() || running>0 )
+	{
+		while ( running<workers && next<list.size() )
+		{
+			BATCHSCENARIO &scenario = list[next++];
+			scenario.started = exec_clock();
+			scenario.pid = fork();
+			if ( scenario.pid==0 )
+			{
+				if ( batch_worker(scenario) )
+					return -1;
+				fflush(nullptr);
+				_exit(XC_INIERR);
+			}
+			else if ( scenario.pid<0 )
+			{
+				output_error("batch scenario '%s': unable to start worker (%s)", scenario.name.c_str(), strerror(errno));
+				scenario.code = XC_PRCERR;
+			}
+			else
+			{
+				output_verbose("batch scenario '%s' started in worker %d", scenario.name.c_str(), (int)scenario.pid);
+				running++;
+			}
+		}
+		if ( running==0 )
+			continue;
+
+		int status;
+		struct rusage usage;
+		pid_t pid = wait4(-1,&status,0,&usage);
+		if ( pid<0 )
+		{
+			if ( errno==EINTR )
+				continue;
+			output_error("batch wait failed (%s)", strerror(errno));
+			return XC_PRCERR;
+		}
+		for ( size_t n=0 ; n<next ; n++ )
+		{
+			BATCHSCENARIO &scenario = list[n];
+			if ( scenario.pid!=pid )
+				continue;
+			scenario.elapsed = (double)(exec_clock()-scenario.started)/(double)global_ms_per_second;
+#ifdef __APPLE__
+			scenario.peak_rss = (double)usage.ru_maxrss/1048576.0; /* bytes */
+#else
+			scenario.peak_rss = (double)usage.ru_maxrss/1024.0; /* kB */
+#endif
+			scenario.code = WIFEXITED(status) ? WEXITSTATUS(status) : (XC_SIGNAL|WTERMSIG(status));
+			output_verbose("batch scenario '%s' done with exit code %d", scenario.name.c_str(), scenario.code);
+			running--;
+			break;
+		}
+	}
+
+	/* summary (the rows share one format, so they must not be collapsed) */
+	int failed = 0;
+	global_suppress_repeat_messages = 0;
+	output_message("%-24s %6s %10s %14s", "scenario", "code", "wall (s)", "peak RSS (MB)");
+	for ( size_t n=0 ; n<list.size() ; n++ )
+	{
+		BATCHSCENARIO &scenario = list[n];
+		output_message("%-24s %6d %10.1f %14.1f", scenario.name.c_str(), scenario.code, scenario.elapsed, scenario.peak_rss);
+		if ( scenario.code!=XC_SUCCESS )
+			failed++;
+	}
+	if ( failed>0 )
+	{
+		output_error("%d of %d batch scenario(s) failed", failed, (int)list.size());
+		return XC_RUNERR;
+	}
+	return XC_SUCCESS;
+#endif
+}
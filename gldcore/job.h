@@ -21,6 +21,7 @@ extern "C" {
 #endif
 
 int job(int argc, char *argv[]);
+int job_batch(void);
 
 #ifdef __cplusplus
 }
@@ -186,6 +186,7 @@ typedef struct stat STAT;
 #include "transform.h"
 #include "instance.h"
 #include "linkage.h"
+#include "find.h"
 #include "gui.h"
 
 static unsigned int linenum=1;
@@ -1104,6 +1105,7 @@ static int resolve_object(UNRESOLVED *item, char *filename)
 		return FAILED;
 	}
 	*(OBJECT**)(item->ref) = obj;
+	find_index_invalidate(); /* the reference may be an object's parent */
 	if ((item->flags&UR_RANKS)==UR_RANKS)
 		object_set_rank(obj,item->by->rank);
 	return SUCCESS;
@@ -4271,7 +4273,10 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 				{
 					/* check for special properties */
 					if (strcmp(propname,"root")==0)
+					{
 						obj->parent = nullptr;
+						find_index_invalidate();
+					}
 					else if (strcmp(propname,"parent")==0)
 					{
 						if (add_unresolved(obj,PT_object,(void*)&obj->parent,oclass,propval,filename,linenum,UR_RANKS)==nullptr)
@@ -4344,6 +4349,7 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 					}
 					else if (strcmp(propname,"groupid")==0){
 						strncpy(obj->groupid, propval, sizeof(obj->groupid));
+						find_index_invalidate();
 					}
 					else if (strcmp(propname,"flags")==0)
 					{
@@ -21,6 +21,7 @@
 #include <xercesc/sax2/Attributes.hpp>
 
 #include "load_xml_handle.h"
+#include "find.h"
 
 #define _CRT_SECURE_NO_DEPRECATE 1
 
@@ -190,6 +191,7 @@ char *gld_loadHndl::read_object_prop(char *buffer, size_t len){
 		if (strcmp(propname, "parent")==0){
 			if (strcmp(propname, "root")==0){
 				obj->parent = nullptr;
+				find_index_invalidate();
 			} else {
 				add_unresolved(obj,PT_object,(void*)&obj->parent,oclass,buffer,"XML",42,UR_RANKS); 
 			}
@@ -734,7 +734,7 @@ int loadshape_init(loadshape *ls) /**< load shape */
 	}
 	
 	/* initialize the random number generator state */
-	ls->rng_state = randwarn(nullptr);
+	ls->rng_state = random_newstate(RS_LOADSHAPE,RS_NEXTID);
 
 	/* establish the initial parameters */
 	loadshape_recalc(ls);
@@ -8,6 +8,15 @@
 	Any time more than one object can concurrently write to the same
 	region of memory, it is necessary to implement locking to prevent
 	one object from overwriting the changes made by another.  
+
+	A lock that is not obtained on the first attempt is retried with a
+	processor pause for up to \p lock_spin_limit attempts, after which the
+	thread yields its processor between attempts so that the thread holding
+	the lock can run.
+
+	When \p lock_stats is set, each thread counts the acquisitions, spins
+	and wait time of every lock it takes, and lock_report() lists the most
+	contended locks (by object or registered name) in the profile output.
  @{	  
  **/
 
@@ -15,8 +24,17 @@
 #include "globals.h"
 #include "exception.h"
 #include "config.h"
+#include "output.h"
+#include "object.h"
+#include "profiler.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 //#define LOCKTRACE // enable this to trace locking events back to variables
 #define MAXSPIN 1000000000
@@ -65,6 +83,18 @@
 	#error "Locking is not supported on this system"
 #endif
 
+/** Processor hint used while spinning on a lock
+ **/
+#if defined(_MSC_VER)
+	#define cpu_relax() YieldProcessor()
+#elif defined(__i386__) || defined(__x86_64__)
+	#define cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+	#define cpu_relax() __asm__ __volatile__("yield")
+#else
+	#define cpu_relax()
+#endif
+
 /** Enable lock trace 
  **/
 #ifdef LOCKTRACE // this code should only be used in care is mystery lock timeouts
@@ -134,12 +164,224 @@ void check_lock(unsigned int *lock, bool write, bool unlock)
 }
 #else
 #define check_lock(X,Y,Z)
-void register_lock(unsigned int *lock)
+#endif
+
+/**********************************************************************************
+ * LOCK STATISTICS
+ **********************************************************************************/
+
+/// contention statistics of a single lock
+typedef struct s_lockstats {
+	int64 reads; ///< number of read locks taken
+	int64 writes; ///< number of write locks taken
+	int64 contended; ///< number of locks not obtained on the first attempt
+	int64 spins; ///< number of attempts made
+	int64 wait; ///< time spent waiting for contended locks (ns)
+} LOCKSTATS;
+
+/// lock statistics of a single thread
+typedef struct s_lockthread {
+	int64 rlock_count, rlock_spin; ///< read lock totals (for the profiler)
+	int64 wlock_count, wlock_spin; ///< write lock totals (for the profiler)
+	std::unordered_map<unsigned int*,LOCKSTATS> locks;
+} LOCKTHREAD;
+
+static std::mutex lockstats_lock;
+static std::vector<LOCKTHREAD*> lockstats_threads;
+static std::map<unsigned int*,LOCKSTATS> lockstats;
+static std::map<unsigned int*,const char*> lock_names;
+static thread_local LOCKTHREAD *lockstats_local = nullptr;
+
+#ifndef LOCKTRACE
+/** Register the name of a lock for the lock statistics report
+ **/
+void register_lock(const char *name, unsigned int *lock)
 {
-	// do nothing
+	std::lock_guard<std::mutex> guard(lockstats_lock);
+	lock_names[lock] = name;
 }
 #endif
 
+static LOCKTHREAD *lockstats_thread(void)
+{
+	if ( lockstats_local==nullptr )
+	{
+		LOCKTHREAD *data = new LOCKTHREAD;
+		data->rlock_count = data->rlock_spin = 0;
+		data->wlock_count = data->wlock_spin = 0;
+		std::lock_guard<std::mutex> guard(lockstats_lock);
+		lockstats_threads.push_back(data);
+		lockstats_local = data;
+	}
+	return lockstats_local;
+}
+
+/** Record a lock acquisition in the calling thread's statistics
+ **/
+static void lockstats_record(unsigned int *lock, bool write, unsigned int spins, int64 wait)
+{
+	LOCKTHREAD *data = lockstats_thread();
+	if ( write )
+	{
+		data->wlock_count++;
+		data->wlock_spin += spins;
+	}
+	else
+	{
+		data->rlock_count++;
+		data->rlock_spin += spins;
+	}
+	if ( global_lock_stats )
+	{
+		LOCKSTATS &stats = data->locks[lock]; // value-initialized when new
+		if ( write )
+			stats.writes++;
+		else
+			stats.reads++;
+		if ( spins>1 )
+		{
+			stats.contended++;
+			stats.wait += wait;
+		}
+		stats.spins += spins;
+	}
+}
+
+/** Acquire a lock, spinning and then yielding until it is obtained
+ **/
+static inline void lock_acquire(unsigned int *lock, bool write)
+{
+	bool record = global_profiler || global_lock_stats;
+	unsigned int value = (*lock);
+	if ( !(value&1) && atomic_compare_and_swap(lock, value, value + 1) )
+	{
+		if ( record )
+			lockstats_record(lock,write,1,0);
+		return;
+	}
+
+	// contended lock
+	int64 start = global_lock_stats ? profile_clock() : 0;
+	unsigned int spins = 1;
+	unsigned int timeout = MAXSPIN;
+	do {
+		if ( spins<(unsigned int)global_lock_spin_limit )
+			cpu_relax();
+		else
+			std::this_thread::yield();
+		spins++;
+		if ( timeout--==0 )
+			throw_exception(write ? "write lock timeout" : "read lock timeout");
+		value = (*lock);
+	} while ((value&1) || !atomic_compare_and_swap(lock, value, value + 1));
+	if ( record )
+		lockstats_record(lock,write,spins,start>0?profile_clock()-start:0);
+}
+
+/** Merge the thread lock statistics.
+	This must only be called while no other thread is taking locks.
+ **/
+void lock_merge(void)
+{
+	extern int64 rlock_count, rlock_spin, wlock_count, wlock_spin;
+	std::lock_guard<std::mutex> guard(lockstats_lock);
+	for ( std::vector<LOCKTHREAD*>::iterator thread=lockstats_threads.begin() ; thread!=lockstats_threads.end() ; thread++ )
+	{
+		LOCKTHREAD *data = *thread;
+		rlock_count += data->rlock_count;
+		rlock_spin += data->rlock_spin;
+		wlock_count += data->wlock_count;
+		wlock_spin += data->wlock_spin;
+		data->rlock_count = data->rlock_spin = 0;
+		data->wlock_count = data->wlock_spin = 0;
+		for ( std::unordered_map<unsigned int*,LOCKSTATS>::iterator item=data->locks.begin() ; item!=data->locks.end() ; item++ )
+		{
+			LOCKSTATS &stats = lockstats[item->first];
+			stats.reads += item->second.reads;
+			stats.writes += item->second.writes;
+			stats.contended += item->second.contended;
+			stats.spins += item->second.spins;
+			stats.wait += item->second.wait;
+		}
+		data->locks.clear();
+	}
+}
+
+static bool lockstats_compare(const std::pair<unsigned int*,LOCKSTATS> &a, const std::pair<unsigned int*,LOCKSTATS> &b)
+{
+	if ( a.second.wait!=b.second.wait )
+		return a.second.wait > b.second.wait;
+	return a.second.contended > b.second.contended;
+}
+
+/** Report the most contended locks in the profile output
+ **/
+void lock_report(void)
+{
+	if ( !global_lock_stats )
+		return;
+	lock_merge();
+
+	int64 reads = 0, writes = 0, contended = 0, spins = 0, wait = 0;
+	std::vector<std::pair<unsigned int*,LOCKSTATS> > locks;
+	for ( std::map<unsigned int*,LOCKSTATS>::iterator item=lockstats.begin() ; item!=lockstats.end() ; item++ )
+	{
+		reads += item->second.reads;
+		writes += item->second.writes;
+		contended += item->second.contended;
+		spins += item->second.spins;
+		wait += item->second.wait;
+		if ( item->second.contended>0 )
+			locks.push_back(*item);
+	}
+	std::sort(locks.begin(),locks.end(),lockstats_compare);
+	if ( global_lock_stats_top>=0 && locks.size()>(size_t)global_lock_stats_top )
+		locks.resize(global_lock_stats_top);
+
+	// name the object locks that are reported
+	std::map<unsigned int*,OBJECT*> objects;
+	for ( std::vector<std::pair<unsigned int*,LOCKSTATS> >::iterator item=locks.begin() ; item!=locks.end() ; item++ )
+		objects[item->first] = nullptr;
+	for ( OBJECT *obj=object_get_first() ; obj!=nullptr && !objects.empty() ; obj=obj->next )
+	{
+		std::map<unsigned int*,OBJECT*>::iterator item = objects.find(&obj->lock);
+		if ( item!=objects.end() )
+			item->second = obj;
+	}
+
+	output_profile("\nLock statistics");
+	output_profile("===============\n");
+	output_profile("Locks used              %8d locks", (int)lockstats.size());
+	output_profile("Read locks taken        %8" FMT_INT64 "d locks", reads);
+	output_profile("Write locks taken       %8" FMT_INT64 "d locks", writes);
+	output_profile("Contended locks         %8" FMT_INT64 "d locks (%.1f%%)", contended, reads+writes>0 ? (double)contended/(double)(reads+writes)*100 : 0.0);
+	output_profile("Spins per contention    %8.1f spins", contended>0 ? (double)(spins-(reads+writes-contended))/(double)contended : 0.0);
+	output_profile("Lock wait time          %8.3f seconds", (double)wait/1e9);
+	if ( locks.empty() )
+	{
+		output_profile("");
+		return;
+	}
+	output_profile("\nLock                             Reads     Writes  Contended      Spins    Wait (ms)");
+	output_profile("------------------------- ---------- ---------- ---------- ---------- ------------");
+	for ( std::vector<std::pair<unsigned int*,LOCKSTATS> >::iterator item=locks.begin() ; item!=locks.end() ; item++ )
+	{
+		char name[1024];
+		OBJECT *obj = objects[item->first];
+		std::map<unsigned int*,const char*>::iterator named = lock_names.find(item->first);
+		if ( obj!=nullptr )
+			object_name(obj,name,sizeof(name));
+		else if ( named!=lock_names.end() )
+			snprintf(name,sizeof(name),"%s",named->second);
+		else
+			snprintf(name,sizeof(name),"%p",(void*)item->first);
+		LOCKSTATS &stats = item->second;
+		output_profile("%-25.25s %10" FMT_INT64 "d %10" FMT_INT64 "d %10" FMT_INT64 "d %10" FMT_INT64 "d %12.3f",
+			name, stats.reads, stats.writes, stats.contended, stats.spins, (double)stats.wait/1e6);
+	}
+	output_profile("");
+}
+
 #if defined METHOD0 
 /**********************************************************************************
  * SINGLE LOCK METHOD
@@ -157,17 +399,8 @@ void register_lock(unsigned int *lock)
 extern "C" void rlock(unsigned int *lock)
 {
 	if(global_lock_enabled){
-		unsigned int timeout = MAXSPIN;
-		unsigned int value;
-		extern unsigned int rlock_count, rlock_spin;
 		check_lock(lock,false,false);
-		atomic_increment(&rlock_count);
-		do {
-			value = (*lock);
-			atomic_increment(&rlock_spin);
-			if ( timeout--==0 )
-				throw_exception("read lock timeout");
-		} while ((value&1) || !atomic_compare_and_swap(lock, value, value + 1));
+		lock_acquire(lock,false);
 	}
 }
 /** Write lock 
@@ -175,17 +408,8 @@ extern "C" void rlock(unsigned int *lock)
 extern "C" void wlock(unsigned int *lock)
 {
 	if(global_lock_enabled){
-		unsigned int timeout = MAXSPIN;
-		unsigned int value;
-		extern unsigned int wlock_count, wlock_spin;
 		check_lock(lock,true,false);
-		atomic_increment(&wlock_count);
-		do {
-			value = (*lock);
-			atomic_increment(&wlock_spin);
-			if ( timeout--==0 )
-				throw_exception("write lock timeout");
-		} while ((value&1) || !atomic_compare_and_swap(lock, value, value + 1));
+		lock_acquire(lock,true);
 	}
 }
 /** Read unlock
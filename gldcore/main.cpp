@@ -38,6 +38,8 @@
 #include "save.h"
 #include "local.h"
 #include "exec.h"
+#include "profiler.h"
+#include "lock.h"
 #include "kml.h"
 #include "kill.h"
 #include "threadpool.h"
@@ -280,7 +282,10 @@ int main(int argc, /**< the number entries on command-line argument list \p argv
     if (global_profiler) {
         class_profiles();
         module_profiles();
+        profile_report();
+        profile_export();
     }
+    lock_report();
 
 #ifdef DUMP_SCHEDULES
     /* dump a copy of the schedules for reference */
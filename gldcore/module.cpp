@@ -219,6 +219,7 @@ s_callbacks::s_callbacks() throw() {
     find.add = findlist_add;
     find.del = findlist_del;
     find.clear = findlist_clear;
+    find.invalidate = find_index_invalidate;
     find_property = class_find_property;
     malloc = module_malloc;
     free = module_free;
@@ -243,6 +244,7 @@ s_callbacks::s_callbacks() throw() {
     random.gamma = random_gamma;
     random.weibull = random_weibull;
     random.rayleigh = random_rayleigh;
+    random.values = random_values;
     object_isa = ::object_isa;
     register_type = class_register_type;
     define_type = class_define_type;
@@ -41,6 +41,8 @@
 #include "lock.h"
 #include "threadpool.h"
 #include "exec.h"
+#include "profiler.h"
+#include "find.h"
 
 using std::isnan;
 
@@ -344,7 +346,7 @@ OBJECT *object_create_single(CLASS *oclass){ /**< the class of the object */
 	obj->out_svc_double = (double)obj->out_svc;
 	obj->space = object_current_namespace();
 	obj->flags = OF_NONE;
-	obj->rng_state = randwarn(nullptr);
+	obj->rng_state = random_newstate(RS_OBJECT,obj->id);
 	obj->heartbeat = 0;
 
 	for ( prop=obj->oclass->pmap; prop!=nullptr; prop=(prop->next?prop->next:(prop->oclass->parent?prop->oclass->parent->pmap:nullptr)))
@@ -358,6 +360,7 @@ OBJECT *object_create_single(CLASS *oclass){ /**< the class of the object */
 
 	last_object = obj;
 	oclass->profiler.numobjs++;
+	find_index_invalidate();
 
 	return obj;
 }
@@ -422,6 +425,7 @@ OBJECT *object_create_foreign(OBJECT *obj) /**< a pointer to the OBJECT data str
 
 	last_object = obj;
 	obj->oclass->profiler.numobjs++;
+	find_index_invalidate();
 
 	return obj;
 }
@@ -488,6 +492,7 @@ OBJECT *object_remove_by_id(OBJECTNUM id){
 		free(target);
 		target = nullptr;
 		deleted_object_count++;
+		find_index_invalidate();
 	}
 
 	return next;
@@ -1342,6 +1347,7 @@ int object_set_parent(OBJECT *obj, /**< the object to set */
 	}
 	obj->parent = parent;
 	obj->child_count++;
+	find_index_invalidate();
 	if(parent!=nullptr)
 		return set_rank(parent,obj->rank,nullptr);
 	return obj->rank;
@@ -1401,19 +1407,6 @@ char *object_property_to_string(OBJECT *obj, const char *name, char *buffer, int
 		return const_cast<char*>("");
 }
 
-void object_profile(OBJECT *obj, OBJECTPROFILEITEM pass, clock_t t)
-{
-	if ( global_profiler==1 )
-	{
-		clock_t dt = (clock_t)exec_clock()-t;
-		obj->synctime[pass] += dt;
-		wlock(&obj->oclass->profiler.lock);
-		obj->oclass->profiler.count++;
-		obj->oclass->profiler.clocks += dt;
-		wunlock(&obj->oclass->profiler.lock);
-	}
-}
-
 TIMESTAMP _object_sync(OBJECT *obj, /**< the object to synchronize */
 					  TIMESTAMP ts, /**< the desire clock to sync to */
 					  PASSCONFIG pass) /**< the pass configuration */
@@ -1502,8 +1495,9 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 					  TIMESTAMP ts, /**< the desire clock to sync to */
 					  PASSCONFIG pass) /**< the pass configuration */
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = profile_start();
 	TIMESTAMP t2=TS_NEVER;
+	output_set_object_context(obj);
 	do {
 		/* don't call sync beyond valid horizon */
 		t2 = _object_sync(obj,
@@ -1511,14 +1505,15 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 				? ts : obj->valid_to),
 				pass);
 	} while (t2 > 0 && ts > (t2 < 0 ? -t2 : t2) && t2 < TS_NEVER);
+	output_set_object_context(nullptr);
 
 	/* do profiling, if needed */
 	if ( global_profiler==1 )
 	{
 		switch (pass) {
-		case PC_PRETOPDOWN: object_profile(obj,OPI_PRESYNC,t);break;
-		case PC_BOTTOMUP: object_profile(obj,OPI_SYNC,t);break;
-		case PC_POSTTOPDOWN: object_profile(obj,OPI_POSTSYNC,t);break;
+		case PC_PRETOPDOWN: profile_object(obj,OPI_PRESYNC,t);break;
+		case PC_BOTTOMUP: profile_object(obj,OPI_SYNC,t);break;
+		case PC_POSTTOPDOWN: profile_object(obj,OPI_POSTSYNC,t);break;
 		default: break;
 		}
 	}
@@ -1534,9 +1529,11 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 
 TIMESTAMP object_heartbeat(OBJECT *obj)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = profile_start();
+	output_set_object_context(obj);
 	TIMESTAMP t1 = obj->oclass->heartbeat ? obj->oclass->heartbeat(obj) : TS_NEVER;
-	object_profile(obj,OPI_HEARTBEAT,t);
+	output_set_object_context(nullptr);
+	profile_object(obj,OPI_HEARTBEAT,t);
 		if ( global_debug_output>0 )
 		{
 			char dt[64]="(invalid)"; convert_from_timestamp(absolute_timestamp(t1),dt,sizeof(dt));
@@ -1552,12 +1549,14 @@ TIMESTAMP object_heartbeat(OBJECT *obj)
  **/
 int object_init(OBJECT *obj) /**< the object to initialize */
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = profile_start();
 	int rv = 1;
 	obj->clock = global_starttime;
+	output_set_object_context(obj);
 	if(obj->oclass->init != nullptr)
 		rv = (int)(*(obj->oclass->init))(obj, obj->parent);
-	object_profile(obj,OPI_INIT,t);
+	output_set_object_context(nullptr);
+	profile_object(obj,OPI_INIT,t);
 	if ( global_debug_output>0 )
 		output_debug("object %s:%d init -> %s", obj->oclass->name, obj->id, rv?"ok":"failed");
 	return rv;
@@ -1574,15 +1573,17 @@ int object_init(OBJECT *obj) /**< the object to initialize */
  **/
 STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = profile_start();
 	STATUS rv = SUCCESS;
 	if(obj->oclass->precommit != nullptr){
+		output_set_object_context(obj);
 		rv = (STATUS)(*(obj->oclass->precommit))(obj, t1);
+		output_set_object_context(nullptr);
 	}
 	if(rv == 1){ // if 'old school' or no precommit callback,
 		rv = SUCCESS;
 	}
-	object_profile(obj,OPI_PRECOMMIT,t);
+	profile_object(obj,OPI_PRECOMMIT,t);
 		if ( global_debug_output>0 )
 			output_debug("object %s:%d precommit -> %s", obj->oclass->name, obj->id, rv?"ok":"failed");
 	return rv;
@@ -1590,15 +1591,17 @@ STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 
 TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = profile_start();
 	TIMESTAMP rv = 1;
 	if(obj->oclass->commit != nullptr){
+		output_set_object_context(obj);
 		rv = (TIMESTAMP)(*(obj->oclass->commit))(obj, t1, t2);
+		output_set_object_context(nullptr);
 	}
 	if(rv == 1){ // if 'old school' or no commit callback,
 		rv =TS_NEVER;
 	}
-	object_profile(obj,OPI_COMMIT,t);
+	profile_object(obj,OPI_COMMIT,t);
 	if ( global_debug_output>0 )
 	{
 		char dt[64]="(invalid)"; convert_from_timestamp(absolute_timestamp(rv),dt,sizeof(dt));
@@ -1615,15 +1618,17 @@ TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
  **/
 STATUS object_finalize(OBJECT *obj)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = profile_start();
 	STATUS rv = SUCCESS;
 	if(obj->oclass->finalize != nullptr){
+		output_set_object_context(obj);
 		rv = (STATUS)(*(obj->oclass->finalize))(obj);
+		output_set_object_context(nullptr);
 	}
 	if(rv == 1){ // if 'old school' or no finalize callback,
 		rv = SUCCESS;
 	}
-	object_profile(obj,OPI_FINALIZE,t);
+	profile_object(obj,OPI_FINALIZE,t);
 	if ( global_debug_output>0 )
 	{
 		output_debug("object %s:%d finalize -> %s", obj->oclass->name, obj->id, rv?"ok":"failed");
@@ -2421,6 +2426,7 @@ OBJECTNAME object_set_name(OBJECT *obj, OBJECTNAME name){
 		item = object_tree_add(obj,name);
 		if(item != nullptr){
 			obj->name = item->name;
+			find_index_invalidate();
 		}
 	}
 
@@ -2446,6 +2452,7 @@ void remove_objects(){
 	}
 
 	next_object_id = 0;
+	find_index_invalidate();
 }
 
 /*****************************************************************************************************
@@ -163,6 +163,7 @@ public:
 		void (*add)(struct s_findlist*, OBJECT*);
 		void (*del)(struct s_findlist*, OBJECT*);
 		void (*clear)(struct s_findlist*);
+		void (*invalidate)(void);
 	} find;
 	PROPERTY *(*find_property)(CLASS *, const PROPERTYNAME);
 	void *(*malloc)(size_t);
@@ -193,6 +194,7 @@ public:
 		double (*gamma)(unsigned int *rng,double a, double b);
 		double (*weibull)(unsigned int *rng,double a, double b);
 		double (*rayleigh)(unsigned int *rng,double a);
+		int (*values)(RANDOMTYPE type, unsigned int *rng, double *value, unsigned int count, double a, double b);
 	} random;
 	int (*object_isa)(OBJECT *obj, const char *type);
 	DELEGATEDTYPE* (*register_type)(CLASS *oclass, char *type,int (*from_string)(void*,char*),int (*to_string)(void*,char*,int));
@@ -35,15 +35,24 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "output.h"
 #include "globals.h"
 #include "exception.h"
 #include "lock.h"
 #include "module.h"
+#include "object.h"
 
 static unsigned int output_lock = 0;
-static char buffer[65536];
+static thread_local char buffer[65536];
+static thread_local char line[sizeof(buffer)+512];
 #define CHECK 0xcdcd
 int overflow=CHECK;
 int flush = 0;
@@ -51,6 +60,7 @@ enum output_type {none, error, standard};
 output_type last_out {none};
 
 static char prefix[16]="";
+static char time_context[256]="INIT";
 void output_prefix_enable(void)
 {
 	unsigned short cpuid, procid;
@@ -200,6 +210,33 @@ static void prep_stream(){
 	return;
 }
 
+typedef enum {OT_FATAL, OT_ERROR, OT_WARNING, OT_DEBUG, OT_VERBOSE, OT_MESSAGE} OUTPUTTYPE;
+static const char *output_typename[] = {"fatal","error","warning","debug","verbose","message"};
+
+/* number of messages of each type using each format, counted without a lock
+   so the output_repeat_limit holds for the messages of all threads */
+#define OUTPUT_COUNTSIZE 4096 /* number of formats counted for each message type (must be a power of 2) */
+typedef struct s_outputcount {
+	std::atomic<const char*> format; /* format counted (nullptr for an unused entry) */
+	std::atomic<int64> count; /* number of messages issued with the format */
+} OUTPUTCOUNT;
+static OUTPUTCOUNT output_counts[OT_MESSAGE+1][OUTPUT_COUNTSIZE];
+
+/* repeated message suppression of each message function */
+typedef enum {OR_FATAL, OR_ERROR, OR_ERRORRAW, OR_WARNING, OR_DEBUG, OR_VERBOSE, OR_MESSAGE, OR_LAST} OUTPUTREPEATTYPE;
+typedef struct s_outputrepeat {
+	char lastfmt[4096]; /* format of the last message */
+	int count; /* number of times the last message was repeated since it was written */
+} OUTPUTREPEAT;
+static OUTPUTREPEAT output_repeats[OR_LAST]; /* shared by all threads (output_lock held) */
+static thread_local OUTPUTREPEAT *output_thread_repeats = nullptr; /* repeats of this thread when output_async is set */
+static thread_local OUTPUTREPEAT *output_purged_repeats = nullptr; /* repeats being purged by output_cleanup() */
+static std::mutex output_repeats_lock;
+static std::vector<OUTPUTREPEAT*> output_all_repeats; /* repeats of every thread that issued a message */
+
+static void output_purge(void);
+static void output_notice(const char *format, ...);
+
 int output_init(int argc,char *argv[])
 {
 	atexit(output_cleanup);
@@ -208,7 +245,45 @@ int output_init(int argc,char *argv[])
 
 void output_cleanup(void)
 {
-	/* nullptr purges buffers */
+	/* purge the repeat counts of every thread */
+	if ( global_output_async )
+	{
+		std::vector<OUTPUTREPEAT*> repeats;
+		{
+			std::lock_guard<std::mutex> lock(output_repeats_lock);
+			repeats = output_all_repeats;
+		}
+		for ( auto item=repeats.begin() ; item!=repeats.end() ; item++ )
+		{
+			output_purged_repeats = *item;
+			output_purge();
+		}
+		output_purged_repeats = nullptr;
+	}
+	else
+		output_purge();
+
+	/* report messages suppressed by output_repeat_limit */
+	if ( global_output_repeat_limit>0 )
+	{
+		for ( int type=0 ; type<=OT_MESSAGE ; type++ )
+		{
+			for ( int n=0 ; n<OUTPUT_COUNTSIZE ; n++ )
+			{
+				OUTPUTCOUNT &entry = output_counts[type][n];
+				const char *format = entry.format.load();
+				int64 count = entry.count.exchange(0);
+				if ( format!=nullptr && count>global_output_repeat_limit )
+					output_notice("%s message '%s' was suppressed %lld times", output_typename[type], format, (long long)(count-global_output_repeat_limit));
+			}
+		}
+	}
+	output_stop();
+}
+
+/* nullptr purges buffers */
+static void output_purge(void)
+{
 	output_verbose(nullptr);
 	output_warning(nullptr);
 	output_error(nullptr);
@@ -262,6 +337,269 @@ FILE *output_set_stream(FILESTREAM fs, FILE *newfp){
 
 static PRINTFUNCTION printstd=default_printstd, printerr=default_printerr;
 
+/**************************************************************
+ * MESSAGE DELIVERY
+ **************************************************************/
+
+/* Messages are normally written as soon as they are formatted.  When
+   output_async is set, each thread puts its formatted messages in its own
+   ring buffer without taking output_lock, and a writer thread does the
+   I/O in the order the messages were issued.  Repeated messages are then
+   suppressed per thread.  Fatal and error messages are still written
+   before the call returns, and raw, test, profile and progress output
+   waits for the queued messages to be written first.  When output_json is set, messages
+   are written as JSON lines that include the simulation clock and the
+   object being updated (if any). */
+
+typedef struct s_outputrecord {
+	unsigned int64 sequence; /* order in which the message was issued */
+	FILE *fp; /* redirection stream (nullptr to use print) */
+	PRINTFUNCTION print; /* print function */
+	char *line; /* text to write */
+} OUTPUTRECORD;
+
+#define OUTPUT_RINGSIZE 1024 /* number of messages each thread can queue (must be a power of 2) */
+typedef struct s_outputring {
+	std::atomic<unsigned int> head; /* next record added by the thread */
+	std::atomic<unsigned int> tail; /* next record removed by the writer */
+	OUTPUTRECORD record[OUTPUT_RINGSIZE];
+} OUTPUTRING;
+
+static std::mutex output_rings_lock;
+static std::vector<OUTPUTRING*> output_rings;
+static thread_local OUTPUTRING *output_ring = nullptr;
+static std::thread *output_writer = nullptr;
+static bool output_stopped = false;
+static std::atomic<bool> output_stopping(false);
+static std::atomic<unsigned int64> output_issued(0), output_written(0);
+static std::mutex output_wait_lock;
+static std::condition_variable output_wakeup, output_done;
+static thread_local OBJECT *object_context = nullptr;
+
+/** Set the object whose callback is being run by the current thread 
+	(\p nullptr when none), which is reported in JSON output
+ **/
+void output_set_object_context(OBJECT *obj)
+{
+	object_context = obj;
+}
+
+static void output_write_record(OUTPUTRECORD *record)
+{
+	if ( record->fp!=nullptr )
+		fputs(record->line,record->fp);
+	else
+		(*(record->print))("%s",record->line);
+	free(record->line);
+}
+
+/* The writer merges the rings in sequence order.  A message that was given
+   its sequence number may not be in its ring yet, so the messages that
+   follow it are kept until it arrives. */
+static void output_writer_main(void)
+{
+	std::map<unsigned int64,OUTPUTRECORD> pending; /* messages waiting for an earlier one */
+	unsigned int64 next = 0; /* sequence number of the next message to write */
+	while ( true )
+	{
+		{
+			std::lock_guard<std::mutex> lock(output_rings_lock);
+			for ( auto ring=output_rings.begin() ; ring!=output_rings.end() ; ring++ )
+			{
+				unsigned int head = (*ring)->head.load(std::memory_order_acquire);
+				unsigned int tail = (*ring)->tail.load(std::memory_order_relaxed);
+				for ( ; tail!=head ; tail++ )
+				{
+					OUTPUTRECORD &record = (*ring)->record[tail&(OUTPUT_RINGSIZE-1)];
+					pending[record.sequence] = record;
+				}
+				(*ring)->tail.store(tail,std::memory_order_release);
+			}
+		}
+		unsigned int64 count = 0;
+		for ( auto record=pending.begin() ; record!=pending.end() && record->first==next ; record=pending.erase(record), next++, count++ )
+			output_write_record(&(record->second));
+		if ( count>0 )
+		{
+			output_written += count;
+			output_done.notify_all();
+		}
+		else if ( output_stopping && output_written==output_issued )
+			break;
+		else
+		{
+			std::unique_lock<std::mutex> lock(output_wait_lock);
+			output_wakeup.wait_for(lock,std::chrono::milliseconds(10));
+		}
+	}
+}
+
+/** Wait until all queued messages are written
+ **/
+void output_flush(void)
+{
+	unsigned int64 target = output_issued;
+	if ( output_writer==nullptr || output_written>=target )
+		return;
+	output_wakeup.notify_one();
+	std::unique_lock<std::mutex> lock(output_wait_lock);
+	while ( output_written<target )
+		output_done.wait_for(lock,std::chrono::milliseconds(10));
+}
+
+/** Stop the writer thread after the queued messages are written
+
+	Messages issued afterward are written directly by the caller.
+ **/
+void output_stop(void)
+{
+	output_stopped = true;
+	if ( output_writer!=nullptr )
+	{
+		output_stopping = true;
+		output_wakeup.notify_one();
+		output_writer->join();
+		delete output_writer;
+		output_writer = nullptr;
+	}
+}
+
+/* check whether a message exceeds the output_repeat_limit */
+static bool output_limited(OUTPUTTYPE type, const char *format)
+{
+	if ( global_output_repeat_limit<=0 || format==nullptr )
+		return false;
+	uintptr_t hash = (uintptr_t)format;
+	hash ^= hash>>12;
+	for ( int n=0 ; n<OUTPUT_COUNTSIZE ; n++ )
+	{
+		OUTPUTCOUNT &entry = output_counts[type][(hash+n)&(OUTPUT_COUNTSIZE-1)];
+		const char *found = entry.format.load();
+		if ( found==nullptr && entry.format.compare_exchange_strong(found,format) )
+			found = format;
+		if ( found==format )
+			return ++entry.count > global_output_repeat_limit;
+	}
+	return false; /* too many formats to count them all */
+}
+
+/* start a message, locking the shared repeat state unless output_async
+   gives each thread its own
+   @return the repeat state of the message function */
+static OUTPUTREPEAT *output_begin(OUTPUTREPEATTYPE type, bool &locked)
+{
+	locked = !global_output_async;
+	if ( locked )
+	{
+		wlock(&output_lock);
+		return output_repeats+type;
+	}
+	if ( output_purged_repeats!=nullptr )
+		return output_purged_repeats+type;
+	if ( output_thread_repeats==nullptr )
+	{
+		output_thread_repeats = new OUTPUTREPEAT[OR_LAST]();
+		std::lock_guard<std::mutex> lock(output_repeats_lock);
+		output_all_repeats.push_back(output_thread_repeats);
+	}
+	return output_thread_repeats+type;
+}
+
+/* finish a message started with output_begin() */
+static void output_end(bool locked)
+{
+	if ( locked )
+		wunlock(&output_lock);
+}
+
+/* write a text as a JSON string */
+static void output_json_string(std::string &json, const char *text)
+{
+	json += '"';
+	for ( const char *c=text ; *c!='\0' ; c++ )
+	{
+		switch ( *c ) {
+		case '"': json += "\\\""; break;
+		case '\\': json += "\\\\"; break;
+		case '\n': json += "\\n"; break;
+		case '\r': json += "\\r"; break;
+		case '\t': json += "\\t"; break;
+		default:
+			if ( (unsigned char)*c<0x20 )
+			{
+				char code[8];
+				snprintf(code,sizeof(code),"\\u%04x",*c);
+				json += code;
+			}
+			else
+				json += *c;
+			break;
+		}
+	}
+	json += '"';
+}
+
+/* deliver a message (the caller holds output_lock unless output_async is set)
+   @return the number of characters in the message */
+static int output_emit(OUTPUTTYPE type, FILE *fp, PRINTFUNCTION print, const char *line, const char *text)
+{
+	std::string json;
+	if ( global_output_json )
+	{
+		char name[256];
+		json = "{\"clock\":";
+		output_json_string(json,time_context);
+		json += ",\"timestamp\":" + std::to_string((long long)global_clock);
+		json += ",\"type\":\"" + std::string(output_typename[type]) + "\"";
+		if ( object_context!=nullptr )
+		{
+			json += ",\"object\":";
+			output_json_string(json,object_name(object_context,name,sizeof(name)));
+			json += ",\"id\":" + std::to_string((long long)object_context->id);
+		}
+		if ( prefix[0]!='\0' )
+		{
+			json += ",\"instance\":";
+			output_json_string(json,prefix);
+		}
+		json += ",\"message\":";
+		output_json_string(json,text);
+		json += "}\n";
+		line = json.c_str();
+	}
+	if ( !global_output_async || output_stopped )
+	{
+		if ( fp!=nullptr )
+			return fputs(line,fp)>=0 ? (int)strlen(line) : -1;
+		else
+			return (*print)("%s",line);
+	}
+	if ( output_ring==nullptr )
+	{
+		output_ring = new OUTPUTRING;
+		output_ring->head = output_ring->tail = 0;
+		std::lock_guard<std::mutex> lock(output_rings_lock);
+		output_rings.push_back(output_ring);
+		if ( output_writer==nullptr )
+			output_writer = new std::thread(output_writer_main);
+	}
+	unsigned int head = output_ring->head.load(std::memory_order_relaxed);
+	while ( head-output_ring->tail.load(std::memory_order_acquire)>=OUTPUT_RINGSIZE )
+	{	/* ring is full */
+		output_wakeup.notify_one();
+		std::this_thread::yield();
+	}
+	OUTPUTRECORD *record = &(output_ring->record[head&(OUTPUT_RINGSIZE-1)]);
+	record->sequence = output_issued++;
+	record->fp = fp;
+	record->print = print;
+	record->line = strdup(line);
+	output_ring->head.store(head+1,std::memory_order_release);
+	if ( type==OT_FATAL || type==OT_ERROR )
+		output_flush();
+	return (int)strlen(line);
+}
+
 /**	Sets stderr to stdout
 
 	This was requested to keep all the output consistantly going to the same output
@@ -299,7 +637,6 @@ PRINTFUNCTION output_set_stderr(PRINTFUNCTION call) /**< The \b printf style fun
 	return old;
 }
 
-static char time_context[256]="INIT";
 void output_set_time_context(TIMESTAMP ts)
 {
 	convert_from_timestamp(ts,time_context,sizeof(time_context)-1);
@@ -322,40 +659,39 @@ char *output_get_time_context(void)
 int output_fatal(const char *format,...) /**< \bprintf style argument list */
 {
 	/* check for repeated message */
-	static char lastfmt[4096] = "";
-	static int count=0;
+	bool locked;
+	OUTPUTREPEAT *repeat = output_begin(OR_FATAL,locked);
 	int result = 0;
-	wlock(&output_lock);
-	if (format!=nullptr && strcmp(lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
+	if (output_limited(OT_FATAL,format))
+		goto Unlock;
+	if (format!=nullptr && strcmp(repeat->lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
 	{
-		count++;
+		repeat->count++;
 		goto Unlock;
 	}
 	else
 	{
 		va_list ptr;
 		int len=0;
-		strncpy(lastfmt,format?format:"",sizeof(lastfmt)-1);
-		if (count>0 && global_suppress_repeat_messages && !global_verbose_mode)
+		strncpy(repeat->lastfmt,format?format:"",sizeof(repeat->lastfmt)-1);
+		if (repeat->count>0 && global_suppress_repeat_messages && !global_verbose_mode)
 		{
-			len = sprintf(buffer,"last fatal error message was repeated %d times", count);
-			count = 0;
+			len = sprintf(buffer,"last fatal error message was repeated %d times", repeat->count);
+			repeat->count = 0;
 			if(format == nullptr) goto Output;
 			else len += sprintf(buffer+len,"\n%sFATAL    [%s] : ",prefix, time_context);
 		}
 		else if (format==nullptr)
 			goto Unlock;
 		va_start(ptr,format);
-		vsprintf(buffer+len,format,ptr); /* note the lack of check on buffer overrun */
+		vsnprintf(buffer+len,sizeof(buffer)-len,format,ptr);
 		va_end(ptr);
 	}
 Output:
-	if (redirect.error)
-		result = fprintf(redirect.error,"%sFATAL    [%s] : %s\n", prefix, time_context, buffer);
-	else
-		result = (*printerr)("%sFATAL    [%s] : %s\n", prefix, time_context, buffer);
+	snprintf(line,sizeof(line),"%sFATAL    [%s] : %s\n", prefix, time_context, buffer);
+	result = output_emit(OT_FATAL,redirect.error,printerr,line,buffer);
 Unlock:
-	wunlock(&output_lock);
+	output_end(locked);
 	return result;
 }
 
@@ -368,31 +704,32 @@ Unlock:
 int output_error(const char *format,...) /**< \bprintf style argument list */
 {
 	/* check for repeated message */
-	static char lastfmt[4096] = "";
-	static int count=0;
+	bool locked;
+	OUTPUTREPEAT *repeat = output_begin(OR_ERROR,locked);
 	int result = 0;
-	wlock(&output_lock);
-	if (format!=nullptr && strcmp(lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
+	if (output_limited(OT_ERROR,format))
+		goto Unlock;
+	if (format!=nullptr && strcmp(repeat->lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
 	{
-		count++;
+		repeat->count++;
 		goto Unlock;
 	}
 	else
 	{
 		va_list ptr;
 		int len=0;
-		strncpy(lastfmt,format?format:"",sizeof(lastfmt)-1);
-		if (count>0 && global_suppress_repeat_messages && !global_verbose_mode)
+		strncpy(repeat->lastfmt,format?format:"",sizeof(repeat->lastfmt)-1);
+		if (repeat->count>0 && global_suppress_repeat_messages && !global_verbose_mode)
 		{
-			len = sprintf(buffer,"last error message was repeated %d times", count);
-			count = 0;
+			len = sprintf(buffer,"last error message was repeated %d times", repeat->count);
+			repeat->count = 0;
 			if(format == nullptr) goto Output;
 			else len += sprintf(buffer+len,"\n%sERROR    [%s] : ", prefix, time_context);
 		}
 		else if (format==nullptr)
 			goto Unlock;
 		va_start(ptr,format);
-		vsprintf(buffer+len,format,ptr); /* note the lack of check on buffer overrun */
+		vsnprintf(buffer+len,sizeof(buffer)-len,format,ptr);
 		va_end(ptr);
 	}
 Output:
@@ -400,12 +737,10 @@ Output:
 	if (notify_error!=nullptr)
 		(*notify_error)();
 
-	if (redirect.error)
-		result = fprintf(redirect.error,"%sERROR    [%s] : %s\n", prefix, time_context, buffer);
-	else
-		result = (*printerr)("%sERROR    [%s] : %s\n", prefix, time_context, buffer);
+	snprintf(line,sizeof(line),"%sERROR    [%s] : %s\n", prefix, time_context, buffer);
+	result = output_emit(OT_ERROR,redirect.error,printerr,line,buffer);
 Unlock:
-	wunlock(&output_lock);
+	output_end(locked);
 	return result;
 }
 
@@ -418,31 +753,32 @@ Unlock:
 int output_error_raw(const char *format,...) /**< \bprintf style argument list */
 {
 	/* check for repeated message */
-	static char lastfmt[4096] = "";
-	static int count=0;
+	bool locked;
+	OUTPUTREPEAT *repeat = output_begin(OR_ERRORRAW,locked);
 	int result = 0;
-	wlock(&output_lock);
-	if (format!=nullptr && strcmp(lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
+	if (output_limited(OT_ERROR,format))
+		goto Unlock;
+	if (format!=nullptr && strcmp(repeat->lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
 	{
-		count++;
+		repeat->count++;
 		goto Unlock;
 	}
 	else
 	{
 		va_list ptr;
 		int len=0;
-		strncpy(lastfmt,format?format:"",sizeof(lastfmt)-1);
-		if (count>0 && global_suppress_repeat_messages && !global_verbose_mode)
+		strncpy(repeat->lastfmt,format?format:"",sizeof(repeat->lastfmt)-1);
+		if (repeat->count>0 && global_suppress_repeat_messages && !global_verbose_mode)
 		{
-			len = sprintf(buffer,"last error message was repeated %d times", count);
-			count = 0;
+			len = sprintf(buffer,"last error message was repeated %d times", repeat->count);
+			repeat->count = 0;
 			if(format == nullptr) goto Output;
 			else len += sprintf(buffer+len,"\n");
 		}
 		else if (format==nullptr)
 			goto Unlock;
 		va_start(ptr,format);
-		vsprintf(buffer+len,format,ptr); /* note the lack of check on buffer overrun */
+		vsnprintf(buffer+len,sizeof(buffer)-len,format,ptr);
 		va_end(ptr);
 	}
 Output:
@@ -450,12 +786,10 @@ Output:
 	if (notify_error!=nullptr)
 		(*notify_error)();
 
-	if (redirect.error)
-		result= fprintf(redirect.error,"%s%s\n", prefix, buffer);
-	else
-		result= (*printerr)("%s%s\n", prefix, buffer);
+	snprintf(line,sizeof(line),"%s%s\n", prefix, buffer);
+	result = output_emit(OT_ERROR,redirect.error,printerr,line,buffer);
 Unlock:
-	wunlock(&output_lock);
+	output_end(locked);
 	return result;
 }
 
@@ -474,6 +808,7 @@ int output_test(const char *format,...) /**< \bprintf style argument list */
 	va_list ptr;
 
 	int result = 0;
+	output_flush();
 	wlock(&output_lock);
 
 	if(format == nullptr){
@@ -518,40 +853,39 @@ int output_warning(const char *format,...) /**< \bprintf style argument list */
 	if (global_warn_mode)
 	{
 		/* check for repeated message */
-		static char lastfmt[4096] = "";
-		static int count=0;
+		bool locked;
+		OUTPUTREPEAT *repeat = output_begin(OR_WARNING,locked);
 		int result = 0;
-		wlock(&output_lock);
-		if (format!=nullptr && strcmp(lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
+		if (output_limited(OT_WARNING,format))
+			goto Unlock;
+		if (format!=nullptr && strcmp(repeat->lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
 		{
-			count++;
+			repeat->count++;
 			goto Unlock;
 		}
 		else
 		{
 			va_list ptr;
 			int len=0;
-			strncpy(lastfmt,format?format:"",sizeof(lastfmt)-1);
-			if (count>0 && global_suppress_repeat_messages && !global_verbose_mode)
+			strncpy(repeat->lastfmt,format?format:"",sizeof(repeat->lastfmt)-1);
+			if (repeat->count>0 && global_suppress_repeat_messages && !global_verbose_mode)
 			{
-				len = sprintf(buffer,"last warning message was repeated %d times", count);
-				count = 0;
+				len = sprintf(buffer,"last warning message was repeated %d times", repeat->count);
+				repeat->count = 0;
 				if(format == nullptr) goto Output;
 				else len += sprintf(buffer+len,"\n%sWARNING  [%s] : ", prefix, time_context);
 			}
 			else if (format==nullptr)
 				goto Unlock;
 			va_start(ptr,format);
-			vsprintf(buffer+len,format,ptr); /* note the lack of check on buffer overrun */
+			vsnprintf(buffer+len,sizeof(buffer)-len,format,ptr);
 			va_end(ptr);
 		}
 Output:
-		if (redirect.warning)
-			result = fprintf(redirect.warning,"%sWARNING  [%s] : %s\n", prefix, time_context, buffer);
-		else
-			result = (*printstd)("%sWARNING  [%s] : %s\n", prefix, time_context, buffer);
+		snprintf(line,sizeof(line),"%sWARNING  [%s] : %s\n", prefix, time_context, buffer);
+		result = output_emit(OT_WARNING,redirect.warning,printstd,line,buffer);
 Unlock:
-		wunlock(&output_lock);
+		output_end(locked);
 		return result;
 	}
 	return 0;
@@ -568,40 +902,39 @@ int output_debug(const char *format,...) /**< \bprintf style argument list */
 	if (global_debug_output)
 	{
 		/* check for repeated message */
-		static char lastfmt[4096] = "";
-		static int count=0;
+		bool locked;
+		OUTPUTREPEAT *repeat = output_begin(OR_DEBUG,locked);
 		int result = 0;
-		wlock(&output_lock);
-		if (format!=nullptr && strcmp(lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
+		if (output_limited(OT_DEBUG,format))
+			goto Unlock;
+		if (format!=nullptr && strcmp(repeat->lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
 		{
-			count++;
+			repeat->count++;
 			goto Unlock;
 		}
 		else
 		{
 			va_list ptr;
 			int len=0;
-			strncpy(lastfmt,format?format:"",sizeof(lastfmt)-1);
-			if (count>0 && global_suppress_repeat_messages && !global_verbose_mode)
+			strncpy(repeat->lastfmt,format?format:"",sizeof(repeat->lastfmt)-1);
+			if (repeat->count>0 && global_suppress_repeat_messages && !global_verbose_mode)
 			{
-				len = sprintf(buffer,"last debug message was repeated %d times", count);
-				count = 0;
+				len = sprintf(buffer,"last debug message was repeated %d times", repeat->count);
+				repeat->count = 0;
 				if(format == 0) goto Output;
 				else len += sprintf(buffer+len,"\n%sDEBUG [%s] : ", prefix, time_context);
 			}
 			else if (format==nullptr)
 				goto Unlock;
 			va_start(ptr,format);
-			vsprintf(buffer+len,format,ptr); /* note the lack of check on buffer overrun */
+			vsnprintf(buffer+len,sizeof(buffer)-len,format,ptr);
 			va_end(ptr);
 		}
 Output:
-		if (redirect.debug)
-			result = fprintf(redirect.debug,"%sDEBUG [%s] : %s\n", prefix, time_context, buffer);
-		else
-			result = (*printstd)("%sDEBUG [%s] : %s\n", prefix, time_context, buffer);
+		snprintf(line,sizeof(line),"%sDEBUG [%s] : %s\n", prefix, time_context, buffer);
+		result = output_emit(OT_DEBUG,redirect.debug,printstd,line,buffer);
 Unlock:
-		wunlock(&output_lock);
+		output_end(locked);
 		return result;
 	}
 	return 0;
@@ -619,39 +952,38 @@ int output_verbose(const char *format,...) /**< \bprintf style argument list */
 	if (global_verbose_mode)
 	{
 		/* check for repeated message */
-		static char lastfmt[4096] = "";
-		static int count=0;
+		bool locked;
+		OUTPUTREPEAT *repeat = output_begin(OR_VERBOSE,locked);
 		int result = 0;
-		wlock(&output_lock);
-		if (format!=nullptr && strcmp(lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
+		if (output_limited(OT_VERBOSE,format))
+			goto Unlock;
+		if (format!=nullptr && strcmp(repeat->lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
 		{
-			count++;
+			repeat->count++;
 			goto Unlock;
 		}
 		else
 		{
 			va_list ptr;
 			int len=0;
-			strncpy(lastfmt,format?format:"",sizeof(lastfmt)-1);
-			if (count>0 && global_suppress_repeat_messages && !global_verbose_mode)
+			strncpy(repeat->lastfmt,format?format:"",sizeof(repeat->lastfmt)-1);
+			if (repeat->count>0 && global_suppress_repeat_messages && !global_verbose_mode)
 			{
-				len = sprintf(buffer,"%slast verbose message was repeated %d times\n   ... ", prefix, count);
-				count = 0;
+				len = sprintf(buffer,"%slast verbose message was repeated %d times\n   ... ", prefix, repeat->count);
+				repeat->count = 0;
 				if(format == 0) goto Output;
 			}
 			else if (format==nullptr)
 				goto Unlock;
 			va_start(ptr,format);
-			vsprintf(buffer+len,format,ptr); /* note the lack of check on buffer overrun */
+			vsnprintf(buffer+len,sizeof(buffer)-len,format,ptr);
 			va_end(ptr);
 		}
 Output:
-		if (redirect.verbose)
-			result = fprintf(redirect.verbose,"%s%s\n", prefix, buffer);
-		else
-			result = (*printstd)("%s   ... %s\n", prefix, buffer);
+		snprintf(line,sizeof(line),redirect.verbose?"%s%s\n":"%s   ... %s\n", prefix, buffer);
+		result = output_emit(OT_VERBOSE,redirect.verbose,printstd,line,buffer);
 Unlock:
-		wunlock(&output_lock);
+		output_end(locked);
 	return result;
 	}
 	return 0;
@@ -666,45 +998,61 @@ int output_message(const char *format,...) /**< \bprintf style argument list */
 	if (!global_quiet_mode)
 	{
 		/* check for repeated message */
-		static char lastfmt[4096] = "";
-		static int count=0;
+		bool locked;
+		OUTPUTREPEAT *repeat = output_begin(OR_MESSAGE,locked);
 		size_t sz = strlen(format?format:"");
 		int result = 0;
-		wlock(&output_lock);
-		if (format!=nullptr && strcmp(lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
+		if (output_limited(OT_MESSAGE,format))
+			goto Unlock;
+		if (format!=nullptr && strcmp(repeat->lastfmt,format)==0 && global_suppress_repeat_messages && !global_verbose_mode)
 		{
-			count++;
+			repeat->count++;
 			goto Unlock;
 		}
 		else
 		{
 			va_list ptr;
 			int len=0;
-			strncpy(lastfmt,format?format:"",sizeof(lastfmt)-1);
-			if (count>0 && global_suppress_repeat_messages && !global_verbose_mode)
+			strncpy(repeat->lastfmt,format?format:"",sizeof(repeat->lastfmt)-1);
+			if (repeat->count>0 && global_suppress_repeat_messages && !global_verbose_mode)
 			{
-				len = sprintf(buffer,"%slast message was repeated %d times\n", prefix, count);
-				count = 0;
+				len = sprintf(buffer,"%slast message was repeated %d times\n", prefix, repeat->count);
+				repeat->count = 0;
 				if(format == nullptr) goto Output;
 			}
 			if (format==nullptr)
 				goto Unlock;
 			va_start(ptr,format);
-			vsprintf(buffer+len,format,ptr); /* note the lack of check on buffer overrun */
+			vsnprintf(buffer+len,sizeof(buffer)-len,format,ptr);
 			va_end(ptr);
 		}
 Output:
-		if (redirect.output)
-			result = fprintf(redirect.output,"%s%s\n", prefix, buffer);
-		else
-			result = (*printstd)("%s%s\n", prefix, buffer);
+		snprintf(line,sizeof(line),"%s%s\n", prefix, buffer);
+		result = output_emit(OT_MESSAGE,redirect.output,printstd,line,buffer);
 Unlock:
-		wunlock(&output_lock);
+		output_end(locked);
 		return result;
 	}
 	return 0;
 }
 
+/* write a message that is never suppressed, such as the output_repeat_limit report */
+static void output_notice(const char *format, ...)
+{
+	char text[1024], notice[sizeof(text)+sizeof(prefix)+2];
+	va_list ptr;
+	bool locked;
+	if ( global_quiet_mode )
+		return;
+	va_start(ptr,format);
+	vsnprintf(text,sizeof(text),format,ptr);
+	va_end(ptr);
+	snprintf(notice,sizeof(notice),"%s%s\n", prefix, text);
+	output_begin(OR_MESSAGE,locked);
+	output_emit(OT_MESSAGE,redirect.output,printstd,notice,text);
+	output_end(locked);
+}
+
 /** Output a profiler message
  **/
 int output_profile(const char *format, ...) /**< /bprintf style argument list */
@@ -713,9 +1061,10 @@ int output_profile(const char *format, ...) /**< /bprintf style argument list */
 	va_list ptr;
 
 	va_start(ptr,format);
-	vsprintf(tmp,format,ptr);
+	vsnprintf(tmp,sizeof(tmp),format,ptr);
 	va_end(ptr);
 
+	output_flush();
 	if (redirect.profile!=nullptr)
 		return fprintf(redirect.profile,"%s%s\n", prefix, tmp);
 	else
@@ -730,6 +1079,8 @@ int output_progress()
 	int res = 0;
 	char *ts; 
 
+	output_flush();
+
 	/* handle delta mode highres time */
 	if ( global_simulation_mode==SM_DELTA )
 	{
@@ -773,6 +1124,7 @@ int output_raw(const char *format,...) /**< \bprintf style argument list */
 	{
 		va_list ptr;
 		int result = 0;
+		output_flush();
 		wlock(&output_lock);
 
 		va_start(ptr,format);
@@ -16,6 +16,8 @@
 
 typedef int (*PRINTFUNCTION)(const char *,...);
 
+struct s_object_list;
+
 typedef enum {FS_IN = 0, FS_STD = 1, FS_ERR = 2} FILESTREAM;
 
 #ifdef __cplusplus
@@ -46,6 +48,9 @@ int output_progress(void);
 int output_profile(const char *format,...);
 
 int output_notify_error(void (*)(void));
+void output_flush(void);
+void output_stop(void);
+void output_set_object_context(struct s_object_list *obj);
 
 void output_set_time_context(TIMESTAMP ts);
 void output_set_delta_time_context(TIMESTAMP ts, DELTAT delta_ts);
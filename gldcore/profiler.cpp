@@ -0,0 +1,361 @@
+/** $Id$
+	Copyright (C) 2026 Battelle Memorial Institute
+	@file profiler.cpp
+	@addtogroup profiler Object profiler
+	@ingroup core
+
+	Each thread that runs object callbacks gets its own profile data the
+	first time it records a call.  The data is only read or cleared by
+	profile_merge(), which is called when no object callbacks are running.
+ @{
+ **/
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "profiler.h"
+#include "output.h"
+#include "class.h"
+#include "module.h"
+
+/// profile statistics of each pass
+typedef struct s_profilepasses {
+	PROFILESTATS pass[_OPI_NUMITEMS];
+} PROFILEPASSES;
+
+/// trace event of a single callback
+typedef struct s_profileevent {
+	OBJECT *obj;
+	OBJECTPROFILEITEM pass;
+	int64 start; ///< start time (ns)
+	int64 duration; ///< duration (ns)
+} PROFILEEVENT;
+
+/// profile data of a single thread
+typedef struct s_profilethread {
+	int id;
+	std::unordered_map<CLASS*,PROFILEPASSES> classes;
+	std::unordered_map<OBJECTRANK,PROFILEPASSES> ranks;
+	std::vector<PROFILEEVENT> events;
+	bool events_dropped;
+	CLASS *last_class; ///< class of the last call recorded
+	PROFILEPASSES *last_passes; ///< statistics of the last class recorded
+} PROFILETHREAD;
+
+static const std::chrono::steady_clock::time_point profile_epoch = std::chrono::steady_clock::now();
+static std::mutex profile_lock;
+static std::vector<PROFILETHREAD*> profile_threads;
+static std::map<CLASS*,PROFILEPASSES> profile_classes;
+static std::map<OBJECTRANK,PROFILEPASSES> profile_ranks;
+static thread_local PROFILETHREAD *profile_local = nullptr;
+
+static const char *profile_passname[_OPI_NUMITEMS] = {"presync","sync","postsync","init","heartbeat","precommit","commit","finalize"};
+static const char *profile_bucketname[PROFILE_BUCKETS] = {"<1us","<10us","<100us","<1ms","<10ms","<100ms","<1s",">=1s"};
+
+/** Get the monotonic profile clock
+	@return nanoseconds since the program started
+ **/
+int64 profile_clock(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-profile_epoch).count();
+}
+
+static PROFILETHREAD *profile_thread(void)
+{
+	if ( profile_local==nullptr )
+	{
+		PROFILETHREAD *data = new PROFILETHREAD;
+		data->events_dropped = false;
+		data->last_class = nullptr;
+		data->last_passes = nullptr;
+		std::lock_guard<std::mutex> lock(profile_lock);
+		data->id = (int)profile_threads.size();
+		profile_threads.push_back(data);
+		profile_local = data;
+	}
+	return profile_local;
+}
+
+static void profile_add(PROFILESTATS &stats, int64 dt)
+{
+	int bucket = 0;
+	for ( int64 limit=1000 ; dt>=limit && bucket<PROFILE_BUCKETS-1 ; limit*=10 )
+		bucket++;
+	stats.count++;
+	stats.total += dt;
+	if ( dt>stats.max )
+		stats.max = dt;
+	stats.histogram[bucket]++;
+}
+
+static void profile_add(PROFILESTATS &stats, const PROFILESTATS &from)
+{
+	stats.count += from.count;
+	stats.total += from.total;
+	if ( from.max>stats.max )
+		stats.max = from.max;
+	for ( int n=0 ; n<PROFILE_BUCKETS ; n++ )
+		stats.histogram[n] += from.histogram[n];
+}
+
+/** Record an object callback that started at \p start (see profile_start()).
+	Only the calling thread's data is updated, so no lock is needed.
+ **/
+void profile_object(OBJECT *obj, OBJECTPROFILEITEM pass, int64 start)
+{
+	if ( !global_profiler || start==0 )
+		return;
+	int64 dt = profile_clock()-start;
+	obj->synctime[pass] += (clock_t)(dt/1000);
+
+	PROFILETHREAD *data = profile_thread();
+	if ( data->last_class!=obj->oclass )
+	{
+		data->last_class = obj->oclass;
+		data->last_passes = &data->classes[obj->oclass]; // value-initialized when new
+	}
+	profile_add(data->last_passes->pass[pass],dt);
+	profile_add(data->ranks[obj->rank].pass[pass],dt);
+
+	if ( global_profile_trace.get_length()>0 )
+	{
+		if ( data->events.size()<(size_t)global_profile_trace_limit )
+		{
+			PROFILEEVENT event = {obj,pass,start,dt};
+			data->events.push_back(event);
+		}
+		else
+			data->events_dropped = true;
+	}
+}
+
+/** Merge the thread profile data into the class profiles.
+	This must only be called while no object callbacks are running.
+ **/
+void profile_merge(void)
+{
+	std::lock_guard<std::mutex> lock(profile_lock);
+	for ( std::vector<PROFILETHREAD*>::iterator thread=profile_threads.begin() ; thread!=profile_threads.end() ; thread++ )
+	{
+		PROFILETHREAD *data = *thread;
+		for ( std::unordered_map<CLASS*,PROFILEPASSES>::iterator item=data->classes.begin() ; item!=data->classes.end() ; item++ )
+		{
+			PROFILEPASSES &passes = profile_classes[item->first];
+			for ( int n=0 ; n<_OPI_NUMITEMS ; n++ )
+				profile_add(passes.pass[n],item->second.pass[n]);
+		}
+		for ( std::unordered_map<OBJECTRANK,PROFILEPASSES>::iterator item=data->ranks.begin() ; item!=data->ranks.end() ; item++ )
+		{
+			PROFILEPASSES &passes = profile_ranks[item->first];
+			for ( int n=0 ; n<_OPI_NUMITEMS ; n++ )
+				profile_add(passes.pass[n],item->second.pass[n]);
+		}
+		data->classes.clear();
+		data->ranks.clear();
+		data->last_class = nullptr;
+		data->last_passes = nullptr;
+	}
+
+	// update the class totals used by the core and model profile reports
+	for ( std::map<CLASS*,PROFILEPASSES>::iterator item=profile_classes.begin() ; item!=profile_classes.end() ; item++ )
+	{
+		int64 total = 0, count = 0;
+		for ( int n=0 ; n<_OPI_NUMITEMS ; n++ )
+		{
+			total += item->second.pass[n].total;
+			count += item->second.pass[n].count;
+		}
+		item->first->profiler.clocks = total/1000;
+		item->first->profiler.count = (int32)count;
+	}
+}
+
+static void profile_row(const char *name, const char *pass, const PROFILESTATS &stats)
+{
+	char hist[PROFILE_BUCKETS*9+1];
+	int len = 0;
+	for ( int n=0 ; n<PROFILE_BUCKETS ; n++ )
+		len += snprintf(hist+len,sizeof(hist)-len," %8" FMT_INT64 "d",stats.histogram[n]);
+	output_profile("%-16.16s %-9.9s %10" FMT_INT64 "d %9.3f %9.1f %9.3f%s",
+		name, pass, stats.count, stats.total/1e9, stats.total/1e3/stats.count, stats.max/1e6, hist);
+}
+
+static void profile_header(const char *title, const char *column)
+{
+	char head[PROFILE_BUCKETS*9+1];
+	char line[PROFILE_BUCKETS*9+1];
+	int len = 0;
+	for ( int n=0 ; n<PROFILE_BUCKETS ; n++ )
+	{
+		snprintf(head+len,sizeof(head)-len," %8s",profile_bucketname[n]);
+		len += snprintf(line+len,sizeof(line)-len," --------");
+	}
+	output_profile("\n%s",title);
+	output_profile("%-16s %-9s %10s %9s %9s %9s%s", column, "Pass", "Calls", "Time (s)", "Mean (us)", "Max (ms)", head);
+	output_profile("---------------- --------- ---------- --------- --------- ---------%s", line);
+}
+
+/** Report the pass, class and rank histograms
+ **/
+void profile_report(void)
+{
+	profile_merge();
+	if ( profile_classes.empty() )
+		return;
+
+	PROFILEPASSES total;
+	memset(&total,0,sizeof(total));
+	for ( std::map<CLASS*,PROFILEPASSES>::iterator item=profile_classes.begin() ; item!=profile_classes.end() ; item++ )
+	{
+		for ( int n=0 ; n<_OPI_NUMITEMS ; n++ )
+			profile_add(total.pass[n],item->second.pass[n]);
+	}
+	profile_header("Pass profiler results","");
+	for ( int n=0 ; n<_OPI_NUMITEMS ; n++ )
+	{
+		if ( total.pass[n].count>0 )
+			profile_row("",profile_passname[n],total.pass[n]);
+	}
+
+	profile_header("Class profiler results","Class");
+	for ( CLASS *oclass=class_get_first_class() ; oclass!=nullptr ; oclass=oclass->next )
+	{
+		std::map<CLASS*,PROFILEPASSES>::iterator item = profile_classes.find(oclass);
+		if ( item==profile_classes.end() )
+			continue;
+		for ( int n=0 ; n<_OPI_NUMITEMS ; n++ )
+		{
+			if ( item->second.pass[n].count>0 )
+				profile_row(oclass->name,profile_passname[n],item->second.pass[n]);
+		}
+	}
+
+	profile_header("Rank profiler results","Rank");
+	for ( std::map<OBJECTRANK,PROFILEPASSES>::iterator item=profile_ranks.begin() ; item!=profile_ranks.end() ; item++ )
+	{
+		char rank[32];
+		snprintf(rank,sizeof(rank),"%u",(unsigned int)item->first);
+		for ( int n=OPI_PRESYNC ; n<=OPI_POSTSYNC ; n++ )
+		{
+			if ( item->second.pass[n].count>0 )
+				profile_row(rank,profile_passname[n],item->second.pass[n]);
+		}
+	}
+	output_profile("");
+}
+
+/// write a name as a JSON string
+static void profile_json_string(FILE *fp, const char *s)
+{
+	fputc('"',fp);
+	for ( ; *s!='\0' ; s++ )
+	{
+		if ( *s=='"' || *s=='\\' )
+			fputc('\\',fp);
+		if ( (unsigned char)*s>=' ' )
+			fputc(*s,fp);
+	}
+	fputc('"',fp);
+}
+
+static int profile_export_trace(const char *filename)
+{
+	FILE *fp = fopen(filename,"w");
+	if ( fp==nullptr )
+	{
+		output_error("unable to open profile trace file '%s'", filename);
+		/* TROUBLESHOOT
+			The profiler could not create the file named by the profile_trace global.
+			Check that the folder exists and that you have permission to write to it.
+		 */
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(profile_lock);
+	bool first = true;
+	size_t count = 0;
+	fprintf(fp,"{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	for ( std::vector<PROFILETHREAD*>::iterator thread=profile_threads.begin() ; thread!=profile_threads.end() ; thread++ )
+	{
+		PROFILETHREAD *data = *thread;
+		fprintf(fp,"%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}", first?"":",", data->id, data->id);
+		first = false;
+		for ( std::vector<PROFILEEVENT>::iterator event=data->events.begin() ; event!=data->events.end() ; event++ )
+		{
+			OBJECT *obj = event->obj;
+			char name[256];
+			if ( obj->name!=nullptr )
+				snprintf(name,sizeof(name),"%s",obj->name);
+			else
+				snprintf(name,sizeof(name),"%s:%d",obj->oclass->name,obj->id);
+			fprintf(fp,",\n{\"name\":");
+			profile_json_string(fp,name);
+			fprintf(fp,",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"class\":",
+				profile_passname[event->pass], event->start/1e3, event->duration/1e3, data->id);
+			profile_json_string(fp,obj->oclass->name);
+			fprintf(fp,",\"rank\":%u}}",(unsigned int)obj->rank);
+		}
+		count += data->events.size();
+		if ( data->events_dropped )
+		{
+			output_warning("profile trace of thread %d was limited to %d events", data->id, global_profile_trace_limit);
+			/* TROUBLESHOOT
+				The profiler stopped recording trace events for a thread when it reached the
+				profile_trace_limit.  Increase profile_trace_limit to record more of the run.
+			 */
+		}
+	}
+	fprintf(fp,"\n]}\n");
+	fclose(fp);
+	output_verbose("profile trace of %d events written to '%s'", (int)count, filename);
+	return 1;
+}
+
+static int profile_export_folded(const char *filename)
+{
+	FILE *fp = fopen(filename,"w");
+	if ( fp==nullptr )
+	{
+		output_error("unable to open profile folded stack file '%s'", filename);
+		/* TROUBLESHOOT
+			The profiler could not create the file named by the profile_folded global.
+			Check that the folder exists and that you have permission to write to it.
+		 */
+		return 0;
+	}
+	for ( CLASS *oclass=class_get_first_class() ; oclass!=nullptr ; oclass=oclass->next )
+	{
+		std::map<CLASS*,PROFILEPASSES>::iterator item = profile_classes.find(oclass);
+		if ( item==profile_classes.end() )
+			continue;
+		for ( int n=0 ; n<_OPI_NUMITEMS ; n++ )
+		{
+			// folded stacks use integer sample counts, here microseconds
+			if ( item->second.pass[n].total>=1000 )
+				fprintf(fp,"gridlabd;%s;%s;%s %" FMT_INT64 "d\n", profile_passname[n], oclass->module?oclass->module->name:"core", oclass->name, item->second.pass[n].total/1000);
+		}
+	}
+	fclose(fp);
+	return 1;
+}
+
+/** Write the trace event and folded stack files, if requested
+	@return 1 on success, 0 if a file could not be written
+ **/
+int profile_export(void)
+{
+	int ok = 1;
+	if ( !global_profiler )
+		return ok;
+	profile_merge();
+	if ( global_profile_trace.get_length()>0 && !profile_export_trace(global_profile_trace.get_string()) )
+		ok = 0;
+	if ( global_profile_folded.get_length()>0 && !profile_export_folded(global_profile_folded.get_string()) )
+		ok = 0;
+	return ok;
+}
+
+/**@}**/
@@ -0,0 +1,50 @@
+/** $Id$
+	Copyright (C) 2026 Battelle Memorial Institute
+	@file profiler.h
+	@addtogroup profiler Object profiler
+	@ingroup core
+
+	The object profiler times every object callback with a monotonic
+	nanosecond clock.  Each thread accumulates its own totals and
+	histograms (per class, per pass and per rank), so no lock is taken
+	while the model runs.  The thread data is merged when the profile is
+	reported.  When \p profile_trace is set, each callback is also
+	recorded as a Chrome trace event, and when \p profile_folded is set
+	the class totals are written as folded stacks for flamegraph tools.
+ @{
+ **/
+
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#include "globals.h"
+#include "object.h"
+
+#define PROFILE_BUCKETS 8 ///< number of decade histogram buckets (<1us, <10us, ... >=1s)
+
+/// profile statistics of a set of callbacks
+typedef struct s_profilestats {
+	int64 count; ///< number of calls
+	int64 total; ///< total time (ns)
+	int64 max; ///< longest call (ns)
+	int64 histogram[PROFILE_BUCKETS]; ///< number of calls by duration decade
+} PROFILESTATS;
+
+int64 profile_clock(void);
+
+/** Get the start time of a profiled callback
+	@return the profile clock (ns) if the profiler is enabled, zero otherwise
+ **/
+inline int64 profile_start(void)
+{
+	return global_profiler ? profile_clock() : 0;
+}
+
+void profile_object(OBJECT *obj, OBJECTPROFILEITEM pass, int64 start);
+void profile_merge(void);
+void profile_report(void);
+int profile_export(void);
+
+#endif
+
+/**@}**/
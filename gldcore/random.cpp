@@ -10,6 +10,16 @@
 	a problem, unless you are using the pseudo-random sequences.  In that case, you
 	need to lock the state variable you are using when generating random numbers.
 
+	When \p random_number_generator is \p RNG4, numbers are generated by a
+	counter-based generator (Philox-4x32-10).  Each state variable is then a
+	handle to a stream keyed by the random seed and the owner of the state
+	(e.g., the object id), and the n-th number of a stream only depends on
+	the key and on n.  Objects therefore get the same numbers regardless of
+	the thread count or the order in which objects are updated, and the
+	numbers have the full 53 bits of precision of a double.  A state that is
+	not a stream handle (e.g., one set by a model) is given its own stream
+	the first time it is used.
+
  @{
  **/
 
@@ -22,6 +32,8 @@
 #include <cstring>
 #include <ctime>
 #include <sys/time.h>
+#include <atomic>
+#include <mutex>
 
 #include "gldrandom.h"
 #include "find.h"
@@ -77,6 +89,160 @@ char* strtok_t(char *str, const char *delim, char **nextp)
 
 static unsigned int *ur_state = nullptr;
 
+/**********************************************************************************
+ * COUNTER-BASED GENERATOR (RNG4)
+ **********************************************************************************/
+
+/// stream of the counter-based generator
+typedef struct s_randomstream {
+	unsigned int domain; ///< owner type (see #RANDOMSTREAM)
+	unsigned int id; ///< owner id
+	unsigned int64 counter; ///< number of values drawn
+} RANDOMSTREAMDATA;
+
+#define RS_CHUNKSIZE 4096 ///< streams allocated at a time
+#define RS_MAXCHUNKS 4096 ///< maximum number of stream chunks (16M streams)
+static RANDOMSTREAMDATA *random_streams[RS_MAXCHUNKS];
+static std::atomic<unsigned int> random_nstreams(0);
+static unsigned int random_nextid[RS_NUMDOMAINS];
+static std::mutex random_streamlock;
+static std::atomic<unsigned int64> random_globalcounter(0);
+
+/** Philox-4x32-10 block function (Salmon et al., SC'11)
+ **/
+static void philox(unsigned int ctr[4], unsigned int key[2])
+{
+	unsigned int k0 = key[0], k1 = key[1];
+	for ( int round=0 ; round<10 ; round++ )
+	{
+		unsigned int64 p0 = (unsigned int64)0xD2511F53*ctr[0];
+		unsigned int64 p1 = (unsigned int64)0xCD9E8D57*ctr[2];
+		unsigned int c0 = (unsigned int)(p1>>32)^ctr[1]^k0;
+		unsigned int c2 = (unsigned int)(p0>>32)^ctr[3]^k1;
+		ctr[1] = (unsigned int)p1;
+		ctr[3] = (unsigned int)p0;
+		ctr[0] = c0;
+		ctr[2] = c2;
+		k0 += 0x9E3779B9;
+		k1 += 0xBB67AE85;
+	}
+}
+
+/** Get the pair of numbers in (0,1) at block \p n of a stream
+ **/
+static void random_block(unsigned int domain, unsigned int id, unsigned int64 n, double value[2])
+{
+	unsigned int ctr[4] = {(unsigned int)n, (unsigned int)(n>>32), domain, 0};
+	unsigned int key[2] = {global_randomseed, id};
+	philox(ctr,key);
+	for ( int i=0 ; i<2 ; i++ )
+	{
+		unsigned int64 bits = ((unsigned int64)ctr[2*i]<<32) | ctr[2*i+1];
+		value[i] = ((bits>>11)+0.5)/9007199254740992.0; // never 0 or 1
+	}
+}
+
+/** Get the number at position \p n of a stream
+ **/
+static inline double random_counter(unsigned int domain, unsigned int id, unsigned int64 n)
+{
+	double value[2];
+	random_block(domain,id,n>>1,value);
+	return value[n&1];
+}
+
+/// check bits that identify a stream handle
+static inline unsigned int random_handlecheck(unsigned int index)
+{
+	return ((index*0x9E3779B1)>>24)|0x80; // never 0, so a zero state is never a handle
+}
+
+static unsigned int random_newstream(RANDOMSTREAM domain, unsigned int id)
+{
+	unsigned int index = random_nstreams.load();
+	if ( index>=RS_CHUNKSIZE*RS_MAXCHUNKS )
+		throw_exception("random_newstream(domain=%d, id=%u): too many random number streams", domain, id);
+		/* TROUBLESHOOT
+			The counter-based random number generator supports up to 16 million streams.
+			Reduce the number of objects that use random numbers or use the RNG3 generator.
+		 */
+	RANDOMSTREAMDATA *&chunk = random_streams[index/RS_CHUNKSIZE];
+	if ( chunk==nullptr )
+		chunk = new RANDOMSTREAMDATA[RS_CHUNKSIZE];
+	RANDOMSTREAMDATA &stream = chunk[index%RS_CHUNKSIZE];
+	stream.domain = domain;
+	stream.id = id;
+	stream.counter = 0;
+	random_nstreams.store(index+1); // publish the stream
+	return (random_handlecheck(index)<<24) | index;
+}
+
+/** Get the stream of a state, creating one if the state is not a stream handle
+ **/
+static RANDOMSTREAMDATA *random_getstream(unsigned int *state)
+{
+	unsigned int index = (*state)&0xffffff;
+	if ( index>=random_nstreams.load() || ((*state)>>24)!=random_handlecheck(index) )
+	{
+		std::lock_guard<std::mutex> lock(random_streamlock);
+		*state = random_newstream(RS_STATE,*state);
+		index = (*state)&0xffffff;
+	}
+	return random_streams[index/RS_CHUNKSIZE]+index%RS_CHUNKSIZE;
+}
+
+/** Create a new random number generator state for an owner.
+	With RNG4 the state is a handle to a stream keyed by \p domain and \p id
+	(the next id of the domain is used when \p id is #RS_NEXTID).  Otherwise
+	the state is seeded from the global generator as before.
+	@return the initial state
+ **/
+unsigned int random_newstate(RANDOMSTREAM domain, unsigned int id)
+{
+	if ( global_randomnumbergenerator!=RNG4 )
+		return randwarn(nullptr);
+	std::lock_guard<std::mutex> lock(random_streamlock);
+	if ( id==RS_NEXTID )
+		id = random_nextid[domain]++;
+	return random_newstream(domain,id);
+}
+
+/** Get the next number in (0,1) from the counter-based generator
+ **/
+static double random_next(unsigned int *state)
+{
+	if ( state==nullptr || state==ur_state )
+		return random_counter(RS_GLOBAL,0,random_globalcounter.fetch_add(1));
+	RANDOMSTREAMDATA *stream = random_getstream(state);
+	return random_counter(stream->domain,stream->id,stream->counter++);
+}
+
+/** Get the next \p count numbers in (0,1) from the counter-based generator.
+	The numbers are the same as those of \p count calls to random_next().
+ **/
+static void random_nextn(unsigned int *state, double *value, unsigned int count)
+{
+	unsigned int domain = RS_GLOBAL, id = 0;
+	unsigned int64 n;
+	if ( state==nullptr || state==ur_state )
+		n = random_globalcounter.fetch_add(count);
+	else
+	{
+		RANDOMSTREAMDATA *stream = random_getstream(state);
+		domain = stream->domain;
+		id = stream->id;
+		n = stream->counter;
+		stream->counter += count;
+	}
+	unsigned int i = 0;
+	if ( count>0 && (n&1) )
+		value[i++] = random_counter(domain,id,n++);
+	for ( ; i+1<count ; i+=2, n+=2 )
+		random_block(domain,id,n>>1,value+i);
+	if ( i<count )
+		value[i] = random_counter(domain,id,n);
+}
+
 unsigned entropy_source(void)
 {
 	struct timeval t;
@@ -153,7 +319,12 @@ int randwarn(unsigned int *state)
 		output_warning("non-deterministic behavior probable--rand was called while running multiple threads");
 	}
 	
-	if ( global_randomnumbergenerator==RNG2 )
+	if ( global_randomnumbergenerator==RNG4 )
+	{
+		/* counter-based generator returns the same 15 bits range as RNG3 */
+		return (int)(random_next(state)*(0x7fff+1.0));
+	}
+	else if ( global_randomnumbergenerator==RNG2 )
 	{
 		/* use the stdc (RNG2) rand functions */
 		if ( state!=nullptr )
@@ -214,6 +385,13 @@ double randunit(unsigned int *state)
 	unsigned int ur;
 	static unsigned int random_lock=0;
 
+	if ( global_randomnumbergenerator==RNG4 )
+	{
+		if ( global_nondeterminism_warning && ( state==nullptr || state==ur_state ) )
+			randwarn(nullptr);
+		return random_next(state);
+	}
+
 	if ( state==nullptr || state==ur_state )
 	{
 		state=ur_state;
@@ -769,6 +947,52 @@ double random_value(RANDOMTYPE type, /**< the type of distribution desired */
 	return x;
 }
 
+/** Generate a batch of random values using the known state that is updated.
+	The values are the same as those of \p count calls to pseudorandom_value().
+	@return the number of values generated, or -1 if the type is not valid
+ **/
+int random_values(RANDOMTYPE type, /**< the type of distribution desired (sampled is not supported) */
+				  unsigned int *state, /**< the state of the random number generator */
+				  double *value, /**< the values generated */
+				  unsigned int count, /**< the number of values to generate */
+				  double a, /**< the first parameter of the distribution */
+				  double b) /**< the second parameter of the distribution */
+{
+	unsigned int i;
+	if ( type==RT_SAMPLED || type==RT_INVALID )
+	{
+		output_error("random_values(type=%d,...): batch generation is not supported for this distribution", type);
+		/* TROUBLESHOOT
+			A batch of random numbers was requested for a distribution that requires a sample set or that isn't recognized.
+			Generate the numbers one at a time using pseudorandom_value() instead.
+		 */
+		return -1;
+	}
+	if ( global_randomnumbergenerator==RNG4 && type==RT_UNIFORM )
+	{
+		random_nextn(state,value,count);
+		for ( i=0 ; i<count ; i++ )
+			value[i] = value[i]*(b-a)+a;
+		return count;
+	}
+	if ( global_randomnumbergenerator==RNG4 && type==RT_NORMAL && b>=0 )
+	{
+		/* each value uses two numbers, see random_normal() */
+		double pair[2*64];
+		for ( i=0 ; i<count ; )
+		{
+			unsigned int n = count-i<64 ? count-i : 64, j;
+			random_nextn(state,pair,2*n);
+			for ( j=0 ; j<n ; j++ )
+				value[i++] = sqrt(-2*log(pair[2*j])) * sin(2*PI*pair[2*j+1])*b+a;
+		}
+		return count;
+	}
+	for ( i=0 ; i<count ; i++ )
+		value[i] = pseudorandom_value(type,state,a,b);
+	return count;
+}
+
 /** Generate a pseudo-random value using the known state that is updated.
 	@return a double containing the random number
  **/
@@ -1100,7 +1324,9 @@ int random_test(void)
 	/* test modulus */
 	initstate = state;
 	output_test("\nTesting modulus starting at state 0x%08x", state);
-	for ( randwarn(&state),count=1; state!=initstate && count!=0 ; count++)
+	if ( global_randomnumbergenerator==RNG4 )
+		count = 0; /* the state is a stream handle and each stream has 2^64 values */
+	else for ( randwarn(&state),count=1; state!=initstate && count!=0 ; count++)
 		randwarn(&state);
 	if ( count==0 )
 		output_test("Modulus exceeds 2^32");
@@ -1136,10 +1362,12 @@ int convert_to_randomvar(char *string, void *data, PROPERTY *prop)
 	char *token = nullptr;
 	char *last = nullptr;
 
-	/* clean memory */
+	/* clean memory (keeping the RNG4 stream given by randomvar_create) */
 	randomvar_struct *next = var->next;
+	unsigned int state = global_randomnumbergenerator==RNG4 ? var->state : 0;
 	memset(var,0,sizeof(randomvar_struct));
 	var->next = next;
+	var->state = state;
 
 	/* check string length before copying to buffer */
 	if (strlen(string)>sizeof(buffer)-1)
@@ -1260,7 +1488,7 @@ int randomvar_create(randomvar_struct *var)
 {
 	memset(var,0,sizeof(randomvar_struct));
 	var->next = randomvar_list;
-	var->state = randwarn(nullptr);
+	var->state = random_newstate(RS_RANDOMVAR,RS_NEXTID);
 	randomvar_list = var;
 	n_randomvars++;
 	return 1;
@@ -1193,6 +1193,7 @@ public:
         double (*gamma)(unsigned int *rng,double a, double b);
         double (*weibull)(unsigned int *rng,double a, double b);
         double (*rayleigh)(unsigned int *rng,double a);
+        int (*values)(RANDOMTYPE type, unsigned int *rng, double *value, unsigned int count, double a, double b);
     } random;
     int (*object_isa)(OBJECT *obj, const char *type);
     DELEGATEDTYPE* (*register_type)(CLASS *oclass, char *type,int (*from_string)(void*,char*),int (*to_string)(void*,char*,int));
@@ -1471,6 +1472,7 @@ inline double gl_random_beta(double a, double b) { return callback->random.beta(
 inline double gl_random_gamma(double a, double b) { return callback->random.gamma(NULL,a,b);};
 inline double gl_random_weibull(double a, double b) { return callback->random.weibull(NULL,a,b);};
 inline double gl_random_rayleigh(double a) { return callback->random.rayleigh(NULL,a);};
+inline int gl_random_values(RANDOMTYPE type, double *value, unsigned int count, double a, double b) { return callback->random.values(type,NULL,value,count,a,b);};
 
 inline bool gl_object_isa(OBJECT *obj, char *type) { return callback->object_isa(obj,type)==1;};
 inline DATETIME *gl_localtime(TIMESTAMP ts,DATETIME *dt) { return callback->time.local_datetime(ts,dt)?dt:NULL;};
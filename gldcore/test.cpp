@@ -136,6 +136,7 @@ int test_lock(void)
 		}
 
 		output_test("*** Begin memory locking test for %d threads", global_threadcount);
+		register_lock("locktest",&key);
 		wlock(&key);
 		for ( n=0 ; n<global_threadcount ; n++ )
 		{
@@ -59,6 +59,18 @@ typedef struct{
 
 static int daysinmonth[] = {31,28,31,30,31,30,31,31,30,31,30,31};
 static const char *dow[] = {"Sun","Mon","Tue","Wed","Thu","Fri","Sat"};
+static const int monthstart[2][13] = { /* day of the year each month starts (normal and leap years) */
+	{0,31,59,90,120,151,181,212,243,273,304,334,365},
+	{0,31,60,91,121,152,182,213,244,274,305,335,366},
+};
+
+#define TSCACHE_SIZE 8 /* number of local times cached by each thread (must be a power of 2) */
+typedef struct {
+	TIMESTAMP ts; /* GMT timestamp converted */
+	unsigned int generation; /* timezone generation used */
+	DATETIME dt; /* local time */
+} TSCACHE;
+static thread_local TSCACHE tscache[TSCACHE_SIZE];
 
 #define YEAR0 (1970) /* basis year is 1970 */
 #define YEAR0_ISLY (0) /* set to 1 if YEAR0 is a leap year, 1970 is not */
@@ -67,6 +79,8 @@ static const char *dow[] = {"Sun","Mon","Tue","Wed","Thu","Fri","Sat"};
 static int tzvalid=0;
 static TIMESTAMP tszero[1000] = {-1}; /* zero timestamp offset for each year */
 static TIMESTAMP dststart[1000], dstend[1000];
+static bool dstsouth[1000]; /* DST starts and ends in different years */
+static unsigned int tzgeneration = 1; /* changes whenever the timezone is loaded */
 static TIMESTAMP tzoffset;
 static char current_tzname[64], tzstd[32], tzdst[32];
 
@@ -85,11 +99,7 @@ char *timestamp_current_timezone(void){
  **/
 int timestamp_year(TIMESTAMP ts, TIMESTAMP *remainder)
 {
-#ifdef USE_TS_CACHE
-	static int year = 0; /* reuse last result */
-#else
 	unsigned int year = (unsigned int)(ts/86400/365.24); /* estimate the year */
-#endif
 	int tsyear = 0;
 
 	if (tszero[0] == -1){	/* need to initialize tszero array */
@@ -131,17 +141,13 @@ int timestamp_year(TIMESTAMP ts, TIMESTAMP *remainder)
  **/
 int isdst(TIMESTAMP t)
 {
-	int DSTstart_year, DSTend_year;
 	int year = timestamp_year(t + tzoffset, nullptr) - YEAR0;
 
 	//Preliminary check to make sure something exists
 	if (dststart[year]>=0)	//If it's -1, no sense going forth
 	{
-		DSTstart_year = timestamp_year(dststart[year],nullptr);
-		DSTend_year = timestamp_year(dstend[year],nullptr);
-
 		//Southern hemisphere DST-oriented check
-		if (DSTstart_year != DSTend_year)
+		if (dstsouth[year])
 		{
 			//See if we're in the "late-year" DST region
 			if (dststart[year] <= t)
@@ -191,75 +197,39 @@ int isdst(TIMESTAMP t)
  **/
 int local_tzoffset(TIMESTAMP t)
 {
-#ifdef USE_TS_CACHE
-	static old_t = 0;
-	static old_tzoffset = 0;
-	if (old_t==0 || old_t!=t)
-	{
-		old_tzoffset = tzoffset + isdst(t)?3600:0;
-		old_t = t;
-	}
-	return old_tzoffset;
-#else
 	return (int)(tzoffset + (isdst(t)?3600:0));
-#endif
 }
 
-/** Converts a GMT timestamp to local datetime struct
-	Adjusts to TZ if possible
- **/
-int local_datetime(TIMESTAMP ts, DATETIME *dt)
+/* Compute the local calendar of a GMT timestamp (the nanosecond is left to the caller) */
+static int local_calendar(TIMESTAMP ts, DATETIME *dt, const char *caller)
 {
-
-	int64 n;
 	TIMESTAMP rem = 0;
 	TIMESTAMP local;
-	int tsyear;
-
-#ifdef USE_TS_CACHE
-	/* allow caching */
-	static TIMESTAMP old_ts =0;
-	static DATETIME old_dt;
-#endif
+	int dst, leap, month;
 
 	if( ts == TS_NEVER || ts==TS_ZERO )
 		return 0;
 
 	if( dt==nullptr || ts<TS_ZERO || ts>TS_MAX ) /* no buffer or timestamp out of range */
 	{
-		output_error("local_datetime(ts=%lli,...): invalid local_datetime request",ts);
+		output_error("%s(ts=%lli,...): invalid local_datetime request",caller,ts);
 		return 0;
 	}
-#ifdef USE_TS_CACHE
-	/* check cache */
-	if (old_ts == ts && old_ts!=0)
-		memcpy(dt,&old_dt,sizeof(DATETIME));
-	else
-		old_ts = 0;
-#endif
 
-	local = LOCALTIME(ts);
-	tsyear = timestamp_year(local, &rem);
+	dst = isdst(ts);
+	local = ts-tzoffset+(dst?3600:0);
+	dt->year = timestamp_year(local, &rem);
 
 	if (rem < 0)
 	{
 		// DPC: note that as of 3.0, the clock is initialized by default, so this error can only
 		//      occur when an invalid timestamp is being converted to local time.  It should no
 		//      longer occur as a result of a missing clock directive.
-		//THROW("local_datetime(ts=%lli, ...): invalid timestamp cannot be converted to local time", ts);
 		/*	TROUBLESHOOT
 			This is the result of an internal core or module coding error which resulted in an
 			invalid UTC clock time being converted to local time.
 		*/
-		output_error("local_datetime(ts=%lli,...): invalid local_datetime request",ts);
-		return 0;
-	}
-
-	if(ts < TS_ZERO && ts > TS_MAX){ /* timestamp out of range */
-		return 0;
-	}
-	
-	if(ts == TS_NEVER){
+		output_error("%s(ts=%lli,...): invalid local_datetime request",caller,ts);
 		return 0;
 	}
 
@@ -267,42 +237,17 @@ int local_datetime(TIMESTAMP ts, DATETIME *dt)
 	dt->timestamp = ts;
 
 	/* DST? */
-	dt->is_dst = (tzvalid && isdst(ts));
-
-	/* compute year */
-	dt->year = tsyear;
+	dt->is_dst = (tzvalid && dst);
 
 	/* yearday and weekday */
 	dt->yearday = (unsigned short)(rem / DAY);
 	dt->weekday = (unsigned short)((local / DAY + DOW0 + 7) % 7);
 
-	/* compute month */
-	dt->month = 0;
-	n = daysinmonth[0] * DAY;
-	while(rem >= n){
-		rem -= n; /* subtract n ticks from ts */
-		dt->month++; /* add to month */
-		if(dt->month == 12){
-			dt->month = 0;
-			++dt->year;
-		}
-		n = (daysinmonth[dt->month] + ((dt->month == 1 && ISLEAPYEAR(dt->year)) ? 1:0)) * 86400 * TS_SECOND;
-		if(n < 86400 * 28){ /**/
-			output_fatal("Breaking an infinite loop in local_datetime! (ts = %" FMT_INT64 "ds", ts);
-			/*	TROUBLESHOOT
-				An internal protection against infinite loops in the time calculation
-				module has encountered a critical problem.  This is often caused by
-				an incorrectly initialized timezone system, a missing timezone specification before
-				a timestamp was used, or a missing timezone localization in your system.
-				Correct the timezone problem and try again.
-			 */
-			return 0;
-		}
-	}
-	dt->month++; /* Jan=1 */
-
-	/* compute day */
-	dt->day = (unsigned short)(rem / DAY + 1);
+	/* compute month and day from the start day of each month */
+	leap = ISLEAPYEAR(dt->year) ? 1 : 0;
+	for ( month = dt->yearday/31 ; month<11 && dt->yearday>=monthstart[leap][month+1] ; month++ ) {}
+	dt->month = month+1; /* Jan=1 */
+	dt->day = (unsigned short)(dt->yearday - monthstart[leap][month] + 1);
 	rem %= DAY;
 
 	/* compute hour */
@@ -315,156 +260,58 @@ int local_datetime(TIMESTAMP ts, DATETIME *dt)
 
 	/* compute second */
 	dt->second = (unsigned short)rem / TS_SECOND;
-	rem %= SECOND;
-
-	/* compute nanosecond */
-	dt->nanosecond = (unsigned int)(rem * 1e9);
 
 	/* determine timezone */
 	strncpy(dt->tz, tzvalid ? (dt->is_dst ? tzdst : tzstd) : "GMT", sizeof(dt->tz));
 
 	/* timezone offset in seconds */
-	dt->tzoffset = (int)(tzoffset - (isdst(dt->timestamp)?3600:0));
+	dt->tzoffset = (int)(tzoffset - (dst?3600:0));
 
-#ifdef USE_TS_CACHE
-	/* cache result */
-	old_ts = ts;
-	memcpy(&old_dt,dt,sizeof(old_dt));
-#endif
 	return 1;
 }
 
 /** Converts a GMT timestamp to local datetime struct
 	Adjusts to TZ if possible
-	deltamode-type version - populates nanoseconds
+
+	Each thread keeps the most recent conversions, so the many calls made
+	with the same clock during a timestep only compute the calendar once.
  **/
-int local_datetime_delta(double tsdbl, DATETIME *dt)
+int local_datetime(TIMESTAMP ts, DATETIME *dt)
 {
-
-	int64 n;
-	TIMESTAMP ts;
-	TIMESTAMP rem = 0;
-	TIMESTAMP local;
-	int tsyear;
-
-#ifdef USE_TS_CACHE
-	/* allow caching */
-	static TIMESTAMP old_ts =0;
-	static DATETIME old_dt;
-#endif
-
-	/*Get the cast version*/
-	ts = (TIMESTAMP)tsdbl;
-
-	if( ts == TS_NEVER || ts==TS_ZERO )
-		return 0;
-
-	if( dt==nullptr || ts<TS_ZERO || ts>TS_MAX ) /* no buffer or timestamp out of range */
-	{
-		output_error("local_datetime_delta(ts=%lli,...): invalid local_datetime request",ts);
-		return 0;
-	}
-#ifdef USE_TS_CACHE
-	/* check cache */
-	if (old_ts == ts && old_ts!=0)
-		memcpy(dt,&old_dt,sizeof(DATETIME));
-	else
-		old_ts = 0;
-#endif
-
-	local = LOCALTIME(ts);
-	tsyear = timestamp_year(local, &rem);
-
-	if (rem < 0)
+	TSCACHE *item = &tscache[(ts^(ts>>7)^(ts>>13))&(TSCACHE_SIZE-1)];
+	if ( dt!=nullptr && item->ts==ts && item->generation==tzgeneration )
 	{
-		// DPC: note that as of 3.0, the clock is initialized by default, so this error can only
-		//      occur when an invalid timestamp is being converted to local time.  It should no
-		//      longer occur as a result of a missing clock directive.
-		//THROW("local_datetime_delta(ts=%lli, ...): invalid timestamp cannot be converted to local time", ts);
-		/*	TROUBLESHOOT
-			This is the result of an internal core or module coding error which resulted in an
-			invalid UTC clock time being converted to local time.
-		*/
-		output_error("local_datetime_delta(ts=%lli,...): invalid local_datetime request",ts);
-		return 0;
-	}
-
-	if(ts < TS_ZERO && ts > TS_MAX){ /* timestamp out of range */
-		return 0;
+		*dt = item->dt;
+		return 1;
 	}
-	
-	if(ts == TS_NEVER){
+	if ( !local_calendar(ts,dt,"local_datetime") )
 		return 0;
-	}
 
-	/* ts is valid */
-	dt->timestamp = ts;
-
-	/* DST? */
-	dt->is_dst = (tzvalid && isdst(ts));
-
-	/* compute year */
-	dt->year = tsyear;
-
-	/* yearday and weekday */
-	dt->yearday = (unsigned short)(rem / DAY);
-	dt->weekday = (unsigned short)((local / DAY + DOW0 + 7) % 7);
-
-	/* compute month */
-	dt->month = 0;
-	n = daysinmonth[0] * DAY;
-	while(rem >= n){
-		rem -= n; /* subtract n ticks from ts */
-		dt->month++; /* add to month */
-		if(dt->month == 12){
-			dt->month = 0;
-			++dt->year;
-		}
-		n = (daysinmonth[dt->month] + ((dt->month == 1 && ISLEAPYEAR(dt->year)) ? 1:0)) * 86400 * TS_SECOND;
-		if(n < 86400 * 28){ /**/
-			output_fatal("Breaking an infinite loop in local_datetime_delta! (ts = %" FMT_INT64 "ds", ts);
-			/*	TROUBLESHOOT
-				An internal protection against infinite loops in the time calculation
-				module has encountered a critical problem.  This is often caused by
-				an incorrectly initialized timezone system, a missing timezone specification before
-				a timestamp was used, or a missing timezone localization in your system.
-				Correct the timezone problem and try again.
-			 */
-			return 0;
-		}
-	}
-	dt->month++; /* Jan=1 */
-
-	/* compute day */
-	dt->day = (unsigned short)(rem / DAY + 1);
-	rem %= DAY;
+	/* compute nanosecond */
+	dt->nanosecond = (unsigned int)((ts%SECOND) * 1e9);
 
-	/* compute hour */
-	dt->hour = (unsigned short)(rem / HOUR);
-	rem %= HOUR;
+	/* cache result */
+	item->ts = ts;
+	item->generation = tzgeneration;
+	item->dt = *dt;
+	return 1;
+}
 
-	/* compute minute */
-	dt->minute = (unsigned short)(rem / MINUTE);
-	rem %= MINUTE;
+/** Converts a GMT timestamp to local datetime struct
+	Adjusts to TZ if possible
+	deltamode-type version - populates nanoseconds
+ **/
+int local_datetime_delta(double tsdbl, DATETIME *dt)
+{
+	/*Get the cast version*/
+	TIMESTAMP ts = (TIMESTAMP)tsdbl;
 
-	/* compute second */
-	dt->second = (unsigned short)rem / TS_SECOND;
-	rem %= SECOND;
+	if ( !local_calendar(ts,dt,"local_datetime_delta") )
+		return 0;
 
 	/* compute nanosecond */
 	dt->nanosecond = (unsigned int)((tsdbl - (double)(ts))*1e9 + 0.5);
 
-	/* determine timezone */
-	strncpy(dt->tz, tzvalid ? (dt->is_dst ? tzdst : tzstd) : "GMT", sizeof(dt->tz));
-
-	/* timezone offset in seconds */
-	dt->tzoffset = (int)(tzoffset - (isdst(dt->timestamp)?3600:0));
-
-#ifdef USE_TS_CACHE
-	/* cache result */
-	old_ts = ts;
-	memcpy(&old_dt,dt,sizeof(old_dt));
-#endif
 	return 1;
 }
 
@@ -970,6 +817,12 @@ void load_tzspecs(char *tz){
 	}
 
 	fclose(fp);
+
+	// note which years have DST ending in the following year
+	for (y = 0; y < sizeof(tszero) / sizeof(tszero[0]); y++){
+		dstsouth[y] = ( dststart[y] >= 0 && dstend[y] >= 0 && timestamp_year(dststart[y],nullptr) != timestamp_year(dstend[y],nullptr) );
+	}
+	tzgeneration++;
 	tzvalid = 1;
 }
 
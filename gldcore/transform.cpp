@@ -8,6 +8,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <map>
+#include <queue>
+#include <vector>
 #include <pthread.h>
 
 #include "platform.h"
@@ -20,6 +23,7 @@
 #include "exec.h"
 
 static TRANSFORM *schedule_xformlist=nullptr;
+static bool transform_changed = true; ///< transform list changed since the dispatch was built
 
 /****************************************************************
  * GridLAB-D Variable Handling for transform functions
@@ -256,6 +260,7 @@ int transform_add_filter(OBJECT *target_obj,		/* pointer to the target object (l
 	xform->t2_dbl = floor((double)global_starttime/tf->timestep)*tf->timestep + tf->timeskew;
 	xform->next = schedule_xformlist;
 	schedule_xformlist = xform;
+	transform_changed = true;
 
 	if ( global_debug_output )
 	{
@@ -305,6 +310,7 @@ int transform_add_external(	OBJECT *target_obj,		/* pointer to the target object
 
 	xform->next = schedule_xformlist;
 	schedule_xformlist = xform;
+	transform_changed = true;
 	output_debug("added external transform %s:%s <- %s(%s:%s)", object_name(target_obj,buffer1,sizeof(buffer1)),target_prop->name,function, object_name(source_obj,buffer2,sizeof(buffer2)),source_prop->name);
 	return 1;
 }
@@ -335,6 +341,7 @@ int transform_add_linear(	TRANSFORMSOURCE stype,	/* specifies the type of source
 	xform->function_type = XT_LINEAR;
 	xform->next = schedule_xformlist;
 	schedule_xformlist = xform;
+	transform_changed = true;
 	output_debug("added linear transform %s:%s <- scale=%.3g, bias=%.3g", object_name(obj,buffer,sizeof(buffer)), prop->name, scale, bias);
 	return 1;
 }
@@ -449,14 +456,134 @@ TIMESTAMP transform_apply(TIMESTAMP t1, TRANSFORM *xform, double *source, double
 	return t2;
 }
 
+/****************************************************************
+ * Transform dispatch
+ *
+ * Schedule transforms are grouped by source schedule and skew so that
+ * one schedule lookup feeds all the targets of a group.  When
+ * transform_events is set, the groups of schedules that are neither
+ * skewed nor interpolated are kept in a queue ordered by the time of
+ * the next schedule change, and their targets are only updated when
+ * the schedule value changes.  All other transforms are updated on
+ * every sync.
+ ****************************************************************/
+
+/// schedule transforms that share a source schedule and skew
+typedef struct s_schedulegroup {
+	SCHEDULE *schedule; ///< source schedule
+	TIMESTAMP skew; ///< schedule skew of the targets
+	bool applied; ///< value has been applied at least once
+	double value; ///< last value applied
+	std::vector<TRANSFORM*> xforms; ///< transforms fed by the schedule
+} SCHEDULEGROUP;
+
+typedef std::pair<TIMESTAMP,SCHEDULEGROUP*> TRANSFORMEVENT;
+
+static std::vector<TRANSFORM*> transform_list; ///< transforms not sourced by a schedule
+static std::vector<SCHEDULEGROUP*> transform_groups; ///< schedule groups updated on every sync
+static std::priority_queue<TRANSFORMEVENT,std::vector<TRANSFORMEVENT>,std::greater<TRANSFORMEVENT> > transform_events; ///< schedule groups updated when the schedule changes
+
+/** Build the transform dispatch from the transform list
+ **/
+static void transform_index(void)
+{
+	for ( std::vector<SCHEDULEGROUP*>::iterator group=transform_groups.begin() ; group!=transform_groups.end() ; group++ )
+		delete *group;
+	for ( ; !transform_events.empty() ; transform_events.pop() )
+		delete transform_events.top().second;
+	transform_list.clear();
+	transform_groups.clear();
+
+	// the list is in reverse order of creation
+	std::vector<TRANSFORM*> xforms;
+	for ( TRANSFORM *xform=schedule_xformlist ; xform!=nullptr ; xform=xform->next )
+		xforms.push_back(xform);
+	std::map<std::pair<SCHEDULE*,TIMESTAMP>,SCHEDULEGROUP*> groups;
+	for ( std::vector<TRANSFORM*>::reverse_iterator item=xforms.rbegin() ; item!=xforms.rend() ; item++ )
+	{
+		TRANSFORM *xform = *item;
+		if ( xform->source_type!=XS_SCHEDULE )
+		{
+			transform_list.push_back(xform);
+			continue;
+		}
+		std::pair<SCHEDULE*,TIMESTAMP> key(xform->source_schedule,xform->target_obj->schedule_skew);
+		SCHEDULEGROUP *&group = groups[key];
+		if ( group==nullptr )
+		{
+			group = new SCHEDULEGROUP;
+			group->schedule = key.first;
+			group->skew = key.second;
+			group->applied = false;
+			group->value = 0.0;
+			if ( global_transform_events && group->skew==0 && (group->schedule->flags&SN_INTERPOLATED)==0 )
+				transform_events.push(TRANSFORMEVENT(TS_ZERO,group));
+			else
+				transform_groups.push_back(group);
+		}
+		group->xforms.push_back(xform);
+	}
+	output_debug("transform_index(): %d schedule groups updated on change, %d updated on sync, %d other transforms",
+		(int)transform_events.size(), (int)transform_groups.size(), (int)transform_list.size());
+	transform_changed = false;
+}
+
+/** Apply a transform and update the next update times
+	@return false on error
+ **/
+static bool transform_update(TIMESTAMP t1, TRANSFORM *xform, double *source, double t1_dbl, TIMESTAMP &t2, double &t2_dbl)
+{
+	double t_dbl = t1_dbl;
+	TIMESTAMP t = transform_apply(t1,xform,source,&t_dbl);
+	if ( t==TS_INVALID )
+		return false;
+	if ( t<t2 )
+		t2 = t;
+	if ( t1_dbl>0.0 && t_dbl<t2_dbl )
+		t2_dbl = t_dbl;
+	return true;
+}
+
+/** Apply the transforms of a schedule group
+	@return false on error
+ **/
+static bool transform_update_group(TIMESTAMP t1, SCHEDULEGROUP *group, double t1_dbl, TIMESTAMP &t2, double &t2_dbl)
+{
+	SCHEDULE *sch = group->schedule;
+	double value, *source = nullptr;
+	if ( group->skew!=0 )
+	{
+		TIMESTAMP tskew = t1 - group->skew; // subtract so the +12 is 'twelve seconds later', not earlier
+		SCHEDULEINDEX index = schedule_index(sch,tskew);
+		int32 dtnext = schedule_dtnext(sch,index)*60;
+		TIMESTAMP t = (dtnext == 0 ? TS_NEVER : t1 + dtnext - (tskew % 60));
+		if ( t<t2 )
+		{
+			t2 = t;
+			if ( t1_dbl>0.0 && (double)t<t2_dbl )
+				t2_dbl = (double)t;
+		}
+		if ( tskew<=sch->since || tskew>=sch->next_t )
+		{
+			value = schedule_value(sch,index);
+			source = &value;
+		}
+	}
+	for ( std::vector<TRANSFORM*>::iterator xform=group->xforms.begin() ; xform!=group->xforms.end() ; xform++ )
+	{
+		if ( !transform_update(t1,*xform,source,t1_dbl,t2,t2_dbl) )
+			return false;
+	}
+	group->applied = true;
+	group->value = sch->value;
+	return true;
+}
+
 clock_t transform_synctime = 0;
 TIMESTAMP transform_syncall(TIMESTAMP t1, TRANSFORMSOURCE source, double *t1_dbl)
 {
-	TRANSFORM *xform;
 	clock_t start = (clock_t)exec_clock();
 	TIMESTAMP t2 = TS_NEVER;
-	TIMESTAMP tskew, tSkewSince, tSkewNext, t;
-	double t_delta_var_time;
 	double t1_dbl_store;
 	double t2_dbl_time = TS_NEVER_DBL;
 
@@ -482,102 +609,40 @@ TIMESTAMP transform_syncall(TIMESTAMP t1, TRANSFORMSOURCE source, double *t1_dbl
 		t1_dbl_store = -1.0;
 	}
 
+	if ( transform_changed )
+		transform_index();
+
 	/* process the schedule transformations */
-	for (xform=schedule_xformlist; xform!=nullptr; xform=xform->next)
-	{	
-		//Update deltamode tracker variable
-		t_delta_var_time = t1_dbl_store;
-
-		if (xform->source_type&source){
-			if((xform->source_type == XS_SCHEDULE) && (xform->target_obj->schedule_skew != 0)){
-			    tskew = t1 - xform->target_obj->schedule_skew; // subtract so the +12 is 'twelve seconds later', not earlier
-			    SCHEDULEINDEX index = schedule_index(xform->source_schedule,tskew);
-			    int32 dtnext = schedule_dtnext(xform->source_schedule,index)*60;
-			    double value = schedule_value(xform->source_schedule,index);
-			    t = (dtnext == 0 ? TS_NEVER : t1 + dtnext - (tskew % 60));
-			    if ( t < t2 )
-				{
-					t2 = t;
-
-					//Deltamode update, if needed
-					if (t1_dbl_store > 0.0)
-					{
-						//Cast double
-						t_delta_var_time = (double)t2;
-
-						//See if the return time needs updating
-						if (t_delta_var_time < t2_dbl_time)
-						{
-							t2_dbl_time = t_delta_var_time;
-						}
-
-						//Reset the variable, in case there's a skew
-						t_delta_var_time = t1_dbl_store;
-					}
-				}
-				
-				if((tskew <= xform->source_schedule->since) || (tskew >= xform->source_schedule->next_t)){
-					t = transform_apply(t1,xform,&value,&t_delta_var_time);
-
-					//Error check
-					if (t==TS_INVALID)
-						return TS_INVALID;
-
-					//Update return time	
-					if ( t<t2 ) t2=t;
-
-					//Deltamode update, if needed
-					if (t1_dbl_store > 0.0)
-					{
-						//See if the return time needs updating
-						if (t_delta_var_time < t2_dbl_time)
-						{
-							t2_dbl_time = t_delta_var_time;
-						}
-					}
-				} 
-				else 
-				{
-					t = transform_apply(t1,xform,nullptr,&t_delta_var_time);
-
-					//Error check
-					if (t==TS_INVALID)
-						return TS_INVALID;
-
-					//Update return time	
-					if ( t<t2 ) t2=t;
-
-					//Deltamode update, if needed
-					if (t1_dbl_store > 0.0)
-					{
-						//See if the return time needs updating
-						if (t_delta_var_time < t2_dbl_time)
-						{
-							t2_dbl_time = t_delta_var_time;
-						}
-					}
-				}
-			} else {
-				t = transform_apply(t1,xform,nullptr,&t_delta_var_time);
-
-				//Error check
-				if (t==TS_INVALID)
-					return TS_INVALID;
+	if ( source&XS_SCHEDULE )
+	{
+		for ( std::vector<SCHEDULEGROUP*>::iterator group=transform_groups.begin() ; group!=transform_groups.end() ; group++ )
+		{
+			if ( !transform_update_group(t1,*group,t1_dbl_store,t2,t2_dbl_time) )
+				return TS_INVALID;
+		}
 
-				//Update return time	
-				if ( t<t2 ) t2=t;
-
-				//Deltamode update, if needed
-				if (t1_dbl_store > 0.0)
-				{
-					//See if the return time needs updating
-					if (t_delta_var_time < t2_dbl_time)
-					{
-						t2_dbl_time = t_delta_var_time;
-					}
-				}
+		// schedules that have not changed yet are checked again on the next sync
+		std::vector<TRANSFORMEVENT> pending;
+		while ( !transform_events.empty() && transform_events.top().first<=t1 )
+		{
+			SCHEDULEGROUP *group = transform_events.top().second;
+			transform_events.pop();
+			if ( !group->applied || group->value!=group->schedule->value )
+			{
+				if ( !transform_update_group(t1,group,t1_dbl_store,t2,t2_dbl_time) )
+					return TS_INVALID;
 			}
+			pending.push_back(TRANSFORMEVENT(group->schedule->next_t,group));
 		}
+		for ( std::vector<TRANSFORMEVENT>::iterator event=pending.begin() ; event!=pending.end() ; event++ )
+			transform_events.push(*event);
+	}
+
+	/* process the other transformations */
+	for ( std::vector<TRANSFORM*>::iterator xform=transform_list.begin() ; xform!=transform_list.end() ; xform++ )
+	{
+		if ( ((*xform)->source_type&source) && !transform_update(t1,*xform,nullptr,t1_dbl_store,t2,t2_dbl_time) )
+			return TS_INVALID;
 	}
 	transform_synctime += (clock_t)exec_clock() - start;
 
@@ -192,7 +192,7 @@ EXPORT jlong JNICALL Java_gridlabd_GObject__1GetFlags(JNIEnv *env, jclass _this,
 
 EXPORT void JNICALL Java_gridlabd_GObject__1SetParent(JNIEnv *env, jclass _this, jlong oaddr, jlong paddr){
 	OBJECT *obj = (OBJECT *)oaddr;
-	obj->parent = (OBJECT *)paddr;
+	gl_set_parent(obj,(OBJECT *)paddr);
 }
 
 EXPORT void JNICALL Java_gridlabd_GObject__1SetFlags(JNIEnv *env, jclass _this, jlong oaddr, jint flags){
@@ -538,6 +538,9 @@ static bool import_objects(MYSQL *mysql)
 			first_object = obj;
 	}
 
+	// names, parents and groupids were written directly
+	gl_find_invalidate();
+
 	// load object properties
 	for ( OBJECT *obj=first_object ; obj!=nullptr ; obj=obj->next )
 	{
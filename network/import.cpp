@@ -184,6 +184,9 @@ int import_cdf(char *file)
 		p->sync(TS_NEVER);
 	}
 
+	// names and parents were written directly
+	gl_find_invalidate();
+
 	return errors>0 ? -errors : n_bus+n_branch;
 }
 EXPORT int import_file(char *file)
@@ -22,6 +22,8 @@ powerflow_powerflow_la_SOURCES += powerflow/capacitor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/capacitor.h
 powerflow_powerflow_la_SOURCES += powerflow/currdump.cpp
 powerflow_powerflow_la_SOURCES += powerflow/currdump.h
+powerflow_powerflow_la_SOURCES += powerflow/dump_stream.cpp
+powerflow_powerflow_la_SOURCES += powerflow/dump_stream.h
 powerflow_powerflow_la_SOURCES += powerflow/emissions.cpp
 powerflow_powerflow_la_SOURCES += powerflow/emissions.h
 powerflow_powerflow_la_SOURCES += powerflow/fault_check.cpp
@@ -85,6 +87,11 @@ powerflow_powerflow_la_SOURCES += powerflow/series_compensator.cpp
 powerflow_powerflow_la_SOURCES += powerflow/series_compensator.h
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.h
+powerflow_powerflow_la_SOURCES += powerflow/solver_fbs.cpp
+powerflow_powerflow_la_SOURCES += powerflow/solver_fbs.h
+powerflow_powerflow_la_SOURCES += powerflow/solver_lu.cpp
+powerflow_powerflow_la_SOURCES += powerflow/solver_lu.h
+powerflow_powerflow_la_SOURCES += powerflow/solver_workers.h
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.cpp
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.h
 powerflow_powerflow_la_SOURCES += powerflow/sync_check.cpp
@@ -124,3 +131,22 @@ powerflow_powerflow_la_SOURCES += powerflow/voltdump.cpp
 powerflow_powerflow_la_SOURCES += powerflow/voltdump.h
 powerflow_powerflow_la_SOURCES += powerflow/volt_var_control.cpp
 powerflow_powerflow_la_SOURCES += powerflow/volt_var_control.h
+
+noinst_PROGRAMS += powerflow/solver_nr_benchmark
+
+powerflow_solver_nr_benchmark_CPPFLAGS =
+powerflow_solver_nr_benchmark_CPPFLAGS += -I$(top_srcdir)/third_party/superLU_MT
+powerflow_solver_nr_benchmark_CPPFLAGS += $(AM_CPPFLAGS)
+
+powerflow_solver_nr_benchmark_LDADD =
+powerflow_solver_nr_benchmark_LDADD += third_party/superLU_MT/libsuperlu.la
+powerflow_solver_nr_benchmark_LDADD += $(PTHREAD_CFLAGS)
+powerflow_solver_nr_benchmark_LDADD += $(PTHREAD_LIBS)
+
+powerflow_solver_nr_benchmark_SOURCES =
+powerflow_solver_nr_benchmark_SOURCES += powerflow/solver_nr_benchmark.cpp
+powerflow_solver_nr_benchmark_SOURCES += powerflow/solver_lu.cpp
+powerflow_solver_nr_benchmark_SOURCES += powerflow/solver_lu.h
+powerflow_solver_nr_benchmark_SOURCES += powerflow/solver_workers.h
+powerflow_solver_nr_benchmark_SOURCES += powerflow/solver_nr.cpp
+powerflow_solver_nr_benchmark_SOURCES += powerflow/solver_nr.h
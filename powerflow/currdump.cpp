@@ -10,8 +10,10 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
 
 #include "currdump.h"
+#include "link.h"
 
 //////////////////////////////////////////////////////////////////////////
 // currdump CLASS FUNCTIONS
@@ -37,6 +39,8 @@ currdump::currdump(MODULE *mod)
 			PT_enumeration, "mode", PADDR(mode),
 				PT_KEYWORD, "RECT", (enumeration)CDM_RECT,
 				PT_KEYWORD, "POLAR", (enumeration)CDM_POLAR,
+			PT_int32,"threads",PADDR(threads),PT_DESCRIPTION,"the number of threads used to format the rows (0 uses all processors)",
+			PT_bool,"background",PADDR(background),PT_DESCRIPTION,"flag to write the file in the background while the simulation continues",
 			nullptr)<1) GL_THROW("unable to publish properties in %s",__FILE__);
 		
 	}
@@ -49,6 +53,9 @@ int currdump::create(void)
 	runtime = TS_NEVER;
 	runcount = 0;
 	mode = CDM_RECT;
+	threads = 1;
+	background = false;
+	stream = new dump_stream;
 	return 1;
 }
 
@@ -57,20 +64,48 @@ int currdump::init(OBJECT *parent)
 	return 1;
 }
 
+/// wait for a background write to complete and release the stream
+STATUS currdump::finalize(void)
+{
+	delete stream;
+	stream = nullptr;
+	return SUCCESS;
+}
+
 int currdump::isa(char *classname)
 {
 	return strcmp(classname,"currdump")==0;
 }
 
-void currdump::dump(TIMESTAMP t){
+/// row of the current dump
+typedef struct {
+	const char *name;
 	char namestr[128];
+	gld::complex *current; ///< current_in_A/B/C
+} CURRDUMPROW;
+
+typedef struct {
+	std::vector<CURRDUMPROW> *rows;
+	enumeration mode;
+} CURRDUMPDATA;
+
+static size_t currdump_row(void *data, size_t n, char *buffer, size_t len)
+{
+	CURRDUMPDATA *dump = (CURRDUMPDATA*)data;
+	CURRDUMPROW &row = (*dump->rows)[n];
+	gld::complex *i = row.current;
+	int size = 0;
+	if ( dump->mode == CDM_RECT )
+		size = snprintf(buffer,len,"%s,%f,%f,%f,%f,%f,%f\n",row.name,i[0].Re(),i[0].Im(),i[1].Re(),i[1].Im(),i[2].Re(),i[2].Im());
+	else if ( dump->mode == CDM_POLAR )
+		size = snprintf(buffer,len,"%s,%f,%f,%f,%f,%f,%f\n",row.name,i[0].Mag(),i[0].Arg(),i[1].Mag(),i[1].Arg(),i[2].Mag(),i[2].Arg());
+	return size<0 ? 0 : ( (size_t)size<len ? (size_t)size : len-1 );
+}
+
+void currdump::dump(TIMESTAMP t){
 	char timestr[64];
 	FINDLIST *links = nullptr;
 	OBJECT *obj = nullptr;
-	FILE *outfile = nullptr;
-
-	gld_property *link_current_value_link[3];
-	gld::complex link_current_values[3];
 
 	if(group[0] == 0){
 		links = gl_find_objects(FL_NEW,FT_MODULE,SAME,"powerflow",FT_END);
@@ -83,82 +118,52 @@ void currdump::dump(TIMESTAMP t){
 		return;
 	}
 
-	outfile = fopen(filename, "w");
-	if(outfile == nullptr){
+	if(!stream->open(filename, background)){
 		gl_error("currdump unable to open %s for output", filename.get_string());
+		gl_free(links);
 		return;
 	}
 
-	//nodeclass = node::oclass;
-	//vA=gl_find_property(nodeclass, "
-
 	/* print column names */
 	gl_printtime(t, timestr, 64);
-	fprintf(outfile,"# %s run at %s on %i links\n", filename.get_string(), timestr, links->hit_count);
+	stream->printf("# %s run at %s on %i links\n", filename.get_string(), timestr, links->hit_count);
 	if(mode == CDM_RECT){
-		fprintf(outfile,"link_name,currA_real,currA_imag,currB_real,currB_imag,currC_real,currC_imag\n");
+		stream->printf("link_name,currA_real,currA_imag,currB_real,currB_imag,currC_real,currC_imag\n");
 	}
 	else if (mode == CDM_POLAR){
-		fprintf(outfile,"link_name,currA_mag,currA_angle,currB_mag,currB_angle,currC_mag,currC_angle\n");
+		stream->printf("link_name,currA_mag,currA_angle,currB_mag,currB_angle,currC_mag,currC_angle\n");
 	}
+
+	//Collect the links
+	std::vector<CURRDUMPROW> rows;
+	rows.reserve(links->hit_count);
 	obj = 0;
 	while (obj=gl_find_next(links,obj)){
-		if(gl_object_isa(obj, "link", "powerflow")){
-
-			//Map the properties of interest - first current
-			link_current_value_link[0] = new gld_property(obj,"current_in_A");
-
-			//Check it
-			if (!link_current_value_link[0]->is_valid() || !link_current_value_link[0]->is_complex())
-			{
-				GL_THROW("currdump - Unable to map current property of link:%d - %s",obj->id,(obj->name ? obj->name : "Unnamed"));
-				/*  TROUBLESHOOT
-				While the currdump object attempted to map the current_in_A, current_in_B, or current_in_C, an error
-				occurred.  Please try again.  If the error persists, please submit your code via the ticketing and issues system.
-				*/
-			}
-
-			//Map the properties of interest - second current
-			link_current_value_link[1] = new gld_property(obj,"current_in_B");
-
-			//Check it
-			if (!link_current_value_link[1]->is_valid() || !link_current_value_link[1]->is_complex())
-			{
-				GL_THROW(const_cast<char*>("currdump - Unable to map current property of link:%d - %s"),obj->id,(obj->name ? obj->name : "Unnamed"));
-				//Defined above
-			}
-
-			//Map the properties of interest - third current
-			link_current_value_link[2] = new gld_property(obj,"current_in_C");
-
-			//Check it
-			if (!link_current_value_link[2]->is_valid() || !link_current_value_link[2]->is_complex())
-			{
-				GL_THROW(const_cast<char*>("currdump - Unable to map current property of link:%d - %s"),obj->id,(obj->name ? obj->name : "Unnamed"));
-				//Defined above
-			}
-
-			//Pull the values
-			link_current_values[0] = link_current_value_link[0]->get_complex();
-			link_current_values[1] = link_current_value_link[1]->get_complex();
-			link_current_values[2] = link_current_value_link[2]->get_complex();
-
-			if(obj->name == nullptr){
-				sprintf(namestr, "%s:%i", obj->oclass->name, obj->id);
-			}
-			if(mode == CDM_RECT){
-				fprintf(outfile,"%s,%f,%f,%f,%f,%f,%f\n",(obj->name ? obj->name : namestr),link_current_values[0].Re(),link_current_values[0].Im(),link_current_values[1].Re(),link_current_values[1].Im(),link_current_values[2].Re(),link_current_values[2].Im());
-			} else if (mode == CDM_POLAR){
-				fprintf(outfile,"%s,%f,%f,%f,%f,%f,%f\n",(obj->name ? obj->name : namestr),link_current_values[0].Mag(),link_current_values[0].Arg(),link_current_values[1].Mag(),link_current_values[1].Arg(),link_current_values[2].Mag(),link_current_values[2].Arg());
-			}
-
-			//Clear the properties found
-			delete link_current_value_link[0];
-			delete link_current_value_link[1];
-			delete link_current_value_link[2];
+		if(!gl_object_isa(obj, "link", "powerflow"))
+			continue;
+
+		CURRDUMPROW row;
+		if(obj->name == nullptr){
+			snprintf(row.namestr, sizeof(row.namestr), "%s:%i", obj->oclass->name, obj->id);
+			row.name = nullptr;
+		} else {
+			row.name = obj->name;
 		}
+		row.current = OBJECTDATA(obj,link_object)->read_I_in;
+		rows.push_back(row);
+	}
+	for ( std::vector<CURRDUMPROW>::iterator row=rows.begin() ; row!=rows.end() ; row++ )
+	{
+		if ( row->name==nullptr )
+			row->name = row->namestr;
+	}
+
+	CURRDUMPDATA data = {&rows, mode};
+	stream->rows(rows.size(), currdump_row, &data, threads);
+
+	if(!stream->close()){
+		gl_error("currdump unable to write %s", filename.get_string());
 	}
-	fclose(outfile);
 
 	//Free the list
 	gl_free(links);
@@ -238,6 +243,18 @@ EXPORT TIMESTAMP commit_currdump(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2){
 	}
 }
 
+EXPORT STATUS finalize_currdump(OBJECT *obj)
+{
+	try {
+		currdump *my = OBJECTDATA(obj,currdump);
+		return my->finalize();
+	}
+	catch (const char *msg) {
+		gl_error("finalize_currdump(obj=%d;%s): %s", obj->id, obj->name?obj->name:"unnamed", msg);
+		return FAILED;
+	}
+}
+
 EXPORT int isa_currdump(OBJECT *obj, char *classname)
 {
 	return OBJECTDATA(obj,currdump)->isa(classname);
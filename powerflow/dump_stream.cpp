@@ -0,0 +1,248 @@
+// $Id: dump_stream.cpp
+/**	Copyright (C) 2026 Battelle Memorial Institute
+	@file dump_stream.cpp
+	@{
+*/
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#include "dump_stream.h"
+
+#define DUMP_BLOCK_SIZE 0x100000 ///< size at which a text block is written (or a new one started)
+#define DUMP_ROW_CHUNK 4096 ///< rows formatted by a thread at a time
+#define DUMP_ROW_SIZE 1024 ///< longest row accepted from a row formatter
+
+dump_stream::dump_stream(void)
+{
+	fp = nullptr;
+	writer = nullptr;
+	background = false;
+	builder["commentStyle"] = "None";
+	builder["indentation"] = "";
+}
+
+dump_stream::~dump_stream(void)
+{
+	if ( fp!=nullptr )
+		close();
+	wait();
+}
+
+bool dump_stream::open(const char *name, bool in_background)
+{
+	// a previous background write may still be using its file
+	wait();
+	fp = fopen(name,"w");
+	if ( fp==nullptr )
+		return false;
+	filename = name;
+	background = in_background;
+	empty.clear();
+	return true;
+}
+
+/// complete the file, either now or in a background thread
+bool dump_stream::close(void)
+{
+	if ( fp==nullptr )
+		return false;
+	if ( background )
+	{
+		std::vector<std::string*> *pending = new std::vector<std::string*>;
+		pending->swap(blocks);
+		writer = new std::thread(write_blocks,fp,pending,new std::string(filename));
+		fp = nullptr;
+		return true;
+	}
+	flush();
+	bool ok = fclose(fp)==0;
+	fp = nullptr;
+	return ok;
+}
+
+/// wait for the background writer to finish
+void dump_stream::wait(void)
+{
+	if ( writer!=nullptr )
+	{
+		writer->join();
+		delete writer;
+		writer = nullptr;
+	}
+}
+
+void dump_stream::write_blocks(FILE *fp, std::vector<std::string*> *blocks, std::string *filename)
+{
+	bool ok = true;
+	for ( std::vector<std::string*>::iterator block=blocks->begin() ; block!=blocks->end() ; block++ )
+	{
+		if ( ok && fwrite((*block)->data(),1,(*block)->size(),fp)!=(*block)->size() )
+			ok = false;
+		delete *block;
+	}
+	if ( fclose(fp)!=0 )
+		ok = false;
+	if ( !ok )
+		gl_error("unable to write dump file '%s' (%s)", filename->c_str(), strerror(errno));
+	delete blocks;
+	delete filename;
+}
+
+std::string &dump_stream::tail(void)
+{
+	if ( blocks.empty() || blocks.back()->size()>=DUMP_BLOCK_SIZE )
+	{
+		if ( !background )
+			flush();
+		blocks.push_back(new std::string);
+		blocks.back()->reserve(DUMP_BLOCK_SIZE+DUMP_ROW_SIZE);
+	}
+	return *blocks.back();
+}
+
+/// write the blocks formatted so far
+void dump_stream::flush(void)
+{
+	if ( fp==nullptr )
+		return;
+	for ( std::vector<std::string*>::iterator block=blocks.begin() ; block!=blocks.end() ; block++ )
+	{
+		fwrite((*block)->data(),1,(*block)->size(),fp);
+		delete *block;
+	}
+	blocks.clear();
+}
+
+void dump_stream::printf(const char *format, ...)
+{
+	char buffer[DUMP_ROW_SIZE];
+	va_list ptr;
+	va_start(ptr,format);
+	int len = vsnprintf(buffer,sizeof(buffer),format,ptr);
+	va_end(ptr);
+	if ( len>=(int)sizeof(buffer) )
+		len = sizeof(buffer)-1;
+	if ( len>0 )
+		tail().append(buffer,len);
+}
+
+/** Format \p count rows in order.  With more than one thread, each thread
+	formats whole chunks of rows into its own text and the chunks are then
+	added in row order, so the output is the same as a serial dump.  A
+	\p threads value of 0 uses one thread per processor.
+ **/
+void dump_stream::rows(size_t count, DUMPROWFORMAT format, void *data, int threads)
+{
+	char buffer[DUMP_ROW_SIZE];
+	if ( threads==0 )
+		threads = (int)std::thread::hardware_concurrency();
+	size_t chunks = (count+DUMP_ROW_CHUNK-1)/DUMP_ROW_CHUNK;
+	if ( threads<=1 || chunks<2 )
+	{
+		for ( size_t n=0 ; n<count ; n++ )
+			tail().append(buffer,format(data,n,buffer,sizeof(buffer)));
+		return;
+	}
+
+	std::vector<std::string> text(chunks);
+	std::atomic<size_t> next(0);
+	auto worker = [&]() {
+		char line[DUMP_ROW_SIZE];
+		size_t chunk;
+		while ( (chunk=next++)<chunks )
+		{
+			size_t last = (chunk+1)*DUMP_ROW_CHUNK < count ? (chunk+1)*DUMP_ROW_CHUNK : count;
+			for ( size_t n=chunk*DUMP_ROW_CHUNK ; n<last ; n++ )
+				text[chunk].append(line,format(data,n,line,sizeof(line)));
+		}
+	};
+	std::vector<std::thread> pool;
+	for ( int n=1 ; n<threads && n<(int)chunks ; n++ )
+		pool.push_back(std::thread(worker));
+	worker();
+	for ( std::vector<std::thread>::iterator thread=pool.begin() ; thread!=pool.end() ; thread++ )
+		thread->join();
+	for ( size_t n=0 ; n<chunks ; n++ )
+		tail().append(text[n]);
+}
+
+void dump_stream::separator(const char *name)
+{
+	std::string &out = tail();
+	if ( !empty.empty() )
+	{
+		if ( !empty.back() )
+			out += ',';
+		empty.back() = false;
+	}
+	if ( name!=nullptr )
+	{
+		out += to_string(Json::Value(name));
+		out += ':';
+	}
+}
+
+void dump_stream::begin_object(const char *name)
+{
+	separator(name);
+	tail() += '{';
+	empty.push_back(true);
+}
+
+void dump_stream::end_object(void)
+{
+	tail() += '}';
+	empty.pop_back();
+}
+
+void dump_stream::begin_array(const char *name)
+{
+	separator(name);
+	tail() += '[';
+	empty.push_back(true);
+}
+
+/// finish the current array (an array with no element is written as null when \p empty_as_null is set)
+void dump_stream::end_array(bool empty_as_null)
+{
+	if ( empty_as_null && empty.back() )
+	{
+		// nothing was added since the opening bracket
+		blocks.back()->pop_back();
+		blocks.back()->append("null");
+	}
+	else
+		tail() += ']';
+	empty.pop_back();
+}
+
+void dump_stream::value(const char *name, const char *string)
+{
+	separator(name);
+	tail() += to_string(Json::Value(string));
+}
+
+/// add a record to the current array
+void dump_stream::append(const Json::Value &record)
+{
+	separator(nullptr);
+	tail() += to_string(record);
+}
+
+/// add a record already converted by to_string() to the current array
+void dump_stream::append_text(const std::string &json)
+{
+	separator(nullptr);
+	tail() += json;
+}
+
+std::string dump_stream::to_string(const Json::Value &record)
+{
+	return Json::writeString(builder,record);
+}
+
+/**@}*/
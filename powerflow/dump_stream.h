@@ -0,0 +1,64 @@
+// $Id: dump_stream.h
+//	Copyright (C) 2026 Battelle Memorial Institute
+
+#ifndef _DUMP_STREAM_H
+#define _DUMP_STREAM_H
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <json/json.h>
+
+#include "powerflow.h"
+
+/** Formats row \p n of a dump into \p buffer
+	@return number of characters written (less than \p len)
+ **/
+typedef size_t (*DUMPROWFORMAT)(void *data, size_t n, char *buffer, size_t len);
+
+/** Streaming writer for the powerflow dump objects.
+
+	Records are formatted as they are produced instead of being collected in
+	a document first, so the memory needed does not grow with the model.
+	Rows can be formatted by several threads (the text is still written in
+	row order), and the file can be written by a background thread so the
+	simulation continues while the dump reaches the disk.
+ **/
+class dump_stream
+{
+private:
+	FILE *fp;
+	std::string filename;
+	std::vector<std::string*> blocks; ///< formatted text not yet written
+	std::thread *writer; ///< background writer (if any)
+	bool background;
+	std::vector<bool> empty; ///< JSON containers that have no element yet
+	Json::StreamWriterBuilder builder;
+private:
+	std::string &tail(void);
+	void flush(void);
+	void separator(const char *name);
+	static void write_blocks(FILE *fp, std::vector<std::string*> *blocks, std::string *filename);
+public:
+	dump_stream(void);
+	~dump_stream(void);
+	bool open(const char *filename, bool background=false);
+	bool close(void);
+	void wait(void);
+
+	// CSV-style output
+	void printf(const char *format, ...);
+	void rows(size_t count, DUMPROWFORMAT format, void *data, int threads=1);
+
+	// JSON output
+	void begin_object(const char *name=NULL);
+	void end_object(void);
+	void begin_array(const char *name=NULL);
+	void end_array(bool empty_as_null=false);
+	void value(const char *name, const char *string);
+	void append(const Json::Value &record);
+	void append_text(const std::string &json);
+	std::string to_string(const Json::Value &record);
+};
+
+#endif // _DUMP_STREAM_H
@@ -39,6 +39,7 @@ fault_check::fault_check(MODULE *mod) : powerflow_object(mod)
 			PT_bool,"full_output_file",PADDR(full_print_output),PT_DESCRIPTION,"Flag to indicate if the output_filename report contains both supported and unsupported nodes -- if false, just does unsupported",
 			PT_bool,"grid_association",PADDR(grid_association_mode),PT_DESCRIPTION,"Flag to indicate if multiple, distinct grids are allowed in a GLM, or if anything not attached to the master swing is removed",
 			PT_object,"eventgen_object",PADDR(rel_eventgen),PT_DESCRIPTION,"Link to generic eventgen object to handle unexpected faults",
+			PT_int64,"incremental_supported_count",PADDR(topology_supported_count),PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of node phases flagged as supported by the incremental support checks",
 			nullptr) < 1) GL_THROW("unable to publish properties in %s",__FILE__);
 			if (gl_publish_function(oclass,"reliability_alterations",(FUNCTIONADDR)powerflow_alterations)==nullptr)
 				GL_THROW("Unable to publish remove from service function");
@@ -79,6 +80,13 @@ int fault_check::create(void)
 
 	force_reassociation = false;	//By default, don't need to reassociate
 
+	topology_links = nullptr;	//Incremental topology tracking is allocated by the first support check
+	topology_visit = nullptr;
+	topology_swing = 0x00;
+	topology_swing_node = -1;	//No check is current yet
+	topology_stamp = 0;
+	topology_supported_count = 0;
+
 	return result;
 }
 
@@ -432,186 +440,145 @@ TIMESTAMP fault_check::sync(TIMESTAMP t0)
 void fault_check::search_links(int node_int)
 {
 	unsigned int index, indexb;
-	bool both_handled, from_val, proceed_in;
-	int branch_val;
-	BRANCHDATA temp_branch;
-	unsigned char work_phases;
+	int node_val, branch_val, branch_int;
+	bool proceed_in;
+	unsigned char link_phases, work_phases;
+	std::vector<int> &work_list = topology_queue[0];
 
 	gl_verbose ("  fault_check::search_links:%s", NR_busdata[node_int].name);
-	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
-	{
-		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
-
-		proceed_in = false;			//Flag that we need to go the next link in
-
-		//Check for no phase or open condition
-		if (((temp_branch.phases & 0x07) != 0x00) && (*temp_branch.status == LS_CLOSED))
-		{
-			for (indexb=0; indexb<3; indexb++)	//Handle phases
-			{
-				work_phases = 0x04 >> indexb;	//Pull off the phase reference
 
-				if ((temp_branch.phases & work_phases) == work_phases)	//We are of the proper phase
-				{
-					both_handled = false;	//Reset flag
+	//Work list of the nodes whose support grew -- each is searched again, rather than recursing down every link
+	work_list.clear();
+	work_list.push_back(node_int);
 
-					//See which end we are, and if the other end has been handled
-					if (temp_branch.from == node_int)	//We're the from
-					{
-						from_val = true;	//Flag us as the from end (so we don't have to check it again later)
-					}
-					else	//Must be the to
-					{
-						from_val = false;	//Flag us as the to end (so we don't have to check it again later)
-					}
+	while (!work_list.empty())
+	{
+		node_val = work_list.back();
+		work_list.pop_back();
 
-					//See if both sides of this link are already set - if so, don't bother going back in
-					if ((Supported_Nodes[temp_branch.to][indexb]==1) && (Supported_Nodes[temp_branch.from][indexb]==1))
-						both_handled=true;
+		//Loop through the connectivity and populate appropriately
+		for (index=0; index<NR_busdata[node_val].Link_Table_Size; index++)	//parse through our connected link
+		{
+			branch_int = NR_busdata[node_val].Link_Table[index];
 
-					//If not handled, proceed with logic-ness
-					if (!both_handled)
-					{
-						//Figure out the indexing so we can tell what we are
-						if (from_val)	//From end
-						{
-							branch_val = temp_branch.to;
+			//Check for no phase or open condition
+			link_phases = topology_link_phases(branch_int);
+			if (link_phases == 0x00)
+				continue;
 
-							//See if our FROM end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.from][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
-						else	//To end
-						{
-							branch_val = temp_branch.from;
+			//Get our opposite end reference
+			if (NR_branchdata[branch_int].from == node_val)
+				branch_val = NR_branchdata[branch_int].to;
+			else
+				branch_val = NR_branchdata[branch_int].from;
 
-							//See if our TO end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.to][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
+			proceed_in = false;			//Flag that we need to go the next link in
 
-						//Flag us as connected
-						Supported_Nodes[branch_val][indexb] = 1;
+			for (indexb=0; indexb<3; indexb++)	//Handle phases
+			{
+				work_phases = 0x04 >> indexb;	//Pull off the phase reference
 
-					}//End both not handled (work to be done)
-				}//End are a proper phase
+				//Supported phase of the link reaching a node not flagged yet
+				if (((link_phases & work_phases) == work_phases) && (Supported_Nodes[node_val][indexb] == 1) && (Supported_Nodes[branch_val][indexb] != 1))
+				{
+					//Flag us as connected
+					Supported_Nodes[branch_val][indexb] = 1;
+					proceed_in = true;
+				}
 			}//End phase testloop
 
 			if (proceed_in)
-			{
-				//Recursion!!
-				search_links(branch_val);
-			}
-		}//End has phases test loop
-	}//End link table loop
+				work_list.push_back(branch_val);
+		}//End link table loop
+	}//End work list
 }
 
-//Mesh searching function -- checks to see how something was removed
-void fault_check::search_links_mesh(int node_int)
+//Phases a link can pass from node_int to node_value in the mesh check
+unsigned char fault_check::mesh_link_phases(int node_int, unsigned int device_value, unsigned int node_value)
 {
-	unsigned int index, device_value, node_value;
-	unsigned char temp_phases, temp_compare_phases, result_phases;
+	unsigned char temp_phases, result_phases;
 
-	gl_verbose ("  fault_check::search_links_mesh:%s", NR_busdata[node_int].name);
-	//Check our entry mode -- if grid association mode, do this as a recursion
-	if (!grid_association_mode)	//Nope, do "normally"
+	//Get initial phasing information - the ones that are available
+	if (*NR_branchdata[device_value].status == LS_CLOSED)
 	{
-		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
-		{
-			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
+		temp_phases = NR_branchdata[device_value].phases;
+	}
+	else
+	{
+		temp_phases = 0x00;
+	}
 
-			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
+	//See if either end has any valid phases
+	if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
+	{
+		//Are we a switch
+		if ((NR_branchdata[device_value].lnk_type == 4) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
+		{
+			if (*NR_branchdata[device_value].status == 1)
 			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].to;
+				temp_phases |= NR_branchdata[device_value].origphases & 0x07;
 			}
-			else	//Must be the TO side, so check from
+		}
+		else if (NR_branchdata[device_value].lnk_type == 3)	//Fuse
+		{
+			//See if it is "base closed"
+			if (*NR_branchdata[device_value].status == 1)
 			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].from;
-			}
+				//In-service -- see which phases are active and create a mask
+				result_phases = (((~NR_branchdata[device_value].faultphases) & 0x07) | 0xF8);
 
-			//Get initial phasing information - the ones that are available
+				//Mask out the original
+				temp_phases |= NR_branchdata[device_value].origphases & result_phases;
+			}
+			else	//Full open - just ignore it
+			{
+				temp_phases = 0x00;
+			}
+		}
+		else
+		{
+			//Make sure enabled - the copy possible phases
 			if (*NR_branchdata[device_value].status == LS_CLOSED)
 			{
-				temp_phases = NR_branchdata[device_value].phases;
+				temp_phases |= NR_branchdata[device_value].origphases & 0x07;
 			}
 			else
 			{
 				temp_phases = 0x00;
 			}
+		}
+	}
 
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
-			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 4) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else if (NR_branchdata[device_value].lnk_type == 3)	//Fuse
-				{
-					//See if it is "base closed"
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						//In-service -- see which phases are active and create a mask
-						result_phases = (((~NR_branchdata[device_value].faultphases) & 0x07) | 0xF8);
+	return temp_phases;
+}
 
-						//Mask out the original
-						temp_phases |= NR_branchdata[device_value].origphases & result_phases;
-					}
-					else	//Full open - just ignore it
-					{
-						temp_phases = 0x00;
-					}
-				}
-				else
-				{
-					//Make sure enabled - the copy possible phases
-					if (*NR_branchdata[device_value].status == LS_CLOSED)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-					else
-					{
-						temp_phases = 0x00;
-					}
-				}
-			}
+//Mesh searching function -- checks to see how something was removed
+//Phases spread from node_int to everything it reaches; each node is searched again only when its phases grow
+void fault_check::search_links_mesh(int node_int)
+{
+	unsigned int index, device_value, node_value;
+	int node_val;
+	unsigned char temp_compare_phases;
+	std::vector<int> &work_list = topology_queue[0];
 
-			//Populate the phase information
-			valid_phases[node_value] |= (valid_phases[node_int] & temp_phases);
-		}//End of node link table traversion
-	}//End not grid association mode
-	else	//Grid association mode
+	gl_verbose ("  fault_check::search_links_mesh:%s", NR_busdata[node_int].name);
+
+	work_list.clear();
+	work_list.push_back(node_int);
+
+	while (!work_list.empty())
 	{
+		node_val = work_list.back();
+		work_list.pop_back();
+
 		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+		for (index=0; index<NR_busdata[node_val].Link_Table_Size; index++)
 		{
 			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
+			device_value = NR_busdata[node_val].Link_Table[index];
 
 			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
+			if (node_val == NR_branchdata[device_value].from)
 			{
 				//Extract our index
 				node_value = NR_branchdata[device_value].to;
@@ -622,59 +589,8 @@ void fault_check::search_links_mesh(int node_int)
 				node_value = NR_branchdata[device_value].from;
 			}
 
-			//Get initial phasing information - the ones that are available
-			if (*NR_branchdata[device_value].status == LS_CLOSED)
-			{
-				temp_phases = NR_branchdata[device_value].phases;
-			}
-			else
-			{
-				temp_phases = 0x00;
-			}
-
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
-			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 4) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else if (NR_branchdata[device_value].lnk_type == 3)	//Fuse
-				{
-					//See if it is "base closed"
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						//In-service -- see which phases are active and create a mask
-						result_phases = (((~NR_branchdata[device_value].faultphases) & 0x07) | 0xF8);
-
-						//Mask out the original
-						temp_phases |= NR_branchdata[device_value].origphases & result_phases;
-					}
-					else	//Full open - just ignore it
-					{
-						temp_phases = 0x00;
-					}
-				}
-				else
-				{
-					//Make sure enabled - the copy possible phases
-					if (*NR_branchdata[device_value].status == LS_CLOSED)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-					else
-					{
-						temp_phases = 0x00;
-					}
-				}
-			}
-
-			//Check our "contributions" against the other end - use this to determine recursion
-			temp_compare_phases = (valid_phases[node_value] | (valid_phases[node_int] & temp_phases));
+			//Check our "contributions" against the other end - use this to determine the next search
+			temp_compare_phases = (valid_phases[node_value] | (valid_phases[node_val] & mesh_link_phases(node_val,device_value,node_value)));
 
 			//See if it is the same
 			if (valid_phases[node_value] != temp_compare_phases)
@@ -682,12 +598,12 @@ void fault_check::search_links_mesh(int node_int)
 				//Populate the phase information - store what we just did (no point doing twice)
 				valid_phases[node_value] = temp_compare_phases;
 
-				//Recurse in, do this node now
-				search_links_mesh(node_value);
+				//Search this node too
+				work_list.push_back(node_value);
 			}
 			//Default else -- they match, so don't bother
 		}//End of node link table traversion
-	}//End grid association mode
+	}//End work list
 }
 
 void fault_check::support_check(int swing_node_int)
@@ -696,6 +612,11 @@ void fault_check::support_check(int swing_node_int)
 	unsigned char phase_vals;
 
 	gl_verbose ("  fault_check::support_check:%s", NR_busdata[swing_node_int].name);
+
+	//Only update what the changed links affect, if the last check is still current
+	if (support_check_incremental(swing_node_int))
+		return;
+
 	//Reset the node status list
 	reset_support_check();
 
@@ -710,12 +631,252 @@ void fault_check::support_check(int swing_node_int)
 
 	//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
 	search_links(swing_node_int);
+
+	//Keep the link phases, so the next check only redoes what changed
+	topology_save(swing_node_int);
+}
+
+//Incremental version of support check -- applies the link changes since the last check one at a time.
+//A link gaining a phase between a supported and an unsupported node flags the unsupported side.  A link
+//losing a phase between two supported nodes searches both sides at once, one node each in turn, until the
+//sides meet (still connected) or one runs out: the side without the swing loses support, and only it is
+//fully searched.  Returns false if a full check is needed.
+bool fault_check::support_check_incremental(int swing_node_int)
+{
+	unsigned int index, indexb;
+	unsigned char new_phases, old_phases, phase_bit;
+	int changed_links;
+
+	//Make sure the last check is for this swing and its phases (and was a radial one)
+	if (!reliability_search_mode || (topology_links == nullptr) || (topology_swing_node != swing_node_int) || ((NR_busdata[swing_node_int].phases & 0x07) != topology_swing))
+		return false;
+
+	changed_links = 0;
+	for (index=0; index<NR_branch_count; index++)
+	{
+		new_phases = topology_link_phases(index);
+		old_phases = topology_links[index];
+
+		if (new_phases == old_phases)
+			continue;
+
+		changed_links++;
+
+		//Apply each phase change by itself, so the support always matches the links applied so far
+		for (indexb=0; indexb<3; indexb++)
+		{
+			phase_bit = 0x04 >> indexb;
+
+			if (((old_phases & phase_bit) == phase_bit) && ((new_phases & phase_bit) == 0x00))
+			{
+				topology_links[index] &= ~phase_bit;
+				topology_link_removed(index,indexb);
+			}
+			else if (((old_phases & phase_bit) == 0x00) && ((new_phases & phase_bit) == phase_bit))
+			{
+				topology_links[index] |= phase_bit;
+				topology_link_added(index,indexb);
+			}
+		}
+	}
+
+	gl_verbose("  fault_check::support_check_incremental:%d links changed", changed_links);
+	return true;
+}
+
+//Phases a link passes in the radial support check -- closed links pass their present phases
+unsigned char fault_check::topology_link_phases(int branch_int)
+{
+	if (*NR_branchdata[branch_int].status == LS_CLOSED)
+		return (NR_branchdata[branch_int].phases & 0x07);
+	else
+		return 0x00;
+}
+
+//Node across a link (by link table index) that passes the phase in the last check, or -1 if it does not
+int fault_check::topology_neighbor(int node_int, unsigned int index, unsigned char phase_bit)
+{
+	int branch_int = NR_busdata[node_int].Link_Table[index];
+
+	if ((topology_links[branch_int] & phase_bit) == 0x00)
+		return -1;
+	else if (NR_branchdata[branch_int].from == node_int)
+		return NR_branchdata[branch_int].to;
+	else
+		return NR_branchdata[branch_int].from;
+}
+
+//Flags a phase of the nodes connected to node_int -- supported (1), or unsupported (0, or 2 if the node never had the phase)
+void fault_check::topology_mark(int node_int, unsigned int phase_index, unsigned int value)
+{
+	unsigned int index, head;
+	int node_val, node_next;
+	unsigned char phase_bit = 0x04 >> phase_index;
+	unsigned int stamp = topology_next_stamp();
+	std::vector<int> &work_list = topology_queue[0];
+
+	work_list.clear();
+	work_list.push_back(node_int);
+	topology_visit[node_int] = stamp;
+
+	for (head=0; head<work_list.size(); head++)
+	{
+		node_val = work_list[head];
+
+		if (value == 1)
+			Supported_Nodes[node_val][phase_index] = 1;
+		else
+			Supported_Nodes[node_val][phase_index] = ((NR_busdata[node_val].origphases & phase_bit) == phase_bit) ? 0 : 2;
+
+		for (index=0; index<NR_busdata[node_val].Link_Table_Size; index++)
+		{
+			node_next = topology_neighbor(node_val,index,phase_bit);
+
+			if ((node_next < 0) || (topology_visit[node_next] == stamp))
+				continue;
+
+			//Supported nodes are already flagged -- stay in the newly energized part
+			if ((value == 1) && (Supported_Nodes[node_next][phase_index] == 1))
+				continue;
+
+			topology_visit[node_next] = stamp;
+			work_list.push_back(node_next);
+		}
+	}
+
+	if (value == 1)
+		topology_supported_count += work_list.size();
+
+	gl_verbose("  fault_check::topology_mark:%d nodes %s", (int)work_list.size(), (value == 1) ? "supported" : "unsupported");
+}
+
+//Updates support after a link gains a phase -- only a link joining a supported node to an unsupported one changes anything
+void fault_check::topology_link_added(int branch_int, unsigned int phase_index)
+{
+	int from_node = NR_branchdata[branch_int].from;
+	int to_node = NR_branchdata[branch_int].to;
+	bool from_supported = (Supported_Nodes[from_node][phase_index] == 1);
+	bool to_supported = (Supported_Nodes[to_node][phase_index] == 1);
+
+	if (from_supported && !to_supported)
+		topology_mark(to_node,phase_index,1);
+	else if (to_supported && !from_supported)
+		topology_mark(from_node,phase_index,1);
+	//Default else -- both sides were already connected to the same things
+}
+
+//Updates support after a link loses a phase -- only a link between supported nodes can split off an unsupported part
+void fault_check::topology_link_removed(int branch_int, unsigned int phase_index)
+{
+	unsigned int index, side, head[2];
+	unsigned int stamp[2];
+	int node_val, node_next;
+	bool has_swing[2];
+	unsigned char phase_bit = 0x04 >> phase_index;
+	int end_node[2] = {NR_branchdata[branch_int].from, NR_branchdata[branch_int].to};
+
+	if ((end_node[0] == end_node[1]) || (Supported_Nodes[end_node[0]][phase_index] != 1) || (Supported_Nodes[end_node[1]][phase_index] != 1))
+		return;
+
+	//Search from both ends, one node per side in turn
+	stamp[0] = topology_next_stamp();
+	stamp[1] = topology_next_stamp();
+	for (side=0; side<2; side++)
+	{
+		topology_queue[side].clear();
+		topology_queue[side].push_back(end_node[side]);
+		topology_visit[end_node[side]] = stamp[side];
+		has_swing[side] = (end_node[side] == topology_swing_node);
+		head[side] = 0;
+	}
+
+	side = 0;
+	while (head[side] < topology_queue[side].size())	//Stops when the side whose turn it is runs out
+	{
+		node_val = topology_queue[side][head[side]++];
+
+		for (index=0; index<NR_busdata[node_val].Link_Table_Size; index++)
+		{
+			node_next = topology_neighbor(node_val,index,phase_bit);
+
+			if ((node_next < 0) || (topology_visit[node_next] == stamp[side]))
+				continue;
+
+			if (topology_visit[node_next] == stamp[1-side])	//The sides met -- still connected, nothing changes
+				return;
+
+			topology_visit[node_next] = stamp[side];
+			topology_queue[side].push_back(node_next);
+
+			if (node_next == topology_swing_node)
+				has_swing[side] = true;
+		}
+
+		side = 1 - side;
+	}
+
+	//This side ran out without meeting the other -- the side without the swing lost its support
+	if (has_swing[side])
+		side = 1 - side;
+
+	topology_mark(end_node[side],phase_index,0);
+}
+
+//Stores the link phases of a completed radial check
+void fault_check::topology_save(int swing_node_int)
+{
+	unsigned int index;
+
+	if (!reliability_search_mode)
+		return;
+
+	//Allocate on first use
+	if (topology_links == nullptr)
+	{
+		topology_links = (unsigned char*)gl_malloc(NR_branch_count*sizeof(unsigned char));
+		topology_visit = (unsigned int*)gl_malloc(NR_bus_count*sizeof(unsigned int));
+
+		if ((topology_links == nullptr) || (topology_visit == nullptr))
+		{
+			GL_THROW("fault_check: topology tracking vector allocation failure");
+			/*  TROUBLESHOOT
+			The fault_check object has failed to allocate the vectors used to update the node support
+			incrementally.  Please try again and if the problem persists, submit your code and a bug
+			report via the ticketing system.
+			*/
+		}
+
+		for (index=0; index<NR_bus_count; index++)
+			topology_visit[index] = 0;
+		topology_stamp = 0;
+	}
+
+	for (index=0; index<NR_branch_count; index++)
+		topology_links[index] = topology_link_phases(index);
+
+	topology_swing = NR_busdata[swing_node_int].phases & 0x07;
+	topology_swing_node = swing_node_int;
+}
+
+//Gets a new search stamp -- clears the stamps when they wrap around
+unsigned int fault_check::topology_next_stamp(void)
+{
+	unsigned int index;
+
+	topology_stamp++;
+	if (topology_stamp == 0)
+	{
+		for (index=0; index<NR_bus_count; index++)
+			topology_visit[index] = 0;
+		topology_stamp = 1;
+	}
+	return topology_stamp;
 }
 
 //Mesh-capable version of support check -- by default, it doesn't support restoration object
 void fault_check::support_check_mesh(void)
 {
-	unsigned int indexa, indexb;
+	unsigned int indexa;
 
 	gl_verbose ("  fault_check::support_check_mesh");
 	//Reset the node status list
@@ -727,15 +888,8 @@ void fault_check::support_check_mesh(void)
 		valid_phases[0] = NR_busdata[0].phases & 0x07;
 
 		//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
-		//Supports possibly meshed topology - brute force method
-		for (indexa=0; indexa<NR_bus_count; indexa++)
-		{
-			for (indexb=0; indexb<NR_bus_count; indexb++)
-			{
-				//Call the search link on individual nodes
-				search_links_mesh(indexb);
-			}
-		}
+		//Supports possibly meshed topology - the search revisits nodes until no phases change
+		search_links_mesh(0);
 	}
 	else	//Grid association mode, do slightly different
 	{
@@ -766,6 +920,10 @@ void fault_check::reset_support_check(void)
 	unsigned int index;
 
 	gl_verbose ("  fault_check::reset_support_check");
+
+	//The support no longer matches the last check's links
+	topology_swing_node = -1;
+
 	//Reset the node - 0 = unsupported, 1 = supported (not populated here), 2 = N/A (no phase there)
 	for (index=0; index<NR_bus_count; index++)
 	{
@@ -1523,19 +1681,32 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 	unsigned int index;
 	bool both_handled, from_val;
 	int branch_val;
-	BRANCHDATA temp_branch;
+	BRANCHDATA *temp_branch;
 	unsigned char work_phases, phase_restrictions;
+	std::vector<std::pair<int,unsigned int> > search_stack;	//Nodes being searched and their next link -- keeps the order of the recursive search
 
 	gl_verbose ("  fault_check::support_search_links:%s:%s:%d", NR_busdata[node_int].name, NR_busdata[node_start].name, impact_mode);
-	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
+
+	search_stack.push_back(std::make_pair(node_int,0u));
+	while (!search_stack.empty())
 	{
-		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
+		node_int = search_stack.back().first;
+		index = search_stack.back().second;
+
+		//Done with this node, back to the one that led to it
+		if (index >= NR_busdata[node_int].Link_Table_Size)
+		{
+			search_stack.pop_back();
+			continue;
+		}
+		search_stack.back().second++;	//parse through our connected link
+
+		temp_branch = &NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
 
 		both_handled = false;	//Reset flag
 
 		//See which end we are, and if the other end has been handled
-		if (temp_branch.from == node_int)	//We're the from
+		if (temp_branch->from == node_int)	//We're the from
 		{
 			from_val = true;	//Flag us as the from end (so we don't have to check it again later)
 		}
@@ -1546,13 +1717,13 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 
 		if ((node_int == node_start) && !from_val)	//We're the TO side of the base node, Oh Noes!
 		{
-			Alteration_Nodes[temp_branch.from] = 1;	//Flag us to prevent future issues (not sure how they'd happen)
+			Alteration_Nodes[temp_branch->from] = 1;	//Flag us to prevent future issues (not sure how they'd happen)
 			continue;	//Nothing to do with this link, so I hereby render this iteration useless and proceed to skip it
 		}
 		else	//FROM side of any, or not the TO side as the base node
 		{
 			//See if both sides of this link are already set - if so, don't bother going back in
-			if ((Alteration_Nodes[temp_branch.to]==1) && (Alteration_Nodes[temp_branch.from]==1))
+			if ((Alteration_Nodes[temp_branch->to]==1) && (Alteration_Nodes[temp_branch->from]==1))
 				both_handled=true;
 		}
 
@@ -1562,15 +1733,15 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 			//Figure out the indexing so we can tell what we are
 			if (from_val)	//From end
 			{
-				branch_val = temp_branch.to;
+				branch_val = temp_branch->to;
 
 				if (!impact_mode)	//Removal time
 				{
 					//Make sure our FROM end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.from] == 1)
+					if (Alteration_Nodes[temp_branch->from] == 1)
 					{
 						//Remove our phase portions - determine by our FROM end
-						work_phases = NR_busdata[temp_branch.from].phases & 0x07;
+						work_phases = NR_busdata[temp_branch->from].phases & 0x07;
 
 						//See if we are split-phase
 						if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
@@ -1603,7 +1774,7 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						}
 
 						//Apply the change to the TO node
-						NR_busdata[temp_branch.to].phases &= work_phases;
+						NR_busdata[temp_branch->to].phases &= work_phases;
 					}//End FROM end is valid
 					else	//FROM end not valid - hope we get hit by something else later
 					{
@@ -1613,7 +1784,7 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 				else	//Restoration time
 				{
 					//Make sure our FROM end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.from] == 1)
+					if (Alteration_Nodes[temp_branch->from] == 1)
 					{
 						//Now see if we can even proceed - if we are a fault blocked area, then go no lower
 						phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
@@ -1635,9 +1806,9 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						else	//At least one phase is valid, proceed
 						{
 							//Restore our phase portions - determine by our FROM end and restrictions
-							work_phases = NR_busdata[temp_branch.from].phases & phase_restrictions;
+							work_phases = NR_busdata[temp_branch->from].phases & phase_restrictions;
 
-							if ((temp_branch.origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
+							if ((temp_branch->origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
 							{
 								if (work_phases != 0x00)
 									work_phases |= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0xE0);	//Mask in SPCT-type flags
@@ -1652,15 +1823,15 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 							//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
 							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
 							{
-								work_phases |= (NR_busdata[temp_branch.to].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
+								work_phases |= (NR_busdata[temp_branch->to].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
 							}
 							else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
 							{
-								work_phases |= (NR_busdata[temp_branch.to].origphases & 0x18);	//D
+								work_phases |= (NR_busdata[temp_branch->to].origphases & 0x18);	//D
 							}
 
 							//Apply the change to the TO node
-							NR_busdata[temp_branch.to].phases |= work_phases;
+							NR_busdata[temp_branch->to].phases |= work_phases;
 						}
 					}//End FROM end is valid
 					else	//FROM end not valid - hope we get hit by something else later
@@ -1671,17 +1842,17 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 			}//End FROM end
 			else	//To end
 			{
-				branch_val = temp_branch.from;
+				branch_val = temp_branch->from;
 
 				if (!impact_mode)	//Removal time
 				{
 					//Make sure our TO end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.to] == 1)	//Implies TO is done, but not FROM.  Basically indicates reverse flow or a mesh - not necessarily good (solver won't care)
+					if (Alteration_Nodes[temp_branch->to] == 1)	//Implies TO is done, but not FROM.  Basically indicates reverse flow or a mesh - not necessarily good (solver won't care)
 					{
 						//Remove our phase portions - determine by our TO end
-						work_phases = NR_busdata[temp_branch.to].phases & 0x07;
+						work_phases = NR_busdata[temp_branch->to].phases & 0x07;
 
-						if ((temp_branch.phases & 0x80) == 0x80)	//See if we are split phase - if so and no phases are present, remove that too for good measure
+						if ((temp_branch->phases & 0x80) == 0x80)	//See if we are split phase - if so and no phases are present, remove that too for good measure
 						{
 							if (work_phases != 0x00)
 								work_phases |= 0xA0;	//Add in the split phase flag
@@ -1704,7 +1875,7 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						}
 
 						//Apply the change to the FROM node
-						NR_busdata[temp_branch.from].phases &= work_phases;
+						NR_busdata[temp_branch->from].phases &= work_phases;
 					}//End TO end is valid
 					else	//TO end not valid - hope we get hit by something else later
 					{
@@ -1714,7 +1885,7 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 				else	//Restoration time
 				{
 					//Make sure our TO end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.to] == 1)
+					if (Alteration_Nodes[temp_branch->to] == 1)
 					{
 						//Now see if we can even proceed - if we are a fault blocked area, then go no lower
 						phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
@@ -1736,9 +1907,9 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						else	//At least one phase is valid, proceed
 						{
 							//Restore our phase portions - determine by our TO end and restrictions
-							work_phases = NR_busdata[temp_branch.to].phases & phase_restrictions;
+							work_phases = NR_busdata[temp_branch->to].phases & phase_restrictions;
 
-							if ((temp_branch.origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
+							if ((temp_branch->origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
 							{
 								if (work_phases != 0x00)
 									work_phases |= 0x80;	//Add in the split phase flag
@@ -1753,15 +1924,15 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 							//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
 							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
 							{
-								work_phases |= (NR_busdata[temp_branch.from].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
+								work_phases |= (NR_busdata[temp_branch->from].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
 							}
 							else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
 							{
-								work_phases |= (NR_busdata[temp_branch.from].origphases & 0x18);	//House?, D
+								work_phases |= (NR_busdata[temp_branch->from].origphases & 0x18);	//House?, D
 							}
 
 							//Apply the change to the TO node
-							NR_busdata[temp_branch.from].phases |= work_phases;
+							NR_busdata[temp_branch->from].phases |= work_phases;
 						}
 					}//End TO end is valid
 					else	//TO end not valid - hope we get hit by something else later
@@ -1777,10 +1948,10 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 			//Flag us as handled
 			Alteration_Nodes[branch_val] = 1;
 
-			//Recursion!!
-			support_search_links(branch_val,node_start,impact_mode);
+			//Search the other end before our next link
+			search_stack.push_back(std::make_pair(branch_val,0u));
 		}//End both not handled (work to be done)
-	}//End link table loop
+	}//End search
 }
 
 //Function to reset "touched" alteration variable
@@ -2145,15 +2316,27 @@ void fault_check::associate_grids(void)
 }
 
 //Multiple grid checking items - the actual crawler
-//This is recursively called
+//Searches depth-first, with an explicit stack of the nodes being searched
 void fault_check::search_associated_grids(unsigned int node_int, int grid_counter)
 {
 	unsigned int index;
 	int node_ref;
+	std::vector<std::pair<unsigned int,unsigned int> > search_stack;	//Nodes being searched and their next link
 
-	//Loop through the connection table for this node
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+	search_stack.push_back(std::make_pair(node_int,0u));
+	while (!search_stack.empty())
 	{
+		node_int = search_stack.back().first;
+		index = search_stack.back().second;
+
+		//Done with this node, back to the one that led to it
+		if (index >= NR_busdata[node_int].Link_Table_Size)
+		{
+			search_stack.pop_back();
+			continue;
+		}
+		search_stack.back().second++;
+
 		//See which end of the link we are
 		if (NR_branchdata[NR_busdata[node_int].Link_Table[index]].from == node_int)	//From end
 		{
@@ -2179,8 +2362,8 @@ void fault_check::search_associated_grids(unsigned int node_int, int grid_counte
 				//Also flag us, as the link, to be associated with this island
 				NR_branchdata[NR_busdata[node_int].Link_Table[index]].island_number = grid_counter;
 
-				//Recurse in
-				search_associated_grids(node_ref,grid_counter);
+				//Search the other end before our next link
+				search_stack.push_back(std::make_pair((unsigned int)node_ref,0u));
 			}
 			else if (NR_busdata[node_ref].island_number != grid_counter)
 			{
@@ -4,6 +4,8 @@
 #ifndef _FAULT_CHECK_H
 #define _FAULT_CHECK_H
 
+#include <vector>
+
 #include "powerflow.h"
 
 #define TIME_BUF_SIZE 64 // TODO: this ought to be in gridlabd.h, which has hard-coded value of 15 that is apparently too small
@@ -35,6 +37,7 @@ public:
 	bool grid_association_mode;		//Flag to see if fault_check should be checking for multiple grids, or just go on the "master swing" idea
 	bool full_print_output;			//Flag to determine if both supported and unsupported nodes get written to the output file
 	OBJECT *rel_eventgen;			//Eventgen object in reliability - allows "unscheduled" faults
+	int64 topology_supported_count;	//Number of node phases flagged as supported by the incremental updates
 
 	fault_check(MODULE *mod);
 	fault_check(CLASS *cl=oclass):powerflow_object(cl){};
@@ -44,6 +47,7 @@ public:
 	void search_links(int node_int);							//Function to check connectivity and support of nodes
 	void search_links_mesh(int node_int);						//Function to check connectivity and support of nodes, but more in the "mesh" sense
 	void support_check(int swing_node_int);						//Function that performs the connectivity check - this way so can be easily externally accessed
+	bool support_check_incremental(int swing_node_int);			//Function that updates the connectivity check for the links that changed since the last one
 	void support_check_mesh(void);								//Function that performs the connectivity check for not-so-radial systems
 	void reset_support_check(void);								//Function to re-init the support matrix
 	void write_output_file(TIMESTAMP tval, double tval_delta);	//Function to write out "unsupported" items
@@ -72,6 +76,23 @@ private:
 	FUNCTIONADDR restoration_fxn;	// Function address for restoration object reconfiguration call
 	bool force_reassociation;	//Flag to force the island reassociation -- used if an island was removed to renumber them
 	char time_buf[TIME_BUF_SIZE];  // to format verbose time stamp output (note: fault_check is a singleton object)
+
+	//Incremental topology tracking -- link phases seen by the last radial support check
+	unsigned char *topology_links;		//Phases each link passed in the last check (0x00 when open)
+	unsigned char topology_swing;		//Phases of the swing node in the last check
+	int topology_swing_node;			//Swing node of the last check (-1 when no check is current)
+	unsigned int *topology_visit;		//Search stamps of the nodes (avoids clearing a visited array per search)
+	unsigned int topology_stamp;		//Current search stamp
+	std::vector<int> topology_queue[2];	//Search work lists (two, for the side-by-side searches of link removals)
+
+	unsigned char topology_link_phases(int branch_int);									//Phases a link passes in the support check
+	int topology_neighbor(int node_int, unsigned int index, unsigned char phase_bit);		//Node across a link that passes a phase, or -1
+	void topology_mark(int node_int, unsigned int phase_index, unsigned int value);		//Flags the connected nodes of a phase
+	void topology_link_added(int branch_int, unsigned int phase_index);					//Updates support after a link gains a phase
+	void topology_link_removed(int branch_int, unsigned int phase_index);				//Updates support after a link loses a phase
+	void topology_save(int swing_node_int);												//Stores the link phases of a completed check
+	unsigned int topology_next_stamp(void);												//Gets a new search stamp
+	unsigned char mesh_link_phases(int node_int, unsigned int device_value, unsigned int node_value);	//Phases a link passes in the mesh check
 };
 
 EXPORT int powerflow_alterations(OBJECT *thisobj, int baselink,bool rest_mode);
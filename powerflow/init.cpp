@@ -91,7 +91,29 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create("powerflow::lu_solver",PT_char256,&LUSolverName,nullptr);
 	gl_global_create("powerflow::NR_iteration_limit",PT_int64,&NR_iteration_limit,nullptr);
 	gl_global_create("powerflow::NR_deltamode_iteration_limit",PT_int64,&NR_delta_iteration_limit,nullptr);
+	gl_global_create("powerflow::NR_jacobian_reuse",PT_bool,&NR_jacobian_reuse,PT_DESCRIPTION,"Flag to reuse the LU factors of a previous Jacobian until the NR convergence rate degrades (chord iterations)",nullptr);
+	gl_global_create("powerflow::NR_jacobian_reuse_rate",PT_double,&NR_jacobian_reuse_rate,PT_DESCRIPTION,"Ratio of successive voltage updates above which the Jacobian is refactored when NR_jacobian_reuse is set",nullptr);
+	gl_global_create("powerflow::NR_factorization_count",PT_int64,&NR_factorization_count,PT_DESCRIPTION,"Number of full LU factorizations of the NR Jacobian",nullptr);
+	gl_global_create("powerflow::NR_refactorization_count",PT_int64,&NR_refactorization_count,PT_DESCRIPTION,"Number of LU refactorizations of the NR Jacobian that kept the ordering and pivots of a previous factorization (lu_solver internal)",nullptr);
+	gl_global_create("powerflow::NR_lu_threaded_count",PT_int64,&NR_lu_threaded_count,PT_DESCRIPTION,"Number of refactorizations of the in-tree LU solver that shared levels between threads",nullptr);
+	gl_global_create("powerflow::NR_factorization_reuse_count",PT_int64,&NR_factorization_reuse_count,PT_DESCRIPTION,"Number of NR solves done with the LU factors of a previous Jacobian",nullptr);
+	gl_global_create("powerflow::NR_solution_skip",PT_bool,&NR_solution_skip,PT_DESCRIPTION,"Flag to keep the previous NR solution when the loads, sources, and topology did not change since it converged",nullptr);
+	gl_global_create("powerflow::NR_solution_skip_tolerance",PT_double,&NR_solution_skip_tolerance,PT_UNITS,"VA",PT_DESCRIPTION,"Largest aggregate load change that keeps the previous NR solution when NR_solution_skip is set",nullptr);
+	gl_global_create("powerflow::NR_solution_skip_count",PT_int64,&NR_solution_skip_count,PT_DESCRIPTION,"Number of NR solves skipped because their inputs did not change",nullptr);
+	gl_global_create("powerflow::NR_solver_timing",PT_bool,&NR_solver_timing,PT_DESCRIPTION,"Flag to accumulate the time spent in the assembly, factorization, solve, and update phases of the NR iterations",nullptr);
+	gl_global_create("powerflow::NR_assembly_time",PT_double,&NR_assembly_time,PT_UNITS,"s",PT_DESCRIPTION,"Time spent building the loads, mismatches, and Jacobian of the NR iterations (NR_solver_timing)",nullptr);
+	gl_global_create("powerflow::NR_factorization_time",PT_double,&NR_factorization_time,PT_UNITS,"s",PT_DESCRIPTION,"Time spent in the LU solves that factor the NR Jacobian (NR_solver_timing)",nullptr);
+	gl_global_create("powerflow::NR_solve_time",PT_double,&NR_solve_time,PT_UNITS,"s",PT_DESCRIPTION,"Time spent in the LU solves with the factors of a previous NR Jacobian (NR_solver_timing)",nullptr);
+	gl_global_create("powerflow::NR_update_time",PT_double,&NR_update_time,PT_UNITS,"s",PT_DESCRIPTION,"Time spent applying the NR voltage updates and checking convergence (NR_solver_timing)",nullptr);
 	gl_global_create("powerflow::NR_superLU_procs",PT_int32,&NR_superLU_procs,nullptr);
+	gl_global_create("powerflow::NR_lu_parallel_width",PT_int32,&NR_lu_parallel_width,PT_DESCRIPTION,"Number of columns an elimination tree level needs to be refactored by NR_lu_threads threads (lu_solver \"internal\")",nullptr);
+	gl_global_create("powerflow::NR_lu_threads",PT_int32,&NR_lu_threads,PT_DESCRIPTION,"Number of threads refactoring the NR matrix with the in-tree LU solver (lu_solver \"internal\"), 0 for one per processor",nullptr);
+	gl_global_create("powerflow::NR_injection_threads",PT_int32,&NR_injection_threads,PT_DESCRIPTION,"Number of threads computing the class-level current injection updates of the generators (e.g., inverter_dyn), 0 for one per processor",nullptr);
+	gl_global_create("powerflow::FBS_array_sweep",PT_bool,&FBS_array_sweep,PT_DESCRIPTION,"Flag to sweep radial FBS feeders as level-ordered arrays in the swing bus sync, instead of in the link sync and postsync passes",nullptr);
+	gl_global_create("powerflow::FBS_sweep_threads",PT_int32,&FBS_sweep_threads,PT_DESCRIPTION,"Number of threads sweeping the wide levels of the FBS array sweep (FBS_array_sweep), 0 for one per processor",nullptr);
+	gl_global_create("powerflow::FBS_sweep_parallel_width",PT_int32,&FBS_sweep_parallel_width,PT_DESCRIPTION,"Number of links a level of the FBS array sweep needs to be swept by FBS_sweep_threads threads",nullptr);
+	gl_global_create("powerflow::FBS_sweep_count",PT_int64,&FBS_sweep_count,PT_DESCRIPTION,"Number of FBS array sweeps",nullptr);
+	gl_global_create("powerflow::FBS_sweep_threaded_count",PT_int64,&FBS_sweep_threaded_count,PT_DESCRIPTION,"Number of FBS array sweep levels split between threads",nullptr);
 	gl_global_create("powerflow::default_maximum_voltage_error",PT_double,&default_maximum_voltage_error,nullptr);
 	gl_global_create("powerflow::default_maximum_power_error",PT_double,&default_maximum_power_error,nullptr);
 	gl_global_create("powerflow::NR_admit_change",PT_bool,&NR_admit_change,nullptr);
@@ -599,6 +621,33 @@ EXPORT STATUS postupdate(MODULE *module, TIMESTAMP t0, unsigned int64 dt)
 	}
 }
 
+EXPORT void term(void)
+{
+	//Report the factorizations of the NR Jacobian, and the ones saved by the chord iterations
+	if ((NR_factorization_count + NR_refactorization_count) > 0)
+	{
+		gl_verbose("powerflow: %lld LU factorizations and %lld refactorizations (%lld threaded) of the NR Jacobian, %lld solves with the factors of a previous Jacobian",NR_factorization_count,NR_refactorization_count,NR_lu_threaded_count,NR_factorization_reuse_count);
+	}
+
+	//Report the solves saved by keeping unchanged solutions
+	if (NR_solution_skip)
+	{
+		gl_verbose("powerflow: %lld NR solves skipped because their inputs did not change",NR_solution_skip_count);
+	}
+
+	//Report the FBS array sweeps
+	if (FBS_sweep_count > 0)
+	{
+		gl_verbose("powerflow: %lld FBS array sweeps, %lld levels split between threads",FBS_sweep_count,FBS_sweep_threaded_count);
+	}
+
+	//Report where the NR iterations spent their time
+	if (NR_solver_timing)
+	{
+		gl_verbose("powerflow: NR assembly %.3f s, factorization %.3f s, solve %.3f s, update %.3f s",NR_assembly_time,NR_factorization_time,NR_solve_time,NR_update_time);
+	}
+}
+
 CDECL int do_kill()
 {
 	/* if global memory needs to be released, this is a good time to do it */
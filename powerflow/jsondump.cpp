@@ -144,22 +144,15 @@ STATUS jsondump::dump_system(void)
 	bool found_match_config;
 
 	// metrics JSON value
-	Json::Value metrics_lines;	// Output dictionary for line and line configuration metrics
 	Json::Value node_object;
 	Json::Value load_object;
 	Json::Value line_object;
 	Json::Value line_configuration_object;
-	Json::Value jsonArray;
-	Json::Value jsonSecondArray;
+	std::vector<std::string> load_records; // loads are written after the buses they are found with
 	Json::Value jsonArray1; // for storing rmatrix and xmatrix
 	Json::Value jsonArray2; // for storing rmatrix and xmatrix
-	// Start write to file
-	Json::StreamWriterBuilder builder;
-	builder["commentStyle"] = "None";
-	builder["indentation"] = "";
-
-	// Open file for writing
-	ofstream out_file;
+	// Records are written to the file as they are produced
+	dump_stream stream;
 
 	//find the link objects
 	if(group[0] == '\0'){
@@ -214,9 +207,23 @@ STATUS jsondump::dump_system(void)
 		return FAILED;
 	}
 
+	// Open file for writing
+	if (!stream.open(filename_dump_system))
+	{
+		gl_error("jsondump unable to open %s for output", filename_dump_system.get_string());
+		/* TROUBLESHOOT
+		The jsondump object was unable to create the system dump file.  Check the filename_dump_system value
+		and make sure the destination folder exists and is writable.
+		*/
+
+		return FAILED;
+	}
+
 	//write style sheet info
-	metrics_lines["$schema"] = "http://json-schema.org/draft-04/schema#";
-	metrics_lines["description"] = "This file describes the system topology information (bus and lines) and line configuration data";
+	stream.begin_object();
+	stream.value("$schema","http://json-schema.org/draft-04/schema#");
+	stream.value("description","This file describes the system topology information (bus and lines) and line configuration data");
+	stream.begin_object("properties");
 
 	// Define b_mat_pu and b_mat_tp_pu to store per unit bmatrix values
 	if (lineConfs->hit_count > 0)
@@ -529,8 +536,8 @@ STATUS jsondump::dump_system(void)
 		reg_phase_count = nullptr;
 	}
 
-	// clear jsonArray - just in case
-	jsonArray.clear();
+	//Start the generators
+	stream.begin_array("generators");
 
 	//Clear the node array too -- just in case
 	node_object.clear();
@@ -652,7 +659,7 @@ STATUS jsondump::dump_system(void)
       		node_object["is_new"] = false;
 
 			//Add the object to the array
-			jsonArray.append(node_object);
+			stream.append(node_object);
 
 			//Clear the node
 			node_object.clear();
@@ -779,7 +786,7 @@ STATUS jsondump::dump_system(void)
       		node_object["is_new"] = false;
 
 			//Add the object to the array
-			jsonArray.append(node_object);
+			stream.append(node_object);
 
 			//Clear the node
 			node_object.clear();
@@ -790,11 +797,13 @@ STATUS jsondump::dump_system(void)
 	}//End diesels
 
 	//Write the values to the overall JSON
-	metrics_lines["properties"]["generators"] = jsonArray;
+	stream.end_array(true);
 
-	//Clear the array and object
+	//Clear the object
 	node_object.clear();
-	jsonArray.clear();
+
+	//Start the buses
+	stream.begin_array("buses");
 
 	//Write nodes
 	if (nodes->hit_count > 0)
@@ -896,7 +905,7 @@ STATUS jsondump::dump_system(void)
 			jsonArray2.clear();
 			
 			// Append to node array
-			jsonArray.append(node_object);
+			stream.append(node_object);
 
 			// clear JSON value
 			node_object.clear();
@@ -1007,7 +1016,7 @@ STATUS jsondump::dump_system(void)
 			jsonArray2.clear();
 			
 			// Append to node array
-			jsonArray.append(node_object);
+			stream.append(node_object);
 
 			// clear JSON value
 			node_object.clear();
@@ -1020,7 +1029,7 @@ STATUS jsondump::dump_system(void)
 
 	//Clear load-related arrays and objects
 	load_object.clear();
-	jsonSecondArray.clear();
+	load_records.clear();
 
 	//Search for loads too - replicate the nodes list, since we'll just leave them the same way
 	if (loads->hit_count > 0)
@@ -1184,13 +1193,13 @@ STATUS jsondump::dump_system(void)
 			jsonArray2.clear();
 
 			// Append to node array
-			jsonArray.append(node_object);
+			stream.append(node_object);
 
 			// clear JSON value
 			node_object.clear();
 
 			//Do the same for the load value
-			jsonSecondArray.append(load_object);
+			load_records.push_back(stream.to_string(load_object));
 
 			//Clear the JSON value
 			load_object.clear();
@@ -1201,19 +1210,22 @@ STATUS jsondump::dump_system(void)
 		}//End of load list traversion
 	}//End of loads non-empty
 
-	// Write bus quantities metrics_lines dictionary
-	metrics_lines["properties"]["buses"] = jsonArray;
-
-	// clear jsonArray
-	jsonArray.clear();
+	// Finish the buses
+	stream.end_array(true);
 
 	//Now do loads -- print out their special properties
+	stream.begin_array("loads");
+	for (std::vector<std::string>::iterator load_record=load_records.begin(); load_record!=load_records.end(); load_record++)
+	{
+		stream.append_text(*load_record);
+	}
+	stream.end_array(true);
 
-	// Write bus quantities metrics_lines dictionary
-	metrics_lines["properties"]["loads"] = jsonSecondArray;
+	// clear load records
+	load_records.clear();
 
-	// clear jsonSecondArray
-	jsonSecondArray.clear();
+	//Start the lines
+	stream.begin_array("lines");
 	
 	//write transformers
 	index = 0;
@@ -1415,7 +1427,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -1624,7 +1636,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -1831,7 +1843,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -2038,7 +2050,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -2245,7 +2257,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -2435,7 +2447,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -2621,7 +2633,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -2808,7 +2820,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -2998,7 +3010,7 @@ STATUS jsondump::dump_system(void)
 			// End of line codes
 
 			// Append to line array
-			jsonArray.append(line_object);
+			stream.append(line_object);
 
 			// clear JSON value
 			line_object.clear();
@@ -3010,11 +3022,11 @@ STATUS jsondump::dump_system(void)
 		}//End of fuses
 	}
 
-	// Write line metrics into metrics_lines dictionary
-	metrics_lines["properties"]["lines"] = jsonArray;
+	// Finish the lines
+	stream.end_array(true);
 
-	// clear jsonArray
-	jsonArray.clear();
+	//Start the line configurations
+	stream.begin_array("line_codes");
 
 	//Write a "fuse config", if it exists - assume that if one exists, this needs written
 	if (fuses->hit_count > 0)
@@ -3056,7 +3068,7 @@ STATUS jsondump::dump_system(void)
 		// end this line configuration
 
 		// Append to line array
-		jsonArray.append(line_configuration_object);
+		stream.append(line_configuration_object);
 
 		// clear JSON value
 		line_configuration_object.clear();
@@ -3102,7 +3114,7 @@ STATUS jsondump::dump_system(void)
 		// end this line configuration
 
 		// Append to line array
-		jsonArray.append(line_configuration_object);
+		stream.append(line_configuration_object);
 
 		// clear JSON value
 		line_configuration_object.clear();
@@ -3188,7 +3200,7 @@ STATUS jsondump::dump_system(void)
 				// end this line configuration
 
 				// Append to line array
-				jsonArray.append(line_configuration_object);
+				stream.append(line_configuration_object);
 
 				// clear JSON value
 				line_configuration_object.clear();
@@ -3268,7 +3280,7 @@ STATUS jsondump::dump_system(void)
 				// end this line configuration
 
 				// Append to line array
-				jsonArray.append(line_configuration_object);
+				stream.append(line_configuration_object);
 
 				// clear JSON value
 				line_configuration_object.clear();
@@ -3332,7 +3344,7 @@ STATUS jsondump::dump_system(void)
 				// end this line configuration
 
 				// Append to line array
-				jsonArray.append(line_configuration_object);
+				stream.append(line_configuration_object);
 
 				// clear JSON value
 				line_configuration_object.clear();
@@ -3396,7 +3408,7 @@ STATUS jsondump::dump_system(void)
 				// end this line configuration
 
 				// Append to line array
-				jsonArray.append(line_configuration_object);
+				stream.append(line_configuration_object);
 
 				// clear JSON value
 				line_configuration_object.clear();
@@ -3404,18 +3416,18 @@ STATUS jsondump::dump_system(void)
 		}//End loop of configurations
 	}//End regulator configurations
 
-	// Write line metrics into metrics_lines dictionary
-	metrics_lines["properties"]["line_codes"] = jsonArray;
-
-	// Clear jsonArray
-	jsonArray.clear();
+	// Finish the line configurations
+	stream.end_array(true);
 
-	// Write JSON files for line and line_codes
-	out_file.open (filename_dump_system);
-	std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
-	writer->write(metrics_lines, &out_file);
-	out_file << endl;
-	out_file.close();
+	// Complete the JSON file for line and line_codes
+	stream.end_object();
+	stream.end_object();
+	stream.printf("\n");
+	if (!stream.close())
+	{
+		gl_error("jsondump unable to write %s", filename_dump_system.get_string());
+		//Defined above
+	}
 
 	//Clean up the mallocs
 	if (lineConfs->hit_count > 0)
@@ -16,6 +16,7 @@
 #include "line_configuration.h"
 #include "triplex_line_configuration.h"
 #include "transformer.h"
+#include "dump_stream.h"
 
 
 class jsondump : public gld_object
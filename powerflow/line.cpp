@@ -45,6 +45,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
 using namespace std;
 
 #include "line.h"
@@ -383,6 +386,119 @@ void line::recalc_line_matricies(gld::complex Zabc_mat[3][3], gld::complex Yabc_
 	multiply(A_mat,b_mat,B_mat);
 }
 
+/* Per-mile impedance of the line configurations in use
+
+	Lines that share a configuration and phases have the same series impedance
+	and shunt admittance per mile, so the Kersting equations are only solved once
+	for each of them and every line scales the result by its own length.  An
+	entry is kept for each line class, configuration, phase set and line
+	capacitance setting, and holds the values for the last frequency they were
+	computed at.  The entry also keeps an image of the configuration and of the
+	conductors and spacing it refers to, so a change to any of their properties
+	is noticed on the next lookup and the values are computed again.
+ */
+typedef std::tuple<CLASS*,OBJECT*,gld::set,bool> LINEIMPEDANCEKEY;
+typedef struct s_lineimpedance {
+	double frequency;		///< frequency the values were computed at
+	std::string image;		///< configuration data the values were computed from
+	gld::complex Z[3][3];	///< series impedance per mile
+	gld::complex Y[3][3];	///< shunt admittance per mile before scaling for frequency and microSiemens
+	gld::complex T[3];		///< other per-configuration terms (triplex neutral current ratios)
+} LINEIMPEDANCE;
+static std::map<LINEIMPEDANCEKEY,LINEIMPEDANCE> line_impedance_cache;
+static unsigned int line_impedance_lock = 0;
+
+/* Copy the data of a configuration and of the objects it refers to */
+static void line_configuration_image(OBJECT *config, std::string &image)
+{
+	image.assign((const char*)OBJECTDATA(config,void),config->oclass->size);
+	for ( PROPERTY *prop = config->oclass->pmap ; prop!=nullptr && prop->oclass==config->oclass ; prop = prop->next )
+	{
+		if ( prop->ptype==PT_object )
+		{
+			OBJECT *ref = *(OBJECT**)GETADDR(config,prop);
+			if ( ref!=nullptr )
+				image.append((const char*)OBJECTDATA(ref,void),ref->oclass->size);
+		}
+	}
+}
+
+/* Frequency the line impedances are computed at */
+static double line_impedance_frequency(void)
+{
+	return enable_frequency_dependence ? current_frequency : nominal_frequency;
+}
+
+/** Get the per-mile impedance of this line's configuration computed for another line
+	@return true if the values are current, false if they have to be computed (and stored with set_unit_impedance)
+ **/
+bool line::get_unit_impedance(gld::complex Zunit[3][3], gld::complex Yunit[3][3], gld::complex Tunit[3])
+{
+	std::string image;
+	bool found = false;
+
+	line_configuration_image(configuration,image);
+	WRITELOCK(&line_impedance_lock);
+	std::map<LINEIMPEDANCEKEY,LINEIMPEDANCE>::iterator item = line_impedance_cache.find(LINEIMPEDANCEKEY(OBJECTHDR(this)->oclass,configuration,phases,use_line_cap));
+	if ( item!=line_impedance_cache.end() && item->second.frequency==line_impedance_frequency() && item->second.image==image )
+	{
+		for ( int i = 0 ; i < 3 ; i++ )
+		{
+			for ( int j = 0 ; j < 3 ; j++ )
+			{
+				Zunit[i][j] = item->second.Z[i][j];
+				if ( Yunit!=nullptr )
+					Yunit[i][j] = item->second.Y[i][j];
+			}
+			if ( Tunit!=nullptr )
+				Tunit[i] = item->second.T[i];
+		}
+		found = true;
+	}
+	WRITEUNLOCK(&line_impedance_lock);
+	return found;
+}
+
+/** Store the per-mile impedance of this line's configuration for the other lines using it
+ **/
+void line::set_unit_impedance(gld::complex Zunit[3][3], gld::complex Yunit[3][3], gld::complex Tunit[3])
+{
+	LINEIMPEDANCE values;
+
+	values.frequency = line_impedance_frequency();
+	line_configuration_image(configuration,values.image);
+	for ( int i = 0 ; i < 3 ; i++ )
+	{
+		for ( int j = 0 ; j < 3 ; j++ )
+		{
+			values.Z[i][j] = Zunit[i][j];
+			values.Y[i][j] = ( Yunit!=nullptr ? Yunit[i][j] : gld::complex(0,0) );
+		}
+		values.T[i] = ( Tunit!=nullptr ? Tunit[i] : gld::complex(0,0) );
+	}
+	WRITELOCK(&line_impedance_lock);
+	line_impedance_cache[LINEIMPEDANCEKEY(OBJECTHDR(this)->oclass,configuration,phases,use_line_cap)] = values;
+	WRITEUNLOCK(&line_impedance_lock);
+}
+
+/** Scale per-mile impedance for the length of this line
+	The shunt admittance is also scaled for frequency and microSiemens as per Kersting (5.14) and (5.15)
+ **/
+void line::scale_unit_impedance(gld::complex Zabc_mat[3][3], gld::complex Yabc_mat[3][3])
+{
+	double miles = length / 5280.0;
+	gld::complex cap_freq_mult = gld::complex(0,(2.0*PI*line_impedance_frequency()*0.000001*miles));
+
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			Zabc_mat[i][j] = Zabc_mat[i][j] * miles;
+			Yabc_mat[i][j] = Yabc_mat[i][j] * cap_freq_mult;
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // IMPLEMENTATION OF CORE LINKAGE: line
 //////////////////////////////////////////////////////////////////////////
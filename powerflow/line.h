@@ -43,6 +43,9 @@ public:
 protected:
 	void load_matrix_based_configuration(gld::complex Zabc_mat[3][3], gld::complex Yabc_mat[3][3]);
 	void recalc_line_matricies(gld::complex Zabc_mat[3][3], gld::complex Yabc_mat[3][3]);
+	bool get_unit_impedance(gld::complex Zunit[3][3], gld::complex Yunit[3][3], gld::complex Tunit[3]=nullptr);
+	void set_unit_impedance(gld::complex Zunit[3][3], gld::complex Yunit[3][3], gld::complex Tunit[3]=nullptr);
+	void scale_unit_impedance(gld::complex Zabc_mat[3][3], gld::complex Yabc_mat[3][3]);
 };
 
 #include "triplex_line.h"
@@ -2979,7 +2979,8 @@ TIMESTAMP link_object::sync(TIMESTAMP t0)
 
 	if (is_closed())
 	{
-		if (solver_method==SM_FBS)
+		//The array sweep adds this current in the SWING node sync (FBS_array_sweep)
+		if ((solver_method==SM_FBS) && !FBS_sweep_active)
 		{
 			node *f;
 			node *t;
@@ -3360,7 +3361,8 @@ TIMESTAMP link_object::postsync(TIMESTAMP t0)
 		else
 			read_I_out[2] = tc[2];
 
-		if (!is_open())
+		//The array sweep already updated the to node in the SWING node sync (FBS_array_sweep)
+		if (!is_open() && !FBS_sweep_active)
 		{
 			/* compute and update voltages */
 			gld::complex v0 =
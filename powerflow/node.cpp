@@ -53,6 +53,8 @@
 #include <cstdlib>
 
 #include "solver_nr.h"
+#include "solver_lu.h"
+#include "solver_fbs.h"
 #include "node.h"
 
 //Library imports items - for external LU solver - stolen from somewhere else in GridLAB-D (tape, I believe)
@@ -879,6 +881,20 @@ int node::init(OBJECT *parent)
 			{
 				matrix_solver_method=MM_SUPERLU;	//This is the default, but we'll set it here anyways
 			}
+			else if (strcmp(LUSolverName.get_string(),"internal") == 0)	//In-tree solver - same interface, nothing to load
+			{
+				LUSolverFcns.dllLink = nullptr;
+				LUSolverFcns.ext_init = (void *)solver_lu_init;
+				LUSolverFcns.ext_alloc = (void *)solver_lu_alloc;
+				LUSolverFcns.ext_solve = (void *)solver_lu_solve;
+				LUSolverFcns.ext_destroy = (void *)solver_lu_destroy;
+				LUSolverFcns.ext_free = (void *)solver_lu_free;
+
+				gl_verbose("In-tree LU solver selected for NR");
+
+				//Flag as an external solver - it goes through the same calls
+				matrix_solver_method=MM_EXTERN;
+			}
 			else	//Something is there, see if we can find it
 			{
 				//Initialize the global
@@ -887,6 +903,7 @@ int node::init(OBJECT *parent)
 				LUSolverFcns.ext_alloc = nullptr;
 				LUSolverFcns.ext_solve = nullptr;
 				LUSolverFcns.ext_destroy = nullptr;
+				LUSolverFcns.ext_free = nullptr;
 
 #ifdef _WIN32
 				snprintf(ext_lib_file_name, 1024, "solver_%s" DLEXT,LUSolverName.get_string());
@@ -993,6 +1010,9 @@ int node::init(OBJECT *parent)
 						}
 
 
+						//Optional - release of the island variables
+						LUSolverFcns.ext_free = DLSYM(LUSolverFcns.dllLink,"LU_free");
+
 						//If any failed, just revert to superLU (probably shouldn't even check others after a failure, but meh)
 						if (ExtLinkFailure)
 						{
@@ -1620,6 +1640,13 @@ TIMESTAMP node::presync(TIMESTAMP t0)
 
 			//Deflag us
 			FBS_swing_set=true;
+			FBS_swing_bus=obj;
+
+			//Flatten the feeder below us for the array sweep
+			if (FBS_array_sweep)
+			{
+				solver_fbs_build(obj);
+			}
 		}
 	}
 
@@ -2712,6 +2739,12 @@ TIMESTAMP node::sync(TIMESTAMP t0)
 	}
 #endif
 
+		//Every node below has its current now - sweep the feeder in one go (links skip their FBS updates)
+		if (FBS_sweep_active && (obj == FBS_swing_bus))
+		{
+			solver_fbs_sweep();
+		}
+
 		// if the parent object is another node
 		if (obj->parent!=nullptr && gl_object_isa(obj->parent,"node","powerflow"))
 		{
@@ -2777,7 +2810,17 @@ TIMESTAMP node::sync(TIMESTAMP t0)
 				}
 
 #ifndef GLD_USE_EIGEN
-				int64 result = solver_nr(NR_bus_count, NR_busdata, NR_branch_count, NR_branchdata, &NR_powerflow, powerflow_type, nullptr, &bad_computation);
+				int64 result;
+
+				//Keep the last solution if nothing it was solved for has changed (NR_solution_skip)
+				if (NR_solution_skip_check(NR_bus_count, NR_busdata, NR_branch_count, NR_branchdata, powerflow_type))
+				{
+					result = 0;
+				}
+				else
+				{
+					result = solver_nr(NR_bus_count, NR_busdata, NR_branch_count, NR_branchdata, &NR_powerflow, powerflow_type, nullptr, &bad_computation);
+				}
 #else
 				long result = NR_Solver.solver_nr(NR_bus_count, NR_busdata, NR_branch_count, NR_branchdata, &NR_powerflow, powerflow_type, nullptr, &bad_computation);
 #endif
@@ -3895,6 +3938,8 @@ int node::NR_populate(void)
 	//Null the extra function pointer -- the individual object will call to populate this
 	NR_busdata[NR_node_reference].ExtraCurrentInjFunc = nullptr;
 	NR_busdata[NR_node_reference].ExtraCurrentInjFuncObject = nullptr;
+	NR_busdata[NR_node_reference].ExtraCurrentInjBatch = -1;
+	NR_busdata[NR_node_reference].ExtraCurrentInjBatchSlot = -1;
 
 	//Extra functions - see if we're a load - map update if we're in the right mode
 	//Could potentially flag this in load/triplex_load - it's primarily needed to keep constant_current-based loads properly rotated
@@ -5552,6 +5597,7 @@ STATUS node::NR_map_current_update_function(OBJECT *callObj)
 {
 	OBJECT *hdr = OBJECTHDR(this);
 	OBJECT *phdr = nullptr;
+	FUNCTIONADDR temp_fxn, temp_push_fxn;
 
 	//Do a simple check -- if we're not in NR, this won't do anything anyways
 	if (solver_method == SM_NR)
@@ -5580,6 +5626,14 @@ STATUS node::NR_map_current_update_function(OBJECT *callObj)
 
 				//Store the object pointer too
 				NR_busdata[NR_node_reference].ExtraCurrentInjFuncObject = callObj;
+
+				//See if the class updates all its objects in one call - if so, the solver calls that instead
+				temp_fxn = (FUNCTIONADDR)(gl_get_function(callObj,"current_injection_update_batch"));
+				temp_push_fxn = (FUNCTIONADDR)(gl_get_function(callObj,"current_injection_push"));
+				if ((temp_fxn != nullptr) && (temp_push_fxn != nullptr))
+				{
+					NR_busdata[NR_node_reference].ExtraCurrentInjBatch = NR_current_injection_batch_register(temp_fxn,temp_push_fxn,callObj,NR_node_reference);
+				}
 			}
 			else	//Already mapped
 			{
@@ -5615,6 +5669,14 @@ STATUS node::NR_map_current_update_function(OBJECT *callObj)
 
 				//Store the object pointer too
 				NR_busdata[*NR_subnode_reference].ExtraCurrentInjFuncObject = callObj;
+
+				//See if the class updates all its objects in one call - if so, the solver calls that instead
+				temp_fxn = (FUNCTIONADDR)(gl_get_function(callObj,"current_injection_update_batch"));
+				temp_push_fxn = (FUNCTIONADDR)(gl_get_function(callObj,"current_injection_push"));
+				if ((temp_fxn != nullptr) && (temp_push_fxn != nullptr))
+				{
+					NR_busdata[*NR_subnode_reference].ExtraCurrentInjBatch = NR_current_injection_batch_register(temp_fxn,temp_push_fxn,callObj,*NR_subnode_reference);
+				}
 			}
 			else	//Already mapped
 			{
@@ -308,6 +308,7 @@ public:
 	friend class fuse;			// needs access to current_inj
 	friend class motor;	// needs access to curr_state
 	friend class performance_motor;	//needs access to curr_state
+	friend void solver_fbs_build(OBJECT *swing);	// needs access to current_inj
 
 	static int kmlinit(int (*stream)(const char*,...));
 	int kmldump(int (*stream)(const char*,...));
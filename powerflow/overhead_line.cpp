@@ -306,9 +306,14 @@ void overhead_line::recalc(void)
 			A_mat[2][2] = 1.0;
 		}
 	}
+	else if (get_unit_impedance(Zabc_mat, Yabc_mat))
+	{
+		//Another line with this configuration already solved Kersting's equations
+		scale_unit_impedance(Zabc_mat, Yabc_mat);
+	}
 	else
 	{
-		// Use Kersting's equations to define the z-matrix
+		// Use Kersting's equations to define the z-matrix - per mile, scaled for length below
 		double dab, dbc, dac, dan, dbn, dcn;
 		double gmr_a, gmr_b, gmr_c, gmr_n, res_a, res_b, res_c, res_n;
 		gld::complex z_aa, z_ab, z_ac, z_an, z_bb, z_bc, z_bn, z_cc, z_cn, z_nn;
@@ -318,9 +323,7 @@ void overhead_line::recalc(void)
 		bool valid_capacitance = false;	//Assume capacitance is invalid by default
 		double freq_coeff_real, freq_coeff_imag, freq_additive_term;
 		line_spacing *spacing_val = nullptr;
-		double miles = length / 5280.0;
 		double cap_coeff;
-		gld::complex cap_freq_mult;
 		
 		//Calculate coefficients for self and mutual impedance - incorporates frequency values
 		//Per Kersting (4.39) and (4.40)
@@ -380,16 +383,6 @@ void overhead_line::recalc(void)
 			//If capacitance calculations desired, compute overall coefficient
 			cap_coeff = 1.0/(PERMITIVITTY_AIR*2.0*PI);
 
-			//Set capacitor frequency/distance/scaling factor (rad/s*S)
-			if (enable_frequency_dependence)	//See which frequency to use
-			{
-				cap_freq_mult = gld::complex(0,(2.0*PI*current_frequency*0.000001*miles));
-			}
-			else
-			{
-				cap_freq_mult = gld::complex(0,(2.0*PI*nominal_frequency*0.000001*miles));
-			}
-
 			//Extract line spacing (nned for capacitance)
 			spacing_val = OBJECTDATA(config->line_spacing, line_spacing);
 
@@ -687,15 +680,15 @@ void overhead_line::recalc(void)
 		}
 
 		//Update impedance
-		Zabc_mat[0][0] = (z_aa - z_an * z_an * z_nn_inv) * miles;
-		Zabc_mat[0][1] = (z_ab - z_an * z_bn * z_nn_inv) * miles;
-		Zabc_mat[0][2] = (z_ac - z_an * z_cn * z_nn_inv) * miles;
-		Zabc_mat[1][0] = (z_ab - z_bn * z_an * z_nn_inv) * miles;
-		Zabc_mat[1][1] = (z_bb - z_bn * z_bn * z_nn_inv) * miles;
-		Zabc_mat[1][2] = (z_bc - z_bn * z_cn * z_nn_inv) * miles;
-		Zabc_mat[2][0] = (z_ac - z_cn * z_an * z_nn_inv) * miles;
-		Zabc_mat[2][1] = (z_bc - z_cn * z_bn * z_nn_inv) * miles;
-		Zabc_mat[2][2] = (z_cc - z_cn * z_cn * z_nn_inv) * miles;
+		Zabc_mat[0][0] = (z_aa - z_an * z_an * z_nn_inv);
+		Zabc_mat[0][1] = (z_ab - z_an * z_bn * z_nn_inv);
+		Zabc_mat[0][2] = (z_ac - z_an * z_cn * z_nn_inv);
+		Zabc_mat[1][0] = (z_ab - z_bn * z_an * z_nn_inv);
+		Zabc_mat[1][1] = (z_bb - z_bn * z_bn * z_nn_inv);
+		Zabc_mat[1][2] = (z_bc - z_bn * z_cn * z_nn_inv);
+		Zabc_mat[2][0] = (z_ac - z_cn * z_an * z_nn_inv);
+		Zabc_mat[2][1] = (z_bc - z_cn * z_bn * z_nn_inv);
+		Zabc_mat[2][2] = (z_cc - z_cn * z_cn * z_nn_inv);
 
 		// If we have valid capacitance values and line capacitance is turned on then
 		// calculate Yabc_mat otherwise just leave is zeroed out.
@@ -727,39 +720,39 @@ void overhead_line::recalc(void)
 				P_mat[2][2] = p_cc;
 			}
 
-			//Now appropriately invert it - scale for frequency, distance, and microSiemens as well as per Kersting (5.14) and (5.15) 
+			//Now appropriately invert it - scaled for frequency, distance, and microSiemens with the impedance below
 			if (has_phase(PHASE_A) && !has_phase(PHASE_B) && !has_phase(PHASE_C)) //only A
-				Yabc_mat[0][0] = gld::complex(1.0) / P_mat[0][0] * cap_freq_mult;
+				Yabc_mat[0][0] = gld::complex(1.0) / P_mat[0][0];
 			else if (!has_phase(PHASE_A) && has_phase(PHASE_B) && !has_phase(PHASE_C)) //only B
-				Yabc_mat[1][1] = gld::complex(1.0) / P_mat[1][1] * cap_freq_mult;
+				Yabc_mat[1][1] = gld::complex(1.0) / P_mat[1][1];
 			else if (!has_phase(PHASE_A) && !has_phase(PHASE_B) && has_phase(PHASE_C)) //only C
-				Yabc_mat[2][2] = gld::complex(1.0) / P_mat[2][2] * cap_freq_mult;
+				Yabc_mat[2][2] = gld::complex(1.0) / P_mat[2][2];
 			else if (has_phase(PHASE_A) && !has_phase(PHASE_B) && has_phase(PHASE_C)) //has A & C
 			{
 				gld::complex detvalue = P_mat[0][0]*P_mat[2][2] - P_mat[0][2]*P_mat[2][0];
 
-				Yabc_mat[0][0] = P_mat[2][2] / detvalue * cap_freq_mult;
-				Yabc_mat[0][2] = P_mat[0][2] * -1.0 / detvalue * cap_freq_mult;
-				Yabc_mat[2][0] = P_mat[2][0] * -1.0 / detvalue * cap_freq_mult;
-				Yabc_mat[2][2] = P_mat[0][0] / detvalue * cap_freq_mult;
+				Yabc_mat[0][0] = P_mat[2][2] / detvalue;
+				Yabc_mat[0][2] = P_mat[0][2] * -1.0 / detvalue;
+				Yabc_mat[2][0] = P_mat[2][0] * -1.0 / detvalue;
+				Yabc_mat[2][2] = P_mat[0][0] / detvalue;
 			}
 			else if (has_phase(PHASE_A) && has_phase(PHASE_B) && !has_phase(PHASE_C)) //has A & B
 			{
 				gld::complex detvalue = P_mat[0][0]*P_mat[1][1] - P_mat[0][1]*P_mat[1][0];
 
-				Yabc_mat[0][0] = P_mat[1][1] / detvalue * cap_freq_mult;
-				Yabc_mat[0][1] = P_mat[0][1] * -1.0 / detvalue * cap_freq_mult;
-				Yabc_mat[1][0] = P_mat[1][0] * -1.0 / detvalue * cap_freq_mult;
-				Yabc_mat[1][1] = P_mat[0][0] / detvalue * cap_freq_mult;
+				Yabc_mat[0][0] = P_mat[1][1] / detvalue;
+				Yabc_mat[0][1] = P_mat[0][1] * -1.0 / detvalue;
+				Yabc_mat[1][0] = P_mat[1][0] * -1.0 / detvalue;
+				Yabc_mat[1][1] = P_mat[0][0] / detvalue;
 			}
 			else if (!has_phase(PHASE_A) && has_phase(PHASE_B) && has_phase(PHASE_C))	//has B & C
 			{
 				gld::complex detvalue = P_mat[1][1]*P_mat[2][2] - P_mat[1][2]*P_mat[2][1];
 
-				Yabc_mat[1][1] = P_mat[2][2] / detvalue * cap_freq_mult;
-				Yabc_mat[1][2] = P_mat[1][2] * -1.0 / detvalue * cap_freq_mult;
-				Yabc_mat[2][1] = P_mat[2][1] * -1.0 / detvalue * cap_freq_mult;
-				Yabc_mat[2][2] = P_mat[1][1] / detvalue * cap_freq_mult;
+				Yabc_mat[1][1] = P_mat[2][2] / detvalue;
+				Yabc_mat[1][2] = P_mat[1][2] * -1.0 / detvalue;
+				Yabc_mat[2][1] = P_mat[2][1] * -1.0 / detvalue;
+				Yabc_mat[2][2] = P_mat[1][1] / detvalue;
 
 				//Other auxilliary by phase
 				if (has_phase(PHASE_A))
@@ -788,15 +781,15 @@ void overhead_line::recalc(void)
 				gld::complex detvalue = P_mat[0][0]*P_mat[1][1]*P_mat[2][2] - P_mat[0][0]*P_mat[1][2]*P_mat[2][1] - P_mat[0][1]*P_mat[1][0]*P_mat[2][2] + P_mat[0][1]*P_mat[2][0]*P_mat[1][2] + P_mat[1][0]*P_mat[0][2]*P_mat[2][1] - P_mat[0][2]*P_mat[1][1]*P_mat[2][0];
 
 				//Invert it
-				Yabc_mat[0][0] = (P_mat[1][1]*P_mat[2][2] - P_mat[1][2]*P_mat[2][1]) / detvalue * cap_freq_mult;
-				Yabc_mat[0][1] = (P_mat[0][2]*P_mat[2][1] - P_mat[0][1]*P_mat[2][2]) / detvalue * cap_freq_mult;
-				Yabc_mat[0][2] = (P_mat[0][1]*P_mat[1][2] - P_mat[0][2]*P_mat[1][1]) / detvalue * cap_freq_mult;
-				Yabc_mat[1][0] = (P_mat[2][0]*P_mat[1][2] - P_mat[1][0]*P_mat[2][2]) / detvalue * cap_freq_mult;
-				Yabc_mat[1][1] = (P_mat[0][0]*P_mat[2][2] - P_mat[0][2]*P_mat[2][0]) / detvalue * cap_freq_mult;
-				Yabc_mat[1][2] = (P_mat[1][0]*P_mat[0][2] - P_mat[0][0]*P_mat[1][2]) / detvalue * cap_freq_mult;
-				Yabc_mat[2][0] = (P_mat[1][0]*P_mat[2][1] - P_mat[1][1]*P_mat[2][0]) / detvalue * cap_freq_mult;
-				Yabc_mat[2][1] = (P_mat[0][1]*P_mat[2][0] - P_mat[0][0]*P_mat[2][1]) / detvalue * cap_freq_mult;
-				Yabc_mat[2][2] = (P_mat[0][0]*P_mat[1][1] - P_mat[0][1]*P_mat[1][0]) / detvalue * cap_freq_mult;
+				Yabc_mat[0][0] = (P_mat[1][1]*P_mat[2][2] - P_mat[1][2]*P_mat[2][1]) / detvalue;
+				Yabc_mat[0][1] = (P_mat[0][2]*P_mat[2][1] - P_mat[0][1]*P_mat[2][2]) / detvalue;
+				Yabc_mat[0][2] = (P_mat[0][1]*P_mat[1][2] - P_mat[0][2]*P_mat[1][1]) / detvalue;
+				Yabc_mat[1][0] = (P_mat[2][0]*P_mat[1][2] - P_mat[1][0]*P_mat[2][2]) / detvalue;
+				Yabc_mat[1][1] = (P_mat[0][0]*P_mat[2][2] - P_mat[0][2]*P_mat[2][0]) / detvalue;
+				Yabc_mat[1][2] = (P_mat[1][0]*P_mat[0][2] - P_mat[0][0]*P_mat[1][2]) / detvalue;
+				Yabc_mat[2][0] = (P_mat[1][0]*P_mat[2][1] - P_mat[1][1]*P_mat[2][0]) / detvalue;
+				Yabc_mat[2][1] = (P_mat[0][1]*P_mat[2][0] - P_mat[0][0]*P_mat[2][1]) / detvalue;
+				Yabc_mat[2][2] = (P_mat[0][0]*P_mat[1][1] - P_mat[0][1]*P_mat[1][0]) / detvalue;
 			}
 
 			//Other auxilliary by phase
@@ -821,6 +814,13 @@ void overhead_line::recalc(void)
 				A_mat[2][2] = 1.0;
 			}
 		}
+
+		//Share the per-mile values, unless a warning about them has to be repeated for each line
+		if (valid_capacitance || !use_line_cap)
+		{
+			set_unit_impedance(Zabc_mat, Yabc_mat);
+		}
+		scale_unit_impedance(Zabc_mat, Yabc_mat);
 	}
 
 	// Calculate line matrixies A_mat, B_mat, a_mat, b_mat, c_mat and d_mat based on Zabc_mat and Yabc_mat
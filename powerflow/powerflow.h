@@ -69,9 +69,10 @@ typedef struct s_ext_fxn {
 	void *ext_alloc;
 	void *ext_solve;
 	void *ext_destroy;
+	void *ext_free;		///< Optional - releases the solver variables of an island (LU_free)
 } EXT_LU_FXN_CALLS;
 
-GLOBAL char256 LUSolverName INIT("KLU");				/**< filename for external LU solver */
+GLOBAL char256 LUSolverName INIT("KLU");				/**< filename for external LU solver ("internal" for the in-tree solver) */
 GLOBAL EXT_LU_FXN_CALLS LUSolverFcns;				/**< links to external LU solver functions */
 GLOBAL SOLVERMETHOD solver_method INIT(SM_FBS);		/**< powerflow solver methodology */
 GLOBAL NRSOLVERALG NR_solver_algorithm INIT(NRM_TCIM);	/**< NR underlying algorithm */
@@ -97,6 +98,9 @@ GLOBAL bool NR_dyn_first_run INIT(true);			/**< Newton-Raphson first run indicat
 GLOBAL bool NR_admit_change INIT(true);				/**< Newton-Raphson admittance matrix change detector - used to prevent complete recalculation of admittance at every timestep */
 GLOBAL bool NR_FPI_imp_load_change INIT(true);		/**< Newton-Raphson Fixed-Point-Iterative - flag to indicate if impedance load changed (for admittance reform) */
 GLOBAL int NR_superLU_procs INIT(1);				/**< Newton-Raphson related - superLU MT processor count to request - separate from thread_count */
+GLOBAL int NR_lu_threads INIT(1);					/**< Newton-Raphson related - threads refactoring the matrix with the in-tree LU solver (0 for one per processor) */
+GLOBAL int NR_lu_parallel_width INIT(32);			/**< Newton-Raphson related - elimination tree levels with fewer columns are refactored by one thread (in-tree LU solver) */
+GLOBAL int NR_injection_threads INIT(1);			/**< Newton-Raphson related - threads computing the class-level current injection updates of the generators (0 for one per processor) */
 GLOBAL TIMESTAMP NR_retval INIT(TS_NEVER);			/**< Newton-Raphson current return value - if t0 objects know we aren't going anywhere */
 GLOBAL OBJECT *NR_swing_bus INIT(nullptr);				/**< Newton-Raphson swing bus */
 GLOBAL int NR_expected_swing_rank INIT(6);			/**< Newton-Raphson expected master swing bus rank - for multi-gen children compatibility */
@@ -104,7 +108,28 @@ GLOBAL bool NR_swing_deferred_pass INIT(false);		/**< Newton-Raphson toggle for
 GLOBAL bool NR_swing_rank_set INIT(false);			/**< Newton-Raphson check to see if SWING has set its rank (mostly for other objects) */
 GLOBAL int NR_swing_bus_reference INIT(-1);			/**< Newton-Raphson swing bus index reference in NR_busdata */
 GLOBAL int64 NR_delta_iteration_limit INIT(10);		/**< Newton-Raphson iteration limit (per deltamode timestep) */
+GLOBAL bool NR_jacobian_reuse INIT(false);			/**< Newton-Raphson chord mode - reuse the LU factors of a previous Jacobian across iterations and timesteps */
+GLOBAL double NR_jacobian_reuse_rate INIT(0.5);		/**< Newton-Raphson chord mode - refactor once an iteration reduces the voltage update by less than this ratio */
+GLOBAL int64 NR_factorization_count INIT(0);		/**< Newton-Raphson statistics - number of full LU factorizations of the Jacobian */
+GLOBAL int64 NR_refactorization_count INIT(0);		/**< Newton-Raphson statistics - number of LU refactorizations that kept the ordering and pivots of a previous factorization (lu_solver internal) */
+GLOBAL int64 NR_lu_threaded_count INIT(0);			/**< Newton-Raphson statistics - number of refactorizations that shared levels between threads (in-tree LU solver) */
+GLOBAL int64 NR_factorization_reuse_count INIT(0);	/**< Newton-Raphson statistics - number of solves done with the LU factors of a previous Jacobian */
+GLOBAL bool NR_solution_skip INIT(false);			/**< Newton-Raphson - keep the previous solution while the loads, sources, and topology it was solved for do not change */
+GLOBAL double NR_solution_skip_tolerance INIT(0.0);	/**< Newton-Raphson solution skipping - largest aggregate load change (VA) that keeps the previous solution */
+GLOBAL int64 NR_solution_skip_count INIT(0);		/**< Newton-Raphson statistics - number of solves skipped because the inputs did not change */
+GLOBAL bool NR_solver_timing INIT(false);			/**< Newton-Raphson statistics - accumulate the time spent in each phase of the solver iterations */
+GLOBAL double NR_assembly_time INIT(0.0);			/**< Newton-Raphson statistics - time spent building the loads, mismatches, and Jacobian (s) */
+GLOBAL double NR_factorization_time INIT(0.0);		/**< Newton-Raphson statistics - time spent in LU solves that factor the Jacobian (s) */
+GLOBAL double NR_solve_time INIT(0.0);				/**< Newton-Raphson statistics - time spent in LU solves with the factors of a previous Jacobian (s) */
+GLOBAL double NR_update_time INIT(0.0);				/**< Newton-Raphson statistics - time spent applying the voltage updates and checking convergence (s) */
 GLOBAL bool FBS_swing_set INIT(false);				/**< Forward-Back Sweep swing assignment variable */
+GLOBAL OBJECT *FBS_swing_bus INIT(nullptr);			/**< Forward-Back Sweep swing bus */
+GLOBAL bool FBS_array_sweep INIT(false);			/**< Forward-Back Sweep - sweep the radial feeder as flat arrays in the swing bus sync, instead of in the link sync/postsync passes */
+GLOBAL bool FBS_sweep_active INIT(false);			/**< Forward-Back Sweep - the feeder was flattened for the array sweep, so the links leave the sweep to it */
+GLOBAL int FBS_sweep_threads INIT(1);				/**< Forward-Back Sweep - threads sweeping the wide levels of the array sweep (0 for one per processor) */
+GLOBAL int FBS_sweep_parallel_width INIT(256);		/**< Forward-Back Sweep - levels of the array sweep with fewer links are swept by one thread */
+GLOBAL int64 FBS_sweep_count INIT(0);				/**< Forward-Back Sweep statistics - number of array sweeps */
+GLOBAL int64 FBS_sweep_threaded_count INIT(0);		/**< Forward-Back Sweep statistics - number of array sweep levels split between threads */
 GLOBAL bool show_matrix_values INIT(false);			/**< flag to enable dumping matrix calculations as they occur */
 GLOBAL double primary_voltage_ratio INIT(60.0);		/**< primary voltage ratio (@todo explain primary_voltage_ratio in powerflow (ticket #131) */
 GLOBAL double nominal_frequency INIT(60.0);			/**< nomimal operating frequencty */
@@ -0,0 +1,390 @@
+/* $Id
+ * Array forward-backward sweep for radial feeders
+ *
+ * Used by the FBS solver when powerflow::FBS_array_sweep is set - the SWING
+ * node sync sweeps the whole feeder, instead of every link adding its current
+ * in its sync and updating its to node in its postsync.  See solver_fbs.h.
+ */
+
+#include <map>
+#include <thread>
+
+#include "solver_fbs.h"
+#include "node.h"
+#include "link.h"
+
+static FBSSWEEP FBS_sweep;
+
+//Leaves the feeder to the link sync/postsync passes
+static void solver_fbs_unsupported(OBJECT *obj, const char *reason)
+{
+	gl_warning("FBS_array_sweep: %s (id:%d) %s - the feeder is solved by the link sync and postsync passes",(obj->name ? obj->name : "Unnamed"),obj->id,reason);
+	/*  TROUBLESHOOT
+	The array forward-backward sweep only handles strictly radial feeders, where every node below the SWING node
+	is fed by exactly one link and every link can be reached from the SWING node.  Parented nodes with links
+	leaving them, open switches tying feeders together, and split-phase SWING nodes are handled by the regular
+	FBS passes, so the simulation continues without the array sweep.  Use the NR solver for meshed systems.
+	*/
+	FBS_sweep_active = false;
+}
+
+//Copies the c, d, A, and B matrices of a link into the flat array
+static void solver_fbs_copy(int index)
+{
+	link_object *lnk = FBS_sweep.branch[index];
+	gld::complex *matrix = &FBS_sweep.abcd[36*index];
+	int row, col;
+
+	for (row=0; row<3; row++)
+	{
+		for (col=0; col<3; col++)
+		{
+			matrix[3*row+col] = lnk->c_mat[row][col];
+			matrix[9+3*row+col] = lnk->d_mat[row][col];
+			matrix[18+3*row+col] = lnk->A_mat[row][col];
+			matrix[27+3*row+col] = lnk->B_mat[row][col];
+		}
+	}
+}
+
+//Extracts the feeder below the SWING node on its first presync
+void solver_fbs_build(OBJECT *swing)
+{
+	FINDLIST *links;
+	OBJECT *obj = nullptr;
+	link_object *lnk;
+	node *root, *tnode;
+	gld_property *temp_property;
+	std::vector<link_object *> found;
+	std::multimap<OBJECT *,int> leaving;
+	std::multimap<OBJECT *,int>::iterator leave;
+	std::pair<std::multimap<OBJECT *,int>::iterator,std::multimap<OBJECT *,int>::iterator> range;
+	std::vector<int> order, reached;
+	int index, level_start, level_end, link_count;
+
+	FBS_sweep_active = false;
+
+	root = OBJECTDATA(swing,node);
+
+	if (root->has_phase(PHASE_S))
+	{
+		solver_fbs_unsupported(swing,"is a split-phase SWING node");
+		return;
+	}
+
+	if ((swing->parent != nullptr) && (gl_object_isa(swing->parent,"node","powerflow") || gl_object_isa(swing->parent,"link","powerflow")))
+	{
+		solver_fbs_unsupported(swing,"is not the top of the feeder");
+		return;
+	}
+
+	links = gl_find_objects(FL_NEW,FT_MODULE,SAME,"powerflow",FT_END);
+
+	if (links == nullptr)
+		return;
+
+	while ((obj=gl_find_next(links,obj)) != nullptr)
+	{
+		if (!gl_object_isa(obj,"link","powerflow"))
+			continue;
+
+		lnk = OBJECTDATA(obj,link_object);
+
+		//The FBS ranks parent each to node to the link feeding it - anything else is not radial
+		if (lnk->to->parent != obj)
+		{
+			gl_free(links);
+			solver_fbs_unsupported(obj,"is not the only link into its to node");
+			return;
+		}
+
+		leaving.insert(std::make_pair(lnk->from,(int)found.size()));
+		found.push_back(lnk);
+	}
+	gl_free(links);
+
+	//No lines, nothing to sweep
+	if (found.empty())
+		return;
+
+	//Breadth-first from the SWING node, so the links come out level by level
+	range = leaving.equal_range(swing);
+	for (leave=range.first; leave!=range.second; leave++)
+	{
+		order.push_back(leave->second);
+		FBS_sweep.parent.push_back(-1);
+	}
+
+	level_start = 0;
+	while (level_start < (int)order.size())
+	{
+		level_end = (int)order.size();
+		FBS_sweep.level_ptr.push_back(level_start);
+
+		for (index=level_start; index<level_end; index++)
+		{
+			range = leaving.equal_range(found[order[index]]->to);
+			for (leave=range.first; leave!=range.second; leave++)
+			{
+				order.push_back(leave->second);
+				FBS_sweep.parent.push_back(index);
+			}
+		}
+
+		level_start = level_end;
+	}
+	FBS_sweep.level_ptr.push_back((int)order.size());
+
+	link_count = (int)order.size();
+
+	if (link_count != (int)found.size())
+	{
+		reached.assign(found.size(),0);
+		for (index=0; index<link_count; index++)
+			reached[order[index]] = 1;
+
+		for (index=0; reached[index]!=0; index++);
+
+		solver_fbs_unsupported(OBJECTHDR(found[index]),"is not connected to the SWING node");
+		FBS_sweep.parent.clear();
+		FBS_sweep.level_ptr.clear();
+		return;
+	}
+
+	FBS_sweep.root_current = root->current_inj;
+
+	for (index=0; index<link_count; index++)
+	{
+		lnk = found[order[index]];
+		obj = OBJECTHDR(lnk);
+		tnode = OBJECTDATA(lnk->to,node);
+
+		FBS_sweep.branch.push_back(lnk);
+		FBS_sweep.to_node.push_back(tnode);
+		FBS_sweep.from_voltage.push_back(OBJECTDATA(lnk->from,node)->voltage);
+		FBS_sweep.to_voltage.push_back(tnode->voltage);
+		FBS_sweep.to_current.push_back(tnode->current_inj);
+
+		//Split-phase nodes fold the currents they feed into their neutral (node::sync)
+		FBS_sweep.neutral.push_back(0);
+		FBS_sweep.neutral_tn.push_back(gld::complex(0.0,0.0));
+		FBS_sweep.neutral_tn.push_back(gld::complex(0.0,0.0));
+
+		if (tnode->has_phase(PHASE_S))
+		{
+			if (gl_object_isa(obj,"triplex_line","powerflow"))
+			{
+				temp_property = new gld_property(obj,"triplex_neutral_1_value");
+				FBS_sweep.neutral_tn[2*index] = temp_property->get_complex();
+				delete temp_property;
+
+				temp_property = new gld_property(obj,"triplex_neutral_2_value");
+				FBS_sweep.neutral_tn[2*index+1] = temp_property->get_complex();
+				delete temp_property;
+
+				FBS_sweep.neutral[index] = 1;
+			}
+			else
+			{
+				FBS_sweep.neutral[index] = 2;
+			}
+		}
+	}
+
+	//Lines, transformers, and reactors keep the matrices of their init under FBS
+	FBS_sweep.abcd.resize(36*link_count);
+	for (index=0; index<link_count; index++)
+	{
+		obj = OBJECTHDR(FBS_sweep.branch[index]);
+
+		if (!(gl_object_isa(obj,"line","powerflow") || gl_object_isa(obj,"transformer","powerflow") || gl_object_isa(obj,"series_reactor","powerflow")))
+			FBS_sweep.refresh.push_back(index);
+
+		solver_fbs_copy(index);
+	}
+
+	//Children of a link are contiguous, in the order their parent was visited
+	FBS_sweep.child_ptr.assign(link_count+1,0);
+	for (index=0; index<link_count; index++)
+	{
+		if (FBS_sweep.parent[index] >= 0)
+			FBS_sweep.child_ptr[FBS_sweep.parent[index]+1]++;
+	}
+	for (index=0; index<link_count; index++)
+		FBS_sweep.child_ptr[index+1] += FBS_sweep.child_ptr[index];
+
+	FBS_sweep.child_index.resize(FBS_sweep.child_ptr[link_count]);
+	for (index=0; index<link_count; index++)
+	{
+		if (FBS_sweep.parent[index] >= 0)
+			FBS_sweep.child_index[index - FBS_sweep.level_ptr[1]] = index;
+	}
+
+	gl_verbose("FBS_array_sweep: %d links in %d levels below %s",link_count,(int)FBS_sweep.level_ptr.size()-1,(swing->name ? swing->name : "the SWING node"));
+
+	FBS_sweep_active = true;
+}
+
+//Backward sweep of links [first,last) of a level - current into each link from its to node and what that feeds
+static void solver_fbs_backward(int first, int last)
+{
+	int index, child, row;
+	link_object *lnk, *child_lnk;
+	node *tnode;
+	gld::complex *tc, *tv, *c, *d;
+	gld::complex fed[3];
+
+	for (index=first; index<last; index++)
+	{
+		tc = FBS_sweep.to_current[index];
+
+		//Closed links leaving the to node, swept with the level below
+		if (FBS_sweep.child_ptr[index] != FBS_sweep.child_ptr[index+1])
+		{
+			fed[0] = fed[1] = fed[2] = gld::complex(0.0,0.0);
+
+			for (child=FBS_sweep.child_ptr[index]; child<FBS_sweep.child_ptr[index+1]; child++)
+			{
+				child_lnk = FBS_sweep.branch[FBS_sweep.child_index[child]];
+
+				if (child_lnk->is_closed())
+				{
+					fed[0] += child_lnk->current_in[0];
+					fed[1] += child_lnk->current_in[1];
+					fed[2] += child_lnk->current_in[2];
+				}
+			}
+
+			tc[0] += fed[0];
+			tc[1] += fed[1];
+			tc[2] += fed[2];
+
+			//Neutral of a split-phase node, as node::sync would have computed it with these currents in
+			if (FBS_sweep.neutral[index] == 1)
+			{
+				tc[2] += FBS_sweep.neutral_tn[2*index]*fed[0] + FBS_sweep.neutral_tn[2*index+1]*fed[1];
+			}
+			else if (FBS_sweep.neutral[index] == 2)
+			{
+				tnode = FBS_sweep.to_node[index];
+
+				if (!((tnode->voltage1.IsZero() || (tnode->power1.IsZero() && tnode->shunt1.IsZero())) ||
+					  (tnode->voltage2.IsZero() || (tnode->power2.IsZero() && tnode->shunt2.IsZero()))))
+				{
+					tc[2] -= fed[0] + fed[1];
+				}
+			}
+		}
+
+		lnk = FBS_sweep.branch[index];
+
+		if (lnk->is_closed())
+		{
+			tv = FBS_sweep.to_voltage[index];
+			c = &FBS_sweep.abcd[36*index];
+			d = c + 9;
+
+			for (row=0; row<3; row++)
+			{
+				lnk->current_in[row] =
+					c[3*row] * tv[0] +
+					c[3*row+1] * tv[1] +
+					c[3*row+2] * tv[2] +
+					d[3*row] * tc[0] +
+					d[3*row+1] * tc[1] +
+					d[3*row+2] * tc[2];
+			}
+		}
+	}
+}
+
+//Forward sweep of links [first,last) of a level - to node voltages from the from node voltages
+static void solver_fbs_forward(int first, int last)
+{
+	int index, row;
+	link_object *lnk;
+	gld::complex *fv, *tv, *tc, *A, *B;
+
+	for (index=first; index<last; index++)
+	{
+		lnk = FBS_sweep.branch[index];
+
+		if (lnk->is_open())
+			continue;
+
+		fv = FBS_sweep.from_voltage[index];
+		tv = FBS_sweep.to_voltage[index];
+		tc = FBS_sweep.to_current[index];
+		A = &FBS_sweep.abcd[36*index+18];
+		B = A + 9;
+
+		for (row=0; row<3; row++)
+		{
+			tv[row] =
+				A[3*row] * fv[0] +
+				A[3*row+1] * fv[1] +
+				A[3*row+2] * fv[2] -
+				B[3*row] * tc[0] -
+				B[3*row+1] * tc[1] -
+				B[3*row+2] * tc[2];
+		}
+	}
+}
+
+//Sweeps one level, split between FBS_sweep_threads threads when it is wide enough
+static void solver_fbs_level(void (*sweep)(int, int), int first, int last)
+{
+	int threads = FBS_sweep_threads;
+	int width = last - first;
+
+	if (threads == 0)
+		threads = (int)std::thread::hardware_concurrency();
+
+	if ((threads <= 1) || (width < FBS_sweep_parallel_width))
+	{
+		sweep(first,last);
+	}
+	else
+	{
+		//Contiguous share of the level, so threads write to different nodes
+		FBS_sweep.workers.run(threads,[&](int thread) {
+			sweep(first+(int)(((int64)width * thread) / threads),first+(int)(((int64)width * (thread+1)) / threads));
+		});
+
+		FBS_sweep_threaded_count++;
+	}
+}
+
+//One backward and forward sweep of the feeder - called from the SWING node sync, once every node has its load current
+void solver_fbs_sweep(void)
+{
+	int level, index;
+	int levels = (int)FBS_sweep.level_ptr.size() - 1;
+	link_object *lnk;
+
+	FBS_sweep_count++;
+
+	//Regulator taps, switch states, and the like changed since the last pass
+	for (index=0; index<(int)FBS_sweep.refresh.size(); index++)
+		solver_fbs_copy(FBS_sweep.refresh[index]);
+
+	//Currents, from the ends of the feeder up
+	for (level=levels-1; level>=0; level--)
+		solver_fbs_level(solver_fbs_backward,FBS_sweep.level_ptr[level],FBS_sweep.level_ptr[level+1]);
+
+	for (index=FBS_sweep.level_ptr[0]; index<FBS_sweep.level_ptr[1]; index++)
+	{
+		lnk = FBS_sweep.branch[index];
+
+		if (lnk->is_closed())
+		{
+			FBS_sweep.root_current[0] += lnk->current_in[0];
+			FBS_sweep.root_current[1] += lnk->current_in[1];
+			FBS_sweep.root_current[2] += lnk->current_in[2];
+		}
+	}
+
+	//Voltages, from the SWING node down
+	for (level=0; level<levels; level++)
+		solver_fbs_level(solver_fbs_forward,FBS_sweep.level_ptr[level],FBS_sweep.level_ptr[level+1]);
+}
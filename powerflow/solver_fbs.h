@@ -0,0 +1,50 @@
+/* $Id
+ * Array forward-backward sweep for radial feeders
+ */
+
+#ifndef _SOLVER_FBS
+#define _SOLVER_FBS
+
+#include <vector>
+
+#include "gld_complex.h"
+#include "object.h"
+#include "solver_workers.h"
+
+class node;
+class link_object;
+
+/** Radial feeder of the FBS solver, flattened for powerflow::FBS_array_sweep
+
+	Built once from the parenting the FBS ranks already rely on: every link is
+	the parent of its to node, so each node below the SWING node is fed by
+	exactly one link.  The links are stored by level from the SWING node - the
+	backward sweep runs the levels bottom-up and the forward sweep top-down, and
+	the links of one level never share a to node, so a level can be split
+	between threads, which are kept with the feeder between the sweeps.  The
+	c, d, A, and B matrices of the links are copied next to each other when
+	the feeder is built; links that rewrite them between passes (regulators,
+	switches, fuses...) are copied again before each sweep.
+ **/
+typedef struct s_fbssweep {
+	gld::complex *root_current;		///< Current injection of the SWING node
+	std::vector<link_object *> branch;		///< Links, level by level from the SWING node
+	std::vector<node *> to_node;	///< To node of each link
+	std::vector<gld::complex *> from_voltage;	///< Voltage of the from node of each link
+	std::vector<gld::complex *> to_voltage;		///< Voltage of the to node of each link
+	std::vector<gld::complex *> to_current;		///< Current injection of the to node of each link
+	std::vector<int> parent;		///< Link feeding the from node of each link (-1 at the SWING node)
+	std::vector<int> child_ptr;		///< Start of the links fed by the to node of each link in child_index
+	std::vector<int> child_index;	///< Links fed by the to node of each link
+	std::vector<int> level_ptr;		///< Start of each level in the link arrays
+	std::vector<gld::complex> abcd;	///< c, d, A, and B matrices of each link, 36 per link
+	std::vector<int> refresh;		///< Links whose matrices are copied again before each sweep
+	std::vector<unsigned char> neutral;	///< Split-phase to node - 1 neutral from the triplex_line multipliers, 2 from the line currents
+	std::vector<gld::complex> neutral_tn;	///< Triplex_line neutral multipliers of the to node, 2 per link
+	solver_workers workers;			///< Threads sweeping the wide levels
+} FBSSWEEP;
+
+void solver_fbs_build(OBJECT *swing);
+void solver_fbs_sweep(void);
+
+#endif
@@ -0,0 +1,534 @@
+/* $Id
+ * In-tree sparse LU solver for the Newton-Raphson powerflow
+ *
+ * Used through the external LU solver interface (LUSolverFcns) when
+ * powerflow::lu_solver is "internal".  See solver_lu.h.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "solver_lu.h"
+#include "powerflow.h"
+
+#define LU_PIVOT_TOLERANCE 0.001	///< Diagonal pivot kept if it is at least this fraction of the largest candidate
+#define LU_REFACTOR_GROWTH 1e8		///< Refactored L entries above this trigger a new factorization with pivoting
+
+//Barrier between the segments of a threaded refactorization (C++17 has no std::barrier)
+class solver_lu_barrier {
+private:
+	std::mutex lock;
+	std::condition_variable wakeup;
+	int count;
+	int waiting;
+	unsigned int generation;
+public:
+	solver_lu_barrier(int threads) : count(threads), waiting(0), generation(0) {};
+	void wait(void)
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		unsigned int arrival = generation;
+		if (++waiting == count)
+		{
+			waiting = 0;
+			generation++;
+			wakeup.notify_all();
+		}
+		else
+		{
+			wakeup.wait(guard,[&]{return arrival != generation;});
+		}
+	};
+};
+
+//Minimum degree column order, on the pattern of A+A'
+static void solver_lu_order(LUSOLVER *lu, const int *Ap, const int *Ai)
+{
+	int n = (int)lu->n;
+	int vindex, uindex, p;
+	std::vector<std::vector<int> > adjacency(n);
+	std::vector<int> merged;
+	std::set<std::pair<int,int> > queue;
+
+	for (vindex=0; vindex<n; vindex++)
+	{
+		for (p=Ap[vindex]; p<Ap[vindex+1]; p++)
+		{
+			if (Ai[p] != vindex)
+			{
+				adjacency[vindex].push_back(Ai[p]);
+				adjacency[Ai[p]].push_back(vindex);
+			}
+		}
+	}
+
+	for (vindex=0; vindex<n; vindex++)
+	{
+		std::sort(adjacency[vindex].begin(),adjacency[vindex].end());
+		adjacency[vindex].erase(std::unique(adjacency[vindex].begin(),adjacency[vindex].end()),adjacency[vindex].end());
+		queue.insert(std::make_pair((int)adjacency[vindex].size(),vindex));
+	}
+
+	lu->Q.clear();
+	while (!queue.empty())
+	{
+		//Eliminate the variable of least degree - its neighbors become a clique
+		vindex = queue.begin()->second;
+		queue.erase(queue.begin());
+		lu->Q.push_back(vindex);
+
+		std::vector<int> &neighbors = adjacency[vindex];
+		for (std::vector<int>::iterator neighbor=neighbors.begin(); neighbor!=neighbors.end(); neighbor++)
+		{
+			uindex = *neighbor;
+			queue.erase(std::make_pair((int)adjacency[uindex].size(),uindex));
+
+			merged.clear();
+			std::set_union(adjacency[uindex].begin(),adjacency[uindex].end(),neighbors.begin(),neighbors.end(),std::back_inserter(merged));
+			merged.erase(std::remove_if(merged.begin(),merged.end(),[&](int w){return (w == uindex) || (w == vindex);}),merged.end());
+			adjacency[uindex].swap(merged);
+
+			queue.insert(std::make_pair((int)adjacency[uindex].size(),uindex));
+		}
+		std::vector<int>().swap(adjacency[vindex]);
+	}
+}
+
+//Depth-first search of the graph of L from row j - pushes the rows reached on xi[top...] in topological order
+static int solver_lu_dfs(LUSOLVER *lu, int j, int top)
+{
+	int head, jnew, p, p2;
+	int *xi = lu->xi.data();
+	int *stack = xi + lu->n;
+	bool done;
+
+	head = 0;
+	stack[0] = j;
+	while (head >= 0)
+	{
+		j = stack[head];
+		jnew = lu->Pinv[j];
+		if (!lu->marked[j])
+		{
+			lu->marked[j] = 1;
+			lu->pstack[head] = (jnew < 0) ? 0 : lu->Lp[jnew];
+		}
+		done = true;
+		p2 = (jnew < 0) ? 0 : lu->Lp[jnew+1];
+		for (p=lu->pstack[head]; p<p2; p++)
+		{
+			if (!lu->marked[lu->Li[p]])
+			{
+				lu->pstack[head] = p;
+				stack[++head] = lu->Li[p];
+				done = false;
+				break;
+			}
+		}
+		if (done)
+		{
+			head--;
+			xi[--top] = j;
+		}
+	}
+	return top;
+}
+
+//Full factorization with threshold partial pivoting, in the column order Q - returns 0 or the (1-based) singular column
+static int solver_lu_factor(LUSOLVER *lu, const int *Ap, const int *Ai, const double *Ax)
+{
+	int n = (int)lu->n;
+	int k, col, p, top, i, ipiv;
+	double *x = lu->x.data();
+	double a, t, pivot;
+
+	lu->factored = false;
+	lu->Pinv.assign(n,-1);
+	lu->Lp.assign(n+1,0);
+	lu->Up.assign(n+1,0);
+	lu->Li.clear();
+	lu->Lx.clear();
+	lu->Ui.clear();
+	lu->Ux.clear();
+
+	for (k=0; k<n; k++)
+	{
+		lu->Lp[k] = (int)lu->Li.size();
+		lu->Up[k] = (int)lu->Ui.size();
+		col = lu->Q[k];
+
+		//Rows reached by the column through L, then x = L\A(:,col)
+		top = n;
+		for (p=Ap[col]; p<Ap[col+1]; p++)
+		{
+			if (!lu->marked[Ai[p]])
+			{
+				top = solver_lu_dfs(lu,Ai[p],top);
+			}
+		}
+		for (p=top; p<n; p++)
+		{
+			lu->marked[lu->xi[p]] = 0;
+			x[lu->xi[p]] = 0.0;
+		}
+		for (p=Ap[col]; p<Ap[col+1]; p++)
+		{
+			x[Ai[p]] = Ax[p];
+		}
+		for (p=top; p<n; p++)
+		{
+			int jrow = lu->xi[p];
+			int jcol = lu->Pinv[jrow];
+			if (jcol < 0)
+				continue;
+			for (int q=lu->Lp[jcol]+1; q<lu->Lp[jcol+1]; q++)
+			{
+				x[lu->Li[q]] -= lu->Lx[q] * x[jrow];
+			}
+		}
+
+		//Pick the pivot - the diagonal if it is large enough
+		ipiv = -1;
+		a = -1.0;
+		for (p=top; p<n; p++)
+		{
+			i = lu->xi[p];
+			if (lu->Pinv[i] < 0)
+			{
+				t = fabs(x[i]);
+				if (t > a)
+				{
+					a = t;
+					ipiv = i;
+				}
+			}
+			else
+			{
+				lu->Ui.push_back(lu->Pinv[i]);
+				lu->Ux.push_back(x[i]);
+			}
+		}
+		if ((ipiv == -1) || !(a > 0.0) || !std::isfinite(a))
+		{
+			for (p=top; p<n; p++)
+				x[lu->xi[p]] = 0.0;
+			return k+1;
+		}
+		if ((lu->Pinv[col] < 0) && (fabs(x[col]) >= a*LU_PIVOT_TOLERANCE))
+		{
+			ipiv = col;
+		}
+
+		pivot = x[ipiv];
+		lu->Ui.push_back(k);
+		lu->Ux.push_back(pivot);
+		lu->Pinv[ipiv] = k;
+		lu->Li.push_back(ipiv);
+		lu->Lx.push_back(1.0);
+		for (p=top; p<n; p++)
+		{
+			i = lu->xi[p];
+			if (lu->Pinv[i] < 0)
+			{
+				lu->Li.push_back(i);
+				lu->Lx.push_back(x[i] / pivot);
+			}
+			x[i] = 0.0;
+		}
+	}
+	lu->Lp[n] = (int)lu->Li.size();
+	lu->Up[n] = (int)lu->Ui.size();
+
+	//Rows of L in pivot order
+	for (p=0; p<lu->Lp[n]; p++)
+	{
+		lu->Li[p] = lu->Pinv[lu->Li[p]];
+	}
+
+	//Rows of U ascending, so refactoring can eliminate them in order
+	std::vector<std::pair<int,double> > column;
+	for (k=0; k<n; k++)
+	{
+		column.clear();
+		for (p=lu->Up[k]; p<lu->Up[k+1]; p++)
+			column.push_back(std::make_pair(lu->Ui[p],lu->Ux[p]));
+		std::sort(column.begin(),column.end());
+		for (p=lu->Up[k]; p<lu->Up[k+1]; p++)
+		{
+			lu->Ui[p] = column[p-lu->Up[k]].first;
+			lu->Ux[p] = column[p-lu->Up[k]].second;
+		}
+	}
+
+	//Refactoring schedule - a column depends on the columns of its U pattern
+	std::vector<int> level(n,0);
+	int level_count = 0;
+	for (k=0; k<n; k++)
+	{
+		for (p=lu->Up[k]; p<lu->Up[k+1]-1; p++)
+		{
+			level[k] = std::max(level[k],level[lu->Ui[p]]+1);
+		}
+		level_count = std::max(level_count,level[k]+1);
+	}
+	std::vector<int> level_ptr(level_count+1,0);
+	for (k=0; k<n; k++)
+		level_ptr[level[k]+1]++;
+	for (i=0; i<level_count; i++)
+		level_ptr[i+1] += level_ptr[i];
+	lu->segment_cols.resize(n);
+	std::vector<int> level_next(level_ptr.begin(),level_ptr.end()-1);
+	for (k=0; k<n; k++)
+		lu->segment_cols[level_next[level[k]]++] = k;
+
+	//Narrow levels that follow each other make one serial segment
+	lu->segment_ptr.clear();
+	lu->segment_parallel.clear();
+	for (i=0; i<level_count; i++)
+	{
+		bool wide = (level_ptr[i+1]-level_ptr[i]) >= NR_lu_parallel_width;
+		if (wide || lu->segment_parallel.empty() || lu->segment_parallel.back())
+		{
+			lu->segment_ptr.push_back(level_ptr[i]);
+			lu->segment_parallel.push_back(wide ? 1 : 0);
+		}
+	}
+	lu->segment_ptr.push_back(n);
+
+	lu->factored = true;
+	lu->factor_count++;
+	return 0;
+}
+
+//Refactors column k with the pivots and patterns of the last factorization - false if the pivot is too small
+static bool solver_lu_refactor_column(LUSOLVER *lu, int k, const int *Ap, const int *Ai, const double *Ax, double *x)
+{
+	int col = lu->Q[k];
+	int p, q, j;
+	double ukj, pivot, lmax;
+
+	for (p=Ap[col]; p<Ap[col+1]; p++)
+	{
+		x[lu->Pinv[Ai[p]]] = Ax[p];
+	}
+
+	for (p=lu->Up[k]; p<lu->Up[k+1]-1; p++)
+	{
+		j = lu->Ui[p];
+		ukj = x[j];
+		x[j] = 0.0;
+		lu->Ux[p] = ukj;
+		for (q=lu->Lp[j]+1; q<lu->Lp[j+1]; q++)
+		{
+			x[lu->Li[q]] -= lu->Lx[q] * ukj;
+		}
+	}
+
+	pivot = x[k];
+	x[k] = 0.0;
+	lu->Ux[lu->Up[k+1]-1] = pivot;
+
+	lmax = 0.0;
+	for (q=lu->Lp[k]+1; q<lu->Lp[k+1]; q++)
+	{
+		lu->Lx[q] = x[lu->Li[q]] / pivot;
+		x[lu->Li[q]] = 0.0;
+		if (!(fabs(lu->Lx[q]) <= lmax))
+			lmax = fabs(lu->Lx[q]);
+	}
+
+	return (pivot != 0.0) && std::isfinite(pivot) && (lmax < LU_REFACTOR_GROWTH);
+}
+
+//Refactors all the columns, by segments of the schedule when threads are used
+static bool solver_lu_refactor(LUSOLVER *lu, const int *Ap, const int *Ai, const double *Ax)
+{
+	int n = (int)lu->n;
+	int threads = NR_lu_threads;
+	int k;
+	bool ok = true;
+
+	if (threads == 0)
+		threads = (int)std::thread::hardware_concurrency();
+
+	//Nothing to share between threads
+	if ((threads <= 1) || (std::find(lu->segment_parallel.begin(),lu->segment_parallel.end(),1) == lu->segment_parallel.end()))
+	{
+		for (k=0; k<n; k++)
+		{
+			ok = solver_lu_refactor_column(lu,k,Ap,Ai,Ax,lu->x.data()) && ok;
+		}
+	}
+	else
+	{
+		std::atomic<bool> all_ok(true);
+		solver_lu_barrier barrier(threads);
+
+		if ((int)lu->thread_x.size() < threads)
+			lu->thread_x.resize(threads);
+		for (k=0; k<threads; k++)
+			lu->thread_x[k].resize(n,0.0);
+
+		std::function<void(int)> worker = [&](int thread) {
+			double *x = lu->thread_x[thread].data();
+			bool thread_ok = true;
+			for (size_t segment=0; segment+1<lu->segment_ptr.size(); segment++)
+			{
+				if (lu->segment_parallel[segment])
+				{
+					//Contiguous share of the level, so threads write to different parts of L and U
+					int width = lu->segment_ptr[segment+1] - lu->segment_ptr[segment];
+					int first = lu->segment_ptr[segment] + (int)(((int64)width * thread) / threads);
+					int last = lu->segment_ptr[segment] + (int)(((int64)width * (thread+1)) / threads);
+					for (int index=first; index<last; index++)
+						thread_ok = solver_lu_refactor_column(lu,lu->segment_cols[index],Ap,Ai,Ax,x) && thread_ok;
+				}
+				else if (thread == 0)
+				{
+					for (int index=lu->segment_ptr[segment]; index<lu->segment_ptr[segment+1]; index++)
+						thread_ok = solver_lu_refactor_column(lu,lu->segment_cols[index],Ap,Ai,Ax,x) && thread_ok;
+				}
+				barrier.wait();
+			}
+			if (!thread_ok)
+				all_ok = false;
+		};
+
+		lu->workers.run(threads,worker);
+		ok = all_ok;
+		if (ok)
+			NR_lu_threaded_count++;
+	}
+
+	if (ok)
+		lu->refactor_count++;
+	return ok;
+}
+
+//Initialization function - allocates the variables of an island on the first call
+void *solver_lu_init(void *ext_array)
+{
+	LUSOLVER *lu;
+
+	if (ext_array == nullptr)
+	{
+		lu = new LUSOLVER;
+		lu->n = 0;
+		lu->analyzed = false;
+		lu->factored = false;
+		lu->factor_count = 0;
+		lu->refactor_count = 0;
+		ext_array = (void *)lu;
+	}
+
+	return ext_array;
+}
+
+//Allocation function - the matrix changed size, so the next solve analyzes it again
+void solver_lu_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change)
+{
+	LUSOLVER *lu = (LUSOLVER *)ext_array;
+
+	lu->n = rowcount;
+	lu->analyzed = false;
+	lu->factored = false;
+	lu->x.assign(rowcount,0.0);
+	lu->xi.assign(2*rowcount,0);
+	lu->pstack.assign(rowcount,0);
+	lu->marked.assign(rowcount,0);
+	lu->thread_x.clear();
+}
+
+//Solution function - solves A x = b in place in rhs_LU, returns 0 on success or a positive value for a singular matrix
+int solver_lu_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount)
+{
+	LUSOLVER *lu = (LUSOLVER *)ext_array;
+	const int *Ap = system_info_vars->cols_LU;
+	const int *Ai = system_info_vars->rows_LU;
+	const double *Ax = system_info_vars->a_LU;
+	double *b = system_info_vars->rhs_LU;
+	int n, k, p, result;
+
+	if (lu->n != rowcount)
+	{
+		solver_lu_alloc(ext_array,rowcount,rowcount,true);
+	}
+	n = (int)lu->n;
+
+	//See if the pattern is the one analyzed
+	if (lu->analyzed && ((lu->Ap.size() != (size_t)(n+1)) || !std::equal(lu->Ap.begin(),lu->Ap.end(),Ap) || (lu->Ai.size() != (size_t)Ap[n]) || !std::equal(lu->Ai.begin(),lu->Ai.end(),Ai)))
+	{
+		lu->analyzed = false;
+	}
+
+	if (!lu->analyzed)
+	{
+		lu->Ap.assign(Ap,Ap+n+1);
+		lu->Ai.assign(Ai,Ai+Ap[n]);
+		solver_lu_order(lu,Ap,Ai);
+		lu->factored = false;
+		lu->analyzed = true;
+	}
+
+	//Refactor with the last pivots if possible, otherwise factor again
+	if (!lu->factored || !solver_lu_refactor(lu,Ap,Ai,Ax))
+	{
+		result = solver_lu_factor(lu,Ap,Ai,Ax);
+		if (result != 0)
+		{
+			return result;
+		}
+	}
+
+	//Forward and back substitutions, in the factor order
+	double *y = lu->x.data();
+	for (k=0; k<n; k++)
+	{
+		y[lu->Pinv[k]] = b[k];
+	}
+	for (k=0; k<n; k++)
+	{
+		for (p=lu->Lp[k]+1; p<lu->Lp[k+1]; p++)
+		{
+			y[lu->Li[p]] -= lu->Lx[p] * y[k];
+		}
+	}
+	for (k=n-1; k>=0; k--)
+	{
+		y[k] /= lu->Ux[lu->Up[k+1]-1];
+		for (p=lu->Up[k]; p<lu->Up[k+1]-1; p++)
+		{
+			y[lu->Ui[p]] -= lu->Ux[p] * y[k];
+		}
+	}
+	for (k=0; k<n; k++)
+	{
+		b[lu->Q[k]] = y[k];
+		y[k] = 0.0;
+	}
+
+	return 0;
+}
+
+//Destruction function - called after each iteration, the factors are kept for the next refactoring
+void solver_lu_destroy(void *ext_array, bool new_iteration)
+{
+}
+
+//Releases the variables of an island
+void solver_lu_free(void *ext_array)
+{
+	LUSOLVER *lu = (LUSOLVER *)ext_array;
+
+	if (lu != nullptr)
+	{
+		gl_verbose("solver_lu: %lld factorizations, %lld refactorizations of a %u-variable matrix",lu->factor_count,lu->refactor_count,lu->n);
+		delete lu;
+	}
+}
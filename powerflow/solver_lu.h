@@ -0,0 +1,59 @@
+/* $Id
+ * In-tree sparse LU solver for the Newton-Raphson powerflow
+ */
+
+#ifndef _SOLVER_LU
+#define _SOLVER_LU
+
+#include <vector>
+
+#include "solver_nr.h"
+#include "solver_workers.h"
+
+/** Sparse LU factors of the NR matrix of one island (lu_solver "internal")
+
+	Implements the LU_init/LU_alloc/LU_solve/LU_destroy interface of the external
+	LU solvers, without a library to load.  The first solve of a sparsity pattern
+	orders the columns by minimum degree and factors the matrix with threshold
+	partial pivoting (left-looking, Gilbert-Peierls).  Later solves with the same
+	pattern only refactor the values, keeping the ordering, the pivots, and the
+	patterns of L and U (like klu_refactor), and factor again from scratch if a
+	pivot became too small.  The columns of one level of the elimination tree do
+	not depend on each other, so levels of at least NR_lu_parallel_width columns
+	are refactored by NR_lu_threads threads, which are kept with the factors of the
+	island between the refactorizations.
+ **/
+typedef struct s_lusolver {
+	unsigned int n;					///< Size of the matrix
+	bool analyzed;					///< Ordering done for the pattern in Ap/Ai
+	bool factored;					///< Pivots and factor patterns valid for the values of the last solve
+	std::vector<int> Ap;			///< Column pointers of the pattern analyzed
+	std::vector<int> Ai;			///< Row indices of the pattern analyzed
+	std::vector<int> Q;				///< Column order - column k of the factors is column Q[k] of the matrix
+	std::vector<int> Pinv;			///< Row order - row i of the matrix is row Pinv[i] of the factors
+	std::vector<int> Lp;			///< L column pointers
+	std::vector<int> Li;			///< L row indices - unit diagonal first in each column
+	std::vector<double> Lx;			///< L values
+	std::vector<int> Up;			///< U column pointers
+	std::vector<int> Ui;			///< U row indices - ascending, so the diagonal is last in each column
+	std::vector<double> Ux;			///< U values
+	std::vector<int> segment_ptr;	///< Refactoring schedule - start of each segment in segment_cols
+	std::vector<int> segment_cols;	///< Refactoring schedule - columns in level order
+	std::vector<char> segment_parallel;	///< Refactoring schedule - columns of the segment are independent
+	std::vector<double> x;			///< Dense work vector (zero between columns)
+	std::vector<int> xi;			///< Reach of a column (2n, second half is the DFS stack)
+	std::vector<int> pstack;		///< DFS positions
+	std::vector<char> marked;		///< DFS marks
+	std::vector<std::vector<double> > thread_x;	///< Dense work vectors of the refactoring threads
+	solver_workers workers;			///< Refactoring threads
+	int64 factor_count;				///< Number of full factorizations
+	int64 refactor_count;			///< Number of refactorizations
+} LUSOLVER;
+
+void *solver_lu_init(void *ext_array);
+void solver_lu_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change);
+int solver_lu_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount);
+void solver_lu_destroy(void *ext_array, bool new_iteration);
+void solver_lu_free(void *ext_array);
+
+#endif
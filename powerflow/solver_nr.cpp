@@ -30,12 +30,18 @@ Initialization after returning to service?
 
 ***********************************************************************
 */
+#include <chrono>
 #include <cmath>
+#include <exception>
+#include <functional>
+#include <thread>
 #ifndef GLD_USE_EIGEN
 #include "solver_nr.h"
+#include "solver_lu.h"
 #else
 #include "solver_nr_eigen.h"
 #endif
+#include "solver_workers.h"
 
 /* access to module global variables */
 #include "powerflow.h"
@@ -68,6 +74,42 @@ namespace gld {
     }
 }
 
+//Class-level current injection updates registered by the generators (see NR_current_injection_batch_register)
+static std::vector<NR_CURRENT_INJECTION_BATCH> NR_current_injection_batches;
+static solver_workers NR_current_injection_workers;
+
+static void NR_current_injection_batch_compute(BUSDATA *bus, int island_number, int64 iteration_count);
+
+//Packed ZIP load tables of compute_load_values - one per island, with the bus count they were built for
+static std::vector<NR_LOAD_TABLE> NR_load_tables;
+static unsigned int NR_load_table_bus_count = 0;
+
+static void NR_load_table_build(unsigned int bus_count, BUSDATA *bus);
+static void NR_load_table_evaluate(BUSDATA *bus, NR_LOAD_TABLE *table, bool jacobian_pass);
+
+//Clock of the solver phase timers (NR_solver_timing) - seconds on a monotonic clock, zero when timing is off
+static inline double NR_timer_clock(void)
+{
+	if (NR_solver_timing)
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	else
+		return 0.0;
+}
+
+//Load inputs, source voltages, and topology the last converged solution was solved for (NR_solution_skip)
+typedef struct {
+	bool valid;								///Flag to indicate the bus voltages are still the solution of these inputs
+	unsigned int bus_count;					///Number of buses stored
+	unsigned int branch_count;				///Number of branches stored
+	std::vector<gld::complex> bus_values;	///Load inputs (and PV/SWING voltages) of each bus, in bus order
+	std::vector<enumeration> branch_status;	///Status of each branch (0 if it has none)
+	std::vector<unsigned char> phases;		///Phases of each bus, followed by those of each branch
+} NR_SOLUTION_INPUTS;
+
+static NR_SOLUTION_INPUTS NR_solution_inputs;
+
+static double NR_solution_input_change(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, bool store);
+
 //SuperLU variable structure
 //These are the working variables, but structured for island implementation
 typedef struct {
@@ -75,8 +117,30 @@ typedef struct {
 	int *perm_r;
 	SuperMatrix A_LU;
 	SuperMatrix B_LU;
+	SuperMatrix L_LU;	//Factors kept for chord iterations (NR_jacobian_reuse)
+	SuperMatrix U_LU;
 } SUPERLU_NR_vars;
 
+//Release the LU factors an island kept for chord iterations, so the next solve refactors the Jacobian
+static void NR_release_LU_factors(NR_MATRIX_CONSTRUCTION *island_values)
+{
+	SUPERLU_NR_vars *superLU_vars;
+
+	if (island_values->LU_factors_held)
+	{
+		superLU_vars = (SUPERLU_NR_vars *)island_values->LU_solver_vars;
+
+#ifdef MT
+		Destroy_SuperNode_SCP(&superLU_vars->L_LU);
+		Destroy_CompCol_NCP(&superLU_vars->U_LU);
+#else
+		Destroy_SuperNode_Matrix(&superLU_vars->L_LU);
+		Destroy_CompCol_Matrix(&superLU_vars->U_LU);
+#endif
+		island_values->LU_factors_held = false;
+	}
+}
+
 //Initialize the sparse notation
 void sparse_init(SPARSE* sm, int nels, int ncols)
 {
@@ -399,6 +463,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	bool proceed_to_next_island;
 	int64 return_value_for_solver_NR;
 
+	//Phase timers (NR_solver_timing)
+	double timer_assembly, timer_lu, timer_update;
+
+	//Refactorization count of the internal LU solver before a solve
+	int64 refactor_count_before = 0;
+
 	//Multi-island pointer to current superLU variables
 	SUPERLU_NR_vars *curr_island_superLU_vars;
 	
@@ -410,6 +480,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	//Set the global - we're working now, so no more adjustments to island arrays until we're done (except removals)
 	NR_solver_working = true;
 
+	//Voltages are about to change - the stored inputs no longer describe them until this solve converges
+	NR_solution_inputs.valid = false;
+
 	//General "short circuit check" - if there are no islands, just leave
 	if (NR_islands_detected <= 0)
 	{
@@ -607,6 +680,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	//While it - loop through until we solve the issue
 	while (still_iterating_islands)
 	{
+		//Start of the assembly phase of this iteration
+		timer_assembly = NR_timer_clock();
+
 		//Map the superLU variables each time -- just easier to do it always
 		if (matrix_solver_method==MM_SUPERLU)
 		{
@@ -652,6 +728,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			powerflow_values->island_matrix_values[island_loop_index].swing_converged = true;	//init it to yes, fail by exception, not default
 		}
 
+		//Compute the class-level current injection updates of this island - pushed in the bus loop below
+		NR_current_injection_batch_compute(bus,island_loop_index,powerflow_values->island_matrix_values[island_loop_index].iteration_count);
+
 		//Compute the calculated loads (not specified) at each bus
 		for (indexer=0; indexer<bus_count; indexer++) //for specific bus k
 		{
@@ -1724,8 +1803,16 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				//See if this particular bus has any "current injection update" requirements - semi-silly to do this for SWING-enabled buses, but makes the code more consistent
 				if ((bus[indexer].ExtraCurrentInjFunc != nullptr) && ((bus[indexer].type == 0) || ((bus[indexer].type > 1) && !bus[indexer].swing_functions_enabled)))
 				{
-					//Call the function
-					call_return_status = ((STATUS (*)(OBJECT *,int64,bool *))(*bus[indexer].ExtraCurrentInjFunc))(bus[indexer].ExtraCurrentInjFuncObject,powerflow_values->island_matrix_values[island_loop_index].iteration_count,&temp_bool_value);
+					//Call the function - a class-level update was computed before the loop, so only push it here, in bus order, since it can push a new voltage to the bus (grid-forming in QSTS)
+					if ((bus[indexer].ExtraCurrentInjBatch >= 0) && (bus[indexer].ExtraCurrentInjBatchSlot >= 0))
+					{
+						call_return_status = ((STATUS (*)(OBJECT *))(*NR_current_injection_batches[bus[indexer].ExtraCurrentInjBatch].push))(bus[indexer].ExtraCurrentInjFuncObject);
+						temp_bool_value = NR_current_injection_batches[bus[indexer].ExtraCurrentInjBatch].converged_failure[bus[indexer].ExtraCurrentInjBatchSlot];
+					}
+					else
+					{
+						call_return_status = ((STATUS (*)(OBJECT *,int64,bool *))(*bus[indexer].ExtraCurrentInjFunc))(bus[indexer].ExtraCurrentInjFuncObject,powerflow_values->island_matrix_values[island_loop_index].iteration_count,&temp_bool_value);
+					}
 
 					//Make sure it worked
 					if (call_return_status == FAILED)
@@ -2543,6 +2630,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 
 			if (matrix_solver_method==MM_SUPERLU)
 			{
+				//Drop any kept factors - they go with the permutations
+				NR_release_LU_factors(&powerflow_values->island_matrix_values[island_loop_index]);
+
 				//Free up superLU matrices
 				gl_free(curr_island_superLU_vars->perm_r);
 				gl_free(curr_island_superLU_vars->perm_c);
@@ -2610,6 +2700,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 		{
 			if (matrix_solver_method==MM_SUPERLU)
 			{
+				//Size changed - kept factors are no longer valid
+				NR_release_LU_factors(&powerflow_values->island_matrix_values[island_loop_index]);
+
 				//Update relevant portions
 				curr_island_superLU_vars->A_LU.nrow = n;
 				curr_island_superLU_vars->A_LU.ncol = m;
@@ -2653,6 +2746,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 		}
 		//Default else -- it is nullptr - zero it and "populate it" below
 
+		//Assembly done - the LU solver takes over
+		timer_lu = NR_timer_clock();
+
 		if (matrix_solver_method==MM_SUPERLU)
 		{
 			////* Create Matrix A in the format expected by Super LU.*/
@@ -2676,6 +2772,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				//Start with "failure" option on the structure
 				mesh_imped_vals->return_code = 0;
 
+				//The impedance solves below overwrite the permutations of any kept factors
+				NR_release_LU_factors(&powerflow_values->island_matrix_values[island_loop_index]);
+
 				//Determine the base index (error check)
 				if (mesh_imped_vals->NodeRefNum > 0)
 				{
@@ -2917,13 +3016,29 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 
 				//Solve the system
 				pdgssv(NR_superLU_procs, &curr_island_superLU_vars->A_LU, curr_island_superLU_vars->perm_c, curr_island_superLU_vars->perm_r, &L_LU, &U_LU, &curr_island_superLU_vars->B_LU, &powerflow_values->island_matrix_values[island_loop_index].solver_info);
+				NR_factorization_count++;
 #else
 				//sequential superLU
 
 				StatInit ( &stat );
 
-				// solve the system
-				dgssv(&options, &curr_island_superLU_vars->A_LU, curr_island_superLU_vars->perm_c, curr_island_superLU_vars->perm_r, &L_LU, &U_LU, &curr_island_superLU_vars->B_LU, &stat, &powerflow_values->island_matrix_values[island_loop_index].solver_info);
+				//See if the factors of a previous Jacobian are kept (chord iteration)
+				if (powerflow_values->island_matrix_values[island_loop_index].LU_factors_held)
+				{
+					//Solve with them
+					dgstrs(NOTRANS, &curr_island_superLU_vars->L_LU, &curr_island_superLU_vars->U_LU, curr_island_superLU_vars->perm_c, curr_island_superLU_vars->perm_r, &curr_island_superLU_vars->B_LU, &stat, &powerflow_values->island_matrix_values[island_loop_index].solver_info);
+
+					powerflow_values->island_matrix_values[island_loop_index].LU_factors_reused = true;
+					NR_factorization_reuse_count++;
+				}
+				else
+				{
+					// solve the system
+					dgssv(&options, &curr_island_superLU_vars->A_LU, curr_island_superLU_vars->perm_c, curr_island_superLU_vars->perm_r, &L_LU, &U_LU, &curr_island_superLU_vars->B_LU, &stat, &powerflow_values->island_matrix_values[island_loop_index].solver_info);
+
+					powerflow_values->island_matrix_values[island_loop_index].LU_factors_reused = false;
+					NR_factorization_count++;
+				}
 #endif
 
 				sol_LU = (double*) ((DNformat*) curr_island_superLU_vars->B_LU.Store)->nzval;
@@ -2958,9 +3073,25 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			}
 			//Default else -- not mesh fault mode, so go like normal
 
+			//Note the refactorizations of the internal solver, so they are counted apart from the full factorizations
+			if (LUSolverFcns.ext_solve == (void *)solver_lu_solve)
+			{
+				refactor_count_before = ((LUSOLVER *)powerflow_values->island_matrix_values[island_loop_index].LU_solver_vars)->refactor_count;
+			}
+
 			//Call the solver
 			powerflow_values->island_matrix_values[island_loop_index].solver_info = ((int (*)(void *,NR_SOLVER_VARS *, unsigned int, unsigned int))(LUSolverFcns.ext_solve))(powerflow_values->island_matrix_values[island_loop_index].LU_solver_vars,&powerflow_values->island_matrix_values[island_loop_index].matrices_LU,n,1);
 
+			//The internal solver only refactors the values when the pattern did not change
+			if ((LUSolverFcns.ext_solve == (void *)solver_lu_solve) && (((LUSOLVER *)powerflow_values->island_matrix_values[island_loop_index].LU_solver_vars)->refactor_count != refactor_count_before))
+			{
+				NR_refactorization_count++;
+			}
+			else
+			{
+				NR_factorization_count++;
+			}
+
 			//Point the solution to the proper place
 			sol_LU = powerflow_values->island_matrix_values[island_loop_index].matrices_LU.rhs_LU;
 		}
@@ -2973,6 +3104,9 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			*/
 		}
 
+		//LU solve done - apply it
+		timer_update = NR_timer_clock();
+
 		//Update bus voltages - check convergence while we're here
 		powerflow_values->island_matrix_values[island_loop_index].max_mismatch_converge = 0;
 
@@ -3280,9 +3414,38 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			Destroy_SuperNode_SCP(&L_LU);
 			Destroy_CompCol_NCP(&U_LU);
 #else
-			//sequential superLU commands
-			Destroy_SuperNode_Matrix( &L_LU );
-			Destroy_CompCol_Matrix( &U_LU );
+			//Chord iterations - keep new factors for the next solves, as long as reusing them converges fast enough
+			if (NR_jacobian_reuse && (powerflow_values->island_matrix_values[island_loop_index].solver_info == 0) && !powerflow_values->island_matrix_values[island_loop_index].NR_realloc_needed)
+			{
+				if (!powerflow_values->island_matrix_values[island_loop_index].LU_factors_reused)
+				{
+					//Keep them instead of destroying them
+					curr_island_superLU_vars->L_LU = L_LU;
+					curr_island_superLU_vars->U_LU = U_LU;
+					powerflow_values->island_matrix_values[island_loop_index].LU_factors_held = true;
+				}
+				else if ((powerflow_values->island_matrix_values[island_loop_index].iteration_count > 0) && (powerflow_values->island_matrix_values[island_loop_index].max_mismatch_converge > (NR_jacobian_reuse_rate * powerflow_values->island_matrix_values[island_loop_index].LU_reuse_mismatch)))
+				{
+					//Converging too slowly on the old Jacobian - refactor on the next iteration
+					NR_release_LU_factors(&powerflow_values->island_matrix_values[island_loop_index]);
+				}
+				//Default else - keep going with the held factors
+
+				//Store the difference for the next rate check
+				powerflow_values->island_matrix_values[island_loop_index].LU_reuse_mismatch = powerflow_values->island_matrix_values[island_loop_index].max_mismatch_converge;
+			}
+			else
+			{
+				//sequential superLU commands
+				if (!powerflow_values->island_matrix_values[island_loop_index].LU_factors_reused)
+				{
+					Destroy_SuperNode_Matrix( &L_LU );
+					Destroy_CompCol_Matrix( &U_LU );
+				}
+
+				//Nothing to reuse on the next solve
+				NR_release_LU_factors(&powerflow_values->island_matrix_values[island_loop_index]);
+			}
 			StatFree ( &stat );
 #endif
 		}
@@ -3297,6 +3460,24 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 			//Defined above
 		}
 
+		//Accumulate the phase times of this iteration
+		if (NR_solver_timing)
+		{
+			NR_assembly_time += timer_lu - timer_assembly;
+
+			//Solves with kept factors skip the factorization
+			if (powerflow_values->island_matrix_values[island_loop_index].LU_factors_reused)
+			{
+				NR_solve_time += timer_update - timer_lu;
+			}
+			else
+			{
+				NR_factorization_time += timer_update - timer_lu;
+			}
+
+			NR_update_time += NR_timer_clock() - timer_update;
+		}
+
 		//Final check -- see if the info result wasn't zero -- if so, deflag us no matter what here
 		if (powerflow_values->island_matrix_values[island_loop_index].solver_info != 0)
 		{
@@ -3538,6 +3719,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 		//Default else - it was a failure, just keep going
 	}
 
+	//Keep the inputs of a converged static solution, so later passes can reuse it while they do not change
+	if (NR_solution_skip && !*bad_computations && (return_value_for_solver_NR >= 0) && (powerflow_type == PF_NORMAL) && (mesh_imped_vals == nullptr))
+	{
+		NR_solution_inputs.valid = (NR_solution_input_change(bus_count,bus,branch_count,branch,true) >= 0.0);
+	}
+
 	//Deflag the "island locker"
 	NR_solver_working = false;
 
@@ -5466,6 +5653,9 @@ void NR_admittance_update(unsigned int bus_count, BUSDATA *bus, unsigned int bra
 				}//end not full ABC with AC on either side case
 			}//end all others else
 		}//end branch for
+
+		//Topology may have changed - repack the loads of the islands
+		NR_load_table_build(bus_count,bus);
 	}// Off-diagonal elements update, as well as diagon fixed "base" elements- same for both
 
 	//If an impedance load change
@@ -5476,6 +5666,9 @@ void NR_admittance_update(unsigned int bus_count, BUSDATA *bus, unsigned int bra
 		{
 			//Build the fixed part of the diagonal PQ bus elements of 6n*6n Y_NR matrix. This part will not be updated at each iteration.
 			powerflow_values->island_matrix_values[island_loop_index].size_diag_fixed = 0;
+
+			//Admittance changed - factors of the old Jacobian can't be reused
+			NR_release_LU_factors(&powerflow_values->island_matrix_values[island_loop_index]);
 		}
 
 		for (jindexer=0; jindexer<bus_count;jindexer++)
@@ -5775,6 +5968,518 @@ void NR_admittance_update(unsigned int bus_count, BUSDATA *bus, unsigned int bra
 	NR_FPI_imp_load_change = false;
 }
 
+//Registers a generator with the class-level current injection update of its class
+//Generators sharing the same kernel are listed together - returns the index stored in BUSDATA.ExtraCurrentInjBatch
+int NR_current_injection_batch_register(FUNCTIONADDR kernel, FUNCTIONADDR push, OBJECT *obj, int bus_index)
+{
+	unsigned int batch_index;
+
+	//See if the class already has a batch
+	for (batch_index=0; batch_index<NR_current_injection_batches.size(); batch_index++)
+	{
+		if (NR_current_injection_batches[batch_index].kernel == kernel)
+		{
+			break;
+		}
+	}
+
+	//Nope, start one
+	if (batch_index == NR_current_injection_batches.size())
+	{
+		NR_current_injection_batches.emplace_back();
+		NR_current_injection_batches[batch_index].kernel = kernel;
+		NR_current_injection_batches[batch_index].push = push;
+	}
+
+	//Add the generator
+	NR_current_injection_batches[batch_index].objects.push_back(obj);
+	NR_current_injection_batches[batch_index].bus_index.push_back(bus_index);
+	NR_current_injection_batches[batch_index].converged_failure.reset(new bool[NR_current_injection_batches[batch_index].objects.size()]);
+
+	return (int)batch_index;
+}
+
+//Computes the class-level current injection updates of the generators of an island, ahead of its current injection loop
+//The bus voltages of each class are gathered into a packed array and its kernel is called once over them, split between
+//NR_injection_threads threads - the bus loop then pushes each injection at the position of its bus, like the per-bus updates
+static void NR_current_injection_batch_compute(BUSDATA *bus, int island_number, int64 iteration_count)
+{
+	unsigned int index, count;
+	int bus_index, threads, share_index;
+	std::vector<STATUS> share_status;
+	std::vector<std::exception_ptr> share_error;
+
+	for (std::vector<NR_CURRENT_INJECTION_BATCH>::iterator batch=NR_current_injection_batches.begin(); batch!=NR_current_injection_batches.end(); batch++)
+	{
+		//Gather the generators the bus loop would update - same island and bus type check as the per-bus updates
+		batch->active.clear();
+		batch->voltages.clear();
+		for (index=0; index<batch->objects.size(); index++)
+		{
+			bus_index = batch->bus_index[index];
+			bus[bus_index].ExtraCurrentInjBatchSlot = -1;
+
+			if ((bus[bus_index].island_number == island_number) && ((bus[bus_index].type == 0) || ((bus[bus_index].type > 1) && !bus[bus_index].swing_functions_enabled)))
+			{
+				bus[bus_index].ExtraCurrentInjBatchSlot = (int)batch->active.size();
+				batch->active.push_back(batch->objects[index]);
+				batch->voltages.push_back(bus[bus_index].V[0]);
+				batch->voltages.push_back(bus[bus_index].V[1]);
+				batch->voltages.push_back(bus[bus_index].V[2]);
+			}
+		}
+
+		count = (unsigned int)batch->active.size();
+		if (count == 0)
+			continue;
+
+		threads = NR_injection_threads;
+		if (threads == 0)
+			threads = (int)std::thread::hardware_concurrency();
+		if (threads > (int)count)
+			threads = (int)count;
+		if (threads < 1)
+			threads = 1;
+
+		//Each thread computes a contiguous share of the generators - errors are handed back to this thread
+		share_status.assign(threads,SUCCESS);
+		share_error.assign(threads,nullptr);
+		std::function<void(int)> share = [&](int thread) {
+			unsigned int first = (unsigned int)((uint64_t)count * thread / threads);
+			unsigned int last = (unsigned int)((uint64_t)count * (thread + 1) / threads);
+
+			try
+			{
+				share_status[thread] = ((STATUS (*)(OBJECT **,gld::complex *,unsigned int,int64,bool *))(*batch->kernel))(batch->active.data() + first,batch->voltages.data() + 3 * first,last - first,iteration_count,batch->converged_failure.get() + first);
+			}
+			catch (...)
+			{
+				share_error[thread] = std::current_exception();
+			}
+		};
+
+		if (threads > 1)
+		{
+			NR_current_injection_workers.run(threads,share);
+		}
+		else
+		{
+			share(0);
+		}
+
+		for (share_index=0; share_index<threads; share_index++)
+		{
+			if (share_error[share_index] != nullptr)
+			{
+				std::rethrow_exception(share_error[share_index]);
+			}
+
+			if (share_status[share_index] == FAILED)
+			{
+				index = (unsigned int)((uint64_t)count * share_index / threads);
+				GL_THROW("External current injection update failed for the devices starting at %s",batch->active[index]->name ? batch->active[index]->name : "Unnamed");
+				/*  TROUBLESHOOT
+				While computing the class-level current injection update of a group of devices, something failed.  Please try again.
+				If the error persists, please submit your code and a bug report via the ticketing system.
+				*/
+			}
+		}
+	}
+}
+
+//Stores a block of bus inputs into the solution snapshot, or returns how far they moved from it
+//weight converts the values to power (1 for powers, |V| for currents, |V|^2 for admittances)
+static double NR_solution_input_block(gld::complex *values, int count, double weight, size_t &value_index, bool store)
+{
+	double change = 0.0;
+	int vindex;
+
+	for (vindex=0; vindex<count; vindex++, value_index++)
+	{
+		if (store)
+		{
+			NR_solution_inputs.bus_values.push_back(values[vindex]);
+		}
+		else
+		{
+			change += (values[vindex] - NR_solution_inputs.bus_values[value_index]).Mag() * weight;
+		}
+	}
+
+	return change;
+}
+
+//Stores the inputs of the load calculations (store=true), or returns how much they changed since they were stored,
+//as an apparent power estimated with the largest phase voltage of each bus.  Returns -1.0 if the change always
+//requires a new solution (source voltage, phases, or status changes, or injections updated inside the solver)
+static double NR_solution_input_change(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, bool store)
+{
+	unsigned int indexer;
+	size_t value_index;
+	double change, volt_mag, volt_sq;
+	char jindex;
+	enumeration status_val;
+
+	if (store)
+	{
+		NR_solution_inputs.bus_count = bus_count;
+		NR_solution_inputs.branch_count = branch_count;
+		NR_solution_inputs.bus_values.clear();
+		NR_solution_inputs.branch_status.clear();
+		NR_solution_inputs.phases.clear();
+	}
+
+	change = 0.0;
+	value_index = 0;
+
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		//Generators and dynamic devices update their injections inside the solver - always solve them
+		if ((bus[indexer].ExtraCurrentInjFunc != nullptr) || (bus[indexer].DynCurrent != nullptr) || (bus[indexer].full_Y != nullptr))
+		{
+			return -1.0;
+		}
+
+		if (store)
+		{
+			NR_solution_inputs.phases.push_back(bus[indexer].phases);
+		}
+		else if (NR_solution_inputs.phases[indexer] != bus[indexer].phases)
+		{
+			return -1.0;
+		}
+
+		//Source voltages must be the ones that were solved
+		if (bus[indexer].type > 0)
+		{
+			if (NR_solution_input_block(bus[indexer].V,3,1.0,value_index,store) != 0.0)
+			{
+				return -1.0;
+			}
+		}
+
+		//Largest phase voltage, to express the current and admittance changes as power
+		volt_mag = 0.0;
+		for (jindex=0; jindex<3; jindex++)
+		{
+			if (bus[indexer].V[jindex].Mag() > volt_mag)
+			{
+				volt_mag = bus[indexer].V[jindex].Mag();
+			}
+		}
+		volt_sq = volt_mag * volt_mag;
+
+		change += NR_solution_input_block(bus[indexer].S,3,1.0,value_index,store);
+		change += NR_solution_input_block(bus[indexer].Y,3,volt_sq,value_index,store);
+		change += NR_solution_input_block(bus[indexer].I,3,volt_mag,value_index,store);
+		change += NR_solution_input_block(bus[indexer].S_dy,6,1.0,value_index,store);
+		change += NR_solution_input_block(bus[indexer].Y_dy,6,volt_sq,value_index,store);
+		change += NR_solution_input_block(bus[indexer].I_dy,6,volt_mag,value_index,store);
+
+		if ((bus[indexer].phases & 0x80) == 0x80)	//Triplex - current12
+		{
+			change += NR_solution_input_block(bus[indexer].extra_var,1,volt_mag,value_index,store);
+		}
+		else if ((bus[indexer].phases & 0x10) == 0x10)	//Differently connected children - power, admittance, current
+		{
+			change += NR_solution_input_block(&bus[indexer].extra_var[0],3,1.0,value_index,store);
+			change += NR_solution_input_block(&bus[indexer].extra_var[3],3,volt_sq,value_index,store);
+			change += NR_solution_input_block(&bus[indexer].extra_var[6],3,volt_mag,value_index,store);
+		}
+
+		if (((bus[indexer].phases & 0x40) == 0x40) && (bus[indexer].house_var != nullptr))	//House currents
+		{
+			change += NR_solution_input_block(bus[indexer].house_var,3,volt_mag,value_index,store);
+		}
+
+		if (bus[indexer].full_Y_load != nullptr)	//FPI load admittances
+		{
+			change += NR_solution_input_block(bus[indexer].full_Y_load,9,volt_sq,value_index,store);
+		}
+	}
+
+	for (indexer=0; indexer<branch_count; indexer++)
+	{
+		status_val = (branch[indexer].status != nullptr) ? *branch[indexer].status : 0;
+
+		if (store)
+		{
+			NR_solution_inputs.branch_status.push_back(status_val);
+			NR_solution_inputs.phases.push_back(branch[indexer].phases);
+		}
+		else if ((NR_solution_inputs.branch_status[indexer] != status_val) || (NR_solution_inputs.phases[bus_count+indexer] != branch[indexer].phases))
+		{
+			return -1.0;
+		}
+	}
+
+	return change;
+}
+
+//Determines if the last converged solution still holds (NR_solution_skip) - counts the solves it skips
+//Admittance changes (switching, taps) are flagged through NR_admit_change and always need a new solution
+bool NR_solution_skip_check(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NRSOLVERMODE powerflow_type)
+{
+	double input_change;
+
+	if (!NR_solution_skip || !NR_solution_inputs.valid || (powerflow_type != PF_NORMAL) || NR_admit_change || NR_FPI_imp_load_change)
+	{
+		return false;
+	}
+
+	//Structure changed since the snapshot
+	if ((bus_count != NR_solution_inputs.bus_count) || (branch_count != NR_solution_inputs.branch_count))
+	{
+		return false;
+	}
+
+	input_change = NR_solution_input_change(bus_count,bus,branch_count,branch,false);
+
+	if ((input_change < 0.0) || (input_change > NR_solution_skip_tolerance))
+	{
+		return false;
+	}
+
+	NR_solution_skip_count++;
+
+	return true;
+}
+
+//Builds the packed ZIP load tables of compute_load_values - called after the admittance update, with the islands current
+//Delta-connected buses, "different" children, houses, triplex, and buses with load update functions or in-rush
+//admittances stay on the per-bus code (residual), since they are few and each has its own conversions
+static void NR_load_table_build(unsigned int bus_count, BUSDATA *bus)
+{
+	unsigned int indexer;
+	int island_index, jindex, row, pair_slot[3];
+	unsigned char pair_mask;
+	NR_LOAD_PHASE new_phase;
+	NR_LOAD_PAIR new_pair;
+	double phase_angle[3] = {0.0, -2.0*PI/3.0, 2.0*PI/3.0};
+	double pair_angle[3] = {PI/6.0, -1.0*PI/2.0, 5.0*PI/6.0};
+
+	NR_load_tables.assign((NR_islands_detected > 0) ? NR_islands_detected : 0,NR_LOAD_TABLE());
+	NR_load_table_bus_count = bus_count;
+
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		island_index = bus[indexer].island_number;
+
+		//Unpowered buses are not solved
+		if ((island_index < 0) || (island_index >= NR_islands_detected))
+		{
+			continue;
+		}
+
+		NR_LOAD_TABLE &table = NR_load_tables[island_index];
+
+		if (((bus[indexer].phases & 0xD8) != 0x00) || (bus[indexer].LoadUpdateFxn != nullptr) || (bus[indexer].full_Y_load != nullptr))
+		{
+			table.residual.push_back(indexer);
+			continue;
+		}
+
+		//Delta pairs touching a phase of the bus - the constant current part is applied even if the other phase is missing
+		for (jindex=0; jindex<3; jindex++)
+		{
+			pair_mask = (0x04 >> jindex) | (0x04 >> ((jindex+1)%3));
+
+			if ((bus[indexer].phases & pair_mask) != 0x00)
+			{
+				new_pair.bus = indexer;
+				new_pair.from = jindex;
+				new_pair.to = (jindex+1)%3;
+				new_pair.present = ((bus[indexer].phases & pair_mask) == pair_mask) ? 1.0 : 0.0;
+				new_pair.rotate_re = cos(pair_angle[jindex]);
+				new_pair.rotate_im = -sin(pair_angle[jindex]);
+
+				pair_slot[jindex] = (int)table.pairs.size();
+				table.pairs.push_back(new_pair);
+			}
+			else
+			{
+				pair_slot[jindex] = -1;
+			}
+		}
+
+		//Phases in matrix order - same mapping as the phase switch of the per-bus code
+		row = 0;
+		for (jindex=0; jindex<3; jindex++)
+		{
+			if ((bus[indexer].phases & (0x04 >> jindex)) != 0x00)
+			{
+				new_phase.bus = indexer;
+				new_phase.row = row;
+				new_phase.phase = jindex;
+				new_phase.pair_out = pair_slot[jindex];
+				new_phase.pair_in = pair_slot[(jindex+2)%3];
+				new_phase.rotate_re = cos(phase_angle[jindex]);
+				new_phase.rotate_im = -sin(phase_angle[jindex]);
+
+				table.phases.push_back(new_phase);
+				row++;
+			}
+		}
+	}
+
+	for (island_index=0; island_index<(int)NR_load_tables.size(); island_index++)
+	{
+		NR_load_tables[island_index].pair_current_re.assign(NR_load_tables[island_index].pairs.size(),0.0);
+		NR_load_tables[island_index].pair_current_im.assign(NR_load_tables[island_index].pairs.size(),0.0);
+	}
+}
+
+//Current-type load of one packed phase - constant current held at its nominal angle to the voltage, pre-rotated
+//currents, explicit wye power and impedance loads, and the explicit delta loads of the two pairs of the phase
+//Zero-voltage phases get no power or current terms, like the per-bus code
+static inline void NR_load_phase_current(BUSDATA *bus, NR_LOAD_TABLE *table, const NR_LOAD_PHASE &entry, double impedance_weight, double &volt_re, double &volt_im, double &mag_sq, double &current_re, double &current_im)
+{
+	BUSDATA &node = bus[entry.bus];
+	int phase = entry.phase;
+	double inv_mag_sq, inv_mag, unit_re, unit_im, load_re, load_im;
+
+	volt_re = node.V[phase].Re();
+	volt_im = node.V[phase].Im();
+	mag_sq = volt_re*volt_re + volt_im*volt_im;
+	inv_mag_sq = (mag_sq > 0.0) ? 1.0/mag_sq : 0.0;
+	inv_mag = sqrt(inv_mag_sq);
+
+	//Constant current - I*(V/|V|)*conj(nominal phasor), for both the bus and the explicit wye current
+	unit_re = (volt_re*entry.rotate_re - volt_im*entry.rotate_im)*inv_mag;
+	unit_im = (volt_re*entry.rotate_im + volt_im*entry.rotate_re)*inv_mag;
+	load_re = node.I[phase].Re() + node.I_dy[phase+3].Re();
+	load_im = node.I[phase].Im() + node.I_dy[phase+3].Im();
+	current_re = load_re*unit_re - load_im*unit_im + node.prerot_I[phase].Re();
+	current_im = load_re*unit_im + load_im*unit_re + node.prerot_I[phase].Im();
+
+	//Explicit wye power - conj(S/V)
+	load_re = node.S_dy[phase+3].Re();
+	load_im = node.S_dy[phase+3].Im();
+	current_re += (load_re*volt_re + load_im*volt_im)*inv_mag_sq;
+	current_im += (load_re*volt_im - load_im*volt_re)*inv_mag_sq;
+
+	//Explicit wye impedance - TCIM only
+	load_re = node.Y_dy[phase+3].Re();
+	load_im = node.Y_dy[phase+3].Im();
+	current_re += impedance_weight*(load_re*volt_re - load_im*volt_im);
+	current_im += impedance_weight*(load_re*volt_im + load_im*volt_re);
+
+	//Explicit delta loads
+	current_re += table->pair_current_re[entry.pair_out] - table->pair_current_re[entry.pair_in];
+	current_im += table->pair_current_im[entry.pair_out] - table->pair_current_im[entry.pair_in];
+}
+
+//Evaluates the loads of the packed buses of an island - the wye-connected and explicit delta/wye parts of the
+//per-bus code, with the solver and pass checks taken out of the phase loops
+static void NR_load_table_evaluate(BUSDATA *bus, NR_LOAD_TABLE *table, bool jacobian_pass)
+{
+	size_t index, count;
+	double impedance_weight, volt_re, volt_im, mag_sq, inv_mag_sq, inv_mag, unit_re, unit_im;
+	double load_re, load_im, current_re, current_im, present;
+	double inv_mag_cu, inv_mag_qu, cross, volt_re_sq, volt_im_sq, offset;
+
+	//FPI carries the impedance loads in the admittance matrix
+	impedance_weight = (NR_solver_algorithm == NRM_TCIM) ? 1.0 : 0.0;
+
+	//Delta pair currents first - each phase takes the difference of its two pairs
+	count = table->pairs.size();
+	for (index=0; index<count; index++)
+	{
+		const NR_LOAD_PAIR &pair = table->pairs[index];
+		BUSDATA &node = bus[pair.bus];
+
+		volt_re = node.V[pair.from].Re() - node.V[pair.to].Re();
+		volt_im = node.V[pair.from].Im() - node.V[pair.to].Im();
+		mag_sq = volt_re*volt_re + volt_im*volt_im;
+		inv_mag_sq = (mag_sq > 0.0) ? 1.0/mag_sq : 0.0;
+		inv_mag = sqrt(inv_mag_sq);
+
+		//Constant current - held at its nominal angle to the line-to-line voltage
+		unit_re = (volt_re*pair.rotate_re - volt_im*pair.rotate_im)*inv_mag;
+		unit_im = (volt_re*pair.rotate_im + volt_im*pair.rotate_re)*inv_mag;
+		load_re = node.I_dy[pair.from].Re();
+		load_im = node.I_dy[pair.from].Im();
+		current_re = load_re*unit_re - load_im*unit_im;
+		current_im = load_re*unit_im + load_im*unit_re;
+
+		//Power and impedance - only across phases the bus has
+		present = pair.present;
+		load_re = node.S_dy[pair.from].Re();
+		load_im = node.S_dy[pair.from].Im();
+		current_re += present*(load_re*volt_re + load_im*volt_im)*inv_mag_sq;
+		current_im += present*(load_re*volt_im - load_im*volt_re)*inv_mag_sq;
+
+		present *= impedance_weight;
+		load_re = node.Y_dy[pair.from].Re();
+		load_im = node.Y_dy[pair.from].Im();
+		current_re += present*(load_re*volt_re - load_im*volt_im);
+		current_im += present*(load_re*volt_im + load_im*volt_re);
+
+		table->pair_current_re[index] = current_re;
+		table->pair_current_im[index] = current_im;
+	}
+
+	count = table->phases.size();
+
+	if (NR_solver_algorithm == NRM_TCIM)
+	{
+		if (!jacobian_pass)	//Current injection pass - scheduled powers
+		{
+			for (index=0; index<count; index++)
+			{
+				const NR_LOAD_PHASE &entry = table->phases[index];
+				BUSDATA &node = bus[entry.bus];
+
+				NR_load_phase_current(bus,table,entry,impedance_weight,volt_re,volt_im,mag_sq,current_re,current_im);
+
+				node.PL[entry.row] = node.S[entry.phase].Re() + current_re*volt_re + current_im*volt_im + node.Y[entry.phase].Re()*mag_sq;
+				node.QL[entry.row] = node.S[entry.phase].Im() + current_re*volt_im - current_im*volt_re - node.Y[entry.phase].Im()*mag_sq;
+			}
+		}
+		else	//Jacobian pass - equations (37) to (40)
+		{
+			for (index=0; index<count; index++)
+			{
+				const NR_LOAD_PHASE &entry = table->phases[index];
+				BUSDATA &node = bus[entry.bus];
+
+				NR_load_phase_current(bus,table,entry,impedance_weight,volt_re,volt_im,mag_sq,current_re,current_im);
+
+				inv_mag_sq = (mag_sq > 0.0) ? 1.0/mag_sq : 0.0;
+				inv_mag_cu = inv_mag_sq*sqrt(inv_mag_sq);
+				inv_mag_qu = inv_mag_sq*inv_mag_sq;
+				offset = (mag_sq > 0.0) ? 0.0 : -2e-4;	//Zero voltage - only the impedance, with the offsets of both per-bus sections
+				cross = volt_re*volt_im;
+				volt_re_sq = volt_re*volt_re;
+				volt_im_sq = volt_im*volt_im;
+				load_re = node.S[entry.phase].Re();
+				load_im = node.S[entry.phase].Im();
+
+				node.Jacob_A[entry.row] = (load_im*(volt_re_sq - volt_im_sq) - 2*cross*load_re)*inv_mag_qu + (cross*current_re + current_im*volt_im_sq)*inv_mag_cu + node.Y[entry.phase].Im() + offset;
+				node.Jacob_B[entry.row] = (load_re*(volt_re_sq - volt_im_sq) + 2*cross*load_im)*inv_mag_qu - (cross*current_im + current_re*volt_re_sq)*inv_mag_cu - node.Y[entry.phase].Re() + offset;
+				node.Jacob_C[entry.row] = (load_re*(volt_im_sq - volt_re_sq) - 2*cross*load_im)*inv_mag_qu + (cross*current_im - current_re*volt_im_sq)*inv_mag_cu - node.Y[entry.phase].Re() + offset;
+				node.Jacob_D[entry.row] = (load_im*(volt_re_sq - volt_im_sq) - 2*cross*load_re)*inv_mag_qu + (cross*current_re - current_im*volt_re_sq)*inv_mag_cu - node.Y[entry.phase].Im() + offset;
+			}
+		}
+	}
+	else	//FPI - load currents, impedances are in the matrix
+	{
+		for (index=0; index<count; index++)
+		{
+			const NR_LOAD_PHASE &entry = table->phases[index];
+			BUSDATA &node = bus[entry.bus];
+
+			NR_load_phase_current(bus,table,entry,impedance_weight,volt_re,volt_im,mag_sq,current_re,current_im);
+
+			inv_mag_sq = (mag_sq > 0.0) ? 1.0/mag_sq : 0.0;
+			load_re = node.S[entry.phase].Re();
+			load_im = node.S[entry.phase].Im();
+
+			node.FPI_current[entry.phase] = gld::complex(current_re + (load_re*volt_re + load_im*volt_im)*inv_mag_sq,current_im + (load_re*volt_im - load_im*volt_re)*inv_mag_sq);
+		}
+	}
+}
+
 //Performs the load calculation portions of the current injection or Jacobian update
 //jacobian_pass should be set to true for the a,b,c, and d updates
 // For first approach, working on system load at each bus for current injection
@@ -5790,10 +6495,28 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 	gld::complex temp_current[3], temp_store[3];
 	char jindex, temp_index, temp_index_b;
 	STATUS temp_status;
+	unsigned int residual_index;
+	NR_LOAD_TABLE *load_table;
 
-	//Loop through the buses
-	for (indexer=0; indexer<bus_count; indexer++)
+	//Packed tables come with the admittance update - rebuild them if the buses changed without one
+	if ((island_number < 0) || (island_number >= (int)NR_load_tables.size()) || (NR_load_table_bus_count != bus_count))
+	{
+		NR_load_table_build(bus_count,bus);
+	}
+
+	//Still nothing - not a solved island
+	if ((island_number < 0) || (island_number >= (int)NR_load_tables.size()))
+	{
+		return;
+	}
+
+	load_table = &NR_load_tables[island_number];
+
+	//Loop through the buses that are not packed - special connections and update functions
+	for (residual_index=0; residual_index<load_table->residual.size(); residual_index++)
 	{
+		indexer = load_table->residual[residual_index];
+
 		//See if we're relevant to the island of interest
 		if (bus[indexer].island_number == island_number)
 		{
@@ -7148,6 +7871,9 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 			}//End Jacobian pass for deltamode loads
 		}//End relevant island check
 	}//end bus traversion for Jacobian or current injection items
+
+	//Plain wye-connected buses, per phase
+	NR_load_table_evaluate(bus,load_table,jacobian_pass);
 }//End load update function
 
 //Function to free up array of NR_SOLVER_STRUCT variables
@@ -7199,6 +7925,9 @@ STATUS NR_array_structure_free(NR_SOLVER_STRUCT *struct_of_interest,int number_o
 				//Map it
 				curr_island_superLU_vars = (SUPERLU_NR_vars*)struct_of_interest->island_matrix_values[index_val].LU_solver_vars;
 
+				//Release any factors kept for chord iterations
+				NR_release_LU_factors(&struct_of_interest->island_matrix_values[index_val]);
+
 				//Free the others, if necessary
 				if (curr_island_superLU_vars->A_LU.Store != nullptr)
 					gl_free(curr_island_superLU_vars->A_LU.Store);
@@ -7222,6 +7951,12 @@ STATUS NR_array_structure_free(NR_SOLVER_STRUCT *struct_of_interest,int number_o
 			{
 				//Call destruction routine
 				((void (*)(void *, bool))(LUSolverFcns.ext_destroy))(struct_of_interest->island_matrix_values[index_val].LU_solver_vars,false);
+
+				//Release the island variables, if the solver can
+				if (LUSolverFcns.ext_free != nullptr)
+				{
+					((void (*)(void *))(LUSolverFcns.ext_free))(struct_of_interest->island_matrix_values[index_val].LU_solver_vars);
+				}
 			}
 			//Default else -- ??? Not sure how we get here
 		}
@@ -7317,6 +8052,9 @@ STATUS NR_array_structure_allocate(NR_SOLVER_STRUCT *struct_of_interest,int numb
 		struct_of_interest->island_matrix_values[index_val].solver_info = -1;	//"Bad", by default
 		struct_of_interest->island_matrix_values[index_val].return_code = -1;	//Still "bad" too
 		struct_of_interest->island_matrix_values[index_val].max_mismatch_converge = 0.0;
+		struct_of_interest->island_matrix_values[index_val].LU_factors_held = false;
+		struct_of_interest->island_matrix_values[index_val].LU_factors_reused = false;
+		struct_of_interest->island_matrix_values[index_val].LU_reuse_mismatch = 0.0;
 	}
 
 	//Null out the main item too
@@ -5,6 +5,9 @@
 #ifndef _SOLVER_NR
 #define _SOLVER_NR
 
+#include <memory>
+#include <vector>
+
 #include "gld_complex.h"
 #include "object.h"
 
@@ -50,6 +53,8 @@ typedef struct  {
 	OBJECT *obj;			///< Link to original object header
 	FUNCTIONADDR ExtraCurrentInjFunc;	///< Link to extra functions of current injection updates -- mostly VSI current updates
 	OBJECT *ExtraCurrentInjFuncObject;	///< Link to the object that mapped the current injection function - needed for function calls
+	int ExtraCurrentInjBatch;			///< Class-level current injection update that serves this bus (index into NR_current_injection_batches), -1 if called per bus
+	int ExtraCurrentInjBatchSlot;		///< Position of the bus's generator in the class-level update of the current pass, -1 if it was not computed there
 	FUNCTIONADDR LoadUpdateFxn;			///< Link to load update function for load objects -- for impedance conversion (inrush or forced)
 	FUNCTIONADDR ShuntUpdateFxn;		///< Link to node shunt update function - for FPI - fixes sequence issue in deltamode
 	int island_number;		///< Numerical designation for which island this bus belongs to
@@ -151,6 +156,9 @@ typedef struct {
 	int solver_info;					///Status return value for LU solver -- put into the array for tracking
 	int64 return_code;					///Specific return value - just to replicate previous functionality
 	double max_mismatch_converge;		///Current difference for convergence checks
+	bool LU_factors_held;				///Flag to indicate the LU factors of a previous Jacobian are kept for reuse (NR_jacobian_reuse)
+	bool LU_factors_reused;				///Flag to indicate the last solve used the held LU factors
+	double LU_reuse_mismatch;			///Convergence difference of the previous iteration - tracks the rate of the chord iterations
 } NR_MATRIX_CONSTRUCTION;
 
 typedef struct {
@@ -165,6 +173,52 @@ typedef struct {
 	int return_code;			/// Special return codes for impedance check -- 0 = non-descript failure, 1 = success, 2 = unsupported solver
 } NR_MESHFAULT_IMPEDANCE;
 
+//Class-level current injection update of the generators of a class
+//The kernel is a STATUS (*)(OBJECT **objects, gld::complex *bus_voltages, unsigned int count, int64 iteration_count, bool *converged_failure)
+//that computes the injections of count generators from their bus voltages (three per generator, packed in the order of objects),
+//flagging in converged_failure[n] the ones that need another iteration - it only touches the generators it is given, so
+//the solver can split the list between threads (NR_injection_threads).  Nothing reaches powerflow until the push, a
+//STATUS (*)(OBJECT *obj), is called for a generator at the position of its bus in the current injection loop
+typedef struct {
+	FUNCTIONADDR kernel;			/// Class-level compute function, published as "current_injection_update_batch"
+	FUNCTIONADDR push;				/// Per-generator push of the computed injection, published as "current_injection_push"
+	std::vector<OBJECT *> objects;	/// Generators served by the kernel
+	std::vector<int> bus_index;		/// Bus each generator injects into
+	std::vector<OBJECT *> active;	/// Generators computed in the current pass (island and bus type)
+	std::vector<gld::complex> voltages;	/// Packed bus voltages of the active generators, three each
+	std::unique_ptr<bool[]> converged_failure;	/// Reiteration flags of the active generators
+} NR_CURRENT_INJECTION_BATCH;
+
+//Packed ZIP load table - one per island, rebuilt when the admittance (topology) changes
+//Wye-connected buses without special children, houses, or load update functions are evaluated per phase
+//from these arrays; the other buses keep the per-bus code of compute_load_values (residual pass)
+typedef struct {
+	int bus;				/// Bus the phase belongs to
+	int row;				/// Position of the phase in the bus entries of the matrix (PL, QL, Jacob_A..D)
+	int phase;				/// Phase of the bus arrays (V, S, Y, I) - 0=A, 1=B, 2=C
+	int pair_out;			/// Delta pair starting at this phase (AB for A) - index into the pair arrays
+	int pair_in;			/// Delta pair ending at this phase (CA for A) - index into the pair arrays
+	double rotate_re;		/// Conjugate of the unit phasor of the nominal phase angle - real part
+	double rotate_im;		/// Conjugate of the unit phasor of the nominal phase angle - imaginary part
+} NR_LOAD_PHASE;
+
+typedef struct {
+	int bus;				/// Bus the delta pair belongs to
+	int from;				/// First phase of the pair - voltage is V[from]-V[to]
+	int to;					/// Second phase of the pair
+	double present;			/// 1.0 if the bus has both phases - power and impedance loads only apply then
+	double rotate_re;		/// Conjugate of the unit phasor of the nominal line-to-line angle - real part
+	double rotate_im;		/// Conjugate of the unit phasor of the nominal line-to-line angle - imaginary part
+} NR_LOAD_PAIR;
+
+typedef struct {
+	std::vector<NR_LOAD_PHASE> phases;	/// Phases of the packed buses
+	std::vector<NR_LOAD_PAIR> pairs;	/// Delta pairs touching the phases of the packed buses
+	std::vector<double> pair_current_re;	/// Delta pair load currents of the current pass - real part
+	std::vector<double> pair_current_im;	/// Delta pair load currents of the current pass - imaginary part
+	std::vector<unsigned int> residual;	/// Buses evaluated one at a time by the per-bus code
+} NR_LOAD_TABLE;
+
 //Function prototypes for external solver interface
 //void *ext_solver_init(void *ext_array);
 //void ext_solver_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change);
@@ -174,6 +228,8 @@ typedef struct {
 int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations);
 void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, bool jacobian_pass, int island_number);
 void NR_admittance_update(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type);
+int NR_current_injection_batch_register(FUNCTIONADDR kernel, FUNCTIONADDR push, OBJECT *obj, int bus_index);
+bool NR_solution_skip_check(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NRSOLVERMODE powerflow_type);
 
 //Newton-Raphson solver array handlers
 STATUS NR_array_structure_free(NR_SOLVER_STRUCT *struct_of_interest,int number_of_islands);		/* Handles freeing NR_SOLVER_STRUCT arrays */
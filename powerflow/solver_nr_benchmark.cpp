@@ -0,0 +1,939 @@
+/* $Id
+ * Standalone benchmark of the Newton-Raphson solver on synthetic feeders
+ *
+ * Builds the BUSDATA/BRANCHDATA arrays of synthetic radial or meshed feeders
+ * without loading a model, solves them with solver_nr for a number of
+ * timesteps with randomly perturbed loads, and reports the iteration counts
+ * and the time spent in each phase of the solver (NR_solver_timing).
+ *
+ * Each island is a 12.47 kV feeder (7200 V line-to-neutral) fed by its own
+ * SWING bus.  Primary buses attach to a random earlier bus, so the feeder is
+ * a random tree.  Branches leaving a three-phase bus become one- or two-phase
+ * laterals with the --laterals probability, and phases are only dropped going
+ * down the feeder.  With the --triplex probability, a primary bus also serves
+ * a split-phase center-tapped transformer, a triplex node, a 100 ft triplex
+ * line, and a triplex meter.  --ties adds lines between random three-phase
+ * buses of each island, making the feeders meshed.  The ZIP loads (50% power,
+ * 25% current, 25% impedance) add up to --load kVA per island, and every
+ * timestep after the first scales each load by a random factor within
+ * 1 +/- --perturb.
+ *
+ *	solver_nr_benchmark [--nodes N] [--islands N] [--ties N] [--laterals F]
+ *		[--triplex F] [--load kVA] [--steps N] [--perturb F] [--seed N]
+ *		[--lu superlu|internal] [--lu-threads N] [--jacobian-reuse]
+ *		[--iteration-limit N] [--verbose]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gridlabd.h"
+
+#define _POWERFLOW_CPP
+#include "powerflow.h"
+#undef _POWERFLOW_CPP
+
+#include "solver_lu.h"
+
+#define BENCHMARK_PRIMARY_VOLTAGE 7200.0	///< Line-to-neutral voltage of the feeders (V)
+#define BENCHMARK_TRIPLEX_VOLTAGE 120.0		///< Line-to-neutral voltage of the triplex secondaries (V)
+#define BENCHMARK_SPCT_RATING 50.0			///< Rating of the split-phase transformers (kVA)
+#define BENCHMARK_TRIPLEX_LENGTH 100.0		///< Length of the triplex lines (ft)
+#define BENCHMARK_POWER_FACTOR 0.95			///< Power factor of the loads (lagging)
+
+/* The benchmark is its own core - the callback table only holds the services the solver uses */
+CALLBACKS *callback = nullptr;
+
+static bool benchmark_verbose = false;
+static TIMESTAMP benchmark_clock = 0;
+static double benchmark_delta_clock = 0.0;
+static TIMESTAMP benchmark_stoptime = TS_NEVER;
+static EXITCODE benchmark_exit_code = XC_SUCCESS;
+
+static int benchmark_output(const char *label, const char *format, va_list ptr)
+{
+	int len = fprintf(stderr,"%s",label);
+	len += vfprintf(stderr,format,ptr);
+	fputc('\n',stderr);
+	return len;
+}
+static int benchmark_output_verbose(const char *format, ...)
+{
+	int len = 0;
+	if (benchmark_verbose)
+	{
+		va_list ptr;
+		va_start(ptr,format);
+		len = benchmark_output("   ... ",format,ptr);
+		va_end(ptr);
+	}
+	return len;
+}
+static int benchmark_output_message(const char *format, ...)
+{
+	va_list ptr;
+	va_start(ptr,format);
+	int len = benchmark_output("",format,ptr);
+	va_end(ptr);
+	return len;
+}
+static int benchmark_output_warning(const char *format, ...)
+{
+	va_list ptr;
+	va_start(ptr,format);
+	int len = benchmark_output("WARNING: ",format,ptr);
+	va_end(ptr);
+	return len;
+}
+static int benchmark_output_error(const char *format, ...)
+{
+	va_list ptr;
+	va_start(ptr,format);
+	int len = benchmark_output("ERROR: ",format,ptr);
+	va_end(ptr);
+	return len;
+}
+static void benchmark_throw(const char *format, ...)
+{
+	va_list ptr;
+	va_start(ptr,format);
+	benchmark_output("FATAL: ",format,ptr);
+	va_end(ptr);
+	exit(XC_EXFAILED);
+}
+
+s_callbacks::s_callbacks() throw()
+{
+	memset(this,0,sizeof(s_callbacks));
+	global_clock = &benchmark_clock;
+	global_delta_curr_clock = &benchmark_delta_clock;
+	global_stoptime = &benchmark_stoptime;
+	global_exit_code = &benchmark_exit_code;
+	output_verbose = benchmark_output_verbose;
+	output_message = benchmark_output_message;
+	output_warning = benchmark_output_warning;
+	output_error = benchmark_output_error;
+	output_fatal = benchmark_output_error;
+	output_debug = benchmark_output_verbose;
+	output_test = benchmark_output_verbose;
+	malloc = ::malloc;
+	free = ::free;
+	exception.throw_exception = benchmark_throw;
+}
+
+/** Storage of one synthetic bus - the values a node object would hold for the solver **/
+typedef struct {
+	gld::complex V[3];
+	gld::complex S[3];
+	gld::complex Y[3];
+	gld::complex I[3];
+	gld::complex prerot_I[3];
+	gld::complex S_dy[6];
+	gld::complex Y_dy[6];
+	gld::complex I_dy[6];
+	gld::complex current12;
+	gld::complex load[3];		///< Unperturbed load of each phase (or of triplex legs 1, 2, and 12)
+	std::vector<int> links;		///< Branches connected to the bus
+	std::string name;
+	gld::set busflags;
+	unsigned char phases;
+	int type;
+	int island;
+	double nominal;
+} BENCHMARK_BUS;
+
+/** Storage of one synthetic branch - the values a link object would hold for the solver **/
+typedef struct {
+	gld::complex Yfrom[9];
+	gld::complex Yto[9];
+	gld::complex YSfrom[9];
+	gld::complex YSto[9];
+	gld::complex If_from[3];
+	gld::complex If_to[3];
+	std::string name;
+	enumeration status;
+	unsigned char phases;
+	unsigned char origphases;
+	unsigned char lnk_type;
+	double v_ratio;
+	int from;
+	int to;
+	int island;
+} BENCHMARK_BRANCH;
+
+/** Options of the benchmark **/
+typedef struct {
+	int nodes;
+	int islands;
+	int ties;
+	double laterals;
+	double triplex;
+	double load;
+	int steps;
+	double perturb;
+	unsigned int seed;
+	bool internal_lu;
+	int lu_threads;
+	bool jacobian_reuse;
+	int64 iteration_limit;
+} BENCHMARK_OPTIONS;
+
+static std::vector<BENCHMARK_BUS> benchmark_bus;
+static std::vector<BENCHMARK_BRANCH> benchmark_branch;
+static bool benchmark_dynamics_enabled = false;
+
+//Phase impedance of the primary lines per mile (Kersting, configuration 601)
+static gld::complex benchmark_line_impedance[3][3] = {
+	{gld::complex(0.3465,1.0179), gld::complex(0.1560,0.5017), gld::complex(0.1580,0.4236)},
+	{gld::complex(0.1560,0.5017), gld::complex(0.3375,1.0478), gld::complex(0.1535,0.3849)},
+	{gld::complex(0.1580,0.4236), gld::complex(0.1535,0.3849), gld::complex(0.3414,1.0348)}
+};
+
+//Number of phases in an ABC phase mask
+static int benchmark_phase_count(unsigned char phases)
+{
+	return ((phases & 0x04) >> 2) + ((phases & 0x02) >> 1) + (phases & 0x01);
+}
+
+//Invert the size x size complex matrix in Z (row stride 3) into Y - Gauss-Jordan elimination
+static void benchmark_invert(gld::complex Z[3][3], int size, gld::complex Y[3][3])
+{
+	gld::complex work[3][6];
+	gld::complex pivot, factor;
+	int row, col, index, best;
+
+	for (row=0; row<size; row++)
+	{
+		for (col=0; col<size; col++)
+		{
+			work[row][col] = Z[row][col];
+			work[row][size+col] = (row == col) ? 1.0 : 0.0;
+		}
+	}
+
+	for (index=0; index<size; index++)
+	{
+		//Partial pivoting - the phase matrices are well conditioned, but be safe
+		best = index;
+		for (row=index+1; row<size; row++)
+		{
+			if (work[row][index].Mag() > work[best][index].Mag())
+				best = row;
+		}
+		if (best != index)
+		{
+			for (col=0; col<2*size; col++)
+			{
+				pivot = work[index][col];
+				work[index][col] = work[best][col];
+				work[best][col] = pivot;
+			}
+		}
+
+		pivot = work[index][index];
+		for (col=0; col<2*size; col++)
+			work[index][col] = work[index][col] / pivot;
+
+		for (row=0; row<size; row++)
+		{
+			if (row != index)
+			{
+				factor = work[row][index];
+				for (col=0; col<2*size; col++)
+					work[row][col] -= factor * work[index][col];
+			}
+		}
+	}
+
+	for (row=0; row<size; row++)
+	{
+		for (col=0; col<size; col++)
+			Y[row][col] = work[row][size+col];
+	}
+}
+
+//Primary line - inverse of the impedance of the phases present, same matrix on both ends
+static void benchmark_line_admittance(BENCHMARK_BRANCH *branch, double length)
+{
+	gld::complex Z[3][3], Y[3][3];
+	int phase_index[3];
+	int size = 0;
+	int row, col;
+
+	for (row=0; row<3; row++)
+	{
+		if ((branch->phases & (0x04 >> row)) != 0)
+			phase_index[size++] = row;
+	}
+
+	for (row=0; row<size; row++)
+	{
+		for (col=0; col<size; col++)
+			Z[row][col] = benchmark_line_impedance[phase_index[row]][phase_index[col]] * (length/5280.0);
+	}
+
+	benchmark_invert(Z,size,Y);
+
+	for (row=0; row<9; row++)
+		branch->Yfrom[row] = 0.0;
+
+	for (row=0; row<size; row++)
+	{
+		for (col=0; col<size; col++)
+			branch->Yfrom[phase_index[row]*3+phase_index[col]] = Y[row][col];
+	}
+
+	for (row=0; row<9; row++)
+		branch->Yto[row] = branch->YSfrom[row] = branch->YSto[row] = branch->Yfrom[row];
+}
+
+//Split-phase center-tapped transformer - admittances as the transformer and link objects compute them for NR
+static void benchmark_spct_admittance(BENCHMARK_BRANCH *branch, int phase)
+{
+	gld::complex impedance(0.006,0.0136);
+	gld::complex shunt(999999999,999999999);
+	double nt = BENCHMARK_PRIMARY_VOLTAGE / BENCHMARK_TRIPLEX_VOLTAGE;
+	double za_basehi = (BENCHMARK_PRIMARY_VOLTAGE*BENCHMARK_PRIMARY_VOLTAGE)/(BENCHMARK_SPCT_RATING*1000);
+	double za_baselo = (BENCHMARK_TRIPLEX_VOLTAGE*BENCHMARK_TRIPLEX_VOLTAGE)/(BENCHMARK_SPCT_RATING*1000);
+	gld::complex z0 = gld::complex(0.5 * impedance.Re(),0.8*impedance.Im()) * za_basehi;
+	gld::complex z1 = gld::complex(impedance.Re(),0.4 * impedance.Im()) * za_baselo;
+	gld::complex z2 = z1;
+	gld::complex zc = gld::complex(za_basehi,0) * gld::complex(shunt.Re(),0) * gld::complex(0,shunt.Im()) / shunt;
+	gld::complex indet = gld::complex(1.0)/(z1*z2*zc*nt*nt+z0*(z2*zc+z1*zc+z1*z2*nt*nt));
+	gld::complex base[3][3];
+	int index;
+
+	base[0][0] = (-(z2*zc*nt*nt+z0*zc+z0*z2*nt*nt))*indet;
+	base[0][1] = (z0*zc)*indet;
+	base[1][0] = (-z0*zc)*indet;
+	base[1][1] = (z1*zc*nt*nt+z0*zc+z0*z1*nt*nt)*indet;
+	base[0][2] = (z2*zc*nt)*indet;
+	base[1][2] = (-z1*zc*nt)*indet;
+	base[2][0] = (-z2*zc*nt)*indet;
+	base[2][1] = (-z1*zc*nt)*indet;
+	base[2][2] = (z2*zc+z1*zc+z1*z2*nt*nt)*indet;
+
+	for (index=0; index<9; index++)
+		branch->Yfrom[index] = branch->Yto[index] = branch->YSfrom[index] = branch->YSto[index] = 0.0;
+
+	branch->YSto[0] = base[0][0];
+	branch->YSto[1] = base[0][1];
+	branch->YSto[3] = base[1][0];
+	branch->YSto[4] = base[1][1];
+
+	branch->Yto[phase] = -base[0][2];
+	branch->Yto[3+phase] = -base[1][2];
+
+	branch->YSfrom[phase*4] = base[2][2];
+
+	branch->Yfrom[phase*3] = -base[2][0];
+	branch->Yfrom[phase*3+1] = -base[2][1];
+}
+
+//Triplex line of 1/0 AA conductors - same impedance calculation as the triplex_line object
+static void benchmark_triplex_admittance(BENCHMARK_BRANCH *branch, double length)
+{
+	double resistance = 0.97;			//Ohm/mile
+	double gmr = 0.0111;				//ft
+	double diameter = 0.368;			//in
+	double insulation = 0.08;			//in
+	double freq_coeff_real = 0.00158836*60.0;
+	double freq_coeff_imag = 0.00202237*60.0;
+	double freq_additive_term = log(100.0/60.0)/2.0 + 7.6786;
+	double D12 = (diameter + 2 * insulation)/12;
+	double D13 = (diameter + insulation)/12;
+	gld::complex zp11 = gld::complex(resistance,0) + freq_coeff_real + gld::complex(0.0,freq_coeff_imag) * (log(1/gmr) + freq_additive_term);
+	gld::complex zp12 = gld::complex(freq_coeff_real,0.0) + gld::complex(0.0,freq_coeff_imag) * (log(1/D12) + freq_additive_term);
+	gld::complex zp13 = gld::complex(freq_coeff_real,0.0) + gld::complex(0.0,freq_coeff_imag) * (log(1/D13) + freq_additive_term);
+	gld::complex Z[3][3], Y[3][3];
+	double miles = length/5280.0;
+	int index;
+
+	Z[0][0] = (zp11-((zp13*zp13)/zp11)) * miles;
+	Z[0][1] = (zp12-((zp13*zp13)/zp11)) * miles;
+	Z[1][0] = -Z[0][1];
+	Z[1][1] = -Z[0][0];
+
+	benchmark_invert(Z,2,Y);
+
+	for (index=0; index<9; index++)
+		branch->Yfrom[index] = 0.0;
+
+	branch->Yfrom[0] = Y[0][0];
+	branch->Yfrom[1] = Y[0][1];
+	branch->Yfrom[3] = Y[1][0];
+	branch->Yfrom[4] = Y[1][1];
+
+	for (index=0; index<9; index++)
+		branch->Yto[index] = branch->YSfrom[index] = branch->YSto[index] = branch->Yfrom[index];
+}
+
+static int benchmark_add_bus(int island, unsigned char phases, int type, double nominal, const char *kind)
+{
+	BENCHMARK_BUS bus;
+	double angle[3] = {0.0, -2.0*PI/3.0, 2.0*PI/3.0};
+	int index;
+
+	bus.phases = phases;
+	bus.type = type;
+	bus.island = island;
+	bus.nominal = nominal;
+	bus.busflags = (type == 2) ? NF_HASSOURCE : 0;
+	bus.name = std::string(kind) + "_" + std::to_string(island) + "_" + std::to_string(benchmark_bus.size());
+
+	for (index=0; index<3; index++)
+		bus.load[index] = 0.0;
+
+	//Flat start, like the node objects
+	if ((phases & 0x80) == 0x80)
+	{
+		index = ((phases & 0x04) == 0x04) ? 0 : (((phases & 0x02) == 0x02) ? 1 : 2);
+		bus.V[0].SetPolar(nominal,angle[index]);
+		bus.V[1].SetPolar(nominal,angle[index]);
+		bus.V[2] = 0.0;
+	}
+	else
+	{
+		for (index=0; index<3; index++)
+		{
+			if ((phases & (0x04 >> index)) != 0)
+				bus.V[index].SetPolar(nominal,angle[index]);
+			else
+				bus.V[index] = 0.0;
+		}
+	}
+
+	benchmark_bus.push_back(bus);
+	return (int)benchmark_bus.size() - 1;
+}
+
+static BENCHMARK_BRANCH *benchmark_add_branch(int island, int from, int to, unsigned char phases, unsigned char lnk_type, const char *kind)
+{
+	BENCHMARK_BRANCH branch;
+
+	branch.phases = phases;
+	branch.origphases = phases & 0x87;
+	branch.lnk_type = lnk_type;
+	branch.v_ratio = 1.0;
+	branch.from = from;
+	branch.to = to;
+	branch.island = island;
+	branch.status = LS_CLOSED;
+	branch.name = std::string(kind) + "_" + std::to_string(island) + "_" + std::to_string(benchmark_branch.size());
+
+	benchmark_bus[from].links.push_back((int)benchmark_branch.size());
+	benchmark_bus[to].links.push_back((int)benchmark_branch.size());
+
+	benchmark_branch.push_back(branch);
+	return &benchmark_branch.back();
+}
+
+//Generate one island - a random tree of primary buses, triplex secondaries, and tie lines
+static void benchmark_generate_island(const BENCHMARK_OPTIONS *options, int island, std::mt19937 &random)
+{
+	std::uniform_real_distribution<double> uniform(0.0,1.0);
+	std::vector<int> primary, three_phase, load_points;
+	std::set<std::pair<int,int> > connected;
+	unsigned char phases, parent_phases, phase_bit;
+	int index, parent, bus, triplex_bus, meter, ties, attempts, from, to, count, pick;
+	double weight, total_weight, scale;
+	std::vector<double> weights;
+	BENCHMARK_BRANCH *branch;
+
+	//SWING bus at the substation
+	bus = benchmark_add_bus(island,0x07,2,BENCHMARK_PRIMARY_VOLTAGE,"swing");
+	primary.push_back(bus);
+	three_phase.push_back(bus);
+
+	for (index=1; index<options->nodes; index++)
+	{
+		parent = primary[(size_t)(uniform(random)*primary.size()) % primary.size()];
+		parent_phases = benchmark_bus[parent].phases;
+		phases = parent_phases;
+
+		//Laterals drop phases on the way down
+		if ((benchmark_phase_count(parent_phases) > 1) && (uniform(random) < options->laterals))
+		{
+			do {
+				if ((benchmark_phase_count(parent_phases) == 3) && (uniform(random) < 1.0/3.0))
+					phases = parent_phases & ~(0x04 >> (int)(uniform(random)*3.0));		//Two-phase lateral
+				else
+					phases = parent_phases & (0x04 >> (int)(uniform(random)*3.0));		//Single-phase lateral
+			} while ((phases == 0) || (phases == parent_phases));
+		}
+
+		bus = benchmark_add_bus(island,phases,0,BENCHMARK_PRIMARY_VOLTAGE,"node");
+		branch = benchmark_add_branch(island,parent,bus,phases,0,"line");
+		benchmark_line_admittance(branch,100.0 + 400.0*uniform(random));
+		connected.insert(std::make_pair(parent,bus));
+
+		primary.push_back(bus);
+		if (phases == 0x07)
+			three_phase.push_back(bus);
+
+		//Triplex secondary on one of the phases
+		if (uniform(random) < options->triplex)
+		{
+			count = benchmark_phase_count(phases);
+			pick = (int)(uniform(random)*count) % count;
+			for (phase_bit=0x04; phase_bit!=0; phase_bit>>=1)
+			{
+				if ((phases & phase_bit) != 0)
+				{
+					if (pick == 0)
+						break;
+					pick--;
+				}
+			}
+
+			triplex_bus = benchmark_add_bus(island,0x80 | 0x20 | phase_bit,0,BENCHMARK_TRIPLEX_VOLTAGE,"triplex_node");
+			branch = benchmark_add_branch(island,bus,triplex_bus,0x80 | 0x20 | phase_bit,2,"spct");
+			branch->v_ratio = BENCHMARK_PRIMARY_VOLTAGE / BENCHMARK_TRIPLEX_VOLTAGE;
+			benchmark_spct_admittance(branch,(phase_bit == 0x04) ? 0 : ((phase_bit == 0x02) ? 1 : 2));
+
+			meter = benchmark_add_bus(island,0x80 | phase_bit,0,BENCHMARK_TRIPLEX_VOLTAGE,"triplex_meter");
+			branch = benchmark_add_branch(island,triplex_bus,meter,0x80 | phase_bit,1,"triplex_line");
+			benchmark_triplex_admittance(branch,BENCHMARK_TRIPLEX_LENGTH);
+
+			load_points.push_back(meter);
+		}
+
+		load_points.push_back(bus);
+	}
+
+	//Tie lines between three-phase buses make the feeder meshed
+	ties = 0;
+	for (attempts=0; (ties < options->ties) && (three_phase.size() > 2) && (attempts < 100*options->ties); attempts++)
+	{
+		from = three_phase[(size_t)(uniform(random)*three_phase.size()) % three_phase.size()];
+		to = three_phase[(size_t)(uniform(random)*three_phase.size()) % three_phase.size()];
+
+		if ((from == to) || connected.count(std::make_pair(from,to)) || connected.count(std::make_pair(to,from)))
+			continue;
+
+		branch = benchmark_add_branch(island,from,to,0x07,0,"tie");
+		benchmark_line_admittance(branch,500.0 + 1500.0*uniform(random));
+		connected.insert(std::make_pair(from,to));
+		ties++;
+	}
+	if (ties < options->ties)
+		gl_warning("island %d has %d of the %d tie lines requested - not enough three-phase buses",island,ties,options->ties);
+
+	//Spread the island load over the load points
+	total_weight = 0.0;
+	for (index=0; index<(int)load_points.size(); index++)
+	{
+		weight = 0.5 + uniform(random);
+		weights.push_back(weight);
+		total_weight += weight;
+	}
+
+	for (index=0; index<(int)load_points.size(); index++)
+	{
+		BENCHMARK_BUS &point = benchmark_bus[load_points[index]];
+		gld::complex load;
+
+		scale = options->load * 1000.0 * weights[index] / total_weight;
+		load = gld::complex(BENCHMARK_POWER_FACTOR,sqrt(1.0 - BENCHMARK_POWER_FACTOR*BENCHMARK_POWER_FACTOR)) * scale;
+
+		if ((point.phases & 0x80) == 0x80)
+		{
+			point.load[0] = load * 0.45;
+			point.load[1] = load * 0.45;
+			point.load[2] = load * 0.10;
+		}
+		else
+		{
+			count = benchmark_phase_count(point.phases);
+			for (phase_bit=0; phase_bit<3; phase_bit++)
+			{
+				if ((point.phases & (0x04 >> phase_bit)) != 0)
+					point.load[phase_bit] = load / (double)count;
+			}
+		}
+	}
+}
+
+//Apply the loads - ZIP on the primary, constant power and impedance on the triplex meters
+static void benchmark_apply_loads(double perturb, std::mt19937 &random)
+{
+	std::uniform_real_distribution<double> uniform(-1.0,1.0);
+	gld::complex nominal, load;
+	double factor;
+	size_t index;
+	int phase;
+
+	for (index=0; index<benchmark_bus.size(); index++)
+	{
+		BENCHMARK_BUS &bus = benchmark_bus[index];
+
+		factor = 1.0 + perturb*uniform(random);
+
+		for (phase=0; phase<3; phase++)
+		{
+			load = bus.load[phase] * factor;
+
+			if ((bus.phases & 0x80) == 0x80)
+			{
+				if (phase < 2)
+				{
+					bus.S[phase] = load * 0.75;
+					bus.Y[phase] = ~(load * 0.25) / (bus.nominal*bus.nominal);
+				}
+				else
+				{
+					bus.S[phase] = load * 0.75;
+					bus.Y[phase] = ~(load * 0.25) / (4.0*bus.nominal*bus.nominal);
+				}
+				bus.I[phase] = 0.0;
+			}
+			else
+			{
+				nominal.SetPolar(bus.nominal,-2.0*PI*phase/3.0);
+				bus.S[phase] = load * 0.5;
+				bus.I[phase] = ~(load * 0.25 / nominal);
+				bus.Y[phase] = ~(load * 0.25) / (bus.nominal*bus.nominal);
+			}
+		}
+	}
+}
+
+//Point the NR arrays at the generated buses and branches
+static void benchmark_populate(std::vector<BUSDATA> &bus, std::vector<BRANCHDATA> &branch)
+{
+	size_t index;
+
+	bus.assign(benchmark_bus.size(),BUSDATA());
+	branch.assign(benchmark_branch.size(),BRANCHDATA());
+
+	for (index=0; index<benchmark_bus.size(); index++)
+	{
+		BENCHMARK_BUS &source = benchmark_bus[index];
+		BUSDATA &target = bus[index];
+
+		target.type = source.type;
+		target.phases = target.origphases = source.phases;
+		target.busflag = &source.busflags;
+		target.V = source.V;
+		target.S = source.S;
+		target.Y = source.Y;
+		target.I = source.I;
+		target.prerot_I = source.prerot_I;
+		target.S_dy = source.S_dy;
+		target.Y_dy = source.Y_dy;
+		target.I_dy = source.I_dy;
+		target.full_Y = target.full_Y_all = target.full_Y_load = nullptr;
+		target.extra_var = ((source.phases & 0x80) == 0x80) ? &source.current12 : nullptr;
+		target.house_var = nullptr;
+		target.Link_Table = source.links.data();
+		target.Link_Table_Size = (unsigned int)source.links.size();
+		target.dynamics_enabled = &benchmark_dynamics_enabled;
+		target.swing_functions_enabled = (source.type == 2);
+		target.swing_topology_entry = false;
+		target.PGenTotal = target.DynCurrent = target.BusHistTerm = target.BusSatTerm = nullptr;
+		target.volt_base = source.nominal;
+		target.mva_base = -1.0;
+		target.Matrix_Loc = -1;
+		target.max_volt_error = source.nominal * default_maximum_voltage_error;
+		target.name = (char *)source.name.c_str();
+		target.obj = nullptr;
+		target.ExtraCurrentInjFunc = nullptr;
+		target.ExtraCurrentInjFuncObject = nullptr;
+		target.ExtraCurrentInjBatch = -1;
+		target.ExtraCurrentInjBatchSlot = -1;
+		target.LoadUpdateFxn = target.ShuntUpdateFxn = nullptr;
+		target.island_number = source.island;
+	}
+
+	for (index=0; index<benchmark_branch.size(); index++)
+	{
+		BENCHMARK_BRANCH &source = benchmark_branch[index];
+		BRANCHDATA &target = branch[index];
+
+		target.Yfrom = source.Yfrom;
+		target.Yto = source.Yto;
+		target.YSfrom = source.YSfrom;
+		target.YSto = source.YSto;
+		target.phases = source.phases;
+		target.origphases = source.origphases;
+		target.faultphases = 0x00;
+		target.from = source.from;
+		target.to = source.to;
+		target.fault_link_below = -1;
+		target.status = &source.status;
+		target.lnk_type = source.lnk_type;
+		target.v_ratio = source.v_ratio;
+		target.name = (char *)source.name.c_str();
+		target.obj = nullptr;
+		target.If_from = source.If_from;
+		target.If_to = source.If_to;
+		target.limit_check = nullptr;
+		target.ExtraDeltaModeFunc = nullptr;
+		target.island_number = source.island;
+	}
+}
+
+static void benchmark_usage(void)
+{
+	printf("Syntax: solver_nr_benchmark [options]\n"
+		"  --nodes N             primary buses per island, SWING included (default 1000)\n"
+		"  --islands N           islands, each with its own SWING bus (default 1)\n"
+		"  --ties N              tie lines per island between three-phase buses (default 0 - radial)\n"
+		"  --laterals F          probability of a branch dropping phases (default 0.3)\n"
+		"  --triplex F           probability of a primary bus serving a triplex secondary (default 0.5)\n"
+		"  --load kVA            load of each island (default 5000)\n"
+		"  --steps N             timesteps to solve (default 100)\n"
+		"  --perturb F           random load change at each timestep (default 0.05)\n"
+		"  --seed N              random seed (default 1)\n"
+		"  --lu superlu|internal LU solver (default superlu)\n"
+		"  --lu-threads N        refactoring threads of the internal LU solver (default 1)\n"
+		"  --jacobian-reuse      reuse the LU factors of previous Jacobians (NR_jacobian_reuse)\n"
+		"  --iteration-limit N   NR iteration limit (default 500)\n"
+		"  --verbose             show the solver messages\n");
+}
+
+static double benchmark_clock_now(void)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void benchmark_report_phase(const char *phase, double time, double total)
+{
+	printf("  %-14s %10.3f ms %6.1f%%\n",phase,time*1000.0,(total > 0.0) ? 100.0*time/total : 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+	BENCHMARK_OPTIONS options = {1000, 1, 0, 0.3, 0.5, 5000.0, 100, 0.05, 1, false, 1, false, 500};
+	CALLBACKS callbacks;
+	std::vector<BUSDATA> bus;
+	std::vector<BRANCHDATA> branch;
+	int64 result, iterations = 0, min_iterations = -1, max_iterations = 0;
+	int step, island, failed = 0, unconverged = 0, phase;
+	unsigned int total_variables = 0, matrix_entries = 0;
+	double start, elapsed, first_solve = 0.0, total_solve = 0.0, phase_total;
+	double magnitude, min_voltage = 1e300, max_voltage = 0.0;
+	bool bad_computations;
+	size_t index;
+
+	callback = &callbacks;
+
+	for (index=1; index<(size_t)argc; index++)
+	{
+		const char *arg = argv[index];
+		const char *value = (index+1 < (size_t)argc) ? argv[index+1] : nullptr;
+
+		if (strcmp(arg,"--jacobian-reuse") == 0)
+			options.jacobian_reuse = true;
+		else if (strcmp(arg,"--verbose") == 0)
+			benchmark_verbose = true;
+		else if ((strcmp(arg,"--help") == 0) || (strcmp(arg,"-h") == 0))
+		{
+			benchmark_usage();
+			return 0;
+		}
+		else if (value == nullptr)
+		{
+			gl_error("option %s is unknown or missing its value",arg);
+			benchmark_usage();
+			return 1;
+		}
+		else
+		{
+			if (strcmp(arg,"--nodes") == 0)
+				options.nodes = atoi(value);
+			else if (strcmp(arg,"--islands") == 0)
+				options.islands = atoi(value);
+			else if (strcmp(arg,"--ties") == 0)
+				options.ties = atoi(value);
+			else if (strcmp(arg,"--laterals") == 0)
+				options.laterals = atof(value);
+			else if (strcmp(arg,"--triplex") == 0)
+				options.triplex = atof(value);
+			else if (strcmp(arg,"--load") == 0)
+				options.load = atof(value);
+			else if (strcmp(arg,"--steps") == 0)
+				options.steps = atoi(value);
+			else if (strcmp(arg,"--perturb") == 0)
+				options.perturb = atof(value);
+			else if (strcmp(arg,"--seed") == 0)
+				options.seed = (unsigned int)strtoul(value,nullptr,10);
+			else if (strcmp(arg,"--lu-threads") == 0)
+				options.lu_threads = atoi(value);
+			else if (strcmp(arg,"--iteration-limit") == 0)
+				options.iteration_limit = atoll(value);
+			else if (strcmp(arg,"--lu") == 0)
+			{
+				if (strcmp(value,"internal") == 0)
+					options.internal_lu = true;
+				else if (strcmp(value,"superlu") == 0)
+					options.internal_lu = false;
+				else
+				{
+					gl_error("LU solver %s is not superlu or internal",value);
+					return 1;
+				}
+			}
+			else
+			{
+				gl_error("option %s is unknown",arg);
+				benchmark_usage();
+				return 1;
+			}
+			index++;
+		}
+	}
+
+	if ((options.nodes < 2) || (options.islands < 1) || (options.steps < 1) || (options.ties < 0) || (options.iteration_limit < 1))
+	{
+		gl_error("the feeders need at least 2 nodes and 1 island, and the benchmark at least 1 step and iteration");
+		return 1;
+	}
+
+	//Solver setup - what the powerflow module globals would hold
+	NR_iteration_limit = options.iteration_limit;
+	NR_jacobian_reuse = options.jacobian_reuse;
+	NR_lu_threads = options.lu_threads;
+	NR_solver_timing = true;
+	if (options.internal_lu)
+	{
+		matrix_solver_method = MM_EXTERN;
+		LUSolverFcns.dllLink = nullptr;
+		LUSolverFcns.ext_init = (void *)solver_lu_init;
+		LUSolverFcns.ext_alloc = (void *)solver_lu_alloc;
+		LUSolverFcns.ext_solve = (void *)solver_lu_solve;
+		LUSolverFcns.ext_destroy = (void *)solver_lu_destroy;
+		LUSolverFcns.ext_free = (void *)solver_lu_free;
+	}
+	else
+	{
+		matrix_solver_method = MM_SUPERLU;
+	}
+
+	//Generate the feeders
+	std::mt19937 random(options.seed);
+	for (island=0; island<options.islands; island++)
+	{
+		benchmark_generate_island(&options,island,random);
+	}
+	benchmark_populate(bus,branch);
+
+	NR_bus_count = (unsigned int)bus.size();
+	NR_branch_count = (unsigned int)branch.size();
+	NR_busdata = bus.data();
+	NR_branchdata = branch.data();
+	if (NR_array_structure_allocate(&NR_powerflow,options.islands) == FAILED)
+	{
+		gl_error("unable to allocate the NR solver arrays");
+		return 1;
+	}
+	NR_islands_detected = options.islands;
+	NR_admit_change = true;
+
+	printf("feeders           %d island%s of %d primary buses, %d tie line%s, laterals %g, triplex %g, %g kVA\n",
+		options.islands,(options.islands == 1) ? "" : "s",options.nodes,options.ties,(options.ties == 1) ? "" : "s",options.laterals,options.triplex,options.load);
+	printf("network           %u buses, %u branches\n",NR_bus_count,NR_branch_count);
+
+	//Timesteps
+	for (step=0; step<options.steps; step++)
+	{
+		benchmark_apply_loads((step == 0) ? 0.0 : options.perturb,random);
+
+		start = benchmark_clock_now();
+		result = solver_nr(NR_bus_count,NR_busdata,NR_branch_count,NR_branchdata,&NR_powerflow,PF_NORMAL,nullptr,&bad_computations);
+		elapsed = benchmark_clock_now() - start;
+
+		//Admittance is only built once, like a model without topology changes
+		NR_admit_change = false;
+
+		if (step == 0)
+		{
+			first_solve = elapsed;
+
+			for (island=0; island<NR_islands_detected; island++)
+			{
+				total_variables += NR_powerflow.island_matrix_values[island].total_variables;
+				matrix_entries += NR_powerflow.island_matrix_values[island].size_Amatrix;
+			}
+		}
+		else
+		{
+			total_solve += elapsed;
+		}
+
+		if (bad_computations)
+		{
+			failed++;
+		}
+		else if (result < 0)
+		{
+			unconverged++;
+		}
+		else
+		{
+			//The return value is the last iteration index of the slowest island
+			iterations += result + 1;
+			if ((min_iterations < 0) || (result + 1 < min_iterations))
+				min_iterations = result + 1;
+			if (result + 1 > max_iterations)
+				max_iterations = result + 1;
+		}
+	}
+
+	//Sanity of the last solution
+	for (index=0; index<benchmark_bus.size(); index++)
+	{
+		for (phase=0; phase<3; phase++)
+		{
+			if ((benchmark_bus[index].phases & 0x80) == 0x80)
+			{
+				if (phase == 2)
+					continue;
+			}
+			else if ((benchmark_bus[index].phases & (0x04 >> phase)) == 0)
+			{
+				continue;
+			}
+
+			magnitude = benchmark_bus[index].V[phase].Mag() / benchmark_bus[index].nominal;
+			if (magnitude < min_voltage)
+				min_voltage = magnitude;
+			if (magnitude > max_voltage)
+				max_voltage = magnitude;
+		}
+	}
+
+	printf("matrix            %u x %u, %u entries\n",2*total_variables,2*total_variables,matrix_entries);
+	printf("LU solver         %s\n",options.internal_lu ? "internal" : "superlu");
+	printf("solves            %d (%d not converged, %d failed)\n",options.steps,unconverged,failed);
+	if (options.steps > unconverged + failed)
+	{
+		printf("iterations        %lld, %.2f per solve, %lld to %lld\n",iterations,(double)iterations/(options.steps-unconverged-failed),min_iterations,max_iterations);
+	}
+	printf("LU solves         %lld factoring, %lld with kept factors\n",NR_factorization_count,NR_factorization_reuse_count);
+	printf("first solve       %10.3f ms\n",first_solve*1000.0);
+	if (options.steps > 1)
+	{
+		printf("other solves      %10.3f ms, %.3f ms per solve\n",total_solve*1000.0,total_solve*1000.0/(options.steps-1));
+	}
+	phase_total = NR_assembly_time + NR_factorization_time + NR_solve_time + NR_update_time;
+	printf("iteration phases  %10.3f ms\n",phase_total*1000.0);
+	benchmark_report_phase("assembly",NR_assembly_time,phase_total);
+	benchmark_report_phase("factorization",NR_factorization_time,phase_total);
+	benchmark_report_phase("solve",NR_solve_time,phase_total);
+	benchmark_report_phase("update",NR_update_time,phase_total);
+	printf("voltages          %.4f to %.4f pu\n",min_voltage,max_voltage);
+
+	NR_array_structure_free(&NR_powerflow,NR_islands_detected);
+
+	return ((failed > 0) || (unconverged > 0)) ? 2 : 0;
+}
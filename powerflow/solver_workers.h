@@ -0,0 +1,94 @@
+/* $Id
+ * Persistent worker threads of the threaded powerflow solvers
+ */
+
+#ifndef _SOLVER_WORKERS
+#define _SOLVER_WORKERS
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Worker threads kept between the calls of a threaded solver
+
+	The in-tree LU refactorization and the FBS array sweep split their wide
+	levels between threads many times per timestep.  run() hands the shares
+	1 to threads-1 to parked workers, runs share 0 in the calling thread, and
+	returns once every share is done, so a call only wakes the workers instead
+	of creating and joining threads.  The workers are started by the first
+	call, restarted if the number of threads changes, and stopped when the
+	pool is destroyed.  All the shares of one call run at the same time, so
+	they can wait for each other (e.g., at a barrier between levels).
+ **/
+class solver_workers {
+private:
+	std::vector<std::thread> workers;
+	std::mutex lock;
+	std::condition_variable start;
+	std::condition_variable done;
+	const std::function<void(int)> *job;	///< Shares of the current call
+	unsigned int generation;				///< Number of calls handed to the workers
+	int pending;							///< Workers still running their share
+	bool exiting;
+private:
+	void work(int share)
+	{
+		unsigned int seen = 0;
+		std::unique_lock<std::mutex> guard(lock);
+		while (true)
+		{
+			start.wait(guard,[&]{return exiting || (generation != seen);});
+			if (exiting)
+				return;
+			seen = generation;
+			guard.unlock();
+			(*job)(share);
+			guard.lock();
+			if (--pending == 0)
+				done.notify_one();
+		}
+	};
+	void stop(void)
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			exiting = true;
+		}
+		start.notify_all();
+		for (std::vector<std::thread>::iterator worker=workers.begin(); worker!=workers.end(); worker++)
+			worker->join();
+		workers.clear();
+		exiting = false;
+		generation = 0;
+	};
+public:
+	solver_workers(void) : job(nullptr), generation(0), pending(0), exiting(false) {};
+	~solver_workers(void) { stop(); };
+	solver_workers(const solver_workers &) = delete;
+	solver_workers &operator=(const solver_workers &) = delete;
+	/// Runs share(0) ... share(threads-1) at the same time and waits for all of them
+	void run(int threads, const std::function<void(int)> &share)
+	{
+		if ((int)workers.size() != threads-1)
+		{
+			stop();
+			for (int index=1; index<threads; index++)
+				workers.push_back(std::thread(&solver_workers::work,this,index));
+		}
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			job = &share;
+			pending = threads-1;
+			generation++;
+		}
+		start.notify_all();
+		share(0);
+		std::unique_lock<std::mutex> guard(lock);
+		done.wait(guard,[&]{return pending == 0;});
+		job = nullptr;
+	};
+};
+
+#endif
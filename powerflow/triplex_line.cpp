@@ -302,6 +302,7 @@ void triplex_line::phase_conductor_checks(void)
 void triplex_line::recalc(void)
 {
 	triplex_line_configuration *line_config = OBJECTDATA(configuration,triplex_line_configuration);
+	gld::complex zs[3][3];
 
 	OBJECT *obj = OBJECTHDR(this);
 	
@@ -330,13 +331,18 @@ void triplex_line::recalc(void)
 			GL_THROW("Only NR and FBS support z-matrix components.");
 
 	}
+	else if (get_unit_impedance(zs, nullptr, tn))
+	{
+		//Another line with this configuration already computed the per-mile values
+		multiply(length/5280.0,zs,b_mat); // Length comes in ft, convert to miles.
+		multiply(length/5280.0,zs,B_mat);
+	}
 	else
 	{
 		// create local variables that will be used to calculate matrices.
 		double dcond,ins_thick,D12,D13,D23;
 		double r1,r2,rn,gmr1,gmr2,gmrn;
 		gld::complex zp11,zp22,zp33,zp12,zp13,zp23;
-		gld::complex zs[3][3];
 		double freq_coeff_real, freq_coeff_imag, freq_additive_term;
 
 		//Calculate coefficients for self and mutual impedance - incorporates frequency values
@@ -430,6 +436,9 @@ void triplex_line::recalc(void)
 		tn[1] = -zp23/zp33;
 		tn[2] = 0;
 
+		//Share the per-mile values with the other lines using this configuration
+		set_unit_impedance(zs, nullptr, tn);
+
 		multiply(length/5280.0,zs,b_mat); // Length comes in ft, convert to miles.
 		multiply(length/5280.0,zs,B_mat);
 	}
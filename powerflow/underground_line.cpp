@@ -339,18 +339,23 @@ void underground_line::recalc(void)
 			A_mat[2][2] = 1.0;
 		}
 	}
+	else if (get_unit_impedance(Zabc_mat, Yabc_mat))
+	{
+		//Another line with this configuration already solved Kersting's equations
+		scale_unit_impedance(Zabc_mat, Yabc_mat);
+	}
 	else
 	{
+		//Kersting's equations are solved per mile, scaled for length below
 		double dia_od1, dia_od2, dia_od3;
 		int16 strands_4, strands_5, strands_6;
 		double rad_14, rad_25, rad_36;
 				double dia[7], res[7], gmr[7], gmrcn[3], rcn[3], gmrs[3], ress[3], tap[8];
 		double d[7][7];
 		double perm_A, perm_B, perm_C, c_an, c_bn, c_cn, temp_denom;
-		gld::complex cap_freq_coeff;
 		gld::complex z[7][7],z_ts[3][3]; //, z_ij[3][3], z_in[3][3], z_nj[3][3], z_nn[3][3], z_abc[3][3];
 		double freq_coeff_real, freq_coeff_imag, freq_additive_term;
-		double miles = length / 5280.0;
+		bool cache_values = true;	//Values are shared with the other lines unless a warning has to be repeated for each of them
 
 		gld::complex test;///////////////
 
@@ -474,16 +479,6 @@ void underground_line::recalc(void)
 			perm_A = UG_GET(A, insulation_rel_permitivitty);
 			perm_B = UG_GET(B, insulation_rel_permitivitty);
 			perm_C = UG_GET(C, insulation_rel_permitivitty);
-
-			//Define the scaling constant for frequency, distance, and microS
-			if (enable_frequency_dependence)	//See which frequency to use
-			{
-				cap_freq_coeff = gld::complex(0,(2.0*PI*current_frequency*0.000001*miles));
-			}
-			else
-			{
-				cap_freq_coeff = gld::complex(0,(2.0*PI*nominal_frequency*0.000001*miles));
-			}
 		}
 
 		#define DIST(ph1, ph2) (has_phase(PHASE_##ph1) && has_phase(PHASE_##ph2) && config->line_spacing ? \
@@ -689,7 +684,7 @@ void underground_line::recalc(void)
 				//multiply(z_p1, z_nj, z_p2);
 
 				subtract(z_ij_cn, z_p2_cn, z_abc_cn);
-				multiply(miles, z_abc_cn, Zabc_mat);
+				equalm(z_abc_cn, Zabc_mat);
 
 			}
 			else {
@@ -719,6 +714,7 @@ void underground_line::recalc(void)
 					if(!has_phase(PHASE_N))
 					{
 						z_nn_ts[3][3]=gld::complex(1.0);
+						cache_values = false;
 					    gl_warning("Underground_line:%d - %s is a tape-shielded cable and may need an explicit phase N conductor",obj->id,(obj->name ? obj->name : "Unnamed"));
 						/*  TROUBLESHOOT
 						The underground cable is set up as a tape-shielded cable.  For neutral currents, it may require an explicit neutral to be connected, unless it represents a
@@ -750,7 +746,7 @@ void underground_line::recalc(void)
 				//multiply(z_p1, z_nj, z_p2);
 				
 				subtract(z_ij_ts, z_p2_ts, z_abc_ts);
-				multiply(miles, z_abc_ts, Zabc_mat);
+				equalm(z_abc_ts, Zabc_mat);
 
 				/* //This is a test example based on example 4.4 in Kersting's
 				gld::complex z_ij_ts[1][1] = {Z(1, 1)};
@@ -807,15 +803,15 @@ void underground_line::recalc(void)
 			if(Z(7, 7) != 0.0){
 				z_nn_inv = Z(7, 7)^(-1.0);
 			}
-			Zabc_mat[0][0] = (Z(1, 1) - Z(1, 7) * Z(1, 7) * z_nn_inv) * miles;
-			Zabc_mat[0][1] = (Z(1, 2) - Z(1, 7) * Z(2, 7) * z_nn_inv) * miles;
-			Zabc_mat[0][2] = (Z(1, 3) - Z(1, 7) * Z(3, 7) * z_nn_inv) * miles;
-			Zabc_mat[1][0] = (Z(2, 1) - Z(2, 7) * Z(1, 7) * z_nn_inv) * miles;
-			Zabc_mat[1][1] = (Z(2, 2) - Z(2, 7) * Z(2, 7) * z_nn_inv) * miles;
-			Zabc_mat[1][2] = (Z(2, 3) - Z(2, 7) * Z(3, 7) * z_nn_inv) * miles;
-			Zabc_mat[2][0] = (Z(3, 1) - Z(3, 7) * Z(1, 7) * z_nn_inv) * miles;
-			Zabc_mat[2][1] = (Z(3, 2) - Z(3, 7) * Z(2, 7) * z_nn_inv) * miles;
-			Zabc_mat[2][2] = (Z(3, 3) - Z(3, 7) * Z(3, 7) * z_nn_inv) * miles;
+			Zabc_mat[0][0] = (Z(1, 1) - Z(1, 7) * Z(1, 7) * z_nn_inv);
+			Zabc_mat[0][1] = (Z(1, 2) - Z(1, 7) * Z(2, 7) * z_nn_inv);
+			Zabc_mat[0][2] = (Z(1, 3) - Z(1, 7) * Z(3, 7) * z_nn_inv);
+			Zabc_mat[1][0] = (Z(2, 1) - Z(2, 7) * Z(1, 7) * z_nn_inv);
+			Zabc_mat[1][1] = (Z(2, 2) - Z(2, 7) * Z(2, 7) * z_nn_inv);
+			Zabc_mat[1][2] = (Z(2, 3) - Z(2, 7) * Z(3, 7) * z_nn_inv);
+			Zabc_mat[2][0] = (Z(3, 1) - Z(3, 7) * Z(1, 7) * z_nn_inv);
+			Zabc_mat[2][1] = (Z(3, 2) - Z(3, 7) * Z(2, 7) * z_nn_inv);
+			Zabc_mat[2][2] = (Z(3, 3) - Z(3, 7) * Z(3, 7) * z_nn_inv);
 		}
 #undef Z
 
@@ -833,6 +829,7 @@ void underground_line::recalc(void)
 				{
 					if ((dia[0]==0.0) || (rad_14==0.0) || (strands_4 == 0))	//Make sure conductor or "neutral ring" radius are not zero
 					{
+						cache_values = false;
 						gl_warning("Unable to compute capacitance for %s",OBJECTHDR(this)->name);
 						/* TROUBLESHOOT
 						One phase of an underground line has either a conductor diameter, a concentric-neutral location diameter, or a neutral
@@ -850,6 +847,7 @@ void underground_line::recalc(void)
 
 						if (temp_denom == 0.0)
 						{
+							cache_values = false;
 							gl_warning("Capacitance calculation failure for %s",OBJECTHDR(this)->name);
 							/*  TROUBLESHOOT
 							While computing the capacitance, a zero-value denominator was encountered.  Please check
@@ -880,6 +878,7 @@ void underground_line::recalc(void)
 				{
 					if ((dia[1]==0.0) || (rad_25==0.0) || (strands_5 == 0))	//Make sure conductor or "neutral ring" radius are not zero
 					{
+						cache_values = false;
 						gl_warning("Unable to compute capacitance for %s",OBJECTHDR(this)->name);
 						//Defined above
 
@@ -892,6 +891,7 @@ void underground_line::recalc(void)
 
 						if (temp_denom == 0.0)
 						{
+							cache_values = false;
 							gl_warning("Capacitance calculation failure for %s",OBJECTHDR(this)->name);
 							//Defined above
 
@@ -919,6 +919,7 @@ void underground_line::recalc(void)
 					if ((dia[2]==0.0) || (rad_36==0.0) || (strands_6 == 0))	//Make sure conductor or "neutral ring" radius are not zero
 
 					{
+						cache_values = false;
 						gl_warning("Unable to compute capacitance for %s",OBJECTHDR(this)->name);
 						//Defined above
 
@@ -932,6 +933,7 @@ void underground_line::recalc(void)
 
 						if (temp_denom == 0.0)
 						{
+							cache_values = false;
 							gl_warning("Capacitance calculation failure for %s",OBJECTHDR(this)->name);
 							//Defined above
 
@@ -960,6 +962,7 @@ void underground_line::recalc(void)
 					
 					if ((dia[0]==0.0) || (rad_14==0.0))	//Make sure conductor or "neutral ring" radius are not zero
 					{
+						cache_values = false;
 						gl_warning("Unable to compute capacitance for %s",OBJECTHDR(this)->name);
 						/* TROUBLESHOOT
 						One phase of an underground line has either a conductor diameter, a concentric-neutral location diameter, or a neutral
@@ -976,6 +979,7 @@ void underground_line::recalc(void)
 
 						if (temp_denom == 0.0)
 						{
+							cache_values = false;
 							gl_warning("Capacitance calculation failure for %s",OBJECTHDR(this)->name);
 							/*  TROUBLESHOOT
 							While computing the capacitance, a zero-value denominator was encountered.  Please check
@@ -1005,6 +1009,7 @@ void underground_line::recalc(void)
 					
 					if ((dia[1]==0.0) || (rad_25==0.0))	//Make sure conductor or "neutral ring" radius are not zero
 					{
+						cache_values = false;
 						gl_warning("Unable to compute capacitance for %s",OBJECTHDR(this)->name);
 						//Defined above
 
@@ -1017,6 +1022,7 @@ void underground_line::recalc(void)
 
 						if (temp_denom == 0.0)
 						{
+							cache_values = false;
 							gl_warning("Capacitance calculation failure for %s",OBJECTHDR(this)->name);
 							//Defined above
 
@@ -1045,6 +1051,7 @@ void underground_line::recalc(void)
 					if ((dia[2]==0.0) || (rad_36==0.0))	//Make sure conductor or "neutral ring" radius are not zero
 
 					{
+						cache_values = false;
 						gl_warning("Unable to compute capacitance for %s",OBJECTHDR(this)->name);
 						//Defined above
 
@@ -1058,6 +1065,7 @@ void underground_line::recalc(void)
 
 						if (temp_denom == 0.0)
 						{
+							cache_values = false;
 							gl_warning("Capacitance calculation failure for %s",OBJECTHDR(this)->name);
 							//Defined above
 
@@ -1078,10 +1086,10 @@ void underground_line::recalc(void)
 
 
 
-			//Make admittance matrix, scaling for frequency, distance, and microSiemens as well as per Kersting (5.15) 
-			Yabc_mat[0][0] = cap_freq_coeff * c_an;
-			Yabc_mat[1][1] = cap_freq_coeff * c_bn;
-			Yabc_mat[2][2] = cap_freq_coeff * c_cn;
+			//Make admittance matrix - scaled for frequency, distance, and microSiemens with the impedance below
+			Yabc_mat[0][0] = c_an;
+			Yabc_mat[1][1] = c_bn;
+			Yabc_mat[2][2] = c_cn;
 		}
 		else	//No line capacitance, carry on as usual
 		{
@@ -1118,6 +1126,12 @@ void underground_line::recalc(void)
 				A_mat[2][2] = 1.0;
 			}
 		}
+
+		if (cache_values)
+		{
+			set_unit_impedance(Zabc_mat, Yabc_mat);
+		}
+		scale_unit_impedance(Zabc_mat, Yabc_mat);
 	}
 
 	// Calculate line matrixies A_mat, B_mat, a_mat, b_mat, c_mat and d_mat based on Zabc_mat and Yabc_mat
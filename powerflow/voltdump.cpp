@@ -8,8 +8,10 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
 
 #include "voltdump.h"
+#include "node.h"
 
 //////////////////////////////////////////////////////////////////////////
 // voltdump CLASS FUNCTIONS
@@ -38,6 +40,8 @@ voltdump::voltdump(MODULE *mod)
 			PT_enumeration, "mode", PADDR(mode),PT_DESCRIPTION,"dumps the voltages in either polar or rectangular notation",
 				PT_KEYWORD, "RECT", (enumeration)VDM_RECT,
 				PT_KEYWORD, "POLAR", (enumeration)VDM_POLAR,
+			PT_int32,"threads",PADDR(threads),PT_DESCRIPTION,"the number of threads used to format the rows (0 uses all processors)",
+			PT_bool,"background",PADDR(background),PT_DESCRIPTION,"flag to write the file in the background while the simulation continues",
 			nullptr)<1) GL_THROW("unable to publish properties in %s",__FILE__);
 		
 	}
@@ -50,6 +54,9 @@ int voltdump::create(void)
 	runtime = TS_NEVER;
 	runcount = 0;
 	mode = VDM_RECT;
+	threads = 1;
+	background = false;
+	stream = new dump_stream;
 	return 1;
 }
 
@@ -58,20 +65,48 @@ int voltdump::init(OBJECT *parent)
 	return 1;
 }
 
+/// wait for a background write to complete and release the stream
+STATUS voltdump::finalize(void)
+{
+	delete stream;
+	stream = nullptr;
+	return SUCCESS;
+}
+
 int voltdump::isa(char *classname)
 {
 	return strcmp(classname,"voltdump")==0;
 }
 
-void voltdump::dump(TIMESTAMP t){
+/// row of the voltage dump
+typedef struct {
+	const char *name;
 	char namestr[128];
+	gld::complex *voltage; ///< voltage_A/B/C (or voltage_1/2/N for triplex nodes)
+} VOLTDUMPROW;
+
+typedef struct {
+	std::vector<VOLTDUMPROW> *rows;
+	enumeration mode;
+} VOLTDUMPDATA;
+
+static size_t voltdump_row(void *data, size_t n, char *buffer, size_t len)
+{
+	VOLTDUMPDATA *dump = (VOLTDUMPDATA*)data;
+	VOLTDUMPROW &row = (*dump->rows)[n];
+	gld::complex *v = row.voltage;
+	int size = 0;
+	if ( dump->mode == VDM_RECT )
+		size = snprintf(buffer,len,"%s,%f,%f,%f,%f,%f,%f\n",row.name,v[0].Re(),v[0].Im(),v[1].Re(),v[1].Im(),v[2].Re(),v[2].Im());
+	else if ( dump->mode == VDM_POLAR )
+		size = snprintf(buffer,len,"%s,%f,%f,%f,%f,%f,%f\n",row.name,v[0].Mag(),v[0].Arg(),v[1].Mag(),v[1].Arg(),v[2].Mag(),v[2].Arg());
+	return size<0 ? 0 : ( (size_t)size<len ? (size_t)size : len-1 );
+}
+
+void voltdump::dump(TIMESTAMP t){
 	char timestr[128];
 	FINDLIST *nodes = nullptr;
 	OBJECT *obj = nullptr;
-	FILE *outfile = nullptr;
-
-	gld_property *node_voltage_value_link[3];
-	gld::complex node_voltage_values[3];
 
 	//Find the objects - note that "FT_CLASS" requires an explicit match (not parent classing), so
 	//this would have to be replicated for all different node types to get it to work.
@@ -86,124 +121,51 @@ void voltdump::dump(TIMESTAMP t){
 		return;
 	}
 
-	outfile = fopen(filename, "w");
-	if(outfile == nullptr){
+	if(!stream->open(filename, background)){
 		gl_error("voltdump unable to open %s for output", filename.get_string());
+		gl_free(nodes);
 		return;
 	}
 
-	//nodeclass = node::oclass;
-	//vA=gl_find_property(nodeclass, "
-
 	/* print column names */
 	gl_printtime(t, timestr, 64);
-	fprintf(outfile,"# %s run at %s on %i powerflow objects (not all are nodes)\n", filename.get_string(), timestr, nodes->hit_count);
+	stream->printf("# %s run at %s on %i powerflow objects (not all are nodes)\n", filename.get_string(), timestr, nodes->hit_count);
 	if (mode == VDM_RECT)
-		fprintf(outfile,"node_name,voltA_real,voltA_imag,voltB_real,voltB_imag,voltC_real,voltC_imag\n");
+		stream->printf("node_name,voltA_real,voltA_imag,voltB_real,voltB_imag,voltC_real,voltC_imag\n");
 	else if (mode == VDM_POLAR)
-		fprintf(outfile,"node_name,voltA_mag,voltA_angle,voltB_mag,voltB_angle,voltC_mag,voltC_angle\n");
-	
+		stream->printf("node_name,voltA_mag,voltA_angle,voltB_mag,voltB_angle,voltC_mag,voltC_angle\n");
+
+	//Collect the nodes - triplex nodes keep voltage_1, voltage_2 and voltage_N in the same place as voltage_A, B and C
+	std::vector<VOLTDUMPROW> rows;
+	rows.reserve(nodes->hit_count);
 	obj = 0;
 	while (obj=gl_find_next(nodes,obj))
 	{
-		if(gl_object_isa(obj, "triplex_node", "powerflow"))
-		{
-
-			//Map the properties of interest - first current
-			node_voltage_value_link[0] = new gld_property(obj,"voltage_1");
-
-			//Check it
-			if (!node_voltage_value_link[0]->is_valid() || !node_voltage_value_link[0]->is_complex())
-			{
-				GL_THROW("voltdump - Unable to map voltage property of triplex_node:%d - %s",obj->id,(obj->name ? obj->name : "Unnamed"));
-				/*  TROUBLESHOOT
-				While the voltdump object attempted to map the voltage_1, voltage_2, or voltage_N, an error
-				occurred.  Please try again.  If the error persists, please submit your code via the ticketing and issues system.
-				*/
-			}
-
-			//Map the properties of interest - second current
-			node_voltage_value_link[1] = new gld_property(obj,"voltage_2");
-
-			//Check it
-			if (!node_voltage_value_link[1]->is_valid() || !node_voltage_value_link[1]->is_complex())
-			{
-				GL_THROW("voltdump - Unable to map voltage property of triplex_node:%d - %s",obj->id,(obj->name ? obj->name : "Unnamed"));
-				//Defined above
-			}
-
-			//Map the properties of interest - third current
-			node_voltage_value_link[2] = new gld_property(obj,"voltage_N");
-
-			//Check it
-			if (!node_voltage_value_link[2]->is_valid() || !node_voltage_value_link[2]->is_complex())
-			{
-				GL_THROW("voltdump - Unable to map voltage property of triplex_node:%d - %s",obj->id,(obj->name ? obj->name : "Unnamed"));
-				//Defined above
-			}
-		}
-		else if(gl_object_isa(obj, "node", "powerflow"))
-		{
-			//Map the properties of interest - first current
-			node_voltage_value_link[0] = new gld_property(obj,"voltage_A");
-
-			//Check it
-			if (!node_voltage_value_link[0]->is_valid() || !node_voltage_value_link[0]->is_complex())
-			{
-				GL_THROW("voltdump - Unable to map voltage property of node:%d - %s",obj->id,(obj->name ? obj->name : "Unnamed"));
-				/*  TROUBLESHOOT
-				While the voltdump object attempted to map the voltage_A, voltage_B, or voltage_C, an error
-				occurred.  Please try again.  If the error persists, please submit your code via the ticketing and issues system.
-				*/
-			}
-
-			//Map the properties of interest - second current
-			node_voltage_value_link[1] = new gld_property(obj,"voltage_B");
-
-			//Check it
-			if (!node_voltage_value_link[1]->is_valid() || !node_voltage_value_link[1]->is_complex())
-			{
-				GL_THROW("voltdump - Unable to map voltage property of node:%d - %s",obj->id,(obj->name ? obj->name : "Unnamed"));
-				//Defined above
-			}
-
-			//Map the properties of interest - third current
-			node_voltage_value_link[2] = new gld_property(obj,"voltage_C");
-
-			//Check it
-			if (!node_voltage_value_link[2]->is_valid() || !node_voltage_value_link[2]->is_complex())
-			{
-				GL_THROW("voltdump - Unable to map voltage property of node:%d - %s",obj->id,(obj->name ? obj->name : "Unnamed"));
-				//Defined above
-			}
-		}
-		else	//Skip -- this is just some other object -- consequence of the findlist restrictions
-		{
-			//Next
+		if(!gl_object_isa(obj, "node", "powerflow"))	//Skip -- this is just some other object -- consequence of the findlist restrictions
 			continue;
-		}
-
-		//Pull the values
-		node_voltage_values[0] = node_voltage_value_link[0]->get_complex();
-		node_voltage_values[1] = node_voltage_value_link[1]->get_complex();
-		node_voltage_values[2] = node_voltage_value_link[2]->get_complex();
 
+		VOLTDUMPROW row;
 		if(obj->name == nullptr){
-			sprintf(namestr, "%s:%i", obj->oclass->name, obj->id);
-		}
-		if(mode == VDM_RECT){
-			fprintf(outfile,"%s,%f,%f,%f,%f,%f,%f\n",(obj->name ? obj->name : namestr),node_voltage_values[0].Re(),node_voltage_values[0].Im(),node_voltage_values[1].Re(),node_voltage_values[1].Im(),node_voltage_values[2].Re(),node_voltage_values[2].Im());
-		} else if(mode == VDM_POLAR){
-			fprintf(outfile,"%s,%f,%f,%f,%f,%f,%f\n",(obj->name ? obj->name : namestr),node_voltage_values[0].Mag(),node_voltage_values[0].Arg(),node_voltage_values[1].Mag(),node_voltage_values[1].Arg(),node_voltage_values[2].Mag(),node_voltage_values[2].Arg());
+			snprintf(row.namestr, sizeof(row.namestr), "%s:%i", obj->oclass->name, obj->id);
+			row.name = nullptr;
+		} else {
+			row.name = obj->name;
 		}
+		row.voltage = OBJECTDATA(obj,node)->voltage;
+		rows.push_back(row);
+	}
+	for ( std::vector<VOLTDUMPROW>::iterator row=rows.begin() ; row!=rows.end() ; row++ )
+	{
+		if ( row->name==nullptr )
+			row->name = row->namestr;
+	}
 
-		//Clear the properties found
-		delete node_voltage_value_link[0];
-		delete node_voltage_value_link[1];
-		delete node_voltage_value_link[2];
+	VOLTDUMPDATA data = {&rows, mode};
+	stream->rows(rows.size(), voltdump_row, &data, threads);
+
+	if(!stream->close()){
+		gl_error("voltdump unable to write %s", filename.get_string());
 	}
-	
-	fclose(outfile);
 
 	//Free the findlist
 	gl_free(nodes);
@@ -279,6 +241,18 @@ EXPORT TIMESTAMP commit_voltdump(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2){
 	I_CATCHALL(commit,voltdump);
 }
 
+EXPORT STATUS finalize_voltdump(OBJECT *obj)
+{
+	try {
+		voltdump *my = OBJECTDATA(obj,voltdump);
+		return my->finalize();
+	}
+	catch (const char *msg) {
+		gl_error("finalize_voltdump(obj=%d;%s): %s", obj->id, obj->name?obj->name:"unnamed", msg);
+		return FAILED;
+	}
+}
+
 EXPORT int isa_voltdump(OBJECT *obj, char *classname)
 {
 	return OBJECTDATA(obj,voltdump)->isa(classname);
@@ -5,6 +5,7 @@
 #define _VOLTDUMP_H
 
 #include "powerflow.h"
+#include "dump_stream.h"
 
 typedef enum {
 	VDM_RECT,
@@ -19,6 +20,9 @@ public:
 	char256 filename;
 	int32 runcount;
 	enumeration mode;		///< dumps the voltages in either polar or rectangular notation
+	int32 threads;			///< number of threads formatting rows
+	bool background;		///< write the file in the background
+	dump_stream *stream;
 public:
 	static CLASS *oclass;
 public:
@@ -27,6 +31,7 @@ public:
 	int init(OBJECT *parent);
 	TIMESTAMP commit(TIMESTAMP t);
 	int isa(char *classname);
+	STATUS finalize(void);
 
 	void dump(TIMESTAMP t);
 };
@@ -1663,6 +1663,39 @@ int house_e::init(OBJECT *parent)
 		powerflow_impedance_conversion_level = 0.0;
 	}
 
+	//Bundle the powerflow values, so each pull or push is one pass over their addresses
+	if (proper_meter_parent == true)
+	{
+		powerflow_values.add(pMeterStatus,&value_MeterStatus);
+		powerflow_values.add(pFrequency,&value_Frequency);
+
+		if (commercial_load_parent == true)
+		{
+			for (int indexval=0; indexval<3; indexval++)
+			{
+				powerflow_values.add(pCircuit_V[indexval],&value_Load_V[indexval]);
+
+				//Only push onto the parent load phases that are actually present
+				if (externalPhases & (1 << indexval))
+				{
+					powerflow_values.add(pPower[indexval],&value_Balanced_Power,PBO_ADD);
+					powerflow_values.add(pShunt[indexval],&value_Balanced_Shunt,PBO_ADD);
+					powerflow_values.add(pLine_I[indexval],&value_Balanced_Current,PBO_ADD);
+				}
+			}
+		}
+		else
+		{
+			for (int indexval=0; indexval<3; indexval++)
+			{
+				powerflow_values.add(pCircuit_V[indexval],&value_Circuit_V[indexval]);
+				powerflow_values.add(pLine_I[indexval],&value_Line_I[indexval],PBO_ADD);
+				powerflow_values.add(pShunt[indexval],&value_Shunt[indexval],PBO_ADD);
+				powerflow_values.add(pPower[indexval],&value_Power[indexval],PBO_ADD);
+			}
+		}
+	}
+
 	//grab the start time of the simulation
 	simulation_beginning_time = gl_globalclock;
 	simulation_beginning_time_dbl = (double)simulation_beginning_time;
@@ -3695,37 +3728,39 @@ void house_e::check_external_voltage()
 //Function to pull all the complex properties from powerflow into local variables
 void house_e::pull_complex_powerflow_values()
 {
-	//Pull in the various values from powerflow - straight reads
+	//Pull in the various values from powerflow - straight reads, unlocked since the parent calls us while it is locked
+	powerflow_values.pull_unlocked();
+
 	if (commercial_load_parent == true) {
 		if (numPhases == 3) { // V1n = positive-sequence voltage
-			complex Va = pCircuit_V[0]->get_complex();
-			complex Vb = pCircuit_V[1]->get_complex();
-			complex Vc = pCircuit_V[2]->get_complex();
+			complex Va = value_Load_V[0];
+			complex Vb = value_Load_V[1];
+			complex Vc = value_Load_V[2];
 			value_Circuit_V[1] = Va + A_OPERATOR * Vb + A2_OPERATOR * Vc;
 			value_Circuit_V[1] /= 3.0;
 		} else if (numPhases == 2) {
 			complex v1;
 			complex v2;
 			if (!(externalPhases & 1)) { // phases B and C
-				v1 = pCircuit_V[1]->get_complex();
-				v2 = pCircuit_V[2]->get_complex();
+				v1 = value_Load_V[1];
+				v2 = value_Load_V[2];
 			} else if (!(externalPhases & 2)) { // phases A and C
-				v1 = pCircuit_V[0]->get_complex();
-				v2 = pCircuit_V[2]->get_complex();
+				v1 = value_Load_V[0];
+				v2 = value_Load_V[2];
 			} else if (!(externalPhases & 4)) { // phases A and B
-				v1 = pCircuit_V[0]->get_complex();
-				v2 = pCircuit_V[1]->get_complex();
+				v1 = value_Load_V[0];
+				v2 = value_Load_V[1];
 			}
 			double vavg = 0.5 * (v1.Mag() + v2.Mag());
 			v1.Mag(vavg);
 			value_Circuit_V[1] = v1;
 		} else if (numPhases == 1) { // V1n = positive-sequence voltage
 			if (externalPhases & 1) {
-				value_Circuit_V[1] = pCircuit_V[0]->get_complex();
+				value_Circuit_V[1] = value_Load_V[0];
 			} else if (externalPhases & 2) {
-				value_Circuit_V[1] = pCircuit_V[1]->get_complex();
+				value_Circuit_V[1] = value_Load_V[1];
 			} else if (externalPhases & 4) {
-				value_Circuit_V[1] = pCircuit_V[2]->get_complex();
+				value_Circuit_V[1] = value_Load_V[2];
 			}
 		}
 		value_Circuit_V[1] /= internalTurnsRatio;
@@ -3738,22 +3773,12 @@ void house_e::pull_complex_powerflow_values()
                value_Circuit_V[1].Mag(), value_Circuit_V[2].Mag(), value_Circuit_V[0].Mag(),
                value_Circuit_V[1].Arg());
 */
-	} else {
-		value_Circuit_V[0] = pCircuit_V[0]->get_complex();
-		value_Circuit_V[1] = pCircuit_V[1]->get_complex();
-		value_Circuit_V[2] = pCircuit_V[2]->get_complex();
 	}
-	value_MeterStatus = pMeterStatus->get_enumeration();
-	value_Frequency = pFrequency->get_double();
 }
 
 //Function to push up all changes of complex properties to powerflow from local variables
 void house_e::push_complex_powerflow_values()
 {
-	gld::complex temp_complex_val;
-	gld_wlock *test_rlock;
-	int indexval;
-
 	if (commercial_load_parent == true) {
 /*
 	OBJECT *obj = OBJECTHDR(this);
@@ -3802,71 +3827,14 @@ void house_e::push_complex_powerflow_values()
 			insertI = 1;
 //			gl_output ("house: %s commercial per-phase I=[%g @ %g]", obj->name, balCurrent.Mag(), balCurrent.Arg());
 		}
-		// now push this building's power onto the parent load phases that are actually present
-		int mask = 1;
-		for (indexval = 0; indexval < 3; indexval++) {
-			if (externalPhases & mask) {
-				if (insertP > 0) {
-					temp_complex_val = pPower[indexval]->get_complex();
-//					gl_output ("  adding P to [%g +j%g] on phase mask %d",
-//										 temp_complex_val.Re(), temp_complex_val.Im(), mask);
-					temp_complex_val += balPower;
-					pPower[indexval]->setp<complex>(temp_complex_val,*test_rlock);
-				}
-				if (insertS > 0) {
-					temp_complex_val = pShunt[indexval]->get_complex();
-
-					//Add in our contribution
-					temp_complex_val += balShunt;
-
-					//Push it back up
-					pShunt[indexval]->setp<complex>(temp_complex_val,*test_rlock);
-				}
-				if (insertI > 0) {
-					temp_complex_val = pLine_I[indexval]->get_complex();
-
-					//Add in the contribution - current gets phase-rotated within powerflow/elsewhere
-					temp_complex_val += balCurrent;
-
-					//Push the value back up
-					pLine_I[indexval]->setp<complex>(temp_complex_val,*test_rlock);
-				}
-			}
-			mask *= 2;
-		}
-	} else {
-		for (indexval=0; indexval<3; indexval++) {
-            //**** Current value ***/
-            //Pull current value again, just in case
-            temp_complex_val = pLine_I[indexval]->get_complex();
-
-            //Add the difference
-            temp_complex_val += value_Line_I[indexval];
-
-            //Push it back up
-            pLine_I[indexval]->setp<gld::complex>(temp_complex_val, *test_rlock);
-
-            //**** shunt value ***/
-            //Pull current value again, just in case
-            temp_complex_val = pShunt[indexval]->get_complex();
-
-            //Add the difference
-            temp_complex_val += value_Shunt[indexval];
-
-            //Push it back up
-            pShunt[indexval]->setp<gld::complex>(temp_complex_val, *test_rlock);
-
-            //**** Power value ***/
-            //Pull current value again, just in case
-            temp_complex_val = pPower[indexval]->get_complex();
-
-            //Add the difference
-            temp_complex_val += value_Power[indexval];
-
-            //Push it back up
-            pPower[indexval]->setp<gld::complex>(temp_complex_val, *test_rlock);
-        }
+		// now push this building's power onto the parent load phases that are actually present (bundled at init)
+		value_Balanced_Power = (insertP > 0) ? balPower : gld::complex(0.0,0.0);
+		value_Balanced_Shunt = (insertS > 0) ? balShunt : gld::complex(0.0,0.0);
+		value_Balanced_Current = (insertI > 0) ? balCurrent : gld::complex(0.0,0.0);
 	}
+
+	//Add the differences to the parent accumulators - unlocked, like the pull
+	powerflow_values.push_unlocked();
 }
 
 //Function to pull the climate data from gld_property links into local variables
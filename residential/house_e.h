@@ -443,6 +443,7 @@ private:
 	gld::complex value_Power[3];						///< value holder for power value on triplex parent
 	enumeration value_MeterStatus;				///< value holder for service_status variable on triplex parent
 	double value_Frequency;						///< value holder for measured frequency on triplex parent
+	gld_bundle powerflow_values;				///< bundle of the powerflow values pulled and pushed each pass
 	typedef enum {	
 		XPFV_NONE	= 0,		// no external power flow
 		XPFV_ONEV	= 1,		// set just external_v1N, assume v2N equal and opposite
@@ -463,6 +464,10 @@ private:
 	double internalTurnsRatio;  // ratio of meter VLN / 120
 	gld::set externalPhases;         // for A, B and C present
 	int numPhases;
+	gld::complex value_Load_V[3];     // phase voltages of the load parent
+	gld::complex value_Balanced_Power;    // per-phase power pushed to the load parent
+	gld::complex value_Balanced_Shunt;    // per-phase shunt pushed to the load parent
+	gld::complex value_Balanced_Current;  // per-phase current pushed to the load parent
 
 	//Pointers for climate properties
 	gld_property *pTout;		// pointer to outdoor temperature (see climate)
@@ -37,6 +37,8 @@ tape_tape_la_SOURCES += tape/odbc.cpp
 tape_tape_la_SOURCES += tape/odbc.h
 tape_tape_la_SOURCES += tape/player.cpp
 tape_tape_la_SOURCES += tape/player.h
+tape_tape_la_SOURCES += tape/player_cache.cpp
+tape_tape_la_SOURCES += tape/player_cache.h
 tape_tape_la_SOURCES += tape/recorder.cpp
 tape_tape_la_SOURCES += tape/recorder.h
 tape_tape_la_SOURCES += tape/shaper.cpp
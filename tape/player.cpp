@@ -128,8 +128,17 @@ PROPERTY *player_link_properties(struct player *player, OBJECT *obj, char *prope
     return first;
 }
 
-int player_write_properties(struct player *my, OBJECT *thisplyr, OBJECT *obj, PROPERTY *prop, const char *buffer)
+int player_write_properties(struct player *my, OBJECT *thisplyr, OBJECT *obj, PROPERTY *prop, const char *buffer, const double *number=nullptr)
 {
+    /* a single number played into a plain double property is copied directly */
+    if (number != nullptr && prop->next == nullptr && prop->ptype == PT_double
+        && (prop->access == PA_PUBLIC || prop->access == PA_HIDDEN) && (prop->flags & PF_RECALC) == 0
+        && prop->notify == nullptr && obj->oclass->notify == nullptr)
+    {
+        *(double *) GETADDR(obj, prop) = *number;
+        return 1;
+    }
+
     int count = 0;
     const char delim[] = ",\n\r\t";
     char1024 bufcpy;
@@ -167,8 +176,14 @@ EXPORT int create_player(OBJECT **obj, OBJECT *parent) {
         strcpy(my->filetype, "txt");
         strcpy(my->mode, "file");
         strcpy(my->property, "(undefined)");
+        strcpy(my->column, "");
         my->next.ts = TS_ZERO;
         strcpy(my->next.value, "");
+        my->next.number = 0.0;
+        my->next.numeric = false;
+        my->cache = nullptr;
+        my->position = 0;
+        my->bound = nullptr;
         my->loopnum = 0;
         my->loop = 0;
         my->status = TS_INIT;
@@ -204,6 +219,13 @@ static int player_open(OBJECT *obj) {
         /* use object name-id as default file name */
         sprintf(fname, "%s-%d.%s", obj->parent->oclass->name, obj->parent->id, my->filetype.get_string());
 
+    /* batch workers search the GLPATH for files not found in their scenario directory */
+    else if (strcmp(my->mode, "file") == 0 && strcmp(fname, "-") != 0 && tape_batch_worker()) {
+        char1024 path;
+        if (gl_findfile(fname, nullptr, R_OK, path, sizeof(path)) != nullptr)
+            strcpy(fname, path);
+    }
+
     /* if type is file or file is stdin */
     tf = get_ftable(my->mode);
     if (tf == nullptr)
@@ -215,8 +237,50 @@ static int player_open(OBJECT *obj) {
 	//Store the starting timestamp - for deltamode stuff
 	my->sim_start_time = gl_globalclock;
 
+    /* players bound to a column share the binary tape of the file */
+    if (my->column[0] != '\0') {
+        if (strcmp(my->mode, "file") != 0 || strcmp(fname, "-") == 0) {
+            gl_error("player:%d: column '%s' can only be played from a file", obj->id, my->column.get_string());
+            /* TROUBLESHOOT
+            Players bound to a value column must read a file, because the columns are loaded from the binary tape of that file.
+            Remove the column or change the player mode to 'file'.
+            */
+            return 0;
+        }
+        my->cache = player_cache_open(fname);
+        if (my->cache == nullptr) {
+            gl_error("player:%d: unable to load the columns of player file '%s'", obj->id, fname.get_string());
+            /* TROUBLESHOOT
+            The file could not be found, or one of its lines could not be read.  Check the file name and the contents of the file.
+            */
+            return 0;
+        }
+        my->bound = player_cache_column(my->cache, my->column);
+        if (my->bound == nullptr) {
+            gl_error("player:%d: player file '%s' has no column '%s'", obj->id, fname.get_string(), my->column.get_string());
+            /* TROUBLESHOOT
+            The column names of a player file are given by a '# timestamp,name1,name2,...' header line before the first sample, as written by recorders.
+            Check that the header line is present and that the column name is spelled correctly.
+            */
+            player_cache_close(my->cache);
+            my->cache = nullptr;
+            return 0;
+        }
+        if (strcmp(my->property, "(undefined)") == 0)
+            strcpy(my->property, my->column);
+    } else if (player_binary && strcmp(my->mode, "file") == 0 && strcmp(fname, "-") != 0) {
+        /* use the binary tape of files when enabled */
+        my->cache = player_cache_open(fname);
+    }
+    if (my->cache != nullptr) {
+        my->position = 0;
+        my->loopnum = my->loop;
+        my->status = TS_OPEN;
+        my->type = FT_FILE;
+    }
+
     /* access the input stream to the player */
-    if ((my->ops->open)(my, fname, flags) == 1) {
+    if (my->cache != nullptr || (my->ops->open)(my, fname, flags) == 1) {
         /* set up the delta_mode recorder if enabled */
         if ((obj->flags) & OF_DELTAMODE) {
             //todo check if referring to tape.cpp delta_add_tape_device
@@ -235,11 +299,19 @@ static int player_open(OBJECT *obj) {
 }
 
 static void rewind_player(struct player *my) {
-    (*my->ops->rewind)(my);
+    if (my->cache != nullptr)
+        my->position = 0;
+    else
+        (*my->ops->rewind)(my);
 }
 
 static void close_player(struct player *my) {
-    (my->ops->close)(my);
+    if (my->cache != nullptr) {
+        player_cache_close(my->cache);
+        my->cache = nullptr;
+        my->bound = nullptr;
+    } else
+        (my->ops->close)(my);
 }
 
 static void trim(char *str, char *to) {
@@ -261,17 +333,16 @@ static void trim(char *str, char *to) {
     }
 }
 
-TIMESTAMP player_read(OBJECT *obj) {
-    char buffer[1024];
+/** Parse a line of a player tape
+	@return 1 if a sample was read, 0 if the line is a comment or blank, -1 if the line could not be split, -2 if the timestamp could not be read
+ **/
+int player_parse(const char *line, PLAYERSAMPLE *sample, char *value) {
     char timebuf[64], valbuf[1024], tbuf[64];
     char tz[6];
     int Y = 0, m = 0, d = 0, H = 0, M = 0;
     double S = 0;
-    struct player *my = OBJECTDATA(obj, struct player);
     char unit[2];
     TIMESTAMP t1;
-    char *result = nullptr;
-    char1024 value;
     int voff = 0;
 
     /* TODO move this to tape.c and make the variable available to all classes in tape */
@@ -287,203 +358,223 @@ TIMESTAMP player_read(OBJECT *obj) {
         else dateformat = ISO;
     }
 
-    while (true) {
-        result = my->ops->read(my, buffer, sizeof(buffer));
-
-        memset(timebuf, 0, 64);
-        memset(valbuf, 0, 1024);
-        memset(tbuf, 0, 64);
-        memset(value, 0, 1024);
-        memset(tz, 0, 6);
-        if (result == nullptr) {
-            if (my->loopnum > 0) {
-                rewind_player(my);
-                my->loopnum--;
-                continue;
-            } else {
-                close_player(my);
-                my->status = TS_DONE;
-                my->next.ts = TS_NEVER;
-                my->next.ns = 0;
+    if (line[0] == '#' || line[0] == '\n') /* ignore comments and blank lines */
+        return 0;
+
+    memset(timebuf, 0, 64);
+    memset(valbuf, 0, 1024);
+    memset(tbuf, 0, 64);
+    memset(value, 0, 1024);
+    memset(tz, 0, 6);
+    if (sscanf(line, "%64[^,],%1024[^\n\r;]", tbuf, valbuf) != 2)
+        return -1;
+    trim(tbuf, timebuf);
+    trim(valbuf, value);
+    while (value[voff] == ' ') {
+        ++voff;
+    }
+    sample->value = value + voff;
+    sample->number = 0.0;
+    sample->ns = 0;
+    if (sscanf(timebuf, "%d-%d-%d %d:%d:%lf %4s", &Y, &m, &d, &H, &M, &S, tz) == 7) {
+        //struct tm dt = {S,M,H,d,m-1,Y-1900,0,0,0};
+        DATETIME dt;
+        switch (dateformat) {
+            case ISO:
+                dt.year = static_cast<short>(Y);
+                dt.month = static_cast<short>(m);
+                dt.day = static_cast<short>(d);
+                break;
+            case US:
+                dt.year = static_cast<short>(d);
+                dt.month = static_cast<short>(Y);
+                dt.day = static_cast<short>(m);
+                break;
+            case EURO:
+                dt.year = static_cast<short>(d);
+                dt.month = static_cast<short>(m);
+                dt.day = static_cast<short>(Y);
+                break;
+            default:
+                dt.year = static_cast<short>(Y);
+                dt.month = static_cast<short>(m);
+                dt.day = static_cast<short>(d);
+                break;
+        }
+        dt.hour = static_cast<short>(H);
+        dt.minute = static_cast<short>(M);
+        dt.second = (unsigned short) S;
+        dt.nanosecond = (unsigned int) (1e9 * (S - dt.second));
+        strcpy(dt.tz, tz);
+        sample->kind = PS_DATETIME;
+        sample->t = (TIMESTAMP) gl_mktime(&dt);
+        sample->ns = dt.nanosecond;
+    } else if (sscanf(timebuf, "%d-%d-%d %d:%d:%lf", &Y, &m, &d, &H, &M, &S) >= 4) {
+        //struct tm dt = {S,M,H,d,m-1,Y-1900,0,0,0};
+        DATETIME dt;
+        switch (dateformat) {
+            case US:
+                dt.year = static_cast<short>(d);
+                dt.month = static_cast<short>(Y);
+                dt.day = static_cast<short>(m);
+                break;
+            case EURO:
+                dt.year = static_cast<short>(d);
+                dt.month = static_cast<short>(m);
+                dt.day = static_cast<short>(Y);
+                break;
+            default:
+                dt.year = static_cast<short>(Y);
+                dt.month = static_cast<short>(m);
+                dt.day = static_cast<short>(d);
+                break;
+        }
+        dt.hour = static_cast<short>(H);
+        dt.minute = static_cast<short>(M);
+        dt.second = (unsigned short) S;
+        dt.tz[0] = 0;
+        dt.nanosecond = (unsigned int) (1e9 * (S - dt.second));
+        sample->kind = PS_DATETIME;
+        sample->t = (TIMESTAMP) gl_mktime(&dt);
+        sample->ns = dt.nanosecond;
+    } else if (sscanf(timebuf, "%" FMT_INT64 "d%1s", &t1, unit) == 2) {
+        int64 scale = 1;
+        switch (unit[0]) {
+            case 's':
+                scale = TS_SECOND;
                 break;
+            case 'm':
+                scale = 60 * TS_SECOND;
+                break;
+            case 'h':
+                scale = 3600 * TS_SECOND;
+                break;
+            case 'd':
+                scale = 86400 * TS_SECOND;
+                break;
+            default:
+                break;
+        }
+        sample->kind = (line[0] == '+') ? PS_SHIFT : PS_ABSOLUTE; /* timeshifts have leading + */
+        sample->t = t1 * scale;
+    } else if (sscanf(timebuf, "%lf", &S) == 1) {
+        sample->kind = PS_SECONDS;
+        sample->t = (TIMESTAMP)S;
+        sample->ns = (unsigned int) (1e9 * (S - sample->t));
+    } else {
+        return -2;
+    }
+    return 1;
+}
+
+/* request deltamode for a sample, if the player is explicitly enabled for it */
+static void player_deltamode(OBJECT *obj, struct player *my, TIMESTAMP t1, int64 ns) {
+    if ((obj->flags & OF_DELTAMODE) == OF_DELTAMODE) {
+        if (my->all_events_delta) {
+            if (my->sim_start_time < t1) {
+                enable_deltamode(t1);
             }
+        } else {
+            enable_deltamode(ns == 0 ? TS_NEVER : t1);
         }
-        if (result[0] == '#' || result[0] == '\n') /* ignore comments and blank lines */
-            continue;
+    }
+}
 
-        if (sscanf(result, "%64[^,],%1024[^\n\r;]", tbuf, valbuf) == 2) {
-            trim(tbuf, timebuf);
-            trim(valbuf, value);
-            if (sscanf(timebuf, "%d-%d-%d %d:%d:%lf %4s", &Y, &m, &d, &H, &M, &S, tz) == 7) {
-                //struct tm dt = {S,M,H,d,m-1,Y-1900,0,0,0};
-                DATETIME dt;
-                switch (dateformat) {
-					case ISO:
-						dt.year = static_cast<short>(Y);
-						dt.month = static_cast<short>(m);
-						dt.day = static_cast<short>(d);
-						break;
-                    case US:
-                        dt.year = static_cast<short>(d);
-                        dt.month = static_cast<short>(Y);
-                        dt.day = static_cast<short>(m);
-                        break;
-                    case EURO:
-                        dt.year = static_cast<short>(d);
-                        dt.month = static_cast<short>(m);
-                        dt.day = static_cast<short>(Y);
-                        break;
-                    default:
-                        dt.year = static_cast<short>(Y);
-                        dt.month = static_cast<short>(m);
-                        dt.day = static_cast<short>(d);
-                        break;
-                }
-                dt.hour = static_cast<short>(H);
-                dt.minute = static_cast<short>(M);
-                dt.second = (unsigned short) S;
-                dt.nanosecond = (unsigned int) (1e9 * (S - dt.second));
-                strcpy(dt.tz, tz);
-                t1 = (TIMESTAMP) gl_mktime(&dt);
-                if ((obj->flags & OF_DELTAMODE) == OF_DELTAMODE)    /* Only request deltamode if we're explicitly enabled */
-				{
-					if (my->all_events_delta)
-					{
-						if (my->sim_start_time < t1)
-						{
-							enable_deltamode(t1);
-						}
-					}
-					else
-					{
-						enable_deltamode(dt.nanosecond==0?TS_NEVER:t1);
-					}
-				}
-                if (t1 != TS_INVALID && my->loop == my->loopnum) {
-                    my->next.ts = t1;
-                    my->next.ns = dt.nanosecond;
-                    while (value[voff] == ' ') {
-                        ++voff;
-                    }
-                    strcpy(my->next.value.get_string(), value.get_string() + voff);
-                }
-            } else if (sscanf(timebuf, "%d-%d-%d %d:%d:%lf", &Y, &m, &d, &H, &M, &S) >= 4) {
-                //struct tm dt = {S,M,H,d,m-1,Y-1900,0,0,0};
-                DATETIME dt;
-                switch (dateformat) {
-                    case US:
-                        dt.year = static_cast<short>(d);
-                        dt.month = static_cast<short>(Y);
-                        dt.day = static_cast<short>(m);
-                        break;
-                    case EURO:
-                        dt.year = static_cast<short>(d);
-                        dt.month = static_cast<short>(m);
-                        dt.day = static_cast<short>(Y);
-                        break;
-                    default:
-                        dt.year = static_cast<short>(Y);
-                        dt.month = static_cast<short>(m);
-                        dt.day = static_cast<short>(d);
-                        break;
-                }
-                dt.hour = static_cast<short>(H);
-                dt.minute = static_cast<short>(M);
-                dt.second = (unsigned short) S;
-                dt.tz[0] = 0;
-                dt.nanosecond = (unsigned int) (1e9 * (S - dt.second));
-                t1 = (TIMESTAMP) gl_mktime(&dt);
-                if ((obj->flags & OF_DELTAMODE) == OF_DELTAMODE)    /* Only request deltamode if we're explicitly enabled */
-                {
-                    if (my->all_events_delta)
-                    {
-                        if (my->sim_start_time < t1)
-                        {
-                            enable_deltamode(t1);
-                        }
-                    }
-                    else
-                    {
-                        enable_deltamode(dt.nanosecond==0?TS_NEVER:t1);
-                    }
-                }
-                if (t1 != TS_INVALID && my->loop == my->loopnum) {
-                    my->next.ts = t1;
-                    my->next.ns = dt.nanosecond;
-                    while (value[voff] == ' ') {
-                        ++voff;
-                    }
-                    strcpy(my->next.value.get_string(), value.get_string() + voff);
-                }
-            } else if (sscanf(timebuf, "%" FMT_INT64 "d%1s", &t1, unit) == 2) {
-                {
-                    int64 scale = 1;
-                    switch (unit[0]) {
-                        case 's':
-                            scale = TS_SECOND;
-                            break;
-                        case 'm':
-                            scale = 60 * TS_SECOND;
-                            break;
-                        case 'h':
-                            scale = 3600 * TS_SECOND;
-                            break;
-                        case 'd':
-                            scale = 86400 * TS_SECOND;
-                            break;
-                        default:
-                            break;
-                    }
-                    t1 *= scale;
-                    if (result[0] == '+') { /* timeshifts have leading + */
-                        my->next.ts += t1;
-                        while (value[voff] == ' ') {
-                            ++voff;
-                        }
-                        strcpy(my->next.value.get_string(), value.get_string() + voff);
-                    } else if (my->loop == my->loopnum) { /* absolute times are ignored on all but first loops */
-                        my->next.ts = t1;
-                        while (value[voff] == ' ') {
-                            ++voff;
-                        }
-                        strcpy(my->next.value.get_string(), value.get_string() + voff);
-                    }
-                }
-            } else if (sscanf(timebuf, "%lf", &S) == 1) {
-                if (my->loop == my->loopnum) {
-					my->next.ts = (TIMESTAMP)S;
-                    my->next.ns = (unsigned int) (1e9 * (S - my->next.ts));
-                    if ((obj->flags & OF_DELTAMODE)==OF_DELTAMODE)	/* Only request deltamode if we're explicitly enabled */
-                    {
-                        if (my->all_events_delta)
-                        {
-                            if (my->sim_start_time < t1)
-                            {
-                                enable_deltamode(t1);
-                            }
-                        }
-                        else
-                        {
-                            enable_deltamode(my->next.ns==0?TS_NEVER:t1);
-                        }
-                    }
-                    while (value[voff] == ' ') {
-                        ++voff;
-                    }
-                    strcpy(my->next.value.get_string(), value.get_string() + voff);
+static void player_next_value(struct player *my, PLAYERSAMPLE *sample) {
+    strcpy(my->next.value.get_string(), sample->value);
+    my->next.number = sample->number;
+    my->next.numeric = (sample->kind & PS_NUMERIC) == PS_NUMERIC;
+}
+
+/* advance the player to a sample */
+static void player_apply(OBJECT *obj, struct player *my, PLAYERSAMPLE *sample) {
+    switch (sample->kind & PS_KIND) {
+        case PS_DATETIME:
+            player_deltamode(obj, my, sample->t, sample->ns);
+            if (sample->t != TS_INVALID && my->loop == my->loopnum) {
+                my->next.ts = sample->t;
+                my->next.ns = sample->ns;
+                player_next_value(my, sample);
+            }
+            break;
+        case PS_SHIFT:
+            my->next.ts += sample->t;
+            player_next_value(my, sample);
+            break;
+        case PS_ABSOLUTE:
+            if (my->loop == my->loopnum) { /* absolute times are ignored on all but first loops */
+                my->next.ts = sample->t;
+                player_next_value(my, sample);
+            }
+            break;
+        case PS_SECONDS:
+            if (my->loop == my->loopnum) {
+                my->next.ts = sample->t;
+                my->next.ns = sample->ns;
+                player_deltamode(obj, my, sample->t, sample->ns);
+                player_next_value(my, sample);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+TIMESTAMP player_read(OBJECT *obj) {
+    char buffer[1024];
+    char1024 value;
+    struct player *my = OBJECTDATA(obj, struct player);
+    char *result = nullptr;
+    PLAYERSAMPLE sample;
+
+    while (true) {
+        if (my->cache != nullptr) {
+            PLAYERCACHE *cache = my->cache;
+            if (my->position < cache->count) {
+                uint32 n = my->position++;
+                sample.kind = cache->kind[n];
+                sample.t = cache->time[n];
+                sample.ns = cache->ns[n];
+                if (my->bound != nullptr) {
+                    sample.kind = (sample.kind & PS_KIND) | my->bound->numeric[n];
+                    sample.number = my->bound->number[n];
+                    sample.value = my->bound->pool + my->bound->value[n];
+                } else {
+                    sample.number = cache->number[n];
+                    sample.value = cache->pool + cache->value[n];
                 }
+                player_apply(obj, my, &sample);
+                break;
             }
-            else
-            {
-                gl_error("player was unable to parse timestamp \'%s\'", result);
-                return TS_INVALID;
+        } else if ((result = my->ops->read(my, buffer, sizeof(buffer))) != nullptr) {
+            switch (player_parse(result, &sample, value.get_string())) {
+                case 0:
+                    continue;
+                case -1:
+                    gl_error("player was unable to split input string \'%s\'", result);
+                    return TS_INVALID;
+                case -2:
+                    gl_error("player was unable to parse timestamp \'%s\'", result);
+                    return TS_INVALID;
+                default:
+                    break;
             }
+            sample.kind &= PS_KIND; /* values read from text are always converted by the target property */
+            player_apply(obj, my, &sample);
             break;
+        }
+        /* end of tape */
+        if (my->loopnum > 0) {
+            rewind_player(my);
+            my->loopnum--;
+            continue;
         } else {
-            gl_error("player was unable to split input string \'%s\'", result);
-            return TS_INVALID;
+            close_player(my);
+            my->status = TS_DONE;
+            my->next.ts = TS_NEVER;
+            my->next.ns = 0;
+            break;
         }
-        // 'continue' statements sent here
     }
     return my->next.ns == 0 ? my->next.ts : (my->next.ts + 1); // 'break' statements sent here
 }
@@ -530,7 +621,7 @@ EXPORT TIMESTAMP sync_player(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
         }
         if (my->target != nullptr) {
             OBJECT *target = obj->parent ? obj->parent : obj; /* target myself if no parent */
-			return_val = player_write_properties(my, obj, target, my->target, my->next.value);
+			return_val = player_write_properties(my, obj, target, my->target, my->next.value, my->next.numeric ? &my->next.number : nullptr);
 
 			if (return_val < 0)	//See if the above came back with an error state
 			{
@@ -586,7 +677,7 @@ EXPORT TIMESTAMP sync_player(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 			if ((my->target!=nullptr) && (my->next.ts<t0))
 			{
 				OBJECT *target = obj->parent ? obj->parent : obj; /* target myself if no parent */
-				return_val = player_write_properties(my, obj, target, my->target, my->next.value);
+				return_val = player_write_properties(my, obj, target, my->target, my->next.value, my->next.numeric ? &my->next.number : nullptr);
 
 				if (return_val < 0)	//See if the above came back with an error state
 				{
@@ -623,7 +714,7 @@ EXPORT TIMESTAMP sync_player(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 				if ((my->target!=nullptr) && (my->next.ts<t0))
 				{
 					OBJECT *target = obj->parent ? obj->parent : obj; /* target myself if no parent */
-					return_val = player_write_properties(my, obj, target, my->target, my->next.value);			
+					return_val = player_write_properties(my, obj, target, my->target, my->next.value, my->next.numeric ? &my->next.number : nullptr);			
 
 					if (return_val < 0)	//See if the above came back with an error state
 					{
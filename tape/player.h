@@ -7,6 +7,26 @@
 
 #include "property.h"
 #include "tape.h"
+#include "player_cache.h"
+
+/// kinds of player samples
+typedef enum {
+	PS_DATETIME=0, ///< absolute date and time
+	PS_SHIFT=1, ///< time shift from the previous sample (leading +)
+	PS_ABSOLUTE=2, ///< absolute timestamp with a unit
+	PS_SECONDS=3, ///< absolute timestamp in seconds
+} PLAYERSAMPLEKIND;
+#define PS_KIND 0x7f ///< mask of the sample kind
+#define PS_NUMERIC 0x80 ///< flag indicating the value is a single number
+
+/// player sample parsed from a tape
+typedef struct s_playersample {
+	unsigned char kind; ///< PLAYERSAMPLEKIND and PS_NUMERIC flag
+	TIMESTAMP t; ///< timestamp or time shift
+	int64 ns; ///< nanoseconds
+	double number; ///< value if PS_NUMERIC is set
+	const char *value; ///< value string
+} PLAYERSAMPLE;
 
 /** @}
   @addtogroup player
@@ -18,6 +38,7 @@ class player : public gld_object {
     char8 filetype; // the type of the player source
     char256 mode;
     char256 property; //< the target property
+    char256 column; //< the value column of the source to play (if any)
     int32 loop; //< the number of time to replay the tape
 	bool all_events_delta;	/**< Flag to force any player update to trigger deltamode */
 
@@ -37,6 +58,8 @@ class player : public gld_object {
         TIMESTAMP ts;
         int64 ns;
         char1024 value;
+        double number;
+        bool numeric;
     } next;
     struct {
         TIMESTAMP ts;
@@ -45,6 +68,9 @@ class player : public gld_object {
     } delta_track;	// Added for deltamode fixes
     PROPERTY *target;
     TAPEOPS *ops;
+    PLAYERCACHE *cache; ///< binary tape (if any)
+    uint32 position; ///< next sample in the binary tape
+    PLAYERCOLUMN *bound; ///< value column of the binary tape played (if any)
 
     player(MODULE *module);
     int create(void);
@@ -57,5 +83,6 @@ class player : public gld_object {
 };
 
 extern TIMESTAMP player_read(OBJECT *obj);
+extern int player_parse(const char *line, PLAYERSAMPLE *sample, char *value);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,452 @@
+/** $Id: player_cache.cpp
+	Copyright (C) 2026 Battelle Memorial Institute
+	@file player_cache.cpp
+	@addtogroup player_cache Binary player tapes
+	@ingroup player
+
+	When \p tape::player_binary is set, players of files read their samples
+	from a binary tape instead of the CSV text.  The samples of a binary tape
+	are already parsed and stored by column (timestamps, numeric values,
+	value strings, nanoseconds and sample kinds), so playing a sample does
+	not need any string scanning or date conversion, and single numbers
+	played into double properties do not need to be converted either.
+
+	A CSV tape \p name is converted automatically to the binary tape
+	\p name.glpb the first time it is played, and converted again when the
+	CSV tape changes, or when the date format or timezone used to compute
+	the timestamps is not the same.  A player may also refer to a binary
+	tape directly.  The binary tape is memory mapped, and all the players
+	that refer to the same file share the same copy.
+
+	A player may also bind to a single value column of a tape by setting
+	\p column to one of the names given by the "# timestamp,..." header
+	line of the tape (which is how recorders label their columns).  This
+	lets many players share one multi-column file, which is loaded and
+	split into columns only once.
+ @{
+ **/
+
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "player.h"
+#include "player_cache.h"
+
+int32 player_binary = 0; /* enable this option to play files from binary tapes */
+
+static unsigned int player_cache_lock = 0;
+static std::map<std::string,PLAYERCACHE*> player_cache_list;
+
+/* date format and timezone that the tape timestamps depend on */
+static void player_cache_signature(char *signature, size_t len)
+{
+	char dateformat[8] = "";
+	DATETIME winter, summer;
+	gl_global_getvar("dateformat", dateformat, sizeof(dateformat));
+	gl_localtime(946684800, &winter); /* 2000-01-01 00:00:00 UTC */
+	gl_localtime(962409600, &summer); /* 2000-07-01 00:00:00 UTC */
+	snprintf(signature, len, "%s;%.5s%+d;%.5s%+d", dateformat, winter.tz, winter.tzoffset, summer.tz, summer.tzoffset);
+}
+
+/* check a tape image and locate its columns */
+static bool player_cache_attach(PLAYERCACHE *cache, const char *signature, struct stat *source)
+{
+	PLAYERCACHEHEADER *header = (PLAYERCACHEHEADER*)cache->data;
+	uint64 count;
+	if ( cache->size < sizeof(PLAYERCACHEHEADER)
+		|| strncmp(header->magic, PLAYERCACHE_MAGIC, sizeof(header->magic)) != 0
+		|| header->version != PLAYERCACHE_VERSION
+		|| header->size != cache->size )
+		return false;
+	count = header->count;
+	if ( header->time+count*sizeof(int64) > cache->size
+		|| header->number+count*sizeof(double) > cache->size
+		|| header->value+count*sizeof(uint32) > cache->size
+		|| header->ns+count*sizeof(int32) > cache->size
+		|| header->kind+count > cache->size
+		|| header->pool > cache->size
+		|| header->columns >= cache->size
+		|| ((const char*)cache->data)[cache->size-1] != '\0' )
+		return false;
+	if ( source != nullptr && (header->source_size != (int64)source->st_size || header->source_time != (int64)source->st_mtime) )
+		return false;
+	if ( strncmp(header->signature, signature, sizeof(header->signature)) != 0 )
+	{
+		if ( source == nullptr )
+		{
+			gl_error("player_cache: binary tape '%s' was compiled for '%s' but the current date format and timezone are '%s'", cache->source.get_string(), header->signature, signature);
+			/* TROUBLESHOOT
+			The timestamps of a binary player tape depend on the date format and the timezone in use when the tape was converted.
+			Play the original CSV tape instead, or use the same date format and timezone that were used when the binary tape was made.
+			*/
+		}
+		return false;
+	}
+	cache->count = header->count;
+	cache->time = (const int64*)((char*)cache->data+header->time);
+	cache->number = (const double*)((char*)cache->data+header->number);
+	cache->value = (const uint32*)((char*)cache->data+header->value);
+	cache->ns = (const int32*)((char*)cache->data+header->ns);
+	cache->kind = (const unsigned char*)((char*)cache->data+header->kind);
+	cache->pool = (const char*)cache->data+header->pool;
+	cache->columns = (const char*)cache->data+header->columns;
+	return true;
+}
+
+static void player_cache_release(PLAYERCACHE *cache)
+{
+	if ( cache->data == nullptr )
+		return;
+#ifndef _WIN32
+	if ( cache->mapped )
+		munmap(cache->data, cache->size);
+	else
+#endif
+		free(cache->data);
+	cache->data = nullptr;
+	cache->size = 0;
+}
+
+/* load a binary tape, mapping it in memory if possible */
+static bool player_cache_map(PLAYERCACHE *cache, const char *fname)
+{
+#ifndef _WIN32
+	int fd = open(fname, O_RDONLY);
+	struct stat info;
+	if ( fd < 0 )
+		return false;
+	if ( fstat(fd, &info) != 0 || info.st_size == 0 )
+	{
+		close(fd);
+		return false;
+	}
+	cache->size = (size_t)info.st_size;
+	cache->data = mmap(nullptr, cache->size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if ( cache->data == MAP_FAILED )
+	{
+		cache->data = nullptr;
+		return false;
+	}
+	cache->mapped = true;
+	return true;
+#else
+	FILE *fp = fopen(fname, "rb");
+	struct stat info;
+	if ( fp == nullptr )
+		return false;
+	if ( stat(fname, &info) != 0 || info.st_size == 0 || (cache->data = malloc(info.st_size)) == nullptr )
+	{
+		fclose(fp);
+		return false;
+	}
+	cache->size = (size_t)info.st_size;
+	cache->mapped = false;
+	if ( fread(cache->data, 1, cache->size, fp) != cache->size )
+	{
+		fclose(fp);
+		player_cache_release(cache);
+		return false;
+	}
+	fclose(fp);
+	return true;
+#endif
+}
+
+/* check whether a value is a single number */
+static bool player_cache_number(const char *value, double *number)
+{
+	char *end;
+	*number = strtod(value, &end);
+	if ( end == value )
+		return false;
+	while ( isspace((unsigned char)*end) ) end++;
+	return *end == '\0';
+}
+
+/* convert a CSV tape to a binary tape image, and save it for later runs */
+static bool player_cache_convert(PLAYERCACHE *cache, const char *fname, const char *binname, const char *signature, struct stat *source)
+{
+	std::vector<int64> time;
+	std::vector<double> number;
+	std::vector<uint32> value;
+	std::vector<int32> ns;
+	std::vector<unsigned char> kind;
+	std::string pool;
+	std::string columns;
+	char buffer[1024];
+	char1024 text;
+	PLAYERSAMPLE sample;
+	PLAYERCACHEHEADER header;
+	FILE *fp = fopen(fname, "r");
+	if ( fp == nullptr )
+		return false;
+	while ( fgets(buffer, sizeof(buffer), fp) != nullptr )
+	{
+		int rc = player_parse(buffer, &sample, text.get_string());
+		if ( rc == 0 )
+		{
+			/* column names are given by the last header line before the first sample */
+			char *p = buffer+1;
+			while ( isspace((unsigned char)*p) ) p++;
+			if ( buffer[0] == '#' && time.empty() && strncmp(p, "timestamp,", 10) == 0 )
+			{
+				columns = p+10;
+				while ( !columns.empty() && isspace((unsigned char)columns.back()) )
+					columns.pop_back();
+			}
+			continue;
+		}
+		if ( rc < 0 || pool.size() > 0xffffffff-sizeof(text) )
+		{
+			/* the text tape reports the problem when it is played */
+			fclose(fp);
+			return false;
+		}
+		if ( player_cache_number(sample.value, &sample.number) )
+			sample.kind |= PS_NUMERIC;
+		time.push_back(sample.t);
+		number.push_back(sample.kind&PS_NUMERIC ? sample.number : 0.0);
+		value.push_back((uint32)pool.size());
+		ns.push_back((int32)sample.ns);
+		kind.push_back(sample.kind);
+		pool.append(sample.value, strlen(sample.value)+1);
+	}
+	fclose(fp);
+
+	/* layout the image */
+	memset(&header, 0, sizeof(header));
+	strncpy(header.magic, PLAYERCACHE_MAGIC, sizeof(header.magic));
+	header.version = PLAYERCACHE_VERSION;
+	header.count = (uint32)time.size();
+	header.source_size = (int64)source->st_size;
+	header.source_time = (int64)source->st_mtime;
+	strncpy(header.signature, signature, sizeof(header.signature)-1);
+	header.time = sizeof(header);
+	header.number = header.time + header.count*sizeof(int64);
+	header.value = header.number + header.count*sizeof(double);
+	header.ns = header.value + header.count*sizeof(uint32);
+	header.kind = header.ns + header.count*sizeof(int32);
+	header.pool = header.kind + header.count;
+	header.columns = header.pool + pool.size();
+	header.size = header.columns + columns.size() + 1;
+
+	/* build the image */
+	cache->data = malloc(header.size);
+	if ( cache->data == nullptr )
+		return false;
+	cache->size = header.size;
+	cache->mapped = false;
+	memcpy(cache->data, &header, sizeof(header));
+	if ( header.count > 0 )
+	{
+		memcpy((char*)cache->data+header.time, time.data(), header.count*sizeof(int64));
+		memcpy((char*)cache->data+header.number, number.data(), header.count*sizeof(double));
+		memcpy((char*)cache->data+header.value, value.data(), header.count*sizeof(uint32));
+		memcpy((char*)cache->data+header.ns, ns.data(), header.count*sizeof(int32));
+		memcpy((char*)cache->data+header.kind, kind.data(), header.count);
+		memcpy((char*)cache->data+header.pool, pool.data(), pool.size());
+	}
+	memcpy((char*)cache->data+header.columns, columns.c_str(), columns.size()+1);
+
+	/* save it for the next run (the image in memory is used for this one) */
+	std::string tmpname = std::string(binname) + ".tmp";
+	fp = fopen(tmpname.c_str(), "wb");
+	bool saved = fp != nullptr && fwrite(cache->data, 1, cache->size, fp) == cache->size;
+	if ( fp != nullptr && fclose(fp) != 0 )
+		saved = false;
+	if ( !saved || rename(tmpname.c_str(), binname) != 0 )
+	{
+		gl_warning("player_cache: unable to save binary tape '%s' (%s), conversion will be repeated on the next run", binname, strerror(errno));
+		/* TROUBLESHOOT
+		The binary tape converted from a CSV player tape could not be written next to the CSV tape.
+		The simulation uses the converted tape anyway, but the conversion will be done again the next time.
+		Check that the folder of the player file is writable.
+		*/
+		remove(tmpname.c_str());
+	}
+	else
+		gl_verbose("player_cache: converted '%s' to '%s' (%u samples)", fname, binname, header.count);
+	return player_cache_attach(cache, signature, nullptr);
+}
+
+/** Open the binary tape of a player file
+	@return the binary tape, or nullptr if the file cannot be played from one
+ **/
+PLAYERCACHE *player_cache_open(const char *fname)
+{
+	char path[1024];
+	char magic[8] = "";
+	char signature[64];
+	struct stat source;
+	PLAYERCACHE *cache = nullptr;
+	FILE *fp;
+
+	if ( gl_findfile((char*)fname, nullptr, R_OK, path, sizeof(path)) == nullptr || stat(path, &source) != 0 )
+		return nullptr;
+
+	WRITELOCK(&player_cache_lock);
+	std::map<std::string,PLAYERCACHE*>::iterator item = player_cache_list.find(path);
+	if ( item != player_cache_list.end() )
+	{
+		cache = item->second;
+		cache->refs++;
+		WRITEUNLOCK(&player_cache_lock);
+		return cache;
+	}
+
+	cache = (PLAYERCACHE*)malloc(sizeof(PLAYERCACHE));
+	if ( cache == nullptr )
+	{
+		WRITEUNLOCK(&player_cache_lock);
+		return nullptr;
+	}
+	memset(cache, 0, sizeof(PLAYERCACHE));
+	strncpy(cache->source.get_string(), path, sizeof(cache->source)-1);
+	player_cache_signature(signature, sizeof(signature));
+
+	fp = fopen(path, "rb");
+	if ( fp != nullptr )
+	{
+		if ( fread(magic, 1, sizeof(magic), fp) != sizeof(magic) )
+			magic[0] = '\0';
+		fclose(fp);
+	}
+	if ( strncmp(magic, PLAYERCACHE_MAGIC, sizeof(magic)) == 0 )
+	{
+		/* binary tape given directly */
+		if ( !player_cache_map(cache, path) || !player_cache_attach(cache, signature, nullptr) )
+		{
+			player_cache_release(cache);
+			free(cache);
+			cache = nullptr;
+		}
+	}
+	else
+	{
+		/* binary tape converted from the CSV tape */
+		std::string binname = std::string(path) + PLAYERCACHE_EXTENSION;
+		if ( !player_cache_map(cache, binname.c_str()) || !player_cache_attach(cache, signature, &source) )
+		{
+			player_cache_release(cache);
+			if ( !player_cache_convert(cache, path, binname.c_str(), signature, &source) )
+			{
+				player_cache_release(cache);
+				free(cache);
+				cache = nullptr;
+			}
+		}
+	}
+	if ( cache != nullptr )
+	{
+		cache->refs = 1;
+		player_cache_list[path] = cache;
+	}
+	WRITEUNLOCK(&player_cache_lock);
+	return cache;
+}
+
+/** Release the binary tape of a player
+ **/
+void player_cache_close(PLAYERCACHE *cache)
+{
+	WRITELOCK(&player_cache_lock);
+	if ( --cache->refs == 0 )
+	{
+		player_cache_list.erase(cache->source.get_string());
+		while ( cache->column_list != nullptr )
+		{
+			PLAYERCOLUMN *column = cache->column_list;
+			cache->column_list = column->next;
+			free(column->number);
+			free(column->value);
+			free(column->numeric);
+			free(column->pool);
+			free(column);
+		}
+		player_cache_release(cache);
+		free(cache);
+	}
+	WRITEUNLOCK(&player_cache_lock);
+}
+
+/** Bind a value column of a binary tape
+	@return the column, or nullptr if the tape has no column by that name
+ **/
+PLAYERCOLUMN *player_cache_column(PLAYERCACHE *cache, const char *name)
+{
+	char1024 names;
+	char *next = nullptr, *item;
+	int index = -1, n = 0;
+	PLAYERCOLUMN *column;
+	std::string pool;
+
+	WRITELOCK(&player_cache_lock);
+	for ( column = cache->column_list ; column != nullptr ; column = column->next )
+	{
+		if ( strcmp(column->name, name) == 0 )
+		{
+			WRITEUNLOCK(&player_cache_lock);
+			return column;
+		}
+	}
+
+	/* locate the column */
+	strncpy(names.get_string(), cache->columns, sizeof(names)-1);
+	for ( item = strtok_s(names.get_string(), ",", &next) ; item != nullptr ; item = strtok_s(nullptr, ",", &next), n++ )
+	{
+		while ( isspace((unsigned char)*item) ) item++;
+		size_t len = strlen(item);
+		while ( len > 0 && isspace((unsigned char)item[len-1]) ) item[--len] = '\0';
+		if ( strcmp(item, name) == 0 )
+		{
+			index = n;
+			break;
+		}
+	}
+	if ( index < 0 || (column = (PLAYERCOLUMN*)malloc(sizeof(PLAYERCOLUMN))) == nullptr )
+	{
+		WRITEUNLOCK(&player_cache_lock);
+		return nullptr;
+	}
+
+	/* split the column out of the value strings */
+	memset(column, 0, sizeof(PLAYERCOLUMN));
+	strncpy(column->name.get_string(), name, sizeof(column->name)-1);
+	column->number = (double*)malloc(sizeof(double)*(cache->count+1));
+	column->value = (uint32*)malloc(sizeof(uint32)*(cache->count+1));
+	column->numeric = (unsigned char*)malloc(cache->count+1);
+	for ( uint32 row = 0 ; row < cache->count ; row++ )
+	{
+		char1024 text;
+		const char *token = "";
+		strncpy(text.get_string(), cache->pool+cache->value[row], sizeof(text)-1);
+		item = strtok_s(text.get_string(), ",\n\r\t", &next); /* same separators as player_write_properties */
+		for ( n = 0 ; item != nullptr && n < index ; n++ )
+			item = strtok_s(nullptr, ",\n\r\t", &next);
+		if ( item != nullptr )
+			token = item;
+		column->value[row] = (uint32)pool.size();
+		column->numeric[row] = player_cache_number(token, &column->number[row]) ? PS_NUMERIC : 0;
+		pool.append(token, strlen(token)+1);
+	}
+	column->pool = (char*)malloc(pool.size()+1);
+	memcpy(column->pool, pool.data(), pool.size());
+	column->next = cache->column_list;
+	cache->column_list = column;
+	WRITEUNLOCK(&player_cache_lock);
+	return column;
+}
+
+/**@}*/
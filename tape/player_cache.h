@@ -0,0 +1,75 @@
+/* $Id: player_cache.h
+ *	Copyright (C) 2026 Battelle Memorial Institute
+ */
+
+#ifndef _PLAYER_CACHE_H
+#define _PLAYER_CACHE_H
+
+#include "gridlabd.h"
+
+#define PLAYERCACHE_MAGIC "GLDPLAY" ///< first bytes of a binary player tape
+#define PLAYERCACHE_VERSION 2 ///< format version of binary player tapes
+#define PLAYERCACHE_EXTENSION ".glpb" ///< extension added to a CSV tape to name its binary tape
+
+/** Binary player tape header
+
+	A binary tape holds the samples of a player tape already parsed.  The
+	header is followed by the columns of the tape, in tape order: the
+	timestamps (int64), the numeric values (double), the offsets of the
+	value strings in the string pool (uint32), the nanoseconds (int32), the
+	sample kinds (unsigned char), the string pool, and the names of the
+	value columns (from a "# timestamp,..." header line, as written by
+	recorders).
+ **/
+typedef struct s_playercacheheader {
+	char magic[8]; ///< PLAYERCACHE_MAGIC
+	uint32 version; ///< PLAYERCACHE_VERSION
+	uint32 count; ///< number of samples
+	int64 source_size; ///< size of the CSV tape converted (0 if none)
+	int64 source_time; ///< modification time of the CSV tape converted
+	char signature[64]; ///< date format and timezone used to compute the timestamps
+	uint64 time; ///< offset of the timestamp column
+	uint64 number; ///< offset of the numeric value column
+	uint64 value; ///< offset of the value string column
+	uint64 ns; ///< offset of the nanosecond column
+	uint64 kind; ///< offset of the sample kind column
+	uint64 pool; ///< offset of the string pool
+	uint64 columns; ///< offset of the column names
+	uint64 size; ///< total size of the tape
+} PLAYERCACHEHEADER;
+
+/// Value column of a binary player tape (shared by all the players bound to it)
+typedef struct s_playercolumn {
+	char256 name; ///< column name
+	double *number; ///< numeric values
+	uint32 *value; ///< offsets of the value strings in the pool
+	unsigned char *numeric; ///< PS_NUMERIC if the value is a single number
+	char *pool; ///< value strings
+	struct s_playercolumn *next;
+} PLAYERCOLUMN;
+
+/// Binary player tape loaded in memory (shared by all the players using it)
+typedef struct s_playercache {
+	char1024 source; ///< path of the tape the players refer to
+	void *data; ///< tape image
+	size_t size; ///< size of the tape image
+	bool mapped; ///< image is memory mapped (otherwise it was allocated)
+	unsigned int refs; ///< number of players using the tape
+	uint32 count; ///< number of samples
+	const int64 *time; ///< timestamp column
+	const double *number; ///< numeric value column
+	const uint32 *value; ///< value string column
+	const int32 *ns; ///< nanosecond column
+	const unsigned char *kind; ///< sample kind column
+	const char *pool; ///< value strings
+	const char *columns; ///< comma-separated names of the value columns
+	PLAYERCOLUMN *column_list; ///< value columns bound so far
+} PLAYERCACHE;
+
+extern int32 player_binary;
+
+PLAYERCACHE *player_cache_open(const char *fname);
+void player_cache_close(PLAYERCACHE *cache);
+PLAYERCOLUMN *player_cache_column(PLAYERCACHE *cache, const char *name);
+
+#endif
@@ -30,6 +30,10 @@
 	do not define more than one value for any given hour of the year.  The
 	shaper will examine the shape when loading it to verify that all hours
 	of the year are defined exactly once.
+
+	A shape file is loaded only once.  All the shapers using the same file
+	with the same file type get their shape from the first shaper that
+	loaded it.
  @{
  **/
  
@@ -37,6 +41,8 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <map>
+#include <string>
 
 #include "gridlabd.h"
 #include "object.h"
@@ -50,6 +56,16 @@
 CLASS *shaper_class = nullptr;
 static OBJECT *last_shaper = nullptr;
 
+/* shape loaded from a file (shared by all the shapers using that file) */
+typedef struct s_shapersource {
+	unsigned char shape[12][31][7][24];
+	double scale;
+	int16 interval;
+	int16 step;
+} SHAPERSOURCE;
+static std::map<std::string,SHAPERSOURCE*> shaper_sources; /* by file type and file name */
+static unsigned int shaper_source_lock = 0;
+
 EXPORT int create_shaper(OBJECT **obj, OBJECT *parent)
 {
 	*obj = gl_create_object(shaper_class);
@@ -100,6 +116,14 @@ static int shaper_open(OBJECT *obj)
 		/* use object name-id as default file name */
 		sprintf(fname,"%s-%d.%s",obj->parent->oclass->name,obj->parent->id, my->filetype.get_string());
 
+	/* batch workers search the GLPATH for files not found in their scenario directory */
+	else if (strcmp(my->mode,"file")==0 && strcmp(fname,"-")!=0 && tape_batch_worker())
+	{
+		char1024 path;
+		if (gl_findfile(fname,nullptr,R_OK,path,sizeof(path))!=nullptr)
+			strcpy(fname,path);
+	}
+
 	/* if type is file or file is stdin */
 	fns = get_ftable(my->mode);
 	if (fns==nullptr)
@@ -107,7 +131,45 @@ static int shaper_open(OBJECT *obj)
 	my->ops = fns->shaper;
 	if(my->ops == nullptr)
 		return 0;
-	if (my->ops->open(my, fname, flags))
+
+	/* files already loaded by another shaper are not read again */
+	if (strcmp(my->mode,"file")==0 && strcmp(fname,"-")!=0)
+	{
+		SHAPERSOURCE *source = nullptr;
+		std::map<std::string,SHAPERSOURCE*>::iterator item;
+		std::string key = std::string(my->filetype.get_string()) + ":" + fname.get_string();
+		WRITELOCK(&shaper_source_lock);
+		item = shaper_sources.find(key);
+		if (item!=shaper_sources.end())
+		{
+			source = item->second;
+			memcpy(my->shape,source->shape,sizeof(my->shape));
+			my->scale = source->scale;
+			my->interval = source->interval;
+			my->step = source->step;
+			my->fp = nullptr;
+			my->type = FT_FILE;
+			my->status = TS_OPEN;
+			WRITEUNLOCK(&shaper_source_lock);
+			return 1;
+		}
+		if (my->ops->open(my, fname, flags))
+		{
+			source = (SHAPERSOURCE*)malloc(sizeof(SHAPERSOURCE));
+			if (source!=nullptr)
+			{
+				memcpy(source->shape,my->shape,sizeof(source->shape));
+				source->scale = my->scale;
+				source->interval = my->interval;
+				source->step = my->step;
+				shaper_sources[key] = source;
+			}
+			WRITEUNLOCK(&shaper_source_lock);
+			return 1;
+		}
+		WRITEUNLOCK(&shaper_source_lock);
+	}
+	else if (my->ops->open(my, fname, flags))
 		return 1;
 	gl_error("%s",my->lasterr[0]?my->lasterr:"unknown error");
 	return 0;
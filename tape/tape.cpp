@@ -137,6 +137,16 @@ void set_csv_options(void)
 		(*update_csv_keep_clean)();
 }
 
+/** Check whether the simulation runs the scenario of a batch sweep (see --batch).
+	Batch workers run in the output directory of their scenario, so they also
+	look for input files on the GLPATH, where the model directory is first.
+ **/
+bool tape_batch_worker(void)
+{
+	char1024 batch_file;
+	return gl_global_getvar("batch_file",batch_file,sizeof(batch_file))!=nullptr && batch_file[0]!='\0';
+}
+
 typedef int (*OPENFUNC)(void *, char *, char *);
 typedef char *(*READFUNC)(void *, char *, unsigned int);
 typedef int (*WRITEFUNC)(void *, char *, char *);
@@ -255,6 +265,7 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create(const_cast<char *>("tape::flush_interval"), PT_int32, &flush_interval, nullptr);
 	gl_global_create(const_cast<char *>("tape::csv_data_only"), PT_int32, &csv_data_only, nullptr);
 	gl_global_create(const_cast<char *>("tape::csv_keep_clean"), PT_int32, &csv_keep_clean, nullptr);
+	gl_global_create(const_cast<char *>("tape::player_binary"), PT_int32, &player_binary, nullptr);
 
 	/* control delta mode */
 	gl_global_create(const_cast<char *>("tape::delta_mode_needed"), PT_timestamp, &delta_mode_needed, nullptr);
@@ -263,6 +274,7 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	player_class = gl_register_class(module, const_cast<char *>("player"), sizeof(struct player), PC_PRETOPDOWN);
 	player_class->trl = TRL_PROVEN;
 	PUBLISH_STRUCT(player,char256,property);
+	PUBLISH_STRUCT(player,char256,column);
 	PUBLISH_STRUCT(player,char1024,file);
 	PUBLISH_STRUCT(player,char8,filetype);
 	PUBLISH_STRUCT(player,char32,mode);
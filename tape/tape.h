@@ -65,6 +65,7 @@ extern void enable_deltamode(TIMESTAMP t); /* indicate when deltamode is needed
 EXPORT int delta_add_tape_device(OBJECT *obj, DELTATAPEOBJ tape_type);
 
 void set_csv_options(void);
+bool tape_batch_worker(void);
 
 // TODO: Misc prototypes from across the module. Move all of these into appropriate header files for each component
 